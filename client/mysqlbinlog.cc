@@ -820,6 +820,10 @@ static bool shall_skip_gtids(Log_event* ev)
   return filtered;
 }
 
+static Exit_status process_payload_events(PRINT_EVENT_INFO *print_event_info,
+                                          Transaction_payload_log_event *ev,
+                                          my_off_t pos, const char *logname);
+
 /**
   Print the given event, and either delete it or delegate the deletion
   to someone else.
@@ -1425,6 +1429,18 @@ Exit_status process_event(PRINT_EVENT_INFO *print_event_info, Log_event *ev,
         goto err;
       break;
     }
+    case TRANSACTION_PAYLOAD_EVENT:
+    {
+      ev->print(result_file, print_event_info);
+      if (head->error == -1 ||
+          copy_event_cache_to_file_and_reinit(head, result_file,
+                                              stop_never /* flush result_file */))
+        goto err;
+      retval= process_payload_events(print_event_info,
+                                     (Transaction_payload_log_event *) ev,
+                                     pos, logname);
+      goto end;
+    }
     case PREVIOUS_GTIDS_LOG_EVENT:
       if (one_database && !opt_skip_gtids)
         warning("The option --database has been used. It may filter "
@@ -1465,6 +1481,75 @@ end:
 }
 
 
+/**
+  Process the events carried by a Transaction_payload_log_event, as if
+  they had been read one after the other at the position of the payload.
+
+  @param[in,out] print_event_info Parameters and context state
+  determining how to print.
+  @param[in] ev The Transaction_payload_log_event.
+  @param[in] pos Offset of the payload from beginning of binlog file.
+  @param[in] logname Name of input binlog.
+
+  @retval ERROR_STOP An error occurred - the program should terminate.
+  @retval OK_CONTINUE No error, the program should continue.
+  @retval OK_STOP No error, but the end of the specified range of
+  events to process has been reached and the program should terminate.
+*/
+static Exit_status process_payload_events(PRINT_EVENT_INFO *print_event_info,
+                                          Transaction_payload_log_event *ev,
+                                          my_off_t pos, const char *logname)
+{
+  char ll_buff[21];
+  Exit_status retval= OK_CONTINUE;
+  DYNAMIC_ARRAY event_bufs;
+  ulong len= ev->get_uncompressed_len();
+  uchar *buf;
+  DBUG_ENTER("process_payload_events");
+
+  if (!ev->is_valid() || !(buf= ev->uncompress_payload()))
+  {
+    error("Could not uncompress the Transaction_payload event at "
+          "position %s.", llstr(pos, ll_buff));
+    DBUG_RETURN(ERROR_STOP);
+  }
+  /*
+    When reading from a remote host, process_event() does not free the
+    buffers of the events; they are freed here once the whole
+    transaction, which may have buffered some of them, was processed.
+  */
+  my_init_dynamic_array(&event_bufs, sizeof(char *), 16, 16);
+
+  for (ulong offset= 0; offset < len && retval == OK_CONTINUE; )
+  {
+    const char *error_msg= NULL;
+    ulong event_len= 0;
+    Log_event *inner=
+      Transaction_payload_log_event::read_event(buf + offset, len - offset,
+                                                &event_len, ev->log_pos,
+                                                glob_description_event,
+                                                &error_msg);
+    if (inner == NULL)
+    {
+      error("Could not read an event of the Transaction_payload event at "
+            "position %s: %s", llstr(pos, ll_buff), error_msg);
+      retval= ERROR_STOP;
+      break;
+    }
+    offset+= event_len;
+    if (opt_remote_proto != BINLOG_LOCAL)
+      insert_dynamic(&event_bufs, (uchar *) &inner->temp_buf);
+    retval= process_event(print_event_info, inner, pos, logname);
+  }
+
+  for (uint i= 0; i < event_bufs.elements; i++)
+    my_free(*dynamic_element(&event_bufs, i, char **));
+  delete_dynamic(&event_bufs);
+  my_free(buf);
+  DBUG_RETURN(retval);
+}
+
+
 static struct my_option my_long_options[] =
 {
   {"help", '?', "Display this help and exit.",
@@ -178,6 +178,7 @@ enum enum_prop {
 
 #include <sys/time.h>
 
+#include <string>
 #include <chrono>
 
 // Simple timer to log how long operations took and ensure they are "fast".
@@ -28,6 +28,7 @@
 /* This indicates whether semi-synchronous replication is enabled. */
 char rpl_semi_sync_master_enabled;
 unsigned long rpl_semi_sync_master_timeout;
+unsigned int rpl_semi_sync_master_wait_for_slave_count = 1;
 unsigned long rpl_semi_sync_master_trace_level;
 char rpl_semi_sync_master_status                    = 0;
 unsigned long rpl_semi_sync_master_yes_transactions = 0;
@@ -388,6 +389,7 @@ ReplSemiSyncMaster::ReplSemiSyncMaster()
     wait_file_pos_(0),
     master_enabled_(false),
     wait_timeout_(0L),
+    wait_for_slave_count_(1),
     state_(0)
 {
   strcpy(reply_file_name_, "");
@@ -413,6 +415,7 @@ int ReplSemiSyncMaster::initObject()
   /* Mutex initialization can only be done after MY_INIT(). */
   mysql_mutex_init(key_ss_mutex_LOCK_binlog_,
                    &LOCK_binlog_, MY_MUTEX_INIT_FAST);
+  setWaitSlaveCount(rpl_semi_sync_master_wait_for_slave_count);
 
   if (rpl_semi_sync_master_enabled)
     result = enableMaster();
@@ -515,11 +518,22 @@ void ReplSemiSyncMaster::add_slave()
   unlock();
 }
 
-void ReplSemiSyncMaster::remove_slave()
+void ReplSemiSyncMaster::remove_slave(uint32 server_id)
 {
   lock();
   rpl_semi_sync_master_clients--;
 
+  /* The slave may come back with fewer events, forget its replies. */
+  for (std::vector<SlaveReply>::iterator it= slave_replies_.begin();
+       it != slave_replies_.end(); ++it)
+  {
+    if (it->server_id == server_id)
+    {
+      slave_replies_.erase(it);
+      break;
+    }
+  }
+
   /* Only switch off if semi-sync is enabled and is on */
   if (getMasterEnabled() && is_on())
   {
@@ -547,6 +561,64 @@ void ReplSemiSyncMaster::remove_slave()
   unlock();
 }
 
+void ReplSemiSyncMaster::setWaitSlaveCount(unsigned int count)
+{
+  lock();
+  wait_for_slave_count_ = count;
+  unlock();
+}
+
+bool ReplSemiSyncMaster::update_slave_replies(uint32 server_id,
+                                              char *log_file_name,
+                                              my_off_t *log_file_pos)
+{
+  std::vector<SlaveReply>::iterator it= slave_replies_.begin();
+  for (; it != slave_replies_.end(); ++it)
+    if (it->server_id == server_id)
+      break;
+
+  if (it == slave_replies_.end())
+  {
+    SlaveReply reply;
+    reply.server_id= server_id;
+    reply.log_name[0]= '\0';
+    reply.log_pos= 0;
+    slave_replies_.push_back(reply);
+    it= slave_replies_.end() - 1;
+  }
+  if (it->log_name[0] == '\0' ||
+      ActiveTranx::compare(log_file_name, *log_file_pos,
+                           it->log_name, it->log_pos) > 0)
+  {
+    strmake(it->log_name, log_file_name, sizeof(it->log_name) - 1);
+    it->log_pos= *log_file_pos;
+  }
+
+  if (slave_replies_.size() < wait_for_slave_count_)
+    return false;
+
+  /*
+    The position replied by enough slaves is the smallest one among the
+    wait_for_slave_count_ largest replies.
+  */
+  std::vector<const SlaveReply*> sorted;
+  for (it= slave_replies_.begin(); it != slave_replies_.end(); ++it)
+    sorted.push_back(&*it);
+  for (size_t i= 0; i < wait_for_slave_count_; i++)
+  {
+    for (size_t j= i + 1; j < sorted.size(); j++)
+    {
+      if (ActiveTranx::compare(sorted[j]->log_name, sorted[j]->log_pos,
+                               sorted[i]->log_name, sorted[i]->log_pos) > 0)
+        std::swap(sorted[i], sorted[j]);
+    }
+  }
+  const SlaveReply *nth= sorted[wait_for_slave_count_ - 1];
+  strmake(log_file_name, nth->log_name, FN_REFLEN - 1);
+  *log_file_pos= nth->log_pos;
+  return true;
+}
+
 bool ReplSemiSyncMaster::is_semi_sync_slave()
 {
   int null_value;
@@ -564,6 +636,7 @@ int ReplSemiSyncMaster::reportReplyBinlog(uint32 server_id,
   int   cmp;
   bool  can_release_threads = false;
   bool  need_copy_send_pos = true;
+  char  replied_file_name[FN_REFLEN];
 
   if (!(getMasterEnabled()))
     return 0;
@@ -580,6 +653,15 @@ int ReplSemiSyncMaster::reportReplyBinlog(uint32 server_id,
     /* We check to see whether we can switch semi-sync ON. */
     try_switch_on(server_id, log_file_name, log_file_pos);
 
+  /* With several slaves to wait for, only count what enough replied. */
+  if (wait_for_slave_count_ > 1)
+  {
+    strmake(replied_file_name, log_file_name, sizeof(replied_file_name) - 1);
+    if (!update_slave_replies(server_id, replied_file_name, &log_file_pos))
+      goto l_end;
+    log_file_name= replied_file_name;
+  }
+
   /* The position should increase monotonically, if there is only one
    * thread sending the binlog to the slave.
    * In reality, to improve the transaction availability, we allow multiple
@@ -881,6 +963,7 @@ int ReplSemiSyncMaster::switch_off()
   rpl_semi_sync_master_off_times++;
   wait_file_name_inited_   = false;
   reply_file_name_inited_  = false;
+  slave_replies_.clear();
   sql_print_information("Semi-sync replication switched OFF.");
 
   /* signal waiting sessions */
@@ -1147,10 +1230,6 @@ int ReplSemiSyncMaster::readSlaveReply(NET *net, uint32 server_id,
                                        const char *event_buf)
 {
   const char *kWho = "ReplSemiSyncMaster::readSlaveReply";
-  const unsigned char *packet;
-  char     log_file_name[FN_REFLEN];
-  my_off_t log_file_pos;
-  ulong    log_file_len = 0;
   ulong    packet_len;
   int      result = -1;
 
@@ -1218,7 +1297,30 @@ int ReplSemiSyncMaster::readSlaveReply(NET *net, uint32 server_id,
     goto l_end;
   }
 
-  packet = net->read_pos;
+  result = reportReplyPacket(server_id, net->read_pos, packet_len);
+
+ l_end:
+  return function_exit(kWho, result);
+}
+
+int ReplSemiSyncMaster::reportReplyPacket(uint32 server_id,
+                                          const unsigned char *packet,
+                                          unsigned long packet_len)
+{
+  const char *kWho = "ReplSemiSyncMaster::reportReplyPacket";
+  char     log_file_name[FN_REFLEN];
+  my_off_t log_file_pos;
+  ulong    log_file_len = 0;
+  int      result = -1;
+
+  function_enter(kWho);
+
+  if (packet_len < REPLY_BINLOG_NAME_OFFSET)
+  {
+    sql_print_error("Read semi-sync reply length error: packet is too small");
+    goto l_end;
+  }
+
   if (packet[REPLY_MAGIC_NUM_OFFSET] != ReplSemiSyncMaster::kPacketMagicNum)
   {
     sql_print_error("Read semi-sync reply magic number error");
@@ -1235,7 +1337,7 @@ int ReplSemiSyncMaster::readSlaveReply(NET *net, uint32 server_id,
   strncpy(log_file_name, (const char*)packet + REPLY_BINLOG_NAME_OFFSET, log_file_len);
   log_file_name[log_file_len] = 0;
 
-  if (trc_level & kTraceDetail)
+  if (trace_level_ & kTraceDetail)
     sql_print_information("%s: Got reply (%s, %lu)",
                           kWho, log_file_name, (ulong)log_file_pos);
 
@@ -1261,6 +1363,7 @@ int ReplSemiSyncMaster::resetMaster()
   wait_file_name_inited_   = false;
   reply_file_name_inited_  = false;
   commit_file_name_inited_ = false;
+  slave_replies_.clear();
 
   rpl_semi_sync_master_yes_transactions = 0;
   rpl_semi_sync_master_no_transactions = 0;
@@ -19,6 +19,7 @@
 #define SEMISYNC_MASTER_H
 
 #include "semisync.h"
+#include <vector>
 
 #ifdef HAVE_PSI_INTERFACE
 extern PSI_mutex_key key_ss_mutex_LOCK_binlog_;
@@ -447,9 +448,20 @@ class ReplSemiSyncMaster
   /* The 'largest' position in that file that a commit transaction is seeing. */
   my_off_t        commit_file_pos_;
 
+  /* The position up to which each slave replied, used only when waiting
+   * for the replies of several slaves.
+   */
+  struct SlaveReply {
+    uint32   server_id;
+    char     log_name[FN_REFLEN];
+    my_off_t log_pos;
+  };
+  std::vector<SlaveReply> slave_replies_;
+
   /* All global variables which can be set by parameters. */
   volatile bool            master_enabled_;      /* semi-sync is enabled on the master */
   unsigned long           wait_timeout_;      /* timeout period(ms) during tranx wait */
+  unsigned int            wait_for_slave_count_; /* replies a tranx waits for */
 
   bool            state_;                    /* whether semi-sync is switched */
 
@@ -472,6 +484,21 @@ class ReplSemiSyncMaster
   int try_switch_on(int server_id,
                     const char *log_file_name, my_off_t log_file_pos);
 
+  /* Record the reply of a slave and find the position up to which
+   * wait_for_slave_count_ slaves have replied.
+   *
+   * Input:
+   *  server_id     - (IN)  server id of the replying slave
+   *  log_file_name - (IN/OUT) the replied position's file name, replaced
+   *                           by the position replied by enough slaves
+   *  log_file_pos  - (IN/OUT) the replied position's file offset
+   *
+   * Return:
+   *  true: enough slaves replied;  false: the position did not move
+   */
+  bool update_slave_replies(uint32 server_id,
+                            char *log_file_name, my_off_t *log_file_pos);
+
  public:
   ReplSemiSyncMaster();
   ~ReplSemiSyncMaster() {}
@@ -492,6 +519,9 @@ class ReplSemiSyncMaster
     wait_timeout_ = wait_timeout;
   }
 
+  /* Set the number of slave replies a transaction waits for. */
+  void setWaitSlaveCount(unsigned int count);
+
   /* Initialize this class after MySQL parameters are initialized. this
    * function should be called once at bootstrap time.
    */
@@ -507,7 +537,7 @@ class ReplSemiSyncMaster
   void add_slave();
     
   /* Remove a semi-sync replication slave */
-  void remove_slave();
+  void remove_slave(uint32 server_id);
 
   /* Is the slave servered by the thread requested semi-sync */
   bool is_semi_sync_slave();
@@ -607,6 +637,20 @@ class ReplSemiSyncMaster
    */
   int readSlaveReply(NET *net, uint32 server_id, const char *event_buf);
 
+  /* Report the reply packet of a slave, read by the dump thread or by the
+   * ACK receiver thread.
+   *
+   * Input:
+   *  server_id    - (IN)  server id of the slave
+   *  packet       - (IN)  the reply packet
+   *  packet_len   - (IN)  length of the packet
+   *
+   * Return:
+   *  0: success;  non-zero: error
+   */
+  int reportReplyPacket(uint32 server_id, const unsigned char *packet,
+                        unsigned long packet_len);
+
   /* In semi-sync replication, this method simulates the reception of
    * an reply and executes reportReplyBinlog directly when a transaction
    * is skipped in the master.
@@ -632,11 +676,14 @@ class ReplSemiSyncMaster
   int resetMaster();
 };
 
+extern ReplSemiSyncMaster repl_semisync;
+
 /* System and status variables for the master component */
 extern char rpl_semi_sync_master_enabled;
 extern char rpl_semi_sync_master_status;
 extern unsigned long rpl_semi_sync_master_clients;
 extern unsigned long rpl_semi_sync_master_timeout;
+extern unsigned int rpl_semi_sync_master_wait_for_slave_count;
 extern unsigned long rpl_semi_sync_master_trace_level;
 extern unsigned long rpl_semi_sync_master_yes_transactions;
 extern unsigned long rpl_semi_sync_master_no_transactions;
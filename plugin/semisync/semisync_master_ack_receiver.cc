@@ -0,0 +1,329 @@
+/* Copyright (c) 2014, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+#include "semisync_master.h"
+#include "semisync_master_ack_receiver.h"
+#include "sql_class.h"                          // THD
+#ifdef HAVE_POLL
+#include <poll.h>
+#endif
+
+/* How long, in milliseconds, one poll of the slave sockets may last. */
+#define ACK_RECEIVER_POLL_TIMEOUT 100
+
+Ack_receiver ack_receiver;
+
+pthread_handler_t ack_receive_handler(void *arg)
+{
+  my_thread_init();
+  reinterpret_cast<Ack_receiver *>(arg)->run();
+  my_thread_end();
+  pthread_exit(0);
+  return NULL;
+}
+
+Ack_receiver::Ack_receiver()
+  : m_status(ST_DOWN), m_slaves_changed(false), m_reading(false),
+    m_inited(false)
+{
+}
+
+void Ack_receiver::init()
+{
+  trace_level_= rpl_semi_sync_master_trace_level;
+  mysql_mutex_init(key_ss_mutex_Ack_receiver_mutex, &m_mutex,
+                   MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_ss_cond_Ack_receiver_cond, &m_cond, NULL);
+  m_inited= true;
+}
+
+void Ack_receiver::cleanup()
+{
+  if (!m_inited)
+    return;
+  stop();
+  m_slaves.clear();
+  mysql_mutex_destroy(&m_mutex);
+  mysql_cond_destroy(&m_cond);
+  m_inited= false;
+}
+
+void Ack_receiver::stop()
+{
+  mysql_mutex_lock(&m_mutex);
+  stop_thread();
+  mysql_mutex_unlock(&m_mutex);
+}
+
+/*
+  Stop the thread and wait for it to end. Called with m_mutex, which is
+  released while waiting.
+*/
+void Ack_receiver::stop_thread()
+{
+  const char *kWho = "Ack_receiver::stop_thread";
+  function_enter(kWho);
+  mysql_mutex_assert_owner(&m_mutex);
+
+  if (m_status == ST_UP)
+  {
+    m_status= ST_STOPPING;
+    mysql_cond_broadcast(&m_cond);
+    mysql_mutex_unlock(&m_mutex);
+    pthread_join(m_pid, NULL);
+    mysql_mutex_lock(&m_mutex);
+    m_status= ST_DOWN;
+    mysql_cond_broadcast(&m_cond);
+  }
+  while (m_status == ST_STOPPING)
+    mysql_cond_wait(&m_cond, &m_mutex);
+
+  function_exit(kWho, 0);
+}
+
+std::vector<Ack_receiver::Slave>::iterator
+Ack_receiver::find_slave(my_thread_id thread_id)
+{
+  mysql_mutex_assert_owner(&m_mutex);
+  std::vector<Slave>::iterator it= m_slaves.begin();
+  for (; it != m_slaves.end(); ++it)
+    if (it->stats.thread_id == thread_id)
+      break;
+  return it;
+}
+
+bool Ack_receiver::add_slave(THD *thd, uint32 server_id)
+{
+  const char *kWho = "Ack_receiver::add_slave";
+  Slave slave;
+  function_enter(kWho);
+
+  memset(&slave.stats, 0, sizeof(slave.stats));
+  slave.stats.server_id= server_id;
+  slave.stats.thread_id= thd->thread_id;
+  slave.vio= *thd->net.vio;
+  slave.net_compress= thd->net.compress;
+  slave.sent_time= 0;
+
+  mysql_mutex_lock(&m_mutex);
+  while (m_status == ST_STOPPING)
+    mysql_cond_wait(&m_cond, &m_mutex);
+  if (m_status == ST_DOWN)
+  {
+    if (mysql_thread_create(key_ss_thread_Ack_receiver_thread, &m_pid,
+                            NULL, ack_receive_handler, this))
+    {
+      sql_print_error("Failed to start semi-sync ACK receiver thread, "
+                      "could not create thread(errno:%d)", errno);
+      mysql_mutex_unlock(&m_mutex);
+      return function_exit(kWho, true);
+    }
+    m_status= ST_UP;
+  }
+  m_slaves.push_back(slave);
+  m_slaves_changed= true;
+  mysql_cond_broadcast(&m_cond);
+  mysql_mutex_unlock(&m_mutex);
+
+  return function_exit(kWho, false);
+}
+
+void Ack_receiver::remove_slave(THD *thd)
+{
+  const char *kWho = "Ack_receiver::remove_slave";
+  function_enter(kWho);
+
+  mysql_mutex_lock(&m_mutex);
+  std::vector<Slave>::iterator it= find_slave(thd->thread_id);
+  if (it != m_slaves.end())
+  {
+    m_slaves.erase(it);
+    m_slaves_changed= true;
+    /*
+      The thread may be using a copy of the connection. Wait for it to
+      see the change, as the connection is closed after this returns.
+    */
+    while (m_reading)
+      mysql_cond_wait(&m_cond, &m_mutex);
+    /*
+      The thread ends with the last slave, so that its THD is freed
+      while the server still runs.
+    */
+    if (m_slaves.empty())
+      stop_thread();
+  }
+  mysql_mutex_unlock(&m_mutex);
+
+  function_exit(kWho, 0);
+}
+
+void Ack_receiver::event_sent(THD *thd)
+{
+  mysql_mutex_lock(&m_mutex);
+  std::vector<Slave>::iterator it= find_slave(thd->thread_id);
+  if (it != m_slaves.end() && it->sent_time == 0)
+    it->sent_time= my_micro_time();
+  mysql_mutex_unlock(&m_mutex);
+}
+
+void Ack_receiver::get_slave_stats(std::vector<SlaveAckStats> *stats)
+{
+  mysql_mutex_lock(&m_mutex);
+  for (std::vector<Slave>::iterator it= m_slaves.begin();
+       it != m_slaves.end(); ++it)
+    stats->push_back(it->stats);
+  mysql_mutex_unlock(&m_mutex);
+}
+
+void Ack_receiver::report_reply(const Slave &slave,
+                                const unsigned char *packet,
+                                unsigned long len)
+{
+  unsigned long long now= my_micro_time();
+
+  mysql_mutex_lock(&m_mutex);
+  std::vector<Slave>::iterator it= find_slave(slave.stats.thread_id);
+  if (it != m_slaves.end() && it->sent_time != 0)
+  {
+    unsigned long long latency= now > it->sent_time ? now - it->sent_time : 0;
+    uint bucket= 0;
+    while (bucket < array_elements(kAckLatencyBucketLimit) &&
+           latency > kAckLatencyBucketLimit[bucket])
+      bucket++;
+    it->stats.latency[bucket]++;
+    it->stats.acks++;
+    it->stats.ack_time+= latency;
+    it->sent_time= 0;
+    rpl_semi_sync_master_net_wait_num++;
+    rpl_semi_sync_master_net_wait_time+= latency;
+  }
+  mysql_mutex_unlock(&m_mutex);
+
+  repl_semisync.reportReplyPacket(slave.stats.server_id, packet, len);
+}
+
+/*
+  Wait until some slaves have sent data, or for at most
+  ACK_RECEIVER_POLL_TIMEOUT.
+
+  Return:
+   the number of slaves with data, or -1 on error
+*/
+int Ack_receiver::wait_for_replies(std::vector<Slave> *slaves,
+                                   std::vector<bool> *ready)
+{
+  int ret;
+  ready->assign(slaves->size(), false);
+#ifdef HAVE_POLL
+  std::vector<struct pollfd> fds(slaves->size());
+  for (size_t i= 0; i < slaves->size(); i++)
+  {
+    fds[i].fd= vio_fd(&(*slaves)[i].vio);
+    fds[i].events= POLLIN;
+    fds[i].revents= 0;
+  }
+  ret= poll(&fds[0], fds.size(), ACK_RECEIVER_POLL_TIMEOUT);
+  for (size_t i= 0; ret > 0 && i < slaves->size(); i++)
+    (*ready)[i]= fds[i].revents != 0;
+#else
+  fd_set fds;
+  my_socket max_fd= 0;
+  struct timeval tv= { 0, ACK_RECEIVER_POLL_TIMEOUT * 1000 };
+  FD_ZERO(&fds);
+  for (size_t i= 0; i < slaves->size(); i++)
+  {
+    my_socket fd= vio_fd(&(*slaves)[i].vio);
+    FD_SET(fd, &fds);
+    set_if_bigger(max_fd, fd);
+  }
+  ret= select((int) max_fd + 1, &fds, NULL, NULL, &tv);
+  for (size_t i= 0; ret > 0 && i < slaves->size(); i++)
+    (*ready)[i]= FD_ISSET(vio_fd(&(*slaves)[i].vio), &fds);
+#endif /* HAVE_POLL */
+  return ret;
+}
+
+void Ack_receiver::run()
+{
+  THD *thd= new THD;
+  std::vector<Slave> slaves;
+  std::vector<bool> ready;
+
+  thd->thread_stack= (char*) &thd;
+  thd->store_globals();
+  my_net_init(&thd->net, NULL);
+  sql_print_information("Starting semi-sync ACK receiver thread");
+
+  mysql_mutex_lock(&m_mutex);
+  while (m_status == ST_UP)
+  {
+    if (m_slaves_changed)
+    {
+      slaves= m_slaves;
+      m_slaves_changed= false;
+    }
+    if (slaves.empty())
+    {
+      mysql_cond_wait(&m_cond, &m_mutex);
+      continue;
+    }
+    m_reading= true;
+    mysql_mutex_unlock(&m_mutex);
+
+    if (wait_for_replies(&slaves, &ready) > 0)
+    {
+      NET *net= &thd->net;
+      for (size_t i= 0; i < slaves.size(); i++)
+      {
+        if (!ready[i])
+          continue;
+        net->vio= &slaves[i].vio;
+        net->compress= slaves[i].net_compress;
+        /* Read all the replies which are already buffered. */
+        do
+        {
+          net_clear(net, 0);
+          ulong len= my_net_read(net);
+          if (len == packet_error)
+          {
+            /*
+              The dump thread finds out about the broken connection when
+              it sends the next event. Until then, do not poll it again.
+            */
+            sql_print_error("Read semi-sync reply network error: %s "
+                            "(errno: %d)", net->last_error, net->last_errno);
+            slaves.erase(slaves.begin() + i);
+            ready.erase(ready.begin() + i);
+            i--;
+            break;
+          }
+          report_reply(slaves[i], net->read_pos, len);
+        } while (net->vio->has_data(net->vio));
+        thd->clear_error();
+      }
+      net->vio= NULL;
+    }
+
+    mysql_mutex_lock(&m_mutex);
+    m_reading= false;
+    mysql_cond_broadcast(&m_cond);
+  }
+  mysql_mutex_unlock(&m_mutex);
+
+  sql_print_information("Stopping semi-sync ACK receiver thread");
+  net_end(&thd->net);
+  thd->release_resources();
+  delete thd;
+}
@@ -0,0 +1,136 @@
+/* Copyright (c) 2014, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+#ifndef SEMISYNC_MASTER_ACK_RECEIVER_H
+#define SEMISYNC_MASTER_ACK_RECEIVER_H
+
+#include "semisync.h"
+#include "violite.h"
+#include <vector>
+
+class THD;
+
+#ifdef HAVE_PSI_INTERFACE
+extern PSI_mutex_key key_ss_mutex_Ack_receiver_mutex;
+extern PSI_cond_key key_ss_cond_Ack_receiver_cond;
+extern PSI_thread_key key_ss_thread_Ack_receiver_thread;
+#endif
+
+/* Upper bounds, in microseconds, of the ack latency histogram buckets. */
+static const unsigned long long kAckLatencyBucketLimit[]=
+  { 1000, 10000, 100000, 1000000 };
+#define ACK_LATENCY_BUCKETS (array_elements(kAckLatencyBucketLimit) + 1)
+
+/**
+  The reply statistics of one semi-sync slave, as shown in
+  INFORMATION_SCHEMA.RPL_SEMI_SYNC_SLAVE_ACKS.
+*/
+struct SlaveAckStats {
+  uint32             server_id;
+  my_thread_id       thread_id;
+  unsigned long long acks;
+  /* Sum of the latencies of the measured replies, in microseconds. */
+  unsigned long long ack_time;
+  unsigned long long latency[ACK_LATENCY_BUCKETS];
+};
+
+/**
+  @class Ack_receiver
+
+  A thread which reads the replies of all semi-sync slaves, so that the
+  binlog dump threads only send events and never wait for a reply.
+
+  The dump thread of a semi-sync slave registers the connection with
+  add_slave() when it starts and removes it with remove_slave() before
+  it ends. The receiver polls the sockets of all registered slaves and
+  reports each reply with ReplSemiSyncMaster::reportReplyPacket().
+
+  The latency of a reply is the time from the sending of the first
+  event which requested it, see event_sent(), to its reception.
+
+  The thread is started with the first slave and ends with the last one.
+*/
+class Ack_receiver : public Trace {
+public:
+  Ack_receiver();
+  ~Ack_receiver() {}
+
+  /* Initialize the mutex, after the PSI keys have been registered. */
+  void init();
+  /* Stop the thread and free the resources. */
+  void cleanup();
+
+  /* Register the connection of a semi-sync slave.
+   *
+   * Input:
+   *  thd          - (IN)  the binlog dump thread serving the slave
+   *  server_id    - (IN)  server id of the slave
+   *
+   * Return:
+   *  false: success;  true: the thread could not be started
+   */
+  bool add_slave(THD *thd, uint32 server_id);
+
+  /* Unregister a slave. When this returns, the receiver does not use the
+   * connection any more.
+   */
+  void remove_slave(THD *thd);
+
+  /* Called by the dump thread after it sent an event which requests a
+   * reply, to measure the reply latency.
+   */
+  void event_sent(THD *thd);
+
+  /* Copy the statistics of the registered slaves. */
+  void get_slave_stats(std::vector<SlaveAckStats> *stats);
+
+  /* The thread function. */
+  void run();
+
+private:
+  enum status { ST_DOWN, ST_UP, ST_STOPPING };
+
+  struct Slave {
+    SlaveAckStats stats;
+    /* A copy of the connection of the dump thread, used for reading. */
+    Vio           vio;
+    my_bool       net_compress;
+    /* When the oldest unanswered reply request was sent, or 0. */
+    unsigned long long sent_time;
+  };
+
+  void stop();
+  void stop_thread();
+  std::vector<Slave>::iterator find_slave(my_thread_id thread_id);
+  int wait_for_replies(std::vector<Slave> *slaves, std::vector<bool> *ready);
+  void report_reply(const Slave &slave, const unsigned char *packet,
+                    unsigned long len);
+
+  enum status    m_status;
+  /* The registered slaves, protected by m_mutex. */
+  std::vector<Slave> m_slaves;
+  /* Set when m_slaves changed since the thread last copied it. */
+  bool           m_slaves_changed;
+  /* Set while the thread polls or reads the sockets without m_mutex. */
+  bool           m_reading;
+  mysql_mutex_t  m_mutex;
+  mysql_cond_t   m_cond;
+  pthread_t      m_pid;
+  bool           m_inited;
+};
+
+extern Ack_receiver ack_receiver;
+
+#endif /* SEMISYNC_MASTER_ACK_RECEIVER_H */
@@ -17,9 +17,11 @@
 
 
 #include "semisync_master.h"
+#include "semisync_master_ack_receiver.h"
 #include "sql_class.h"                          // THD
+#include "sql_show.h"                           // schema_table_store_record
 
-static ReplSemiSyncMaster repl_semisync;
+ReplSemiSyncMaster repl_semisync;
 
 C_MODE_START
 
@@ -76,6 +78,19 @@ int repl_semi_binlog_dump_start(Binlog_transmit_param *param,
   {
     /* One more semi-sync slave */
     repl_semisync.add_slave();
+
+    /*
+      The replies are read by the ACK receiver thread, except on SSL
+      connections, which cannot be read and written by two threads.
+    */
+    THD *thd= current_thd;
+    if (vio_type(thd->net.vio) != VIO_TYPE_SSL &&
+        ack_receiver.add_slave(thd, param->server_id))
+    {
+      repl_semisync.remove_slave(param->server_id);
+      return 1;
+    }
+
     /* Tell server it will observe the transmission.*/
     param->set_observe_flag();
 
@@ -105,7 +120,8 @@ int repl_semi_binlog_dump_end(Binlog_transmit_param *param)
   if (semi_sync_slave)
   {
     /* One less semi-sync slave */
-    repl_semisync.remove_slave();
+    ack_receiver.remove_slave(current_thd);
+    repl_semisync.remove_slave(param->server_id);
   }
   return 0;
 }
@@ -135,12 +151,32 @@ int repl_semi_after_send_event(Binlog_transmit_param *param,
 {
   if (repl_semisync.is_semi_sync_slave())
   {
+    THD *thd= current_thd;
     if(skipped_log_pos>0)
       repl_semisync.skipSlaveReply(event_buf, param->server_id,
                                    skipped_log_file, skipped_log_pos);
+    else if (vio_type(thd->net.vio) != VIO_TYPE_SSL)
+    {
+      /*
+        The ACK receiver thread reads the reply, only make sure that the
+        event is not left in the buffers. The time is taken before the
+        flush, as the reply may be read as soon as the event is sent.
+      */
+      if ((unsigned char)event_buf[2] == ReplSemiSyncMaster::kPacketFlagSync)
+      {
+        ack_receiver.event_sent(thd);
+        if (net_flush(&thd->net))
+          sql_print_error("Semi-sync master failed on net_flush() "
+                          "before waiting for slave reply");
+        /*
+          The slave sends the reply as packet 0 and then expects the
+          next event to be packet 1, as if the reply was read here.
+        */
+        thd->net.pkt_nr= thd->net.compress_pkt_nr= 1;
+      }
+    }
     else
     {
-      THD *thd= current_thd;
       /*
         Possible errors in reading slave reply are ignored deliberately
         because we do not want dump thread to quit on this. Error
@@ -181,6 +217,11 @@ static void fix_rpl_semi_sync_master_enabled(MYSQL_THD thd,
 				      void *ptr,
 				      const void *val);
 
+static void fix_rpl_semi_sync_master_wait_for_slave_count(MYSQL_THD thd,
+                                                          SYS_VAR *var,
+                                                          void *ptr,
+                                                          const void *val);
+
 static MYSQL_SYSVAR_BOOL(enabled, rpl_semi_sync_master_enabled,
   PLUGIN_VAR_OPCMDARG,
  "Enable semi-synchronous replication master (disabled by default). ",
@@ -209,11 +250,21 @@ static MYSQL_SYSVAR_ULONG(trace_level, rpl_semi_sync_master_trace_level,
   &fix_rpl_semi_sync_master_trace_level, // update
   32, 0, ~0UL, 1);
 
+static MYSQL_SYSVAR_UINT(wait_for_slave_count,
+  rpl_semi_sync_master_wait_for_slave_count,
+  PLUGIN_VAR_OPCMDARG,
+ "How many slaves must have received the events of a transaction before "
+ "its commit returns to the client.",
+  NULL,                         // check
+  &fix_rpl_semi_sync_master_wait_for_slave_count, // update
+  1, 1, 65535, 1);
+
 static SYS_VAR* semi_sync_master_system_vars[]= {
   MYSQL_SYSVAR(enabled),
   MYSQL_SYSVAR(timeout),
   MYSQL_SYSVAR(wait_no_slave),
   MYSQL_SYSVAR(trace_level),
+  MYSQL_SYSVAR(wait_for_slave_count),
   NULL,
 };
 
@@ -235,6 +286,17 @@ static void fix_rpl_semi_sync_master_trace_level(MYSQL_THD thd,
 {
   *(unsigned long *)ptr= *(unsigned long *)val;
   repl_semisync.setTraceLevel(rpl_semi_sync_master_trace_level);
+  ack_receiver.trace_level_= rpl_semi_sync_master_trace_level;
+  return;
+}
+
+static void fix_rpl_semi_sync_master_wait_for_slave_count(MYSQL_THD thd,
+                                                          SYS_VAR *var,
+                                                          void *ptr,
+                                                          const void *val)
+{
+  *(unsigned int *)ptr= *(unsigned int *)val;
+  repl_semisync.setWaitSlaveCount(rpl_semi_sync_master_wait_for_slave_count);
   return;
 }
 
@@ -355,17 +417,28 @@ static SHOW_VAR semi_sync_master_status_vars[]= {
 
 #ifdef HAVE_PSI_INTERFACE
 PSI_mutex_key key_ss_mutex_LOCK_binlog_;
+PSI_mutex_key key_ss_mutex_Ack_receiver_mutex;
 
 static PSI_mutex_info all_semisync_mutexes[]=
 {
-  { &key_ss_mutex_LOCK_binlog_, "LOCK_binlog_", 0}
+  { &key_ss_mutex_LOCK_binlog_, "LOCK_binlog_", 0},
+  { &key_ss_mutex_Ack_receiver_mutex, "Ack_receiver::m_mutex", 0}
 };
 
 PSI_cond_key key_ss_cond_COND_binlog_send_;
+PSI_cond_key key_ss_cond_Ack_receiver_cond;
 
 static PSI_cond_info all_semisync_conds[]=
 {
-  { &key_ss_cond_COND_binlog_send_, "COND_binlog_send_", 0}
+  { &key_ss_cond_COND_binlog_send_, "COND_binlog_send_", 0},
+  { &key_ss_cond_Ack_receiver_cond, "Ack_receiver::m_cond", 0}
+};
+
+PSI_thread_key key_ss_thread_Ack_receiver_thread;
+
+static PSI_thread_info all_semisync_threads[]=
+{
+  { &key_ss_thread_Ack_receiver_thread, "Ack_receiver", PSI_FLAG_GLOBAL}
 };
 #endif /* HAVE_PSI_INTERFACE */
 
@@ -389,6 +462,9 @@ static void init_semisync_psi_keys(void)
   count= array_elements(all_semisync_conds);
   mysql_cond_register(category, all_semisync_conds, count);
 
+  count= array_elements(all_semisync_threads);
+  mysql_thread_register(category, all_semisync_threads, count);
+
   count= array_elements(all_semisync_stages);
   mysql_stage_register(category, all_semisync_stages, count);
 }
@@ -402,6 +478,7 @@ static int semi_sync_master_plugin_init(void *p)
 
   if (repl_semisync.initObject())
     return 1;
+  ack_receiver.init();
   if (register_trans_observer(&trans_observer, p))
     return 1;
   if (register_binlog_storage_observer(&storage_observer, p))
@@ -428,6 +505,7 @@ static int semi_sync_master_plugin_deinit(void *p)
     sql_print_error("unregister_binlog_transmit_observer failed");
     return 1;
   }
+  ack_receiver.cleanup();
   repl_semisync.cleanup();
   sql_print_information("unregister_replicator OK");
   return 0;
@@ -437,6 +515,64 @@ struct Mysql_replication semi_sync_master_plugin= {
   MYSQL_REPLICATION_INTERFACE_VERSION
 };
 
+/*
+  INFORMATION_SCHEMA.RPL_SEMI_SYNC_SLAVE_ACKS: the replies of each
+  connected semi-sync slave, and a histogram of their latency.
+*/
+static ST_FIELD_INFO slave_acks_fields_info[]=
+{
+  {"SERVER_ID", 10, MYSQL_TYPE_LONG, 0, MY_I_S_UNSIGNED, 0, SKIP_OPEN_TABLE},
+  {"THREAD_ID", 21, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0,
+   SKIP_OPEN_TABLE},
+  {"ACKS", 21, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, SKIP_OPEN_TABLE},
+  {"ACK_WAIT_TIME", 21, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0,
+   SKIP_OPEN_TABLE},
+  {"ACKS_1MS", 21, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0,
+   SKIP_OPEN_TABLE},
+  {"ACKS_10MS", 21, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0,
+   SKIP_OPEN_TABLE},
+  {"ACKS_100MS", 21, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0,
+   SKIP_OPEN_TABLE},
+  {"ACKS_1S", 21, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0,
+   SKIP_OPEN_TABLE},
+  {"ACKS_MORE", 21, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0,
+   SKIP_OPEN_TABLE},
+  {0, 0, MYSQL_TYPE_NULL, 0, 0, 0, 0}
+};
+
+static int slave_acks_fill_table(THD *thd, TABLE_LIST *tables, Item *cond)
+{
+  TABLE *table= tables->table;
+  std::vector<SlaveAckStats> stats;
+  ack_receiver.get_slave_stats(&stats);
+
+  for (std::vector<SlaveAckStats>::iterator it= stats.begin();
+       it != stats.end(); ++it)
+  {
+    uint field= 0;
+    table->field[field++]->store(it->server_id, true);
+    table->field[field++]->store(it->thread_id, true);
+    table->field[field++]->store(it->acks, true);
+    table->field[field++]->store(it->ack_time, true);
+    for (uint i= 0; i < ACK_LATENCY_BUCKETS; i++)
+      table->field[field++]->store(it->latency[i], true);
+    if (schema_table_store_record(thd, table))
+      return 1;
+  }
+  return 0;
+}
+
+static int slave_acks_plugin_init(void *p)
+{
+  ST_SCHEMA_TABLE *schema= (ST_SCHEMA_TABLE *) p;
+  schema->fields_info= slave_acks_fields_info;
+  schema->fill_table= slave_acks_fill_table;
+  return 0;
+}
+
+static struct st_mysql_information_schema slave_acks_plugin=
+{ MYSQL_INFORMATION_SCHEMA_INTERFACE_VERSION };
+
 /*
   Plugin library descriptor
 */
@@ -455,5 +591,20 @@ mysql_declare_plugin(semisync_master)
   semi_sync_master_system_vars,	/* system variables */
   NULL,                         /* config options */
   0,                            /* flags */
+},
+{
+  MYSQL_INFORMATION_SCHEMA_PLUGIN,
+  &slave_acks_plugin,
+  "RPL_SEMI_SYNC_SLAVE_ACKS",
+  "Oracle Corporation",
+  "Replies of the semi-synchronous replication slaves",
+  PLUGIN_LICENSE_GPL,
+  slave_acks_plugin_init,       /* Plugin Init */
+  NULL,                         /* Plugin Deinit */
+  0x0100 /* 1.0 */,
+  NULL,                         /* status variables */
+  NULL,                         /* system variables */
+  NULL,                         /* config options */
+  0,                            /* flags */
 }
 mysql_declare_plugin_end;
@@ -0,0 +1,975 @@
+/* Copyright (c) 2014, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file
+
+  Pool-of-threads connection scheduler.
+
+  The plugin installs itself as the server's thread scheduler through
+  my_thread_scheduler_set(), after which @@thread_handling reports
+  "loaded-dynamically". It must be loaded at startup with --plugin-load.
+
+  Connections are spread round robin over thread_pool_size thread groups.
+  Each group waits for client data on its own epoll set and runs ready
+  connections with a small set of worker threads:
+
+  - One worker at a time is the listener. It waits in epoll_wait() and
+    moves the connections that became readable into the group's queues.
+  - The other workers take connections from the queues and execute
+    commands until the client has no more data, then give the socket
+    back to epoll. A connection is never bound to a thread while it is
+    idle.
+  - A group normally runs at most 1 + thread_pool_oversubscribe
+    connections at once. Workers which block (row locks, disk, sleeps)
+    report it through thd_wait_begin()/thd_wait_end() and stop counting
+    as active, so that another worker can be woken or created.
+  - A connection with an open transaction is queued at high priority,
+    so that transactions holding locks finish before new work is let in.
+  - A timer thread checks every thread_pool_stall_limit milliseconds
+    that each group makes progress. A group with queued connections
+    and no event taken since the last check is stalled: it is allowed
+    one more running connection, and a worker is woken or created.
+    The timer also closes connections idle for longer than wait_timeout.
+*/
+
+#include <my_global.h>
+#include <my_pthread.h>
+#include <mysql/plugin.h>
+#include <mysql/psi/mysql_thread.h>
+#include <mysql/thread_pool_priv.h>
+#include <my_atomic.h>
+#include <sql_plist.h>
+#include <sys/epoll.h>
+
+/** Upper limit of thread_pool_size. */
+#define MAX_THREAD_GROUPS 128
+/** Number of events read by a listener in one epoll_wait() call. */
+#define MAX_EVENTS 16
+
+static uint thread_pool_size;
+static uint thread_pool_oversubscribe;
+static uint thread_pool_stall_limit;
+static uint thread_pool_max_threads;
+static uint thread_pool_idle_timeout;
+
+struct Thread_group;
+
+/** The scheduler state of a connection, owned by its THD. */
+struct Pool_connection
+{
+  THD *thd;
+  Thread_group *group;
+  my_socket fd;
+  /** Authentication has been done. */
+  bool logged_in;
+  /** The socket has been added to the epoll set of the group. */
+  bool in_epoll;
+  /** The connection waits for client data in epoll. */
+  bool idle;
+  /** The worker running the connection is inside thd_wait_begin(). */
+  bool waiting;
+  /** Time, in microseconds, at which an idle connection is closed. */
+  ulonglong abs_wait_timeout;
+  /** Links of the high or low priority queue of the group. */
+  Pool_connection *next_in_queue, **prev_in_queue;
+  /** Links of the list of all connections of the group. */
+  Pool_connection *next_in_group, **prev_in_group;
+};
+
+typedef I_P_List<Pool_connection,
+                 I_P_List_adapter<Pool_connection,
+                                  &Pool_connection::next_in_queue,
+                                  &Pool_connection::prev_in_queue>,
+                 I_P_List_counter,
+                 I_P_List_fast_push_back<Pool_connection> >
+        Connection_queue;
+
+typedef I_P_List<Pool_connection,
+                 I_P_List_adapter<Pool_connection,
+                                  &Pool_connection::next_in_group,
+                                  &Pool_connection::prev_in_group>,
+                 I_P_List_counter>
+        Connection_list;
+
+/** A worker thread, lives on the stack of the thread. */
+struct Worker
+{
+  mysql_cond_t cond;
+  /** Set, under the group mutex, when the worker is taken off the list. */
+  bool woken;
+  Worker *next, **prev;
+};
+
+typedef I_P_List<Worker,
+                 I_P_List_adapter<Worker, &Worker::next, &Worker::prev>,
+                 I_P_List_counter>
+        Worker_list;
+
+struct Thread_group
+{
+  mysql_mutex_t mutex;
+  int epoll_fd;
+  /** Written to at shutdown to wake up the listener. */
+  int shutdown_pipe[2];
+  Connection_queue high_queue;
+  Connection_queue low_queue;
+  /** Idle workers, most recently used first. */
+  Worker_list waiting_workers;
+  Connection_list connections;
+  Worker *listener;
+  /** Workers alive, including the listener and the idle ones. */
+  uint thread_count;
+  /** Workers running a connection and not inside thd_wait_begin(). */
+  uint active_thread_count;
+  /** Connections taken from the queues, used for stall detection. */
+  ulonglong dequeue_count;
+  ulonglong last_dequeue_count;
+  /** Let one connection run above the oversubscribe limit. */
+  bool stalled;
+  bool shutdown;
+};
+
+static Thread_group *thread_groups;
+static uint group_count;
+static volatile int32 next_group= 0;
+static volatile int32 total_thread_count= 0;
+static ulonglong stall_count= 0;
+
+static mysql_mutex_t LOCK_timer;
+static mysql_cond_t COND_timer;
+static pthread_t timer_thread;
+static bool timer_shutdown;
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_key key_group_mutex, key_LOCK_timer;
+
+static PSI_mutex_info all_thread_pool_mutexes[]=
+{
+  { &key_group_mutex, "Thread_group::mutex", 0},
+  { &key_LOCK_timer, "LOCK_timer", PSI_FLAG_GLOBAL}
+};
+
+static PSI_cond_key key_worker_cond, key_COND_timer;
+
+static PSI_cond_info all_thread_pool_conds[]=
+{
+  { &key_worker_cond, "Worker::cond", 0},
+  { &key_COND_timer, "COND_timer", PSI_FLAG_GLOBAL}
+};
+
+static PSI_thread_key key_thread_worker, key_thread_timer;
+
+static PSI_thread_info all_thread_pool_threads[]=
+{
+  { &key_thread_worker, "worker", 0},
+  { &key_thread_timer, "timer", PSI_FLAG_GLOBAL}
+};
+
+static void init_thread_pool_psi_keys(void)
+{
+  const char *category= "thread_pool";
+
+  mysql_mutex_register(category, all_thread_pool_mutexes,
+                       array_elements(all_thread_pool_mutexes));
+  mysql_cond_register(category, all_thread_pool_conds,
+                      array_elements(all_thread_pool_conds));
+  mysql_thread_register(category, all_thread_pool_threads,
+                        array_elements(all_thread_pool_threads));
+}
+#endif /* HAVE_PSI_INTERFACE */
+
+
+static bool too_many_active(Thread_group *group)
+{
+  return group->active_thread_count >= 1 + thread_pool_oversubscribe &&
+         !group->stalled;
+}
+
+
+static void enqueue(Thread_group *group, Pool_connection *conn)
+{
+  mysql_mutex_assert_owner(&group->mutex);
+  conn->idle= false;
+  if (conn->logged_in && thd_is_transaction_active(conn->thd))
+    group->high_queue.push_back(conn);
+  else
+    group->low_queue.push_back(conn);
+}
+
+
+static Pool_connection *dequeue(Thread_group *group)
+{
+  mysql_mutex_assert_owner(&group->mutex);
+  Pool_connection *conn= group->high_queue.pop_front();
+  if (!conn)
+    conn= group->low_queue.pop_front();
+  if (conn)
+  {
+    group->dequeue_count++;
+    if (group->active_thread_count >= 1 + thread_pool_oversubscribe)
+      group->stalled= false;
+  }
+  return conn;
+}
+
+
+static bool queue_is_empty(Thread_group *group)
+{
+  return group->high_queue.is_empty() && group->low_queue.is_empty();
+}
+
+
+extern "C" void *worker_main(void *arg);
+
+/**
+  Make a worker available to the group: wake an idle one or, when no
+  connection of the group is running or the group is stalled, start a
+  new one.
+*/
+
+static void wake_or_create_worker(Thread_group *group)
+{
+  mysql_mutex_assert_owner(&group->mutex);
+  Worker *worker= group->waiting_workers.pop_front();
+  if (worker)
+  {
+    worker->woken= true;
+    mysql_cond_signal(&worker->cond);
+    return;
+  }
+
+  if (group->shutdown ||
+      (group->active_thread_count > 0 && !group->stalled))
+    return;
+  if ((uint) my_atomic_add32(&total_thread_count, 1) >=
+      thread_pool_max_threads)
+  {
+    my_atomic_add32(&total_thread_count, -1);
+    return;
+  }
+
+  pthread_t thread_id;
+  group->thread_count++;
+  if (mysql_thread_create(key_thread_worker, &thread_id,
+                          get_connection_attrib(), worker_main, group))
+  {
+    group->thread_count--;
+    my_atomic_add32(&total_thread_count, -1);
+    sql_print_error("Thread pool: can't create a worker thread "
+                    "(errno= %d)", errno);
+    return;
+  }
+  inc_thread_created();
+}
+
+
+/**
+  Wait for client data as the listener of the group, and queue the
+  connections which have some.
+  Called and returns with the group mutex locked.
+*/
+
+static void listen(Thread_group *group, Worker *worker)
+{
+  struct epoll_event events[MAX_EVENTS];
+
+  group->listener= worker;
+  mysql_mutex_unlock(&group->mutex);
+  int count= epoll_wait(group->epoll_fd, events, MAX_EVENTS, -1);
+  mysql_mutex_lock(&group->mutex);
+  group->listener= NULL;
+
+  for (int i= 0; i < count; i++)
+  {
+    /* A killed connection may have been queued by wake_killed(). */
+    Pool_connection *conn= (Pool_connection*) events[i].data.ptr;
+    if (conn && conn->idle)
+      enqueue(group, conn);
+  }
+
+  /* Another worker takes over listening, or runs the queued connections. */
+  if (!queue_is_empty(group))
+    wake_or_create_worker(group);
+}
+
+
+/**
+  Get the next connection to run.
+  Called and returns with the group mutex locked.
+
+  @retval NULL  The worker is to exit.
+*/
+
+static Pool_connection *get_event(Thread_group *group, Worker *worker)
+{
+  mysql_mutex_assert_owner(&group->mutex);
+
+  while (!group->shutdown)
+  {
+    if (!too_many_active(group))
+    {
+      Pool_connection *conn= dequeue(group);
+      if (conn)
+      {
+        group->active_thread_count++;
+        return conn;
+      }
+    }
+
+    if (!group->listener && queue_is_empty(group))
+    {
+      listen(group, worker);
+      continue;
+    }
+
+    struct timespec abstime;
+    set_timespec(abstime, thread_pool_idle_timeout);
+    worker->woken= false;
+    group->waiting_workers.push_front(worker);
+    int error= 0;
+    while (!worker->woken && !group->shutdown && !error)
+      error= mysql_cond_timedwait(&worker->cond, &group->mutex, &abstime);
+
+    if (!worker->woken)
+    {
+      group->waiting_workers.remove(worker);
+      /* Keep one worker per group, the listener is needed for epoll. */
+      if (error && group->thread_count > 1)
+        return NULL;
+    }
+  }
+  return NULL;
+}
+
+
+/**
+  Queue an idle connection which has been killed, so that a worker ends
+  it. Shutting the socket down would not do: vio_shutdown() also closes
+  it, which silently removes it from the epoll set.
+*/
+
+static void wake_killed(Thread_group *group, Pool_connection *conn)
+{
+  mysql_mutex_assert_owner(&group->mutex);
+  epoll_ctl(group->epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+  conn->in_epoll= false;
+  enqueue(group, conn);
+  if (!too_many_active(group))
+    wake_or_create_worker(group);
+}
+
+
+/**
+  Close the connection and free the THD. Called by the worker which runs
+  the connection, after the client connection has been closed.
+*/
+
+static void end_pool_connection(Pool_connection *conn)
+{
+  Thread_group *group= conn->group;
+  THD *thd= conn->thd;
+
+  mysql_mutex_lock(&group->mutex);
+  group->connections.remove(conn);
+  mysql_mutex_unlock(&group->mutex);
+
+  /* post_kill_notification() reads the scheduler data under LOCK_thd_data. */
+  thd_lock_data(thd);
+  thd_set_scheduler_data(thd, NULL);
+  thd_unlock_data(thd);
+  my_free(conn);
+
+  thd_release_resources(thd);
+  dec_connection_count();
+  remove_global_thread(thd);
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  PSI_THREAD_CALL(delete_thread)(thd_get_psi(thd));
+#endif
+  destroy_thd(thd);
+}
+
+
+/**
+  Give the socket back to epoll, to be woken up when the client sends
+  the next command.
+
+  @retval true  The connection has been killed, or the socket could not
+                be added to the epoll set.
+*/
+
+static bool start_io(Pool_connection *conn)
+{
+  Thread_group *group= conn->group;
+  struct epoll_event event;
+
+  event.events= EPOLLIN | EPOLLONESHOT;
+  event.data.ptr= conn;
+  conn->abs_wait_timeout= my_micro_time() +
+    (ulonglong) thd_get_net_wait_timeout(conn->thd) * 1000000ULL;
+
+  /*
+    A kill which comes before this point is seen here, a later one finds
+    the connection idle in tp_post_kill_notification().
+  */
+  mysql_mutex_lock(&group->mutex);
+  if (!thd_is_connection_alive(conn->thd))
+  {
+    mysql_mutex_unlock(&group->mutex);
+    return true;
+  }
+  conn->idle= true;
+  mysql_mutex_unlock(&group->mutex);
+
+  /* Once armed, another worker may take the connection at any time. */
+  int op= conn->in_epoll ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+  conn->in_epoll= true;
+  if (epoll_ctl(group->epoll_fd, op, conn->fd, &event))
+  {
+    mysql_mutex_lock(&group->mutex);
+    conn->idle= false;
+    mysql_mutex_unlock(&group->mutex);
+    return true;
+  }
+  return false;
+}
+
+
+/**
+  Run a connection: log in or execute the commands sent by the client.
+
+  @param conn         Connection to run.
+  @param stack_start  Start of the stack of the worker thread.
+*/
+
+static void handle_event(Pool_connection *conn, char *stack_start)
+{
+  THD *thd= conn->thd;
+  bool has_data= true;
+  bool quit= false;
+
+  thd_set_thread_stack(thd, stack_start);
+  if (thd_store_globals(thd))
+  {
+    close_connection(thd, ER_OUT_OF_RESOURCES);
+    end_pool_connection(conn);
+    return;
+  }
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  PSI_thread *worker_psi= PSI_THREAD_CALL(get_thread)();
+  PSI_THREAD_CALL(set_thread)(thd_get_psi(thd));
+#endif
+
+  if (!conn->logged_in)
+  {
+    if (thd_prepare_connection(thd))
+    {
+      close_connection(thd, 0);
+      end_pool_connection(conn);
+      goto end;
+    }
+    conn->logged_in= true;
+    has_data= thd_connection_has_data(thd);
+  }
+
+  while (has_data && thd_is_connection_alive(thd))
+  {
+    mysql_audit_release(thd);
+    if (do_command(thd))
+    {
+      quit= true;
+      break;
+    }
+    has_data= thd_connection_has_data(thd);
+  }
+
+  if (quit || !thd_is_connection_alive(thd))
+  {
+    end_connection(thd);
+    close_connection(thd, 0);
+    end_pool_connection(conn);
+    goto end;
+  }
+
+  /* Detach the THD from this thread before another worker can take it. */
+  thd_set_mysys_var(thd, NULL);
+  if (start_io(conn))
+  {
+    thd_store_globals(thd);
+    end_connection(thd);
+    close_connection(thd, 0);
+    end_pool_connection(conn);
+  }
+
+end:
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  PSI_THREAD_CALL(set_thread)(worker_psi);
+#endif
+  return;
+}
+
+
+extern "C" void *worker_main(void *arg)
+{
+  Thread_group *group= (Thread_group*) arg;
+  char *stack_start= (char*) &group;
+  Worker worker;
+
+  my_thread_init();
+  mysql_cond_init(key_worker_cond, &worker.cond, NULL);
+
+  mysql_mutex_lock(&group->mutex);
+  for (;;)
+  {
+    Pool_connection *conn= get_event(group, &worker);
+    if (!conn)
+      break;
+    mysql_mutex_unlock(&group->mutex);
+    handle_event(conn, stack_start);
+    mysql_mutex_lock(&group->mutex);
+    group->active_thread_count--;
+  }
+  group->thread_count--;
+  mysql_mutex_unlock(&group->mutex);
+  my_atomic_add32(&total_thread_count, -1);
+
+  mysql_cond_destroy(&worker.cond);
+  my_thread_end();
+  pthread_exit(0);
+  return NULL;
+}
+
+
+/**
+  Check the groups for stalls and for connections idle for longer than
+  wait_timeout.
+*/
+
+static void check_groups()
+{
+  ulonglong now= my_micro_time();
+
+  for (uint i= 0; i < group_count; i++)
+  {
+    Thread_group *group= &thread_groups[i];
+    mysql_mutex_lock(&group->mutex);
+
+    /*
+      No connection was taken since the last check, although there are
+      connections waiting, or nobody listens to epoll: the running
+      connections are long queries or wait without reporting it.
+    */
+    if (group->dequeue_count == group->last_dequeue_count &&
+        (!queue_is_empty(group) ||
+         (!group->listener && !group->connections.is_empty())))
+    {
+      if (!group->stalled)
+        stall_count++;
+      group->stalled= true;
+      wake_or_create_worker(group);
+    }
+    group->last_dequeue_count= group->dequeue_count;
+
+    Connection_list::Iterator it(group->connections);
+    Pool_connection *conn;
+    while ((conn= it++))
+    {
+      if (conn->idle && conn->abs_wait_timeout < now)
+      {
+        thd_set_killed(conn->thd);
+        wake_killed(group, conn);
+      }
+    }
+    mysql_mutex_unlock(&group->mutex);
+  }
+}
+
+
+extern "C" void *timer_main(void *arg)
+{
+  my_thread_init();
+
+  mysql_mutex_lock(&LOCK_timer);
+  while (!timer_shutdown)
+  {
+    struct timespec abstime;
+    set_timespec_nsec(abstime, thread_pool_stall_limit * 1000000ULL);
+    mysql_cond_timedwait(&COND_timer, &LOCK_timer, &abstime);
+    if (timer_shutdown)
+      break;
+    mysql_mutex_unlock(&LOCK_timer);
+    check_groups();
+    mysql_mutex_lock(&LOCK_timer);
+  }
+  mysql_mutex_unlock(&LOCK_timer);
+
+  my_thread_end();
+  pthread_exit(0);
+  return NULL;
+}
+
+
+/**
+  Called by the acceptor thread, with LOCK_thread_count locked, for a new
+  client connection. The login is done by a worker of the group.
+*/
+
+static void tp_add_connection(THD *thd)
+{
+  thd_new_connection_setup(thd, (char*) &thd);
+
+  Pool_connection *conn=
+    (Pool_connection*) my_malloc(sizeof(Pool_connection), MYF(MY_ZEROFILL));
+  if (!conn)
+  {
+    close_connection(thd, ER_OUT_OF_RESOURCES);
+    thd_release_resources(thd);
+    dec_connection_count();
+    remove_global_thread(thd);
+    destroy_thd(thd);
+    return;
+  }
+
+  uint group_no= (uint) my_atomic_add32(&next_group, 1) % group_count;
+  Thread_group *group= &thread_groups[group_no];
+  conn->thd= thd;
+  conn->group= group;
+  conn->fd= thd_get_fd(thd);
+  thd_set_scheduler_data(thd, conn);
+
+  mysql_mutex_lock(&group->mutex);
+  group->connections.push_front(conn);
+  enqueue(group, conn);
+  if (!too_many_active(group))
+    wake_or_create_worker(group);
+  mysql_mutex_unlock(&group->mutex);
+}
+
+
+static void tp_wait_begin(THD *thd, int wait_type)
+{
+  if (!thd && !(thd= thd_get_current_thd()))
+    return;
+  Pool_connection *conn= (Pool_connection*) thd_get_scheduler_data(thd);
+  if (!conn || conn->waiting)
+    return;
+
+  Thread_group *group= conn->group;
+  mysql_mutex_lock(&group->mutex);
+  conn->waiting= true;
+  group->active_thread_count--;
+  if (!queue_is_empty(group) && !too_many_active(group))
+    wake_or_create_worker(group);
+  mysql_mutex_unlock(&group->mutex);
+}
+
+
+static void tp_wait_end(THD *thd)
+{
+  if (!thd && !(thd= thd_get_current_thd()))
+    return;
+  Pool_connection *conn= (Pool_connection*) thd_get_scheduler_data(thd);
+  if (!conn || !conn->waiting)
+    return;
+
+  Thread_group *group= conn->group;
+  mysql_mutex_lock(&group->mutex);
+  conn->waiting= false;
+  group->active_thread_count++;
+  mysql_mutex_unlock(&group->mutex);
+}
+
+
+/**
+  Called with LOCK_thd_data locked when the connection is killed. An idle
+  connection is not run by any thread, queue it so that a worker ends it.
+*/
+
+static void tp_post_kill_notification(THD *thd)
+{
+  Pool_connection *conn= (Pool_connection*) thd_get_scheduler_data(thd);
+  if (!conn)
+    return;
+
+  Thread_group *group= conn->group;
+  mysql_mutex_lock(&group->mutex);
+  if (conn->idle)
+    wake_killed(group, conn);
+  mysql_mutex_unlock(&group->mutex);
+}
+
+
+/**
+  Only called if a connection is ended before it reaches the pool, e.g.
+  from setup_connection_thread_globals().
+*/
+
+static bool tp_end_thread(THD *thd, bool put_in_cache)
+{
+  Pool_connection *conn= (Pool_connection*) thd_get_scheduler_data(thd);
+  if (conn)
+  {
+    end_pool_connection(conn);
+    return true;
+  }
+  thd_release_resources(thd);
+  dec_connection_count();
+  remove_global_thread(thd);
+  destroy_thd(thd);
+  return true;
+}
+
+
+static scheduler_functions tp_scheduler_functions=
+{
+  0,                                     // max_threads
+  NULL,                                  // init
+  NULL,                                  // init_new_connection_thread
+  tp_add_connection,                     // add_connection
+  tp_wait_begin,                         // thd_wait_begin
+  tp_wait_end,                           // thd_wait_end
+  tp_post_kill_notification,             // post_kill_notification
+  tp_end_thread,                         // end_thread
+  NULL,                                  // end
+};
+
+
+static bool init_group(Thread_group *group)
+{
+  group->epoll_fd= epoll_create(MAX_EVENTS);
+  if (group->epoll_fd < 0)
+    return true;
+  if (pipe(group->shutdown_pipe))
+    return true;
+
+  struct epoll_event event;
+  event.events= EPOLLIN;
+  event.data.ptr= NULL;
+  return epoll_ctl(group->epoll_fd, EPOLL_CTL_ADD, group->shutdown_pipe[0],
+                   &event) != 0;
+}
+
+
+static void stop_groups()
+{
+  for (uint i= 0; i < group_count; i++)
+  {
+    Thread_group *group= &thread_groups[i];
+    mysql_mutex_lock(&group->mutex);
+    group->shutdown= true;
+    Worker_list::Iterator it(group->waiting_workers);
+    Worker *worker;
+    while ((worker= it++))
+      mysql_cond_signal(&worker->cond);
+    mysql_mutex_unlock(&group->mutex);
+    if (group->shutdown_pipe[1] >= 0 &&
+        write(group->shutdown_pipe[1], "", 1) < 0)
+      sql_print_error("Thread pool: can't wake up the listener "
+                      "(errno= %d)", errno);
+  }
+
+  /* Workers running a connection exit once it is done. */
+  while (my_atomic_load32(&total_thread_count) > 0)
+    my_sleep(10000);
+
+  for (uint i= 0; i < group_count; i++)
+  {
+    Thread_group *group= &thread_groups[i];
+    if (group->epoll_fd >= 0)
+      close(group->epoll_fd);
+    if (group->shutdown_pipe[0] >= 0)
+      close(group->shutdown_pipe[0]);
+    if (group->shutdown_pipe[1] >= 0)
+      close(group->shutdown_pipe[1]);
+    mysql_mutex_destroy(&group->mutex);
+  }
+  delete [] thread_groups;
+  thread_groups= NULL;
+  group_count= 0;
+}
+
+
+static int thread_pool_plugin_init(void *p)
+{
+#ifdef HAVE_PSI_INTERFACE
+  init_thread_pool_psi_keys();
+#endif
+
+  if (!thread_pool_size)
+    thread_pool_size= MY_MIN((uint) sysconf(_SC_NPROCESSORS_ONLN),
+                           MAX_THREAD_GROUPS);
+
+  thread_groups= new Thread_group[thread_pool_size];
+  group_count= thread_pool_size;
+  for (uint i= 0; i < group_count; i++)
+  {
+    Thread_group *group= &thread_groups[i];
+    group->epoll_fd= group->shutdown_pipe[0]= group->shutdown_pipe[1]= -1;
+    group->listener= NULL;
+    group->thread_count= group->active_thread_count= 0;
+    group->dequeue_count= group->last_dequeue_count= 0;
+    group->stalled= group->shutdown= false;
+    mysql_mutex_init(key_group_mutex, &group->mutex, MY_MUTEX_INIT_FAST);
+  }
+  for (uint i= 0; i < group_count; i++)
+  {
+    if (init_group(&thread_groups[i]))
+    {
+      sql_print_error("Thread pool: can't create the epoll set "
+                      "(errno= %d)", errno);
+      stop_groups();
+      return 1;
+    }
+  }
+
+  mysql_mutex_init(key_LOCK_timer, &LOCK_timer, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_timer, &COND_timer, NULL);
+  timer_shutdown= false;
+  if (mysql_thread_create(key_thread_timer, &timer_thread,
+                          NULL, timer_main, NULL))
+  {
+    sql_print_error("Thread pool: can't create the timer thread "
+                    "(errno= %d)", errno);
+    mysql_cond_destroy(&COND_timer);
+    mysql_mutex_destroy(&LOCK_timer);
+    stop_groups();
+    return 1;
+  }
+
+  tp_scheduler_functions.max_threads= thread_pool_max_threads;
+  my_thread_scheduler_set(&tp_scheduler_functions);
+  return 0;
+}
+
+
+static int thread_pool_plugin_deinit(void *p)
+{
+  my_thread_scheduler_reset();
+
+  mysql_mutex_lock(&LOCK_timer);
+  timer_shutdown= true;
+  mysql_cond_signal(&COND_timer);
+  mysql_mutex_unlock(&LOCK_timer);
+  pthread_join(timer_thread, NULL);
+  mysql_cond_destroy(&COND_timer);
+  mysql_mutex_destroy(&LOCK_timer);
+
+  stop_groups();
+  return 0;
+}
+
+
+static MYSQL_SYSVAR_UINT(size, thread_pool_size,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of thread groups. Connections are spread over the groups, "
+  "and each group runs about one query at a time. 0 means the number "
+  "of CPUs.",
+  NULL, NULL, 0, 0, MAX_THREAD_GROUPS, 0);
+
+static MYSQL_SYSVAR_UINT(oversubscribe, thread_pool_oversubscribe,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of queries, above one, a thread group may run at the same "
+  "time when none of them is stalled or waiting.",
+  NULL, NULL, 3, 0, 1000, 0);
+
+static MYSQL_SYSVAR_UINT(stall_limit, thread_pool_stall_limit,
+  PLUGIN_VAR_RQCMDARG,
+  "Time, in milliseconds, after which a thread group which makes no "
+  "progress is considered stalled and may run one more query.",
+  NULL, NULL, 500, 10, 60000, 0);
+
+static MYSQL_SYSVAR_UINT(max_threads, thread_pool_max_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of worker threads of all thread groups.",
+  NULL, NULL, 1000, 1, 100000, 0);
+
+static MYSQL_SYSVAR_UINT(idle_timeout, thread_pool_idle_timeout,
+  PLUGIN_VAR_RQCMDARG,
+  "Time, in seconds, after which an idle worker thread exits. The last "
+  "worker of a thread group does not exit.",
+  NULL, NULL, 60, 1, 86400, 0);
+
+static struct st_mysql_sys_var* thread_pool_system_vars[]=
+{
+  MYSQL_SYSVAR(size),
+  MYSQL_SYSVAR(oversubscribe),
+  MYSQL_SYSVAR(stall_limit),
+  MYSQL_SYSVAR(max_threads),
+  MYSQL_SYSVAR(idle_timeout),
+  NULL
+};
+
+
+static int show_threads(MYSQL_THD thd, SHOW_VAR *var, char *buff)
+{
+  var->type= SHOW_INT;
+  var->value= buff;
+  *(int*) buff= my_atomic_load32(&total_thread_count);
+  return 0;
+}
+
+static int show_idle_threads(MYSQL_THD thd, SHOW_VAR *var, char *buff)
+{
+  uint count= 0;
+  for (uint i= 0; i < group_count; i++)
+    count+= thread_groups[i].waiting_workers.elements();
+  var->type= SHOW_INT;
+  var->value= buff;
+  *(uint*) buff= count;
+  return 0;
+}
+
+static int show_queued(MYSQL_THD thd, SHOW_VAR *var, char *buff)
+{
+  uint count= 0;
+  for (uint i= 0; i < group_count; i++)
+    count+= thread_groups[i].high_queue.elements() +
+            thread_groups[i].low_queue.elements();
+  var->type= SHOW_INT;
+  var->value= buff;
+  *(uint*) buff= count;
+  return 0;
+}
+
+static SHOW_VAR thread_pool_status_vars[]=
+{
+  {"Thread_pool_idle_threads", (char*) &show_idle_threads, SHOW_FUNC},
+  {"Thread_pool_queued_connections", (char*) &show_queued, SHOW_FUNC},
+  {"Thread_pool_stalls", (char*) &stall_count, SHOW_LONGLONG},
+  {"Thread_pool_threads", (char*) &show_threads, SHOW_FUNC},
+  {NULL, NULL, SHOW_LONG}
+};
+
+
+struct st_mysql_daemon thread_pool_plugin=
+{ MYSQL_DAEMON_INTERFACE_VERSION };
+
+mysql_declare_plugin(thread_pool)
+{
+  MYSQL_DAEMON_PLUGIN,
+  &thread_pool_plugin,
+  "thread_pool",
+  "Oracle Corporation",
+  "Pool-of-threads connection scheduler",
+  PLUGIN_LICENSE_GPL,
+  thread_pool_plugin_init,    /* Plugin Init */
+  thread_pool_plugin_deinit,  /* Plugin Deinit */
+  0x0100,                     /* 1.0 */
+  thread_pool_status_vars,    /* status variables */
+  thread_pool_system_vars,    /* system variables */
+  NULL,                       /* config options */
+  PLUGIN_OPT_NO_INSTALL | PLUGIN_OPT_NO_UNINSTALL
+}
+mysql_declare_plugin_end;
@@ -29,9 +29,13 @@
 #include "sql_show.h"
 #include "sql_parse.h"
 #include "rpl_mi.h"
+#include "rpl_master.h"
 #include <list>
 #include <string>
+#include <vector>
 #include <my_stacktrace.h>
+#include <my_murmur3.h>
+#include <zlib.h>
 
 using std::max;
 using std::min;
@@ -65,6 +69,23 @@ static int limit_unsafe_warning_count= 0;
 
 static handlerton *binlog_hton;
 bool opt_binlog_order_commits= true;
+ulong opt_binlog_group_commit_sync_delay= 0;
+ulong opt_binlog_group_commit_sync_no_delay_count= 0;
+my_bool opt_binlog_gtid_commit_group= FALSE;
+ulong opt_binlog_transaction_dependency_tracking=
+  DEPENDENCY_TRACKING_COMMIT_ORDER;
+ulong opt_binlog_transaction_dependency_history_size= 25000;
+ulonglong binlog_writeset_conflicts= 0;
+ulonglong binlog_writeset_unsafe_trx= 0;
+ulonglong binlog_payload_compressed_bytes= 0;
+ulonglong binlog_payload_uncompressed_bytes= 0;
+
+ulonglong binlog_stage_groups[Stage_manager::STAGE_COUNTER];
+ulonglong binlog_stage_trx[Stage_manager::STAGE_COUNTER];
+ulonglong binlog_stage_leader_wait_time[Stage_manager::STAGE_COUNTER];
+ulonglong binlog_group_commit_fsyncs= 0;
+ulonglong binlog_group_commit_fsync_time= 0;
+ulonglong binlog_group_commit_delay_time= 0;
 bool opt_gtid_precommit= false;
 
 const char *log_bin_index= 0;
@@ -317,6 +338,7 @@ public:
   }
 
   int finalize(THD *thd, Log_event *end_event);
+  int compress_events(THD *thd);
   int flush(THD *thd, my_off_t *bytes, bool *wrote_xid);
   int write_event(THD *thd, Log_event *event);
 
@@ -372,6 +394,11 @@ public:
     return flags.with_xid;
   }
 
+  bool has_commit_group() const
+  {
+    return flags.with_commit_group;
+  }
+
   bool is_trx_cache() const
   {
     return flags.transactional;
@@ -410,6 +437,7 @@ public:
     flags.with_xid= false;
     flags.immediate= false;
     flags.finalized= false;
+    flags.with_commit_group= false;
     /*
       The truncate function calls reinit_io_cache that calls my_b_flush_io_cache
       which may increase disk_writes. This breaks the disk_writes use by the
@@ -526,6 +554,12 @@ protected:
       This indicates that the cache contain an XID event.
      */
     bool with_xid:1;
+
+    /*
+      This indicates that the Gtid_log_event at the start of the cache
+      reserves room for the binlog commit group.
+     */
+    bool with_commit_group:1;
   } flags;
 
 private:
@@ -717,7 +751,8 @@ public:
                ptr_binlog_stmt_cache_disk_use_arg),
     trx_cache(TRUE, max_binlog_cache_size_arg,
               ptr_binlog_cache_use_arg,
-              ptr_binlog_cache_disk_use_arg)
+              ptr_binlog_cache_disk_use_arg),
+    writeset_unsafe(false)
   {  }
 
   binlog_cache_data* get_binlog_cache_data(bool is_transactional)
@@ -770,9 +805,30 @@ public:
     return 0;
   }
 
+  /**
+    Forget the write set of the transaction, once it has been flushed
+    or rolled back.
+  */
+  void reset_writeset()
+  {
+    writeset.clear();
+    writeset_unsafe= false;
+  }
+
   binlog_stmt_cache_data stmt_cache;
   binlog_trx_cache_data trx_cache;
 
+  /**
+    Hashes of the unique key values changed by the transaction, see
+    add_row_to_writeset().
+  */
+  std::vector<uint32> writeset;
+  /**
+    The write set cannot tell what the transaction conflicts with, so it
+    must not be applied in parallel with any other transaction.
+  */
+  bool writeset_unsafe;
+
 private:
 
   binlog_cache_mngr& operator=(const binlog_cache_mngr& info);
@@ -917,6 +973,37 @@ static int binlog_close_connection(handlerton *hton, THD *thd)
   DBUG_RETURN(0);
 }
 
+/**
+  Check if the changes of an event are described by the write set of the
+  transaction. Rows events are, and so are the events which only frame
+  the transaction; anything else, e.g. a statement, is not.
+*/
+static bool writeset_safe_event(Log_event *ev)
+{
+  switch (ev->get_type_code())
+  {
+  case TABLE_MAP_EVENT:
+  case ROWS_QUERY_LOG_EVENT:
+  case XID_EVENT:
+  case PRE_GA_WRITE_ROWS_EVENT:
+  case PRE_GA_UPDATE_ROWS_EVENT:
+  case PRE_GA_DELETE_ROWS_EVENT:
+  case WRITE_ROWS_EVENT_V1:
+  case UPDATE_ROWS_EVENT_V1:
+  case DELETE_ROWS_EVENT_V1:
+  case WRITE_ROWS_EVENT:
+  case UPDATE_ROWS_EVENT:
+  case DELETE_ROWS_EVENT:
+    return true;
+#ifdef HAVE_REPLICATION
+  case QUERY_EVENT:
+    return ev->starts_group() || ev->ends_group();
+#endif
+  default:
+    return false;
+  }
+}
+
 int binlog_cache_data::write_event(THD *thd, Log_event *ev)
 {
   DBUG_ENTER("binlog_cache_data::write_event");
@@ -929,9 +1016,17 @@ int binlog_cache_data::write_event(THD *thd, Log_event *ev)
       DBUG_RETURN(1);
     else if (status == Group_cache::APPEND_NEW_GROUP)
     {
-      Gtid_log_event gtid_ev(thd, is_trx_cache());
+      /*
+        The commit group is only known at flush time, when this event is
+        rewritten, so only reserve room for it here.
+      */
+      bool with_commit_group= opt_binlog_gtid_commit_group &&
+        get_byte_position() == 0;
+      Gtid_log_event gtid_ev(thd, is_trx_cache(), NULL, with_commit_group);
       if (gtid_ev.write(&cache_log) != 0)
         DBUG_RETURN(1);
+      if (with_commit_group)
+        flags.with_commit_group= true;
     }
   }
 
@@ -960,6 +1055,8 @@ int binlog_cache_data::write_event(THD *thd, Log_event *ev)
       flags.with_xid= true;
     if (ev->is_using_immediate_logging())
       flags.immediate= true;
+    if (!writeset_safe_event(ev))
+      thd_get_cache_mngr(thd)->writeset_unsafe= true;
   }
   DBUG_RETURN(0);
 }
@@ -1079,15 +1176,19 @@ gtid_before_write_cache(THD* thd, binlog_cache_data* cache_data)
 
   /*
     If an automatic group number was generated, change the first event
-    into a "real" one.
+    into a "real" one. If the event has room for the commit group, it is
+    filled in here as well: the group was assigned in the flush stage.
   */
-  if (thd->variables.gtid_next.type == AUTOMATIC_GROUP)
+  if (thd->variables.gtid_next.type == AUTOMATIC_GROUP ||
+      cache_data->has_commit_group())
   {
-    DBUG_ASSERT(group_cache->get_n_groups() == 1);
+    DBUG_ASSERT(thd->variables.gtid_next.type != AUTOMATIC_GROUP ||
+                group_cache->get_n_groups() == 1);
     Cached_group *cached_group= group_cache->get_unsafe_pointer(0);
     DBUG_ASSERT(cached_group->spec.type != AUTOMATIC_GROUP);
     Gtid_log_event gtid_ev(thd, cache_data->is_trx_cache(),
-                           &cached_group->spec);
+                           &cached_group->spec,
+                           cache_data->has_commit_group());
     bool using_file= cache_data->cache_log.pos_in_file > 0;
     my_off_t saved_position= cache_data->reset_write_pos(0, using_file);
     error= gtid_ev.write(&cache_data->cache_log);
@@ -1165,12 +1266,98 @@ binlog_cache_data::finalize(THD *thd, Log_event *end_event)
       DBUG_RETURN(error);
     if (int error= write_event(thd, end_event))
       DBUG_RETURN(error);
+    if (flags.transactional && !flags.incident &&
+        thd->variables.binlog_transaction_compression)
+    {
+      if (int error= compress_events(thd))
+        DBUG_RETURN(error);
+    }
     flags.finalized= true;
     DBUG_PRINT("debug", ("flags.finalized: %s", YESNO(flags.finalized)));
   }
   DBUG_RETURN(0);
 }
 
+/**
+  Replaces the events of the cache with a Transaction_payload_log_event
+  carrying them compressed. A Gtid event at the start of the cache is
+  kept in front of the payload, since it is rewritten when the cache is
+  flushed.
+
+  This is done by the session, before the transaction enters the flush
+  stage, so that the compression does not add to the time LOCK_log is
+  held. The cache is left as it is when it is larger than a slave can
+  read back as a single event, or when compression does not make it
+  smaller.
+
+  @param thd The thread whose transaction is being committed
+
+  @return
+    nonzero if an error pops up when reading or writing the cache.
+*/
+int
+binlog_cache_data::compress_events(THD *thd)
+{
+  DBUG_ENTER("binlog_cache_data::compress_events");
+  my_off_t const total= my_b_tell(&cache_log);
+  if (total > slave_max_allowed_packet || group_cache.get_n_groups() > 1)
+    DBUG_RETURN(0);
+
+  int error= 0;
+  my_off_t start= 0;
+  uchar *payload= NULL;
+  uLongf payload_len= 0;
+  uchar *buf= (uchar *) my_malloc(total, MYF(MY_WME));
+  if (buf == NULL)
+    DBUG_RETURN(1);
+
+  if (reinit_io_cache(&cache_log, READ_CACHE, 0, 0, 0) ||
+      my_b_read(&cache_log, buf, total))
+  {
+    error= 1;
+    goto end;
+  }
+
+  if (buf[EVENT_TYPE_OFFSET] == GTID_LOG_EVENT ||
+      buf[EVENT_TYPE_OFFSET] == ANONYMOUS_GTID_LOG_EVENT)
+    start= uint4korr(buf + EVENT_LEN_OFFSET);
+
+  payload_len= compressBound(total - start);
+  if (!(payload= (uchar *) my_malloc(payload_len, MYF(MY_WME))) ||
+      compress(payload, &payload_len, buf + start, total - start) != Z_OK)
+  {
+    error= 1;
+    goto end;
+  }
+  DBUG_PRINT("info", ("compressed %llu bytes to %lu", total - start,
+                      (ulong) payload_len));
+
+  if (LOG_EVENT_HEADER_LEN + Transaction_payload_log_event::BODY_HEADER_LEN +
+      payload_len >= total - start)
+  {
+    /* Not worth it, go on with the events as they are. */
+    truncate(total);
+    goto end;
+  }
+
+  truncate(start);
+  {
+    Transaction_payload_log_event ev(thd, payload, payload_len,
+                                     (ulong) (total - start));
+    if ((error= ev.write(&cache_log)))
+      goto end;
+  }
+  statistic_add(binlog_payload_uncompressed_bytes, total - start,
+                &LOCK_status);
+  statistic_add(binlog_payload_compressed_bytes,
+                my_b_tell(&cache_log) - start, &LOCK_status);
+
+end:
+  my_free(payload);
+  my_free(buf);
+  DBUG_RETURN(error);
+}
+
 /**
   Flush caches to the binary log.
 
@@ -1384,6 +1571,7 @@ Stage_manager::Mutex_queue::append(THD *first)
 
   bool empty= (m_first == NULL);
   *m_last= first;
+  ++m_size;
   DBUG_PRINT("info", ("m_first: 0x%llx, &m_first: 0x%llx, m_last: 0x%llx",
                        (ulonglong) m_first, (ulonglong) &m_first,
                        (ulonglong) m_last));
@@ -1393,7 +1581,10 @@ Stage_manager::Mutex_queue::append(THD *first)
     the queue as well.
   */
   while (first->next_to_commit)
+  {
     first= first->next_to_commit;
+    ++m_size;
+  }
   m_last= &first->next_to_commit;
   DBUG_PRINT("info", ("m_first: 0x%llx, &m_first: 0x%llx, m_last: 0x%llx",
                         (ulonglong) m_first, (ulonglong) &m_first,
@@ -1445,7 +1636,7 @@ Stage_manager::enroll_for(StageID stage, THD *thd, mysql_mutex_t *stage_mutex)
 }
 
 
-THD *Stage_manager::Mutex_queue::fetch_and_empty()
+THD *Stage_manager::Mutex_queue::fetch_and_empty(ulong *size)
 {
   DBUG_ENTER("Stage_manager::Mutex_queue::fetch_and_empty");
   lock();
@@ -1453,8 +1644,11 @@ THD *Stage_manager::Mutex_queue::fetch_and_empty()
                        (ulonglong) m_first, (ulonglong) &m_first,
                        (ulonglong) m_last));
   THD *result= m_first;
+  if (size)
+    *size= m_size;
   m_first= NULL;
   m_last= &m_first;
+  m_size= 0;
   DBUG_PRINT("info", ("m_first: 0x%llx, &m_first: 0x%llx, m_last: 0x%llx",
                        (ulonglong) m_first, (ulonglong) &m_first,
                        (ulonglong) m_last));
@@ -1473,6 +1667,23 @@ THD *Stage_manager::Mutex_queue::fetch_and_empty()
   DBUG_RETURN(result);
 }
 
+ulonglong
+Stage_manager::wait_count_or_timeout(ulong count, ulong usec, StageID stage)
+{
+  ulonglong start= my_micro_time();
+  ulonglong now= start;
+  /* Check the queue ten times during the wait. */
+  ulong step= max(usec / 10, 1UL);
+
+  while (now - start < usec &&
+         (count == 0 || m_queue[stage].get_size() < count))
+  {
+    my_sleep(step);
+    now= my_micro_time();
+  }
+  return now - start;
+}
+
 #ifndef DBUG_OFF
 void Stage_manager::clear_preempt_status(THD *head)
 {
@@ -1663,6 +1874,9 @@ int MYSQL_BIN_LOG::rollback(THD *thd, bool all)
   }
 
 end:
+  if (cache_mngr != NULL && ending_trans(thd, all))
+    cache_mngr->reset_writeset();
+
   /*
     When a statement errors out on auto-commit mode it is rollback
     implicitly, so the same should happen to its GTID.
@@ -2434,7 +2648,8 @@ bool mysql_show_binlog_events(THD* thd)
 
 MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
   :bytes_written(0), file_id(1), open_count(1),
-   sync_period_ptr(sync_period), sync_counter(0),
+   sync_period_ptr(sync_period), sync_counter(0), commit_group_counter(0),
+   writeset_group_closed(true),
    m_prep_xids(0),
    is_relay_log(0), signal_cnt(0),
    checksum_alg_reset(BINLOG_CHECKSUM_ALG_UNDEF),
@@ -3807,6 +4022,12 @@ bool MYSQL_BIN_LOG::reset_logs(THD* thd)
   name=0;					// Protect against free
   close(LOG_CLOSE_TO_BE_OPENED);
 
+#ifdef HAVE_REPLICATION
+  /* The new binary logs reuse the names of the deleted ones. */
+  if (!is_relay_log)
+    binlog_dump_cache.invalidate();
+#endif
+
   /*
     First delete all old log files and then update the index file.
     As we first delete the log files and do not use sort of logging,
@@ -6599,8 +6820,27 @@ MYSQL_BIN_LOG::process_flush_stage_queue(my_off_t *total_bytes_var,
     for guaranteeing to flush prepared records of transactions before
     flushing them to binary log, which is required by crash recovery.
   */
-  THD *first_seen= stage_manager.fetch_queue_for(Stage_manager::FLUSH_STAGE);
+  /*
+    If the binary log will be synced after this group, wait a little for
+    more sessions to join the group, so that they share the sync. This is
+    done in the flush stage because, when sync_binlog is 1, LOCK_log is
+    held through the sync stage and no session could join it.
+  */
+  unsigned int sync_period= get_sync_period();
+  if (opt_binlog_group_commit_sync_delay > 0 &&
+      sync_period && sync_counter + 1 >= sync_period)
+    binlog_group_commit_delay_time+=
+      stage_manager.wait_count_or_timeout(
+        opt_binlog_group_commit_sync_no_delay_count,
+        opt_binlog_group_commit_sync_delay,
+        Stage_manager::FLUSH_STAGE);
+
+  ulong group_size;
+  THD *first_seen= stage_manager.fetch_queue_for(Stage_manager::FLUSH_STAGE,
+                                                 &group_size);
   DBUG_ASSERT(first_seen != NULL);
+  binlog_stage_groups[Stage_manager::FLUSH_STAGE]++;
+  binlog_stage_trx[Stage_manager::FLUSH_STAGE]+= group_size;
 
   /* Do an explicit transaction log group write before flushing binary log
      cache to file. */
@@ -6617,9 +6857,27 @@ MYSQL_BIN_LOG::process_flush_stage_queue(my_off_t *total_bytes_var,
 
   DBUG_EXECUTE_IF("crash_after_flush_engine_log", DBUG_SUICIDE(););
 
+  /*
+    All transactions of the group have been prepared in the engines and
+    none has committed yet, so they do not conflict with each other: a
+    slave may apply them in parallel. With write sets, the commit group
+    may also span several flush groups, see writeset_commit_group().
+  */
+  bool use_writeset= opt_binlog_transaction_dependency_tracking ==
+                     DEPENDENCY_TRACKING_WRITESET;
+  if (!use_writeset)
+  {
+    commit_group_counter++;
+    writeset_group_closed= true;
+  }
+
   /* Flush thread caches to binary log. */
   for (THD *head= first_seen ; head ; head = head->next_to_commit)
   {
+    head->binlog_commit_group= use_writeset ?
+      writeset_commit_group(head) : commit_group_counter;
+    if (binlog_cache_mngr *cache_mngr= thd_get_cache_mngr(head))
+      cache_mngr->reset_writeset();
     std::pair<int,my_off_t> result= flush_thread_caches(head);
     total_bytes+= result.second;
     if (flush_error == 1)
@@ -6637,6 +6895,55 @@ MYSQL_BIN_LOG::process_flush_stage_queue(my_off_t *total_bytes_var,
 }
 
 
+/**
+  Find the commit group of a transaction from its write set.
+
+  Transactions whose write sets do not intersect may be applied in
+  parallel on a slave, even when they were committed in different flush
+  groups. So the write sets of the current commit group are kept in
+  writeset_history, and a transaction joins the group unless it changed
+  a row already changed in it. A transaction which is unsafe, see
+  add_row_to_writeset(), is given a commit group of its own.
+
+  @param thd  Thread of the transaction being flushed.
+
+  @return The commit group of the transaction.
+*/
+
+ulonglong MYSQL_BIN_LOG::writeset_commit_group(THD *thd)
+{
+  mysql_mutex_assert_owner(&LOCK_log);
+  binlog_cache_mngr *cache_mngr= thd_get_cache_mngr(thd);
+
+  if (cache_mngr == NULL || cache_mngr->writeset_unsafe)
+  {
+    binlog_writeset_unsafe_trx++;
+    writeset_history.clear();
+    writeset_group_closed= true;
+    return ++commit_group_counter;
+  }
+
+  const std::vector<uint32> &writeset= cache_mngr->writeset;
+  bool conflict= false;
+  for (std::vector<uint32>::const_iterator it= writeset.begin();
+       it != writeset.end() && !conflict; ++it)
+    conflict= writeset_history.count(*it) != 0;
+  if (conflict)
+    binlog_writeset_conflicts++;
+
+  if (conflict || writeset_group_closed ||
+      writeset_history.size() + writeset.size() >
+        opt_binlog_transaction_dependency_history_size)
+  {
+    commit_group_counter++;
+    writeset_history.clear();
+    writeset_group_closed= false;
+  }
+  writeset_history.insert(writeset.begin(), writeset.end());
+  return commit_group_counter;
+}
+
+
 /**
   Commit a sequence of sessions.
 
@@ -6797,7 +7104,10 @@ MYSQL_BIN_LOG::change_stage(THD *thd,
     DBUG_ASSERT(!thd_get_cache_mngr(thd)->dbug_any_finalized());
     DBUG_RETURN(true);
   }
+  ulonglong start= my_micro_time();
   mysql_mutex_lock(enter_mutex);
+  /* Protected by enter_mutex, which is the mutex of the stage. */
+  binlog_stage_leader_wait_time[stage]+= my_micro_time() - start;
   DBUG_RETURN(false);
 }
 
@@ -7106,12 +7416,22 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit)
                           thd->thread_id, thd->commit_error));
     DBUG_RETURN(finish_commit(thd));
   }
-  THD *final_queue= stage_manager.fetch_queue_for(Stage_manager::SYNC_STAGE);
+  ulong group_size;
+  THD *final_queue= stage_manager.fetch_queue_for(Stage_manager::SYNC_STAGE,
+                                                  &group_size);
+  binlog_stage_groups[Stage_manager::SYNC_STAGE]++;
+  binlog_stage_trx[Stage_manager::SYNC_STAGE]+= group_size;
   if (flush_error == 0 && total_bytes > 0)
   {
     DEBUG_SYNC(thd, "before_sync_binlog_file");
+    ulonglong start= my_micro_time();
     std::pair<bool, bool> result= sync_binlog_file(false);
     flush_error= result.first;
+    if (result.second)
+    {
+      binlog_group_commit_fsyncs++;
+      binlog_group_commit_fsync_time+= my_micro_time() - start;
+    }
   }
 
   if (need_LOCK_log)
@@ -7135,7 +7455,10 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit)
                             thd->thread_id, thd->commit_error));
       DBUG_RETURN(finish_commit(thd));
     }
-    THD *commit_queue= stage_manager.fetch_queue_for(Stage_manager::COMMIT_STAGE);
+    THD *commit_queue=
+      stage_manager.fetch_queue_for(Stage_manager::COMMIT_STAGE, &group_size);
+    binlog_stage_groups[Stage_manager::COMMIT_STAGE]++;
+    binlog_stage_trx[Stage_manager::COMMIT_STAGE]+= group_size;
     DBUG_EXECUTE_IF("semi_sync_3-way_deadlock",
                     DEBUG_SYNC(thd, "before_process_commit_stage_queue"););
     process_commit_stage_queue(thd, commit_queue);
@@ -8536,6 +8859,99 @@ CPP_UNNAMED_NS_START
 
 CPP_UNNAMED_NS_END
 
+/**
+  Add the unique key values of a row image to the write set of the
+  transaction, used by binlog_transaction_dependency_tracking=WRITESET.
+
+  Each unique key of the row is hashed with the database and table
+  names, in the form used to sort it, so that values which compare equal
+  in the collation of the key get the same hash. When the key values
+  cannot all be known, the transaction is marked unsafe instead.
+
+  @param thd      Thread whose transaction changed the row.
+  @param table    The changed table.
+  @param record   The row image, in the layout of table->record[0].
+  @param cols     Columns present in the image, or NULL for the full row.
+  @param cols2    Further columns present in the image, or NULL.
+*/
+static void add_row_to_writeset(THD *thd, TABLE *table, const uchar *record,
+                                MY_BITMAP *cols, MY_BITMAP *cols2)
+{
+  binlog_cache_mngr *const cache_mngr= thd_get_cache_mngr(thd);
+  if (cache_mngr->writeset_unsafe)
+    return;
+
+  /*
+    Rows changed through foreign keys, e.g. by a cascading delete, are
+    not logged, so a table with foreign keys is never safe.
+  */
+  if (opt_binlog_transaction_dependency_tracking !=
+        DEPENDENCY_TRACKING_WRITESET ||
+      cache_mngr->writeset.size() + table->s->keys >
+        opt_binlog_transaction_dependency_history_size ||
+      !table->file->can_switch_engines())
+  {
+    cache_mngr->writeset_unsafe= true;
+    cache_mngr->writeset.clear();
+    return;
+  }
+
+  const my_ptrdiff_t ptr_diff= record - table->record[0];
+  const char *db= table->s->db.str;
+  const char *table_name= table->s->table_name.str;
+  uint32 table_hash= murmur3_32((const uchar*) db, strlen(db) + 1, 0);
+  table_hash= murmur3_32((const uchar*) table_name, strlen(table_name) + 1,
+                         table_hash);
+  uchar buf[MAX_KEY_LENGTH];
+  bool has_unique_key= false;
+
+  for (uint keynr= 0; keynr < table->s->keys; keynr++)
+  {
+    KEY *key= table->key_info + keynr;
+    if (!(key->flags & HA_NOSAME))
+      continue;
+    has_unique_key= true;
+
+    bool is_null= false;
+    uint32 hash= murmur3_32((const uchar*) &keynr, sizeof(keynr), table_hash);
+    for (uint part= 0; part < key->user_defined_key_parts; part++)
+    {
+      KEY_PART_INFO *key_part= key->key_part + part;
+      Field *field= key_part->field;
+      if ((key_part->key_part_flag & (HA_PART_KEY_SEG | HA_BLOB_PART)) ||
+          (cols && !bitmap_is_set(cols, field->field_index) &&
+           !(cols2 && bitmap_is_set(cols2, field->field_index))))
+        goto unsafe;
+      if (field->is_real_null(ptr_diff))
+      {
+        /* NULL values never conflict in a unique key. */
+        is_null= true;
+        break;
+      }
+
+      uint length= field->sort_length();
+      const CHARSET_INFO *cs= field->sort_charset();
+      if (use_strnxfrm(cs))
+        length= cs->coll->strnxfrmlen(cs, length);
+      if (length > sizeof(buf))
+        goto unsafe;
+      field->move_field_offset(ptr_diff);
+      field->make_sort_key(buf, length);
+      field->move_field_offset(-ptr_diff);
+      hash= murmur3_32(buf, length, hash);
+    }
+    if (!is_null)
+      cache_mngr->writeset.push_back(hash);
+  }
+
+  if (has_unique_key)
+    return;
+
+unsafe:
+  cache_mngr->writeset_unsafe= true;
+  cache_mngr->writeset.clear();
+}
+
 int THD::binlog_write_row(TABLE* table, bool is_trans, 
                           uchar const *record,
                           const uchar* extra_row_info)
@@ -8562,6 +8978,8 @@ int THD::binlog_write_row(TABLE* table, bool is_trans,
   if (unlikely(ev == 0))
     return HA_ERR_OUT_OF_MEM;
 
+  add_row_to_writeset(this, table, record, NULL, NULL);
+
   return ev->add_row_data(row_data, len);
 }
 
@@ -8622,6 +9040,9 @@ int THD::binlog_update_row(TABLE* table, bool is_trans,
   if (unlikely(ev == 0))
     return HA_ERR_OUT_OF_MEM;
 
+  add_row_to_writeset(this, table, before_record, old_read_set, NULL);
+  add_row_to_writeset(this, table, after_record, old_read_set, old_write_set);
+
   error= ev->add_row_data(before_row, before_size) ||
          ev->add_row_data(after_row, after_size);
 
@@ -8674,6 +9095,8 @@ int THD::binlog_delete_row(TABLE* table, bool is_trans,
   if (unlikely(ev == 0))
     return HA_ERR_OUT_OF_MEM;
 
+  add_row_to_writeset(this, table, record, old_read_set, NULL);
+
   error= ev->add_row_data(row_data, len);
 
   /* restore read/write set for the rest of execution */
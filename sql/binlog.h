@@ -19,6 +19,7 @@
 #include "mysqld.h"                             /* opt_relay_logname */
 #include "log_event.h"
 #include "log.h"
+#include <set>
 
 extern ulong rpl_read_size;
 
@@ -36,7 +37,8 @@ public:
     friend class Stage_manager;
   public:
     Mutex_queue()
-      : m_first(NULL), m_last(&m_first), group_prepared_engine(NULL)
+      : m_first(NULL), m_last(&m_first), m_size(0),
+        group_prepared_engine(NULL)
     {
     }
 
@@ -67,8 +69,19 @@ public:
        Fetch the entire queue for a stage.
 
        This will fetch the entire queue in one go.
+
+       @param[out] size If not NULL, the number of sessions fetched.
     */
-    THD *fetch_and_empty();
+    THD *fetch_and_empty(ulong *size);
+
+    /** Number of sessions currently in the queue. */
+    ulong get_size()
+    {
+      lock();
+      ulong size= m_size;
+      unlock();
+      return size;
+    }
 
   private:
     void lock() { mysql_mutex_lock(&m_lock); }
@@ -88,6 +101,9 @@ public:
     */
     THD **m_last;
 
+    /** Number of sessions in the queue. */
+    ulong m_size;
+
     /**
        Store the max prepared log for each engine that supports ha_flush_logs.
        We have to init group_prepared_engine after all plugins are inited.
@@ -197,13 +213,31 @@ public:
   /**
     Fetch the entire queue and empty it.
 
+    @param stage Stage identifier for the queue to fetch.
+    @param[out] size If not NULL, the number of sessions fetched.
+
     @return Pointer to the first session of the queue.
    */
-  THD *fetch_queue_for(StageID stage) {
+  THD *fetch_queue_for(StageID stage, ulong *size= NULL) {
     DBUG_PRINT("debug", ("Fetching queue for stage %d", stage));
-    return m_queue[stage].fetch_and_empty();
+    return m_queue[stage].fetch_and_empty(size);
   }
 
+  /**
+    Wait until the queue of a stage holds at least @c count sessions,
+    or until @c usec microseconds have passed, whichever comes first.
+
+    The stage leader calls this before fetching the queue, so that more
+    sessions can join the group.
+
+    @param count Number of sessions that ends the wait, 0 for none.
+    @param usec  Maximum time to wait, in microseconds.
+    @param stage Stage identifier for the queue to watch.
+
+    @return Time actually waited, in microseconds.
+   */
+  ulonglong wait_count_or_timeout(ulong count, ulong usec, StageID stage);
+
   void signal_done(THD *queue) {
     mysql_mutex_lock(&m_lock_done);
     for (THD *thd= queue ; thd ; thd = thd->next_to_commit)
@@ -311,6 +345,18 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   */
   uint *sync_period_ptr;
   uint sync_counter;
+  /*
+    Number of the last flush stage group, protected by LOCK_log. See
+    THD::binlog_commit_group.
+  */
+  ulonglong commit_group_counter;
+  /*
+    Writeset dependency tracking, protected by LOCK_log: the unique key
+    hashes written by the transactions of the current commit group, and
+    whether the next transaction has to start a new group.
+  */
+  std::set<uint32> writeset_history;
+  bool writeset_group_closed;
 
   my_atomic_rwlock_t m_prep_xids_lock;
   mysql_cond_t m_prep_xids_cond;
@@ -515,6 +561,7 @@ private:
                     THD* queue, mysql_mutex_t *leave,
                     mysql_mutex_t *enter);
   std::pair<int,my_off_t> flush_thread_caches(THD *thd);
+  ulonglong writeset_commit_group(THD *thd);
   int flush_cache_to_file(my_off_t *flush_end_pos);
   int finish_commit(THD *thd);
   std::pair<bool, bool> sync_binlog_file(bool force);
@@ -721,6 +768,46 @@ int gtid_empty_group_log_and_cleanup(THD *thd);
 extern const char *log_bin_index;
 extern const char *log_bin_basename;
 extern bool opt_binlog_order_commits;
+extern ulong opt_binlog_group_commit_sync_delay;
+extern ulong opt_binlog_group_commit_sync_no_delay_count;
+extern my_bool opt_binlog_gtid_commit_group;
+extern ulong opt_binlog_transaction_dependency_tracking;
+extern ulong opt_binlog_transaction_dependency_history_size;
+
+/**
+  How the binlog commit group recorded in Gtid_log_event is computed,
+  see @@global.binlog_transaction_dependency_tracking.
+*/
+enum enum_binlog_dependency_tracking
+{
+  /* One group per flush stage group */
+  DEPENDENCY_TRACKING_COMMIT_ORDER= 0,
+  /* A group lasts until a transaction conflicts with it on a unique key */
+  DEPENDENCY_TRACKING_WRITESET= 1
+};
+
+/* Writeset dependency tracking statistics, updated under LOCK_log. */
+extern ulonglong binlog_writeset_conflicts;
+extern ulonglong binlog_writeset_unsafe_trx;
+
+/*
+  Bytes of transaction events before and after they were compressed into
+  Transaction_payload_log_events, exported as status variables.
+*/
+extern ulonglong binlog_payload_compressed_bytes;
+extern ulonglong binlog_payload_uncompressed_bytes;
+
+/*
+  Group commit statistics, exported as status variables. The counters of
+  a stage are only updated by the leader of the stage while it holds the
+  stage mutex.
+*/
+extern ulonglong binlog_stage_groups[Stage_manager::STAGE_COUNTER];
+extern ulonglong binlog_stage_trx[Stage_manager::STAGE_COUNTER];
+extern ulonglong binlog_stage_leader_wait_time[Stage_manager::STAGE_COUNTER];
+extern ulonglong binlog_group_commit_fsyncs;
+extern ulonglong binlog_group_commit_fsync_time;
+extern ulonglong binlog_group_commit_delay_time;
 extern bool opt_gtid_precommit;
 
 /**
@@ -240,6 +240,7 @@ ha_rows filesort(THD *thd, TABLE *table, Filesort *filesort,
                           table,
                           thd->variables.max_length_for_sort_data,
                           max_rows, sort_positions);
+  param.max_sort_threads= thd->variables.filesort_max_threads;
 
   table_sort.addon_buf= 0;
   table_sort.addon_length= param.addon_length;
@@ -410,6 +411,14 @@ ha_rows filesort(THD *thd, TABLE *table, Filesort *filesort,
       goto err;
   }
 
+  if (param.parallel_sort_buffers)
+  {
+    thd->inc_status_sort_parallel();
+    Opt_trace_object(trace, "filesort_parallel_sort")
+      .add("sorted_buffers", param.parallel_sort_buffers)
+      .add("max_threads", param.parallel_sort_threads);
+  }
+
   if (num_rows > param.max_rows)
   {
     // If find_all_keys() produced more results than the query LIMIT.
@@ -875,6 +884,21 @@ static ha_rows find_all_keys(Sort_param *param, SQL_SELECT *select,
 } /* find_all_keys */
 
 
+/**
+  Remember that a sort buffer was sorted by several threads, for the
+  Sort_parallel status variable and the optimizer trace.
+*/
+
+static inline void note_sort_threads(Sort_param *param, uint threads)
+{
+  if (threads > 1)
+  {
+    param->parallel_sort_buffers++;
+    param->parallel_sort_threads= max(param->parallel_sort_threads, threads);
+  }
+}
+
+
 /**
   @details
   Sort the buffer and write:
@@ -909,7 +933,7 @@ write_keys(Sort_param *param, Filesort_info *fs_info, uint count,
   rec_length= param->rec_length;
   uchar **sort_keys= fs_info->get_sort_keys();
 
-  fs_info->sort_buffer(param, count);
+  note_sort_threads(param, fs_info->sort_buffer(param, count));
 
   if (!my_b_inited(tempfile) &&
       open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX, DISK_BUFFER_SIZE,
@@ -1265,7 +1289,7 @@ static bool save_index(Sort_param *param, uint count, Filesort_info *table_sort)
   uchar *to;
   DBUG_ENTER("save_index");
 
-  table_sort->sort_buffer(param, count);
+  note_sort_threads(param, table_sort->sort_buffer(param, count));
   res_length= param->res_length;
   offset= param->rec_length-res_length;
   if (!(to= table_sort->record_pointers= 
@@ -14,6 +14,7 @@
    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
 
 #include "filesort_utils.h"
+#include "mysqld.h"
 #include "sql_const.h"
 #include "sql_sort.h"
 #include "table.h"
@@ -183,23 +184,155 @@ size_t try_reserve(std::pair<type*, ptrdiff_t> *buf, ptrdiff_t size)
   return buf->second;
 }
 
+
+/**
+  Do not give a sort thread less than this many keys: below this the cost
+  of creating the thread and of the extra merge passes is larger than
+  what is gained from sorting in parallel.
+*/
+const uint MIN_KEYS_PER_SORT_THREAD= 10000;
+
+/**
+  One unit of work for a parallel sort: either sort [first, last) in place,
+  or merge the sorted ranges [first, middle) and [middle, last) into dest.
+*/
+struct Sort_work
+{
+  uchar **first;
+  uchar **middle;
+  uchar **last;
+  uchar **dest;
+  size_t sort_length;
+};
+
+
+void do_sort_work(const Sort_work *work)
+{
+  Mem_compare cmp(work->sort_length);
+  if (work->dest == NULL)
+    std::stable_sort(work->first, work->last, cmp);
+  else if (work->middle == work->last)
+    std::copy(work->first, work->last, work->dest);
+  else
+    std::merge(work->first, work->middle, work->middle, work->last,
+               work->dest, cmp);
+}
+
+
+extern "C" void *filesort_worker(void *arg)
+{
+  my_thread_init();
+  do_sort_work(static_cast<Sort_work*>(arg));
+  my_thread_end();
+  pthread_exit(0);
+  return NULL;
+}
+
+
+/**
+  Run work[0..count-1] concurrently: work[0] is done by the calling thread,
+  the rest by worker threads. If a worker thread cannot be created, its work
+  is done by the calling thread instead, so this never fails.
+*/
+void run_sort_work(Sort_work *work, uint count, pthread_t *threads)
+{
+  bool started[MAX_FILESORT_THREADS];
+  for (uint i= 1; i < count; i++)
+    started[i]= !mysql_thread_create(key_thread_filesort_worker, &threads[i],
+                                     NULL, filesort_worker, &work[i]);
+  do_sort_work(&work[0]);
+  for (uint i= 1; i < count; i++)
+  {
+    if (started[i])
+      pthread_join(threads[i], NULL);
+    else
+      do_sort_work(&work[i]);
+  }
+}
+
+
+/**
+  Sort keys[0..count-1] with num_threads threads.
+
+  The keys are split into num_threads chunks which are sorted concurrently
+  with std::stable_sort. The sorted chunks are then merged pairwise, all
+  merges of one pass running concurrently, alternating between the key
+  array and tmp, until a single sorted sequence is left. std::merge
+  prefers the left input on ties, so the result is the same as that of
+  a serial std::stable_sort.
+*/
+void parallel_sort(uchar **keys, uint count, uint num_threads,
+                   size_t sort_length, uchar **tmp)
+{
+  Sort_work work[MAX_FILESORT_THREADS];
+  pthread_t threads[MAX_FILESORT_THREADS];
+  uchar **bounds[MAX_FILESORT_THREADS + 1];
+
+  for (uint i= 0; i <= num_threads; i++)
+    bounds[i]= keys + (ulonglong) count * i / num_threads;
+
+  for (uint i= 0; i < num_threads; i++)
+  {
+    work[i].first= bounds[i];
+    work[i].middle= work[i].last= bounds[i + 1];
+    work[i].dest= NULL;
+    work[i].sort_length= sort_length;
+  }
+  run_sort_work(work, num_threads, threads);
+
+  uchar **from= keys;
+  uchar **to= tmp;
+  for (uint chunks= num_threads; chunks > 1; chunks= (chunks + 1) / 2)
+  {
+    uint merges= 0;
+    for (uint i= 0; i < chunks; i+= 2, merges++)
+    {
+      Sort_work *w= &work[merges];
+      w->first= from + (bounds[i] - keys);
+      w->middle= from + (bounds[std::min(i + 1, chunks)] - keys);
+      w->last= from + (bounds[std::min(i + 2, chunks)] - keys);
+      w->dest= to + (bounds[i] - keys);
+      w->sort_length= sort_length;
+      // The merged chunk starts where its left input started.
+      bounds[merges]= bounds[i];
+    }
+    bounds[merges]= bounds[chunks];
+    run_sort_work(work, merges, threads);
+    std::swap(from, to);
+  }
+  if (from != keys)
+    std::copy(from, from + count, keys);
+}
+
 } // namespace
 
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+uint Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   if (count <= 1)
-    return;
+    return 1;
   if (param->sort_length == 0)
-    return;
+    return 1;
 
   uchar **keys= get_sort_keys();
+
+  uint num_threads= std::min<uint>(param->max_sort_threads,
+                                   count / MIN_KEYS_PER_SORT_THREAD);
+  num_threads= std::min<uint>(num_threads, MAX_FILESORT_THREADS);
+  std::pair<uchar**, ptrdiff_t> tmp;
+  if (num_threads > 1 && try_reserve(&tmp, count))
+  {
+    parallel_sort(keys, count, num_threads, param->sort_length, tmp.first);
+    std::return_temporary_buffer(tmp.first);
+    return num_threads;
+  }
+
   std::pair<uchar**, ptrdiff_t> buffer;
   if (radixsort_is_appliccable(count, param->sort_length) &&
       try_reserve(&buffer, count))
   {
     radixsort_for_str_ptr(keys, count, param->sort_length, buffer.first);
     std::return_temporary_buffer(buffer.first);
-    return;
+    return 1;
   }
   /*
     std::stable_sort has some extra overhead in allocating the temp buffer,
@@ -211,7 +344,8 @@ void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
   {
     size_t size= param->sort_length;
     my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
-    return;
+    return 1;
   }
   std::stable_sort(keys, keys + count, Mem_compare(param->sort_length));
+  return 1;
 }
@@ -66,8 +66,15 @@ public:
     m_idx_array(), m_record_length(0), m_start_of_data(NULL)
   {}
 
-  /** Sort me... */
-  void sort_buffer(const Sort_param *param, uint count);
+  /**
+    Sort me...
+    If param->max_sort_threads allows it, and there are enough keys,
+    the keys are split into chunks which are sorted by separate threads
+    and then merged, also in parallel, into the final order.
+
+    @return The number of threads which took part in the sort.
+  */
+  uint sort_buffer(const Sort_param *param, uint count);
 
   /// Initializes a record pointer.
   uchar *get_record_buffer(uint idx)
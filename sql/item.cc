@@ -3407,6 +3407,7 @@ Item_param::Item_param(uint pos_in_query_arg) :
   pos_in_query(pos_in_query_arg),
   set_param_func(default_set_param_func),
   limit_clause_param(FALSE),
+  query_literal(FALSE),
   m_out_param_info(NULL)
 {
   item_name.set("?");
@@ -3787,6 +3788,11 @@ double Item_param::val_real()
   case STRING_VALUE:
   case LONG_DATA_VALUE:
   {
+    if (query_literal)
+      return double_from_string_with_check(str_value.charset(),
+                                           str_value.ptr(),
+                                           (char *) str_value.ptr() +
+                                           str_value.length());
     int dummy_err;
     char *end_not_used;
     return my_strntod(str_value.charset(), (char*) str_value.ptr(),
@@ -3823,6 +3829,11 @@ longlong Item_param::val_int()
   case STRING_VALUE:
   case LONG_DATA_VALUE:
     {
+      if (query_literal)
+        return longlong_from_string_with_check(str_value.charset(),
+                                               str_value.ptr(),
+                                               (char *) str_value.ptr() +
+                                               str_value.length());
       int dummy_err;
       return my_strntoll(str_value.charset(), str_value.ptr(),
                          str_value.length(), 10, (char**) 0, &dummy_err);
@@ -3851,6 +3862,8 @@ my_decimal *Item_param::val_decimal(my_decimal *dec)
     return dec;
   case STRING_VALUE:
   case LONG_DATA_VALUE:
+    if (query_literal)
+      return val_decimal_from_string(dec);
     string2my_decimal(E_DEC_FATAL_ERROR, &str_value, dec);
     return dec;
   case TIME_VALUE:
@@ -4120,6 +4133,7 @@ Item_param::set_param_type_and_swap_value(Item_param *src)
   unsigned_flag= src->unsigned_flag;
   param_type= src->param_type;
   set_param_func= src->set_param_func;
+  query_literal= src->query_literal;
   item_type= src->item_type;
   item_result_type= src->item_result_type;
 
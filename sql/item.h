@@ -2565,6 +2565,12 @@ public:
   bool eq(const Item *item, bool binary_cmp) const;
   /** Item is a argument to a limit clause. */
   bool limit_clause_param;
+  /**
+    Item stands for a literal of a query executed from the query template
+    cache: strings are converted to numbers with the warnings a string
+    literal would give.
+  */
+  bool query_literal;
   void set_param_type_and_swap_value(Item_param *from);
 
 private:
@@ -56,6 +56,7 @@ slave_ignored_err_throttle(window_size,
 
 #include <base64.h>
 #include <my_bitmap.h>
+#include <zlib.h>
 #include "rpl_utility.h"
 
 #include "sql_digest.h"
@@ -705,6 +706,7 @@ const char* Log_event::get_type_str(Log_event_type type)
   case GTID_LOG_EVENT: return "Gtid";
   case ANONYMOUS_GTID_LOG_EVENT: return "Anonymous_Gtid";
   case PREVIOUS_GTIDS_LOG_EVENT: return "Previous_gtids";
+  case TRANSACTION_PAYLOAD_EVENT: return "Transaction_payload";
   case HEARTBEAT_LOG_EVENT: return "Heartbeat";
   default: return "Unknown";				/* impossible */
   }
@@ -1523,6 +1525,7 @@ Log_event* Log_event::read_log_event(const char* buf, uint event_len,
 
   if (event_type > description_event->number_of_event_types &&
       event_type != FORMAT_DESCRIPTION_EVENT &&
+      event_type != TRANSACTION_PAYLOAD_EVENT &&
       /*
         Skip the event type check when simulating an
         unknown ignorable log event.
@@ -1659,6 +1662,9 @@ Log_event* Log_event::read_log_event(const char* buf, uint event_len,
     case PREVIOUS_GTIDS_LOG_EVENT:
       ev= new Previous_gtids_log_event(buf, event_len, description_event);
       break;
+    case TRANSACTION_PAYLOAD_EVENT:
+      ev= new Transaction_payload_log_event(buf, event_len, description_event);
+      break;
 #if defined(HAVE_REPLICATION)
     case WRITE_ROWS_EVENT:
       ev = new Write_rows_log_event(buf, event_len, description_event);
@@ -2734,6 +2740,35 @@ Slave_worker *Log_event::get_slave_worker(Relay_log_info *rli)
     if (!rli->curr_group_seen_gtid && !rli->curr_group_seen_begin)
     {
       ulong gaq_idx __attribute__((unused));
+
+      if (rli->mts_parallel_type == MTS_PARALLEL_TYPE_LOGICAL_CLOCK)
+      {
+        /*
+          Transactions of one commit group on the master did not
+          conflict and may be applied in parallel. Any other group
+          waits for all the assigned ones to commit first.
+        */
+        ulonglong commit_group= is_gtid_event(this) ?
+          static_cast<Gtid_log_event*>(this)->get_commit_group() : 0;
+        if (commit_group == 0 || commit_group != rli->mts_last_commit_group)
+        {
+          mts_commit_group_waits++;
+          // No need to know a possible error out of synchronization call.
+          (void) wait_for_workers_to_finish(rli);
+          rli->mts_group_status= Relay_log_info::MTS_IN_GROUP;
+        }
+        else
+          mts_commit_group_parallel++;
+        rli->mts_last_commit_group= commit_group;
+        /*
+          The rows events of the group are mapped to a pseudo database
+          so that the group is bound to a single Worker.
+        */
+        my_snprintf(rli->mts_clock_partition, sizeof(rli->mts_clock_partition),
+                    "\001%lu", (ulong) (rli->mts_groups_assigned %
+                                        rli->workers.elements));
+      }
+
       rli->mts_groups_assigned++;
 
       rli->curr_group_isolated= FALSE;
@@ -2791,6 +2826,12 @@ Slave_worker *Log_event::get_slave_worker(Relay_log_info *rli)
     Mts_db_names mts_dbs;
 
     get_mts_dbs(&mts_dbs);
+    if (rli->mts_parallel_type == MTS_PARALLEL_TYPE_LOGICAL_CLOCK &&
+        get_type_code() == TABLE_MAP_EVENT)
+    {
+      mts_dbs.num= 1;
+      mts_dbs.name[0]= rli->mts_clock_partition;
+    }
     /*
       Bug 12982188 - MTS: SBR ABORTS WITH ERROR 1742 ON LOAD DATA
       Logging on master can create a group with no events holding
@@ -13461,6 +13502,172 @@ int Rows_query_log_event::do_apply_event(Relay_log_info const *rli)
 #endif
 
 
+#ifndef MYSQL_CLIENT
+Transaction_payload_log_event::
+Transaction_payload_log_event(THD *thd_arg, const uchar *payload,
+                              ulong payload_len, ulong uncompressed_len)
+  : Log_event(thd_arg, 0, Log_event::EVENT_TRANSACTIONAL_CACHE,
+              Log_event::EVENT_NORMAL_LOGGING),
+    m_payload(payload), m_payload_len(payload_len),
+    m_uncompressed_len(uncompressed_len),
+    m_compression_type(COMPRESSION_ZLIB)
+{
+}
+#endif
+
+
+Transaction_payload_log_event::
+Transaction_payload_log_event(const char *buf, uint event_len,
+                              const Format_description_log_event *descr_event)
+  : Log_event(buf, descr_event), m_payload(NULL), m_payload_len(0),
+    m_uncompressed_len(0), m_compression_type(COMPRESSION_ZLIB)
+{
+  DBUG_ENTER("Transaction_payload_log_event::Transaction_payload_log_event");
+  uint8 const common_header_len= descr_event->common_header_len;
+
+  if (event_len < common_header_len + BODY_HEADER_LEN)
+    DBUG_VOID_RETURN;
+
+  const uchar *body= (const uchar *) buf + common_header_len;
+  m_compression_type= body[0];
+  m_uncompressed_len= uint4korr(body + 1);
+  DBUG_PRINT("info", ("compression_type: %u; uncompressed_len: %lu",
+                      m_compression_type, m_uncompressed_len));
+  // if m_payload == NULL, is_valid will return false
+  if (m_compression_type != COMPRESSION_ZLIB)
+    DBUG_VOID_RETURN;
+  m_payload= body + BODY_HEADER_LEN;
+  m_payload_len= event_len - common_header_len - BODY_HEADER_LEN;
+  DBUG_VOID_RETURN;
+}
+
+#ifndef MYSQL_CLIENT
+int Transaction_payload_log_event::pack_info(Protocol *protocol)
+{
+  char buf[64];
+  size_t bytes= my_snprintf(buf, sizeof(buf),
+                            "compression=zlib; uncompressed_len=%lu",
+                            m_uncompressed_len);
+  protocol->store(buf, bytes, &my_charset_bin);
+  return 0;
+}
+#endif
+
+#ifdef MYSQL_CLIENT
+void
+Transaction_payload_log_event::print(FILE *file,
+                                     PRINT_EVENT_INFO *print_event_info)
+{
+  if (print_event_info->short_form)
+    return;
+
+  IO_CACHE *const head= &print_event_info->head_cache;
+  print_header(head, print_event_info, FALSE);
+  my_b_printf(head, "\tTransaction_payload\tcompression: zlib\t"
+              "uncompressed_len: %lu\n", m_uncompressed_len);
+}
+#endif
+
+#ifdef MYSQL_SERVER
+bool Transaction_payload_log_event::write_data_body(IO_CACHE *file)
+{
+  DBUG_ENTER("Transaction_payload_log_event::write_data_body");
+  uchar buf[BODY_HEADER_LEN];
+  buf[0]= m_compression_type;
+  int4store(buf + 1, m_uncompressed_len);
+  DBUG_RETURN(wrapper_my_b_safe_write(file, buf, sizeof(buf)) ||
+              wrapper_my_b_safe_write(file, m_payload, m_payload_len));
+}
+#endif
+
+uchar *Transaction_payload_log_event::uncompress_payload() const
+{
+  DBUG_ENTER("Transaction_payload_log_event::uncompress_payload");
+  uchar *buf= (uchar *) my_malloc(m_uncompressed_len, MYF(MY_WME));
+  if (buf == NULL)
+    DBUG_RETURN(NULL);
+
+  uLongf len= m_uncompressed_len;
+  if (uncompress(buf, &len, m_payload, m_payload_len) != Z_OK ||
+      len != m_uncompressed_len)
+  {
+    my_free(buf);
+    DBUG_RETURN(NULL);
+  }
+  DBUG_RETURN(buf);
+}
+
+Log_event *
+Transaction_payload_log_event::read_event(const uchar *buf, ulong len,
+                                          ulong *event_len, my_off_t log_pos,
+                                          const Format_description_log_event
+                                          *descr_event,
+                                          const char **error)
+{
+  DBUG_ENTER("Transaction_payload_log_event::read_event");
+
+  if (len < LOG_EVENT_MINIMAL_HEADER_LEN ||
+      (*event_len= uint4korr(buf + EVENT_LEN_OFFSET)) > len ||
+      *event_len < LOG_EVENT_MINIMAL_HEADER_LEN)
+  {
+    *error= "Truncated event in transaction payload";
+    DBUG_RETURN(NULL);
+  }
+
+  /*
+    The events were written to the binlog cache, so they carry no
+    checksum; add one if the events of this log are expected to have it.
+  */
+  uint8 alg= descr_event->checksum_alg;
+  ulong checksum_len= (alg != BINLOG_CHECKSUM_ALG_OFF &&
+                       alg != BINLOG_CHECKSUM_ALG_UNDEF) ?
+    BINLOG_CHECKSUM_LEN : 0;
+  ulong data_len= *event_len + checksum_len;
+
+  // some events use the extra byte to null-terminate strings
+  char *data= (char *) my_malloc(data_len + 1, MYF(MY_WME));
+  if (data == NULL)
+  {
+    *error= "Out of memory";
+    DBUG_RETURN(NULL);
+  }
+  data[data_len]= 0;
+  memcpy(data, buf, *event_len);
+  int4store(data + EVENT_LEN_OFFSET, data_len);
+  int4store(data + LOG_POS_OFFSET, log_pos);
+  if (checksum_len)
+  {
+    ha_checksum crc= my_checksum(0L, NULL, 0);
+    crc= my_checksum(crc, (uchar *) data, *event_len);
+    int4store(data + *event_len, crc);
+  }
+
+  Log_event *ev= Log_event::read_log_event(data, data_len, error,
+                                           descr_event, FALSE);
+  if (ev != NULL)
+    ev->register_temp_buf(data);
+  else
+    my_free(data);
+  DBUG_RETURN(ev);
+}
+
+#if defined(MYSQL_SERVER) && defined(HAVE_REPLICATION)
+int Transaction_payload_log_event::do_apply_event(Relay_log_info const *rli)
+{
+  DBUG_ENTER("Transaction_payload_log_event::do_apply_event");
+  /*
+    The slave SQL thread unpacks the payload when reading it and applies
+    the events it carries, so this is only reached through a BINLOG
+    statement.
+  */
+  rli->report(ERROR_LEVEL, ER_SLAVE_FATAL_ERROR, ER(ER_SLAVE_FATAL_ERROR),
+              "Transaction_payload events can only be applied by the "
+              "slave SQL thread");
+  DBUG_RETURN(1);
+}
+#endif
+
+
 const char *Gtid_log_event::SET_STRING_PREFIX= "SET @@SESSION.GTID_NEXT= '";
 
 
@@ -13498,17 +13705,33 @@ Gtid_log_event::Gtid_log_event(const char *buffer, uint event_len,
   spec.gtid.gno= uint8korr(ptr_buffer);
   ptr_buffer+= ENCODED_GNO_LENGTH;
 
+  /*
+    The body is optional and only understood when it starts with a known
+    type code, so that older and newer masters stay compatible.
+  */
+  has_commit_group= false;
+  commit_group= 0;
+  if (event_len >= (uint) (common_header_len + POST_HEADER_LENGTH +
+                           ENCODED_COMMIT_GROUP_LENGTH) &&
+      (uchar) *ptr_buffer == COMMIT_GROUP_TYPECODE)
+  {
+    has_commit_group= true;
+    commit_group= uint8korr(ptr_buffer + 1);
+  }
+
   DBUG_VOID_RETURN;
 }
 
 #ifndef MYSQL_CLIENT
 Gtid_log_event::Gtid_log_event(THD* thd_arg, bool using_trans,
-                               const Gtid_specification *spec_arg)
+                               const Gtid_specification *spec_arg,
+                               bool with_commit_group)
 : Log_event(thd_arg, thd_arg->variables.gtid_next.type == ANONYMOUS_GROUP ?
             LOG_EVENT_IGNORABLE_F : 0,
             using_trans ? Log_event::EVENT_TRANSACTIONAL_CACHE :
             Log_event::EVENT_STMT_CACHE, Log_event::EVENT_NORMAL_LOGGING),
-  commit_flag(true)
+  commit_flag(true), has_commit_group(with_commit_group),
+  commit_group(thd_arg->binlog_commit_group)
 {
   DBUG_ENTER("Gtid_log_event::Gtid_log_event(THD *)");
   spec= spec_arg ? *spec_arg : thd_arg->variables.gtid_next;
@@ -13593,6 +13816,19 @@ bool Gtid_log_event::write_data_header(IO_CACHE *file)
   DBUG_ASSERT(ptr_buffer == (buffer + sizeof(buffer)));
   DBUG_RETURN(wrapper_my_b_safe_write(file, (uchar *) buffer, sizeof(buffer)));
 }
+
+bool Gtid_log_event::write_data_body(IO_CACHE *file)
+{
+  DBUG_ENTER("Gtid_log_event::write_data_body");
+  if (!has_commit_group)
+    DBUG_RETURN(false);
+
+  uchar buffer[ENCODED_COMMIT_GROUP_LENGTH];
+  buffer[0]= COMMIT_GROUP_TYPECODE;
+  int8store(buffer + 1, commit_group);
+  DBUG_PRINT("info", ("commit_group=%llu", commit_group));
+  DBUG_RETURN(wrapper_my_b_safe_write(file, buffer, sizeof(buffer)));
+}
 #endif // MYSQL_SERVER
 
 #if defined(MYSQL_SERVER) && defined(HAVE_REPLICATION)
@@ -713,6 +713,12 @@ enum Log_event_type
   ANONYMOUS_GTID_LOG_EVENT= 34,
 
   PREVIOUS_GTIDS_LOG_EVENT= 35,
+
+  /*
+    The compressed events of one transaction. This type is not described
+    by Format_description_log_event, see LOG_EVENT_TYPES.
+  */
+  TRANSACTION_PAYLOAD_EVENT= 36,
   /*
     Add new events here - right above this comment!
     Existing events (except ENUM_END_EVENT) should never change their numbers
@@ -725,8 +731,11 @@ enum Log_event_type
    The number of types we handle in Format_description_log_event (UNKNOWN_EVENT
    is not to be handled, it does not exist in binlogs, it does not have a
    format).
+   TRANSACTION_PAYLOAD_EVENT has no post-header and is left out, so that the
+   Format_description_log_event, and thereby every position in a binlog that
+   does not use it, stays the same as before the type was added.
 */
-#define LOG_EVENT_TYPES (ENUM_END_EVENT-1)
+#define LOG_EVENT_TYPES (TRANSACTION_PAYLOAD_EVENT-1)
 
 enum Int_event_type
 {
@@ -4888,6 +4897,132 @@ private:
 };
 
 
+/**
+  @class Transaction_payload_log_event
+
+  The events of one transaction, compressed as a single unit. The master
+  writes it in place of the events of the transaction cache, right after
+  the Gtid event when there is one. The dump thread and the slave I/O
+  thread pass it on like any other event; only the SQL thread and
+  mysqlbinlog look inside it.
+
+  @section Transaction_payload_log_event_binary_format Binary Format
+
+  The event has no post-header. The body is:
+
+  <table>
+  <caption>Transaction_payload_log_event body</caption>
+
+  <tr>
+    <th>Name</th>
+    <th>Format</th>
+    <th>Description</th>
+  </tr>
+
+  <tr>
+    <td>compression_type</td>
+    <td>1 byte enumeration</td>
+    <td>How the payload is compressed, see enum_compression_type.</td>
+  </tr>
+
+  <tr>
+    <td>uncompressed_len</td>
+    <td>4 byte unsigned integer</td>
+    <td>The length of the events once uncompressed.</td>
+  </tr>
+
+  <tr>
+    <td>payload</td>
+    <td>variable length</td>
+    <td>The compressed events. They are stored as they were in the
+    binlog cache: without checksum and with log_pos relative to the
+    start of the cache.</td>
+  </tr>
+  </table>
+*/
+class Transaction_payload_log_event : public Log_event
+{
+public:
+  enum enum_compression_type
+  {
+    COMPRESSION_ZLIB= 0
+  };
+
+  static const uint BODY_HEADER_LEN= 5;
+
+#ifndef MYSQL_CLIENT
+  /**
+    The event does not copy @c payload, which must stay valid until the
+    event is written.
+  */
+  Transaction_payload_log_event(THD *thd_arg, const uchar *payload,
+                                ulong payload_len, ulong uncompressed_len);
+#endif
+
+  Transaction_payload_log_event(const char *buf, uint event_len,
+                                const Format_description_log_event *descr_event);
+  virtual ~Transaction_payload_log_event() {}
+
+#ifndef MYSQL_CLIENT
+  int pack_info(Protocol*);
+#endif
+
+#ifdef MYSQL_CLIENT
+  virtual void print(FILE *file, PRINT_EVENT_INFO *print_event_info);
+#endif
+#ifdef MYSQL_SERVER
+  virtual bool write_data_body(IO_CACHE *file);
+#endif
+
+  virtual Log_event_type get_type_code() { return TRANSACTION_PAYLOAD_EVENT; }
+
+  virtual bool is_valid() const { return m_payload != NULL; }
+
+  virtual int get_data_size() { return (int) (BODY_HEADER_LEN + m_payload_len); }
+
+  ulong get_uncompressed_len() const { return m_uncompressed_len; }
+
+  /**
+    Uncompresses the payload into a buffer allocated with my_malloc,
+    which the caller must free.
+
+    @return The buffer, or NULL on error.
+  */
+  uchar *uncompress_payload() const;
+
+  /**
+    Reads the event at the start of @c buf, a part of an uncompressed
+    payload. The event is rebuilt as if it had been written to the binary
+    log on its own: its log_pos is set to @c log_pos and a checksum is
+    added when @c descr_event has one, so that it can be printed and
+    applied like any other event.
+
+    @param[in]  buf         The remaining part of the uncompressed payload.
+    @param[in]  len         The length of @c buf.
+    @param[out] event_len   The length of the event in @c buf.
+    @param[in]  log_pos     The log_pos of the payload event.
+    @param[in]  descr_event The description of the log the payload is in.
+    @param[out] error       The error message, if NULL is returned.
+
+    @return The event, or NULL on error.
+  */
+  static Log_event *read_event(const uchar *buf, ulong len, ulong *event_len,
+                               my_off_t log_pos,
+                               const Format_description_log_event *descr_event,
+                               const char **error);
+
+#if defined(MYSQL_SERVER) && defined(HAVE_REPLICATION)
+  virtual int do_apply_event(Relay_log_info const *rli);
+#endif
+
+private:
+  const uchar *m_payload;
+  ulong m_payload_len;
+  ulong m_uncompressed_len;
+  uint8 m_compression_type;
+};
+
+
 
 static inline bool copy_event_cache_to_file_and_reinit(IO_CACHE *cache,
                                                        FILE *file,
@@ -4958,7 +5093,8 @@ public:
     or from @@SESSION.GTID_NEXT if spec==NULL.
   */
   Gtid_log_event(THD *thd_arg, bool using_trans,
-                 const Gtid_specification *spec= NULL);
+                 const Gtid_specification *spec= NULL,
+                 bool with_commit_group= false);
 #endif
 
 #ifndef MYSQL_CLIENT
@@ -4979,7 +5115,11 @@ public:
     DBUG_RETURN(ret);
   }
 
-  int get_data_size() { return POST_HEADER_LENGTH; }
+  int get_data_size()
+  {
+    return POST_HEADER_LENGTH +
+      (has_commit_group ? ENCODED_COMMIT_GROUP_LENGTH : 0);
+  }
 
 private:
   /// Used internally by both print() and pack_info().
@@ -4991,6 +5131,7 @@ public:
 #endif
 #ifdef MYSQL_SERVER
   bool write_data_header(IO_CACHE *file);
+  bool write_data_body(IO_CACHE *file);
 #endif
 
 #if defined(MYSQL_SERVER) && defined(HAVE_REPLICATION)
@@ -5057,6 +5198,14 @@ public:
   rpl_gno get_gno() const { return spec.gtid.gno; }
   /// Return true if this is the last group of the transaction, else false.
   bool get_commit_flag() const { return commit_flag; }
+  /**
+    Return the binlog group commit that wrote this transaction on the
+    master, or 0 if the event does not carry it.  Transactions with the
+    same non-zero value were committed together and therefore did not
+    conflict.
+  */
+  ulonglong get_commit_group() const
+  { return has_commit_group ? commit_group : 0; }
 
   /// string holding the text "SET @@GLOBAL.GTID_NEXT = '"
   static const char *SET_STRING_PREFIX;
@@ -5073,6 +5222,10 @@ private:
   static const int ENCODED_SID_LENGTH= rpl_sid::BYTE_LENGTH;
   /// Length of GNO in event encoding
   static const int ENCODED_GNO_LENGTH= 8;
+  /// Type code of the commit group field in the event body
+  static const uchar COMMIT_GROUP_TYPECODE= 1;
+  /// Length of the commit group field, type code included
+  static const int ENCODED_COMMIT_GROUP_LENGTH= 1 + 8;
 
 public:
   /// Total length of post header
@@ -5089,6 +5242,10 @@ private:
   rpl_sid sid;
   /// True if this is the last group of the transaction, false otherwise.
   bool commit_flag;
+  /// True if the event body carries commit_group.
+  bool has_commit_group;
+  /// Binlog group commit that wrote this transaction on the master.
+  ulonglong commit_group;
 };
 
 
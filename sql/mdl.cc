@@ -24,6 +24,7 @@
 #include <mysql/psi/mysql_stage.h>
 #include "sql_class.h"
 #include <my_murmur3.h>
+#include <my_atomic.h>
 
 #ifdef HAVE_PSI_INTERFACE
 static PSI_mutex_key key_MDL_map_mutex;
@@ -126,7 +127,8 @@ public:
   MDL_map_partition();
   ~MDL_map_partition();
   inline MDL_lock *find_or_insert(const MDL_key *mdl_key,
-                                  my_hash_value_type hash_value);
+                                  my_hash_value_type hash_value,
+                                  enum_mdl_type type, bool *fast_path);
   inline void remove(MDL_lock *lock);
   my_hash_value_type get_key_hash(const MDL_key *mdl_key) const
   {
@@ -176,7 +178,8 @@ class MDL_map
 public:
   void init();
   void destroy();
-  MDL_lock *find_or_insert(const MDL_key *key);
+  MDL_lock *find_or_insert(const MDL_key *key, enum_mdl_type type,
+                           bool *fast_path);
   void remove(MDL_lock *lock);
 private:
   /** Array of partitions where the locks are actually stored. */
@@ -417,12 +420,36 @@ public:
 
   bool is_empty() const
   {
-    return (m_granted.is_empty() && m_waiting.is_empty());
+    return (m_granted.is_empty() && m_waiting.is_empty() &&
+            fast_path_lock_count() == 0);
   }
 
   virtual const bitmap_t *incompatible_granted_types_bitmap() const = 0;
   virtual const bitmap_t *incompatible_waiting_types_bitmap() const = 0;
 
+  /**
+    Array of increments of m_fast_path_state for lock types which
+    can be granted on the fast path, zero for all other lock types.
+  */
+  virtual const int64 *unobtrusive_lock_increments() const = 0;
+  /**
+    Bitmap of "obtrusive" lock types, i.e. types which, when granted or
+    waiting, prevent some of unobtrusive lock types from being granted.
+  */
+  virtual bitmap_t obtrusive_lock_types_bitmap() const = 0;
+
+  bool fast_path_acquire(enum_mdl_type type);
+  void fast_path_release(enum_mdl_type type);
+  void materialize_fast_path_ticket(MDL_ticket *ticket);
+  void update_has_obtrusive(bitmap_t pending_type_bit);
+  bitmap_t fast_path_granted_bitmap() const;
+
+  int64 fast_path_lock_count() const
+  {
+    return my_atomic_load64(const_cast<volatile int64*>(&m_fast_path_state)) &
+           FAST_PATH_COUNTERS_MASK;
+  }
+
   bool has_pending_conflicting_lock(enum_mdl_type type);
 
   bool can_grant_lock(enum_mdl_type type, MDL_context *requstor_ctx,
@@ -454,11 +481,34 @@ public:
   */
   ulong m_hog_lock_count;
 
+  /**
+    State of the fast path for unobtrusive lock types (SR and SW for
+    per-object locks, IX for scoped locks).
+
+    The lower 40 bits hold two 20-bit counters of locks which have been
+    granted on the fast path, i.e. by atomically incrementing this member
+    without taking m_rwlock and without adding tickets to m_granted.
+    The HAS_OBTRUSIVE bit is set while any obtrusive lock is granted or
+    waiting, and disables the fast path for new requests, so that the
+    counters can only go down while an obtrusive request is pending.
+
+    The counters are changed atomically, either without any locks or
+    under MDL_map_partition::m_mutex (increments of counters for locks
+    that can be removed from the hash, see MDL_map_partition::remove()).
+    The HAS_OBTRUSIVE bit is changed only under write-locked m_rwlock.
+  */
+  volatile int64 m_fast_path_state;
+
+  static const int64 FAST_PATH_COUNTER_MASK= (1LL << 20) - 1;
+  static const int64 FAST_PATH_COUNTERS_MASK= (1LL << 40) - 1;
+  static const int64 HAS_OBTRUSIVE= 1LL << 40;
+
 public:
 
   MDL_lock(const MDL_key *key_arg, MDL_map_partition *map_part)
   : key(key_arg),
     m_hog_lock_count(0),
+    m_fast_path_state(0),
     m_ref_usage(0),
     m_ref_release(0),
     m_is_destroyed(FALSE),
@@ -557,9 +607,19 @@ public:
     return 0;
   }
 
+  virtual const int64 *unobtrusive_lock_increments() const
+  {
+    return m_unobtrusive_lock_increment;
+  }
+  virtual bitmap_t obtrusive_lock_types_bitmap() const
+  {
+    return MDL_BIT(MDL_SHARED) | MDL_BIT(MDL_EXCLUSIVE);
+  }
+
 private:
   static const bitmap_t m_granted_incompatible[MDL_TYPE_END];
   static const bitmap_t m_waiting_incompatible[MDL_TYPE_END];
+  static const int64 m_unobtrusive_lock_increment[MDL_TYPE_END];
 };
 
 
@@ -585,6 +645,7 @@ public:
     key.mdl_key_init(new_key);
     /* m_granted and m_waiting should be already in the empty/initial state. */
     DBUG_ASSERT(is_empty());
+    DBUG_ASSERT(m_fast_path_state == 0);
     /* Object should not be marked as destroyed. */
     DBUG_ASSERT(! m_is_destroyed);
     /*
@@ -621,9 +682,21 @@ public:
             MDL_BIT(MDL_EXCLUSIVE));
   }
 
+  virtual const int64 *unobtrusive_lock_increments() const
+  {
+    return m_unobtrusive_lock_increment;
+  }
+  virtual bitmap_t obtrusive_lock_types_bitmap() const
+  {
+    return (MDL_BIT(MDL_SHARED_NO_WRITE) |
+            MDL_BIT(MDL_SHARED_NO_READ_WRITE) |
+            MDL_BIT(MDL_EXCLUSIVE));
+  }
+
 private:
   static const bitmap_t m_granted_incompatible[MDL_TYPE_END];
   static const bitmap_t m_waiting_incompatible[MDL_TYPE_END];
+  static const int64 m_unobtrusive_lock_increment[MDL_TYPE_END];
 
 public:
   /** Members for linking the object into the list of unused objects. */
@@ -789,12 +862,19 @@ MDL_map_partition::~MDL_map_partition()
   Find MDL_lock object corresponding to the key, create it
   if it does not exist.
 
+  @param mdl_key            Key of the object to be locked.
+  @param type               Type of the lock requested.
+  @param fast_path [in/out] In: TRUE if the lock may be granted on the
+                            fast path. Out: TRUE if it has been granted.
+
   @retval non-NULL - Success. MDL_lock instance for the key with
-                     locked MDL_lock::m_rwlock.
+                     locked MDL_lock::m_rwlock, unless the lock has
+                     been granted on the fast path.
   @retval NULL     - Failure (OOM).
 */
 
-MDL_lock* MDL_map::find_or_insert(const MDL_key *mdl_key)
+MDL_lock* MDL_map::find_or_insert(const MDL_key *mdl_key, enum_mdl_type type,
+                                  bool *fast_path)
 {
   MDL_lock *lock;
 
@@ -815,6 +895,11 @@ MDL_lock* MDL_map::find_or_insert(const MDL_key *mdl_key)
     lock= (mdl_key->mdl_namespace() == MDL_key::GLOBAL) ? m_global_lock :
                                                           m_commit_lock;
 
+    /* These objects are never removed, so no m_mutex is needed. */
+    if (*fast_path && lock->fast_path_acquire(type))
+      return lock;
+    *fast_path= FALSE;
+
     mysql_prlock_wrlock(&lock->m_rwlock);
 
     return lock;
@@ -824,7 +909,7 @@ MDL_lock* MDL_map::find_or_insert(const MDL_key *mdl_key)
   uint part_id= hash_value % mdl_locks_hash_partitions;
   MDL_map_partition *part= m_partitions.at(part_id);
 
-  return part->find_or_insert(mdl_key, hash_value);
+  return part->find_or_insert(mdl_key, hash_value, type, fast_path);
 }
 
 
@@ -832,13 +917,18 @@ MDL_lock* MDL_map::find_or_insert(const MDL_key *mdl_key)
   Find MDL_lock object corresponding to the key and hash value in
   MDL_map partition, create it if it does not exist.
 
+  @sa MDL_map::find_or_insert() for description of parameters.
+
   @retval non-NULL - Success. MDL_lock instance for the key with
-                     locked MDL_lock::m_rwlock.
+                     locked MDL_lock::m_rwlock, unless the lock has
+                     been granted on the fast path.
   @retval NULL     - Failure (OOM).
 */
 
 MDL_lock* MDL_map_partition::find_or_insert(const MDL_key *mdl_key,
-                                            my_hash_value_type hash_value)
+                                            my_hash_value_type hash_value,
+                                            enum_mdl_type type,
+                                            bool *fast_path)
 {
   MDL_lock *lock;
 
@@ -896,6 +986,17 @@ retry:
     }
   }
 
+  /*
+    Granting the lock on the fast path under m_mutex ensures that the
+    object can't be concurrently removed from the hash or re-used.
+  */
+  if (*fast_path && lock->fast_path_acquire(type))
+  {
+    mysql_mutex_unlock(&m_mutex);
+    return lock;
+  }
+  *fast_path= FALSE;
+
   if (move_from_hash_to_lock_mutex(lock))
     goto retry;
 
@@ -1008,6 +1109,17 @@ void MDL_map::remove(MDL_lock *lock)
 void MDL_map_partition::remove(MDL_lock *lock)
 {
   mysql_mutex_lock(&m_mutex);
+  if (lock->fast_path_lock_count())
+  {
+    /*
+      Someone has been granted a lock on the fast path after we checked
+      that the object is empty. It is still in use and will be removed
+      by whoever releases the last lock on it.
+    */
+    mysql_mutex_unlock(&m_mutex);
+    mysql_prlock_unlock(&lock->m_rwlock);
+    return;
+  }
   my_hash_delete(&m_locks, (uchar*) lock);
   /*
     To let threads holding references to the MDL_lock object know that it was
@@ -1080,6 +1192,7 @@ MDL_context::MDL_context()
   :
   m_owner(NULL),
   m_needs_thr_lock_abort(FALSE),
+  m_fast_path_tickets(0),
   m_waiting_for(NULL)
 {
   mysql_prlock_init(key_MDL_context_LOCK_waiting_for, &m_LOCK_waiting_for);
@@ -1103,6 +1216,7 @@ void MDL_context::destroy()
   DBUG_ASSERT(m_tickets[MDL_STATEMENT].is_empty());
   DBUG_ASSERT(m_tickets[MDL_TRANSACTION].is_empty());
   DBUG_ASSERT(m_tickets[MDL_EXPLICIT].is_empty());
+  DBUG_ASSERT(m_fast_path_tickets == 0);
 
   mysql_prlock_destroy(&m_LOCK_waiting_for);
 }
@@ -1617,6 +1731,18 @@ const MDL_lock::bitmap_t MDL_scoped_lock::m_waiting_incompatible[MDL_TYPE_END] =
 };
 
 
+/**
+  Increments of MDL_lock::m_fast_path_state for scoped lock types
+  which can be granted on the fast path. Only IX locks, which are
+  acquired by every statement changing data, are such.
+*/
+
+const int64 MDL_scoped_lock::m_unobtrusive_lock_increment[MDL_TYPE_END] =
+{
+  1, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+
 /**
   Compatibility (or rather "incompatibility") matrices for per-object
   metadata lock. Arrays of bitmaps which elements specify which granted/
@@ -1711,6 +1837,21 @@ MDL_object_lock::m_waiting_incompatible[MDL_TYPE_END] =
 };
 
 
+/**
+  Increments of MDL_lock::m_fast_path_state for per-object lock types
+  which can be granted on the fast path. SR and SW locks, which are
+  acquired by DML statements, are only incompatible with SNW, SNRW and
+  X locks, so they can be granted by simply incrementing a counter as
+  long as none of these "obtrusive" locks is granted or waiting.
+*/
+
+const int64
+MDL_object_lock::m_unobtrusive_lock_increment[MDL_TYPE_END] =
+{
+  0, 0, 0, 1, 1LL << 20, 0, 0, 0, 0
+};
+
+
 /**
   Check if request for the metadata lock can be satisfied given its
   current state.
@@ -1745,7 +1886,14 @@ MDL_lock::can_grant_lock(enum_mdl_type type_arg,
   */
   if (ignore_lock_priority || !(m_waiting.bitmap() & waiting_incompat_map))
   {
-    if (! (m_granted.bitmap() & granted_incompat_map))
+    /*
+      Locks granted on the fast path never belong to the requestor, as
+      it moves them to m_granted before any request which might conflict
+      with them, see MDL_context::materialize_fast_path_locks().
+    */
+    if (fast_path_granted_bitmap() & granted_incompat_map)
+      can_grant= FALSE;
+    else if (! (m_granted.bitmap() & granted_incompat_map))
       can_grant= TRUE;
     else
     {
@@ -1773,6 +1921,7 @@ void MDL_lock::remove_ticket(Ticket_list MDL_lock::*list, MDL_ticket *ticket)
 {
   mysql_prlock_wrlock(&m_rwlock);
   (this->*list).remove_ticket(ticket);
+  update_has_obtrusive(0);
   if (is_empty())
     mdl_locks.remove(this);
   else
@@ -1819,6 +1968,122 @@ bool MDL_lock::has_pending_conflicting_lock(enum_mdl_type type)
 }
 
 
+/**
+  Try to grant lock on the fast path, i.e. without write-locking m_rwlock
+  and without adding the ticket to m_granted, by atomically incrementing
+  the counter for the lock type in m_fast_path_state.
+
+  @note For MDL_lock objects which can be removed from MDL_map this must
+        be called under MDL_map_partition::m_mutex protection, so that
+        MDL_map_partition::remove() can't miss the new lock.
+
+  @retval TRUE   Lock has been granted.
+  @retval FALSE  Lock of this type can't be granted on the fast path or
+                 some obtrusive lock is granted or waiting.
+*/
+
+bool MDL_lock::fast_path_acquire(enum_mdl_type type)
+{
+  int64 increment= unobtrusive_lock_increments()[type];
+  int64 old_state;
+
+  if (increment == 0)
+    return FALSE;
+
+  old_state= my_atomic_load64(&m_fast_path_state);
+  do
+  {
+    if (old_state & HAS_OBTRUSIVE)
+      return FALSE;
+    DBUG_ASSERT(((old_state / increment) & FAST_PATH_COUNTER_MASK) !=
+                FAST_PATH_COUNTER_MASK);
+  } while (! my_atomic_cas64(&m_fast_path_state, &old_state,
+                              old_state + increment));
+  return TRUE;
+}
+
+
+/**
+  Release lock which was granted on the fast path.
+
+  Usually this is a simple atomic decrement. But m_rwlock has to be
+  taken if there is an obtrusive lock waiting, which might be granted
+  now, or if this is the last reference to a lock object which should
+  be removed from MDL_map then.
+*/
+
+void MDL_lock::fast_path_release(enum_mdl_type type)
+{
+  int64 increment= unobtrusive_lock_increments()[type];
+  int64 old_state= my_atomic_load64(&m_fast_path_state);
+
+  DBUG_ASSERT(increment != 0);
+
+  do
+  {
+    if ((old_state & HAS_OBTRUSIVE) ||
+        (m_map_part && (old_state & FAST_PATH_COUNTERS_MASK) == increment))
+    {
+      mysql_prlock_wrlock(&m_rwlock);
+      my_atomic_add64(&m_fast_path_state, -increment);
+      if (is_empty())
+        mdl_locks.remove(this);
+      else
+      {
+        reschedule_waiters();
+        mysql_prlock_unlock(&m_rwlock);
+      }
+      return;
+    }
+  } while (! my_atomic_cas64(&m_fast_path_state, &old_state,
+                              old_state - increment));
+}
+
+
+/**
+  Set or clear the HAS_OBTRUSIVE bit of m_fast_path_state according to
+  types of tickets in m_granted and m_waiting lists.
+
+  @param pending_type_bit  Bit for the type of request which is being
+                           processed and is not in any list yet, or 0.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::update_has_obtrusive(bitmap_t pending_type_bit)
+{
+  bool has_obtrusive= (m_granted.bitmap() | m_waiting.bitmap() |
+                       pending_type_bit) & obtrusive_lock_types_bitmap();
+  bool had_obtrusive= my_atomic_load64(&m_fast_path_state) & HAS_OBTRUSIVE;
+
+  mysql_prlock_assert_write_owner(&m_rwlock);
+
+  if (has_obtrusive && ! had_obtrusive)
+    my_atomic_add64(&m_fast_path_state, HAS_OBTRUSIVE);
+  else if (! has_obtrusive && had_obtrusive)
+    my_atomic_add64(&m_fast_path_state, -HAS_OBTRUSIVE);
+}
+
+
+/**
+  Get bitmap of types of locks which are currently granted on the fast path.
+*/
+
+MDL_lock::bitmap_t MDL_lock::fast_path_granted_bitmap() const
+{
+  const int64 *increments= unobtrusive_lock_increments();
+  int64 counters= fast_path_lock_count();
+  bitmap_t result= 0;
+
+  for (uint i= 0; counters && i < MDL_TYPE_END; i++)
+  {
+    if (counters & (increments[i] * FAST_PATH_COUNTER_MASK))
+      result|= MDL_BIT(i);
+  }
+  return result;
+}
+
+
 MDL_wait_for_graph_visitor::~MDL_wait_for_graph_visitor()
 {
 }
@@ -1945,6 +2210,7 @@ MDL_context::try_acquire_lock(MDL_request *mdl_request)
       is no need to release it.
     */
     DBUG_ASSERT(! ticket->m_lock->is_empty());
+    ticket->m_lock->update_has_obtrusive(0);
     mysql_prlock_unlock(&ticket->m_lock->m_rwlock);
     MDL_ticket::destroy(ticket);
   }
@@ -1977,6 +2243,7 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
   MDL_key *key= &mdl_request->key;
   MDL_ticket *ticket;
   enum_mdl_duration found_duration;
+  bool fast_path;
 
   DBUG_ASSERT(mdl_request->type != MDL_EXCLUSIVE ||
               is_lock_owner(MDL_key::GLOBAL, "", "", MDL_INTENTION_EXCLUSIVE));
@@ -2030,8 +2297,26 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
                                    )))
     return TRUE;
 
-  /* The below call implicitly locks MDL_lock::m_rwlock on success. */
-  if (!(lock= mdl_locks.find_or_insert(key)))
+  /*
+    Our own locks granted on the fast path are not in MDL_lock::m_granted
+    lists, so can_grant_lock() would treat them as locks of some other
+    context. Move them there before requesting a lock of type which can
+    conflict with them, i.e. of any type which is never granted on the
+    fast path.
+  */
+  if (m_fast_path_tickets &&
+      mdl_request->type != MDL_INTENTION_EXCLUSIVE &&
+      mdl_request->type != MDL_SHARED_READ &&
+      mdl_request->type != MDL_SHARED_WRITE)
+    materialize_fast_path_locks();
+
+  fast_path= can_use_fast_path();
+
+  /*
+    The below call implicitly locks MDL_lock::m_rwlock on success,
+    unless the lock is granted on the fast path.
+  */
+  if (!(lock= mdl_locks.find_or_insert(key, mdl_request->type, &fast_path)))
   {
     MDL_ticket::destroy(ticket);
     return TRUE;
@@ -2039,18 +2324,34 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
 
   ticket->m_lock= lock;
 
-  if (lock->can_grant_lock(mdl_request->type, this, false))
+  if (fast_path)
   {
+    ticket->m_is_fast_path= TRUE;
+    m_fast_path_tickets++;
+  }
+  else
+  {
+    /*
+      Disable the fast path before checking for conflicts with locks
+      granted on it if the request is obtrusive, so that the set of
+      such locks can only shrink while the request is pending.
+    */
+    lock->update_has_obtrusive(MDL_BIT(mdl_request->type));
+
+    if (! lock->can_grant_lock(mdl_request->type, this, false))
+    {
+      *out_ticket= ticket;
+      return FALSE;
+    }
+
     lock->m_granted.add_ticket(ticket);
 
     mysql_prlock_unlock(&lock->m_rwlock);
+  }
 
-    m_tickets[mdl_request->duration].push_front(ticket);
+  m_tickets[mdl_request->duration].push_front(ticket);
 
-    mdl_request->ticket= ticket;
-  }
-  else
-    *out_ticket= ticket;
+  mdl_request->ticket= ticket;
 
   return FALSE;
 }
@@ -2426,6 +2727,9 @@ MDL_context::upgrade_shared_lock(MDL_ticket *mdl_ticket,
   if (mdl_ticket->has_stronger_or_equal_type(new_type))
     DBUG_RETURN(FALSE);
 
+  /* The merge below needs the ticket to be in MDL_lock::m_granted. */
+  materialize_fast_path_locks();
+
   mdl_xlock_request.init(&mdl_ticket->m_lock->key, new_type,
                          MDL_TRANSACTION);
 
@@ -2727,7 +3031,13 @@ void MDL_context::release_lock(enum_mdl_duration duration, MDL_ticket *ticket)
   DBUG_ASSERT(this == ticket->get_ctx());
   mysql_mutex_assert_not_owner(&LOCK_open);
 
-  lock->remove_ticket(&MDL_lock::m_granted, ticket);
+  if (ticket->m_is_fast_path)
+  {
+    lock->fast_path_release(ticket->m_type);
+    m_fast_path_tickets--;
+  }
+  else
+    lock->remove_ticket(&MDL_lock::m_granted, ticket);
 
   m_tickets[duration].remove(ticket);
   MDL_ticket::destroy(ticket);
@@ -2736,6 +3046,42 @@ void MDL_context::release_lock(enum_mdl_duration duration, MDL_ticket *ticket)
 }
 
 
+/**
+  Move tickets of this context which were granted on the fast path to
+  MDL_lock::m_granted lists, where they are visible to the deadlock
+  detector, to notify_conflicting_locks() and to can_grant_lock().
+*/
+
+void MDL_context::materialize_fast_path_locks()
+{
+  if (m_fast_path_tickets == 0)
+    return;
+
+  for (int i= 0; i < MDL_DURATION_END; i++)
+  {
+    Ticket_iterator it(m_tickets[i]);
+    MDL_ticket *ticket;
+
+    while ((ticket= it++))
+    {
+      if (! ticket->m_is_fast_path)
+        continue;
+
+      MDL_lock *lock= ticket->m_lock;
+      mysql_prlock_wrlock(&lock->m_rwlock);
+      lock->m_granted.add_ticket(ticket);
+      my_atomic_add64(&lock->m_fast_path_state,
+                      -lock->unobtrusive_lock_increments()[ticket->m_type]);
+      mysql_prlock_unlock(&lock->m_rwlock);
+
+      ticket->m_is_fast_path= FALSE;
+      m_fast_path_tickets--;
+    }
+  }
+  DBUG_ASSERT(m_fast_path_tickets == 0);
+}
+
+
 /**
   Release lock with explicit duration.
 
@@ -2842,6 +3188,7 @@ void MDL_ticket::downgrade_lock(enum_mdl_type type)
   m_lock->m_granted.remove_ticket(this);
   m_type= type;
   m_lock->m_granted.add_ticket(this);
+  m_lock->update_has_obtrusive(0);
   m_lock->reschedule_waiters();
   mysql_prlock_unlock(&m_lock->m_rwlock);
 }
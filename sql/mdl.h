@@ -114,6 +114,14 @@ public:
    */
   virtual bool notify_shared_lock(MDL_context_owner *in_use,
                                   bool needs_thr_lock_abort) = 0;
+
+  /**
+     Does the owner need notify_shared_lock() to be called for it even
+     when it holds only SR, SW or scoped IX locks? Such locks of other
+     owners are granted on the fast path and are invisible to the code
+     which sends notifications.
+   */
+  virtual bool needs_shared_lock_notification() = 0;
 };
 
 /**
@@ -612,7 +620,8 @@ private:
      m_duration(duration_arg),
 #endif
      m_ctx(ctx_arg),
-     m_lock(NULL)
+     m_lock(NULL),
+     m_is_fast_path(FALSE)
   {}
 
   static MDL_ticket *create(MDL_context *ctx_arg, enum_mdl_type type_arg
@@ -641,6 +650,13 @@ private:
   */
   MDL_lock *m_lock;
 
+  /**
+    TRUE if the lock was granted on the fast path, i.e. it is accounted
+    for in the counters of MDL_lock instead of the MDL_lock::m_granted
+    list. Context private.
+  */
+  bool m_is_fast_path;
+
 private:
   MDL_ticket(const MDL_ticket &);               /* not implemented */
   MDL_ticket &operator=(const MDL_ticket &);    /* not implemented */
@@ -803,6 +819,9 @@ public:
             will see the new value eventually.
     */
     m_needs_thr_lock_abort= needs_thr_lock_abort;
+    /* Locks of such a context have to be visible to notifications. */
+    if (needs_thr_lock_abort)
+      materialize_fast_path_locks();
   }
   bool get_needs_thr_lock_abort() const
   {
@@ -881,6 +900,10 @@ private:
     FALSE - Otherwise.
   */
   bool m_needs_thr_lock_abort;
+  /**
+    Number of tickets in this context which were granted on the fast path.
+  */
+  uint m_fast_path_tickets;
 
   /**
     Read-write lock protecting m_waiting_for member.
@@ -906,6 +929,12 @@ private:
   void release_lock(enum_mdl_duration duration, MDL_ticket *ticket);
   bool try_acquire_lock_impl(MDL_request *mdl_request,
                              MDL_ticket **out_ticket);
+  bool can_use_fast_path() const
+  {
+    return ! m_needs_thr_lock_abort &&
+           ! m_owner->needs_shared_lock_notification();
+  }
+  void materialize_fast_path_locks();
 
 public:
   void find_deadlock();
@@ -915,6 +944,12 @@ public:
   /** Inform the deadlock detector there is an edge in the wait-for graph. */
   void will_wait_for(MDL_wait_for_subgraph *waiting_for_arg)
   {
+    /*
+      Locks granted on the fast path are invisible to the deadlock
+      detector, so they have to be moved to MDL_lock::m_granted lists
+      before we become a node of the wait-for graph.
+    */
+    materialize_fast_path_locks();
     mysql_prlock_wrlock(&m_LOCK_waiting_for);
     m_waiting_for=  waiting_for_arg;
     mysql_prlock_unlock(&m_LOCK_waiting_for);
@@ -26,6 +26,7 @@
 #include "unireg.h"
 #include <signal.h>
 #include "sql_parse.h"    // test_if_data_home_dir
+#include "sql_throttle.h" // throttle_queue_wait_status
 #include "sql_cache.h"    // query_cache, query_cache_*
 #include "sql_locale.h"   // MY_LOCALES, my_locales, my_locale_by_name
 #include "sql_show.h"     // free_status_vars, add_status_vars,
@@ -520,6 +521,8 @@ uint  slave_net_timeout;
 ulong slave_exec_mode_options;
 ulonglong slave_type_conversions_options;
 ulong opt_mts_slave_parallel_workers;
+ulong opt_mts_parallel_type;
+my_bool opt_slave_preserve_commit_order;
 ulonglong opt_mts_pending_jobs_size_max;
 ulonglong slave_rows_search_algorithms_options;
 #ifndef DBUG_OFF
@@ -557,6 +560,8 @@ uint opt_write_query_throttling_limit= 0;
 int32 write_query_running= 0;
 ulonglong read_queries= 0, write_queries= 0;
 ulonglong total_query_rejected= 0, write_query_rejected= 0;
+uint opt_query_throttling_queue_size= 0;
+ulong opt_query_throttling_queue_timeout= 1000;
 
 Error_log_throttle err_log_throttle(Log_throttle::LOG_THROTTLE_WINDOW_SIZE,
                                     sql_print_error,
@@ -752,6 +757,8 @@ mysql_mutex_t LOCK_prepared_stmt_count;
 mysql_mutex_t LOCK_sql_slave_skip_counter;
 mysql_mutex_t LOCK_slave_net_timeout;
 mysql_mutex_t LOCK_log_throttle_qni;
+mysql_mutex_t LOCK_throttle_queue;
+mysql_cond_t COND_throttle_queue;
 #ifdef HAVE_OPENSSL
 mysql_mutex_t LOCK_des_key_file;
 #endif
@@ -2007,6 +2014,8 @@ static void clean_up_mutexes()
   mysql_mutex_destroy(&LOCK_thread_created);
   mysql_mutex_destroy(&LOCK_thread_count);
   mysql_mutex_destroy(&LOCK_log_throttle_qni);
+  mysql_mutex_destroy(&LOCK_throttle_queue);
+  mysql_cond_destroy(&COND_throttle_queue);
   mysql_mutex_destroy(&LOCK_status);
   mysql_mutex_destroy(&LOCK_delayed_insert);
   mysql_mutex_destroy(&LOCK_delayed_status);
@@ -4241,6 +4250,9 @@ static int init_thread_environment()
                    &LOCK_connection_count, MY_MUTEX_INIT_FAST);
   mysql_mutex_init(key_LOCK_log_throttle_qni,
                    &LOCK_log_throttle_qni, MY_MUTEX_INIT_FAST);
+  mysql_mutex_init(key_LOCK_throttle_queue,
+                   &LOCK_throttle_queue, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_throttle_queue, &COND_throttle_queue, NULL);
 #ifdef HAVE_OPENSSL
   mysql_mutex_init(key_LOCK_des_key_file,
                    &LOCK_des_key_file, MY_MUTEX_INIT_FAST);
@@ -7532,6 +7544,13 @@ static int show_open_tables(THD *thd, SHOW_VAR *var, char *buff)
   return 0;
 }
 
+static int show_table_cache_instances(THD *thd, SHOW_VAR *var, char *buff)
+{
+  var->type= SHOW_ARRAY;
+  var->value= (char*) table_cache_manager.status_vars();
+  return 0;
+}
+
 static int show_prepared_stmt_count(THD *thd, SHOW_VAR *var, char *buff)
 {
   var->type= SHOW_LONG;
@@ -7924,6 +7943,26 @@ SHOW_VAR status_vars[]= {
   {"Binlog_cache_use",         (char*) &binlog_cache_use,       SHOW_LONG},
   {"Binlog_stmt_cache_disk_use",(char*) &binlog_stmt_cache_disk_use,  SHOW_LONG},
   {"Binlog_stmt_cache_use",    (char*) &binlog_stmt_cache_use,       SHOW_LONG},
+  {"Binlog_commit_stage_groups", (char*) &binlog_stage_groups[Stage_manager::COMMIT_STAGE], SHOW_LONGLONG},
+  {"Binlog_commit_stage_leader_wait_time", (char*) &binlog_stage_leader_wait_time[Stage_manager::COMMIT_STAGE], SHOW_LONGLONG},
+  {"Binlog_commit_stage_trx",  (char*) &binlog_stage_trx[Stage_manager::COMMIT_STAGE], SHOW_LONGLONG},
+#ifdef HAVE_REPLICATION
+  {"Binlog_dump_cache_hits",   (char*) &binlog_dump_cache_hits, SHOW_LONGLONG},
+  {"Binlog_dump_cache_misses", (char*) &binlog_dump_cache_misses, SHOW_LONGLONG},
+#endif
+  {"Binlog_flush_stage_groups", (char*) &binlog_stage_groups[Stage_manager::FLUSH_STAGE], SHOW_LONGLONG},
+  {"Binlog_flush_stage_leader_wait_time", (char*) &binlog_stage_leader_wait_time[Stage_manager::FLUSH_STAGE], SHOW_LONGLONG},
+  {"Binlog_flush_stage_trx",   (char*) &binlog_stage_trx[Stage_manager::FLUSH_STAGE], SHOW_LONGLONG},
+  {"Binlog_group_commit_delay_time", (char*) &binlog_group_commit_delay_time, SHOW_LONGLONG},
+  {"Binlog_group_commit_fsync_time", (char*) &binlog_group_commit_fsync_time, SHOW_LONGLONG},
+  {"Binlog_group_commit_fsyncs", (char*) &binlog_group_commit_fsyncs, SHOW_LONGLONG},
+  {"Binlog_payload_compressed_bytes", (char*) &binlog_payload_compressed_bytes, SHOW_LONGLONG},
+  {"Binlog_payload_uncompressed_bytes", (char*) &binlog_payload_uncompressed_bytes, SHOW_LONGLONG},
+  {"Binlog_sync_stage_groups", (char*) &binlog_stage_groups[Stage_manager::SYNC_STAGE], SHOW_LONGLONG},
+  {"Binlog_sync_stage_leader_wait_time", (char*) &binlog_stage_leader_wait_time[Stage_manager::SYNC_STAGE], SHOW_LONGLONG},
+  {"Binlog_sync_stage_trx",    (char*) &binlog_stage_trx[Stage_manager::SYNC_STAGE], SHOW_LONGLONG},
+  {"Binlog_writeset_conflicts", (char*) &binlog_writeset_conflicts, SHOW_LONGLONG},
+  {"Binlog_writeset_unsafe_trx", (char*) &binlog_writeset_unsafe_trx, SHOW_LONGLONG},
   {"Bytes_received",           (char*) offsetof(STATUS_VAR, bytes_received), SHOW_LONGLONG_STATUS},
   {"Bytes_sent",               (char*) offsetof(STATUS_VAR, bytes_sent), SHOW_LONGLONG_STATUS},
   {"Com",                      (char*) com_status_vars, SHOW_ARRAY},
@@ -7982,6 +8021,8 @@ SHOW_VAR status_vars[]= {
   {"Opened_tables",            (char*) offsetof(STATUS_VAR, opened_tables), SHOW_LONGLONG_STATUS},
   {"Opened_table_definitions", (char*) offsetof(STATUS_VAR, opened_shares), SHOW_LONGLONG_STATUS},
   {"Prepared_stmt_count",      (char*) &show_prepared_stmt_count, SHOW_FUNC},
+  {"Prepared_stmt_plan_cache_hits", (char*) offsetof(STATUS_VAR, ps_plan_cache_hits), SHOW_LONGLONG_STATUS},
+  {"Prepared_stmt_plan_cache_misses", (char*) offsetof(STATUS_VAR, ps_plan_cache_misses), SHOW_LONGLONG_STATUS},
 #ifdef HAVE_QUERY_CACHE
   {"Qcache_free_blocks",       (char*) &query_cache.free_memory_blocks, SHOW_LONG_NOFLUSH},
   {"Qcache_free_memory",       (char*) &query_cache.free_memory, SHOW_LONG_NOFLUSH},
@@ -7993,6 +8034,8 @@ SHOW_VAR status_vars[]= {
   {"Qcache_total_blocks",      (char*) &query_cache.total_blocks, SHOW_LONG_NOFLUSH},
 #endif /*HAVE_QUERY_CACHE*/
   {"Queries",                  (char*) &show_queries,            SHOW_FUNC},
+  {"Query_template_cache_hits", (char*) offsetof(STATUS_VAR, query_template_cache_hits), SHOW_LONGLONG_STATUS},
+  {"Query_template_cache_misses", (char*) offsetof(STATUS_VAR, query_template_cache_misses), SHOW_LONGLONG_STATUS},
   {"Questions",                (char*) offsetof(STATUS_VAR, questions), SHOW_LONGLONG_STATUS},
   {"Read_queries",             (char*) &read_queries,        SHOW_LONG},
   {"Select_full_join",         (char*) offsetof(STATUS_VAR, select_full_join_count), SHOW_LONGLONG_STATUS},
@@ -8002,10 +8045,13 @@ SHOW_VAR status_vars[]= {
   {"Select_scan",	       (char*) offsetof(STATUS_VAR, select_scan_count), SHOW_LONGLONG_STATUS},
   {"Slave_open_temp_tables",   (char*) &slave_open_temp_tables, SHOW_INT},
 #ifdef HAVE_REPLICATION
+  {"Slave_commit_group_parallel", (char*) &mts_commit_group_parallel, SHOW_LONGLONG},
+  {"Slave_commit_group_waits", (char*) &mts_commit_group_waits, SHOW_LONGLONG},
   {"Slave_retried_transactions",(char*) &show_slave_retried_trans, SHOW_FUNC},
   {"Slave_heartbeat_period",   (char*) &show_heartbeat_period, SHOW_FUNC},
   {"Slave_received_heartbeats",(char*) &show_slave_received_heartbeats, SHOW_FUNC},
   {"Slave_last_heartbeat",     (char*) &show_slave_last_heartbeat, SHOW_FUNC},
+  {"Slave_relay_log_pipeline_events", (char*) &relay_log_pipeline_events, SHOW_LONGLONG},
 #ifndef DBUG_OFF
   {"Slave_rows_last_search_algorithm_used",(char*) &show_slave_rows_last_search_algorithm_used, SHOW_FUNC},
 #endif
@@ -8015,6 +8061,7 @@ SHOW_VAR status_vars[]= {
   {"Slow_queries",             (char*) offsetof(STATUS_VAR, long_query_count), SHOW_LONGLONG_STATUS},
   {"Sort_merge_passes",        (char*) offsetof(STATUS_VAR, filesort_merge_passes), SHOW_LONGLONG_STATUS},
   {"Sort_range",               (char*) offsetof(STATUS_VAR, filesort_range_count), SHOW_LONGLONG_STATUS},
+  {"Sort_parallel",            (char*) offsetof(STATUS_VAR, filesort_parallel_count), SHOW_LONGLONG_STATUS},
   {"Sort_rows",                (char*) offsetof(STATUS_VAR, filesort_rows), SHOW_LONGLONG_STATUS},
   {"Sort_scan",                (char*) offsetof(STATUS_VAR, filesort_scan_count), SHOW_LONGLONG_STATUS},
 #ifdef HAVE_OPENSSL
@@ -8051,6 +8098,7 @@ SHOW_VAR status_vars[]= {
 #endif
 #endif
 #endif /* HAVE_OPENSSL */
+  {"Table_cache_instance",     (char*) &show_table_cache_instances, SHOW_FUNC},
   {"Table_locks_immediate",    (char*) &locks_immediate,        SHOW_LONG},
   {"Table_locks_waited",       (char*) &locks_waited,           SHOW_LONG},
   {"Table_open_cache_hits",    (char*) offsetof(STATUS_VAR, table_open_cache_hits), SHOW_LONGLONG_STATUS},
@@ -8065,6 +8113,10 @@ SHOW_VAR status_vars[]= {
   {"Threads_connected",        (char*) &connection_count,       SHOW_INT},
   {"Threads_created",        (char*) &thread_created,   SHOW_LONG_NOFLUSH},
   {"Threads_running",          (char*) &num_thread_running,     SHOW_INT},
+  {"Throttled_queries_admitted", (char*) &throttle_queue_admitted, SHOW_LONGLONG},
+  {"Throttled_queries_queued", (char*) &throttle_queue_waiting,  SHOW_INT},
+  {"Throttled_queries_timed_out", (char*) &throttle_queue_timed_out, SHOW_LONGLONG},
+  {"Throttled_queries_wait",   (char*) throttle_queue_wait_status, SHOW_ARRAY},
   {"Total_queries_rejected",   (char*) &total_query_rejected,   SHOW_LONG},
   {"Uptime",                   (char*) &show_starttime,         SHOW_FUNC},
 #ifdef ENABLED_PROFILING
@@ -9437,9 +9489,10 @@ PSI_mutex_key
   key_mutex_slave_parallel_pend_jobs, key_mutex_mts_temp_tables_lock,
   key_mutex_slave_parallel_worker_count,
   key_mutex_slave_parallel_worker,
+  key_mutex_slave_parallel_commit_order,
   key_structure_guard_mutex, key_TABLE_SHARE_LOCK_ha_data,
   key_LOCK_error_messages, key_LOG_INFO_lock, key_LOCK_thread_count,
-  key_LOCK_log_throttle_qni;
+  key_LOCK_log_throttle_qni, key_LOCK_throttle_queue;
 PSI_mutex_key key_LOCK_thd_remove;
 PSI_mutex_key key_RELAYLOG_LOCK_commit;
 PSI_mutex_key key_RELAYLOG_LOCK_commit_queue;
@@ -9525,6 +9578,7 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_mutex_slave_parallel_worker_count, "Relay_log_info::exit_count_lock", 0},
   { &key_mutex_mts_temp_tables_lock, "Relay_log_info::temp_tables_lock", 0},
   { &key_mutex_slave_parallel_worker, "Worker_info::jobs_lock", 0},
+  { &key_mutex_slave_parallel_commit_order, "Relay_log_info::mts_commit_order_lock", 0},
   { &key_structure_guard_mutex, "Query_cache::structure_guard_mutex", 0},
   { &key_TABLE_SHARE_LOCK_ha_data, "TABLE_SHARE::LOCK_ha_data", 0},
   { &key_LOCK_error_messages, "LOCK_error_messages", PSI_FLAG_GLOBAL},
@@ -9532,6 +9586,7 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_LOCK_thread_count, "LOCK_thread_count", PSI_FLAG_GLOBAL},
   { &key_LOCK_thd_remove, "LOCK_thd_remove", PSI_FLAG_GLOBAL},
   { &key_LOCK_log_throttle_qni, "LOCK_log_throttle_qni", PSI_FLAG_GLOBAL},
+  { &key_LOCK_throttle_queue, "LOCK_throttle_queue", PSI_FLAG_GLOBAL},
   { &key_gtid_ensure_index_mutex, "Gtid_state", PSI_FLAG_GLOBAL},
   { &key_LOCK_thread_created, "LOCK_thread_created", PSI_FLAG_GLOBAL },
 #ifdef HAVE_MY_TIMER
@@ -9585,9 +9640,10 @@ PSI_cond_key key_BINLOG_update_cond,
   key_relay_log_info_data_cond, key_relay_log_info_log_space_cond,
   key_relay_log_info_start_cond, key_relay_log_info_stop_cond,
   key_relay_log_info_sleep_cond, key_cond_slave_parallel_pend_jobs,
-  key_cond_slave_parallel_worker,
+  key_cond_slave_parallel_worker, key_cond_slave_parallel_commit_order,
   key_TABLE_SHARE_cond, key_user_level_lock_cond,
-  key_COND_thread_count, key_COND_thread_cache, key_COND_flush_thread_cache;
+  key_COND_thread_count, key_COND_thread_cache, key_COND_flush_thread_cache,
+  key_COND_throttle_queue;
 PSI_cond_key key_RELAYLOG_update_cond;
 PSI_cond_key key_BINLOG_COND_done;
 PSI_cond_key key_RELAYLOG_COND_done;
@@ -9628,11 +9684,13 @@ static PSI_cond_info all_server_conds[]=
   { &key_relay_log_info_sleep_cond, "Relay_log_info::sleep_cond", 0},
   { &key_cond_slave_parallel_pend_jobs, "Relay_log_info::pending_jobs_cond", 0},
   { &key_cond_slave_parallel_worker, "Worker_info::jobs_cond", 0},
+  { &key_cond_slave_parallel_commit_order, "Relay_log_info::mts_commit_order_cond", 0},
   { &key_TABLE_SHARE_cond, "TABLE_SHARE::cond", 0},
   { &key_user_level_lock_cond, "User_level_lock::cond", 0},
   { &key_COND_thread_count, "COND_thread_count", PSI_FLAG_GLOBAL},
   { &key_COND_thread_cache, "COND_thread_cache", PSI_FLAG_GLOBAL},
   { &key_COND_flush_thread_cache, "COND_flush_thread_cache", PSI_FLAG_GLOBAL},
+  { &key_COND_throttle_queue, "COND_throttle_queue", PSI_FLAG_GLOBAL},
   { &key_gtid_ensure_index_cond, "Gtid_state", PSI_FLAG_GLOBAL},
 #ifdef HAVE_MY_TIMER
   { &key_thread_timer_notifier, "thread_timer_notifier", PSI_FLAG_GLOBAL},
@@ -9641,7 +9699,8 @@ static PSI_cond_info all_server_conds[]=
 
 PSI_thread_key key_thread_bootstrap, key_thread_delayed_insert,
   key_thread_handle_manager, key_thread_main,
-  key_thread_one_connection, key_thread_signal_hand;
+  key_thread_one_connection, key_thread_signal_hand,
+  key_thread_filesort_worker;
 
 #ifdef HAVE_MY_TIMER
 PSI_thread_key key_thread_timer_notifier;
@@ -9670,7 +9729,8 @@ static PSI_thread_info all_server_threads[]=
   { &key_thread_handle_manager, "manager", PSI_FLAG_GLOBAL},
   { &key_thread_main, "main", PSI_FLAG_GLOBAL},
   { &key_thread_one_connection, "one_connection", 0},
-  { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL}
+  { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL},
+  { &key_thread_filesort_worker, "filesort_worker", 0}
 };
 
 #ifdef HAVE_MMAP
@@ -9821,11 +9881,13 @@ PSI_stage_info stage_waiting_for_the_next_event_in_relay_log= { 0, "Waiting for
 PSI_stage_info stage_waiting_for_the_slave_thread_to_advance_position= { 0, "Waiting for the slave SQL thread to advance position", 0};
 PSI_stage_info stage_waiting_to_finalize_termination= { 0, "Waiting to finalize termination", 0};
 PSI_stage_info stage_waiting_to_get_readlock= { 0, "Waiting to get readlock", 0};
+PSI_stage_info stage_waiting_for_query_admission= { 0, "Waiting for query admission", 0};
 PSI_stage_info stage_slave_waiting_workers_to_exit= { 0, "Waiting for workers to exit", 0};
 PSI_stage_info stage_slave_waiting_worker_to_release_partition= { 0, "Waiting for Slave Worker to release partition", 0};
 PSI_stage_info stage_slave_waiting_worker_to_free_events= { 0, "Waiting for Slave Workers to free pending events", 0};
 PSI_stage_info stage_slave_waiting_worker_queue= { 0, "Waiting for Slave Worker queue", 0};
 PSI_stage_info stage_slave_waiting_event_from_coordinator= { 0, "Waiting for an event from Coordinator", 0};
+PSI_stage_info stage_slave_waiting_for_commit_order= { 0, "Waiting for preceding transaction to commit", 0};
 
 #ifdef HAVE_PSI_INTERFACE
 
@@ -9926,7 +9988,8 @@ PSI_stage_info *all_server_stages[]=
   & stage_waiting_for_the_next_event_in_relay_log,
   & stage_waiting_for_the_slave_thread_to_advance_position,
   & stage_waiting_to_finalize_termination,
-  & stage_waiting_to_get_readlock
+  & stage_waiting_to_get_readlock,
+  & stage_waiting_for_query_admission
 };
 
 PSI_socket_key key_socket_tcpip, key_socket_unix, key_socket_client_connection;
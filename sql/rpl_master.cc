@@ -30,6 +30,9 @@
 
 int max_binlog_dump_events = 0; // unlimited
 my_bool opt_sporadic_binlog_dump_fail = 0;
+ulonglong binlog_dump_cache_size;
+ulonglong binlog_dump_cache_hits= 0, binlog_dump_cache_misses= 0;
+Binlog_dump_cache binlog_dump_cache;
 
 #ifndef DBUG_OFF
 static int binlog_dump_count = 0;
@@ -75,18 +78,28 @@ extern "C" void slave_info_free(void *s)
 
 #ifdef HAVE_PSI_INTERFACE
 static PSI_mutex_key key_LOCK_slave_list;
+static PSI_rwlock_key key_rwlock_Binlog_dump_cache_lock;
 
 static PSI_mutex_info all_slave_list_mutexes[]=
 {
   { &key_LOCK_slave_list, "LOCK_slave_list", PSI_FLAG_GLOBAL}
 };
 
+static PSI_rwlock_info all_binlog_dump_cache_rwlocks[]=
+{
+  { &key_rwlock_Binlog_dump_cache_lock, "Binlog_dump_cache::lock",
+    PSI_FLAG_GLOBAL}
+};
+
 static void init_all_slave_list_mutexes(void)
 {
   int count;
 
   count= array_elements(all_slave_list_mutexes);
   mysql_mutex_register("sql", all_slave_list_mutexes, count);
+
+  count= array_elements(all_binlog_dump_cache_rwlocks);
+  mysql_rwlock_register("sql", all_binlog_dump_cache_rwlocks, count);
 }
 #endif /* HAVE_PSI_INTERFACE */
 
@@ -100,6 +113,7 @@ void init_slave_list()
                (my_hash_get_key) slave_list_key,
                (my_hash_free_key) slave_info_free, 0);
   mysql_mutex_init(key_LOCK_slave_list, &LOCK_slave_list, MY_MUTEX_INIT_FAST);
+  binlog_dump_cache.init();
 }
 
 void end_slave_list()
@@ -110,6 +124,161 @@ void end_slave_list()
     my_hash_free(&slave_list);
     mysql_mutex_destroy(&LOCK_slave_list);
   }
+  binlog_dump_cache.destroy();
+}
+
+
+void Binlog_dump_cache::init()
+{
+  mysql_rwlock_init(key_rwlock_Binlog_dump_cache_lock, &m_lock);
+  m_log_name[0]= 0;
+  m_end_pos= 0;
+  m_inited= true;
+}
+
+
+void Binlog_dump_cache::destroy()
+{
+  if (!m_inited)
+    return;
+  clear();
+  mysql_rwlock_destroy(&m_lock);
+  m_inited= false;
+}
+
+
+/* Drop all events. Called with the lock held for writing. */
+void Binlog_dump_cache::clear()
+{
+  for (std::deque<Event>::iterator it= m_events.begin();
+       it != m_events.end(); ++it)
+    my_free(it->data);
+  m_events.clear();
+  m_size= 0;
+  m_log_name[0]= 0;
+  m_end_pos= 0;
+}
+
+
+ulonglong Binlog_dump_cache::get_generation()
+{
+  mysql_rwlock_rdlock(&m_lock);
+  ulonglong generation= m_generation;
+  mysql_rwlock_unlock(&m_lock);
+  return generation;
+}
+
+
+void Binlog_dump_cache::invalidate()
+{
+  mysql_rwlock_wrlock(&m_lock);
+  clear();
+  m_generation++;
+  mysql_rwlock_unlock(&m_lock);
+}
+
+
+bool Binlog_dump_cache::event_pos_less(const Event &event, my_off_t pos)
+{
+  return event.pos < pos;
+}
+
+
+bool Binlog_dump_cache::read(const char *log_name, ulonglong generation,
+                             IO_CACHE *log, String *packet)
+{
+  my_off_t pos= my_b_tell(log);
+  my_off_t end_pos= 0;
+
+  if (binlog_dump_cache_size == 0)
+    return false;
+
+  mysql_rwlock_rdlock(&m_lock);
+  if (generation == m_generation && !m_events.empty() &&
+      pos >= m_events.front().pos && pos < m_end_pos &&
+      !strcmp(log_name, m_log_name))
+  {
+    std::deque<Event>::iterator it=
+      std::lower_bound(m_events.begin(), m_events.end(), pos,
+                       event_pos_less);
+    if (it != m_events.end() && it->pos == pos &&
+        !packet->append((const char*) it->data, it->len))
+      end_pos= pos + it->len;
+  }
+  mysql_rwlock_unlock(&m_lock);
+
+  if (!end_pos)
+  {
+    my_atomic_add64((longlong*) &binlog_dump_cache_misses, 1);
+    return false;
+  }
+  my_atomic_add64((longlong*) &binlog_dump_cache_hits, 1);
+  my_b_seek(log, end_pos);
+  return true;
+}
+
+
+/* Drop the oldest events above binlog_dump_cache_size. */
+void Binlog_dump_cache::trim()
+{
+  mysql_rwlock_wrlock(&m_lock);
+  while (m_size > binlog_dump_cache_size)
+  {
+    my_free(m_events.front().data);
+    m_size-= m_events.front().len;
+    m_events.pop_front();
+  }
+  if (m_events.empty())
+    clear();
+  mysql_rwlock_unlock(&m_lock);
+}
+
+
+void Binlog_dump_cache::add(const char *log_name, ulonglong generation,
+                            my_off_t pos, const char *event, ulong len)
+{
+  ulonglong max_size= binlog_dump_cache_size;
+  Event ev;
+
+  if (max_size == 0)
+    return;
+
+  mysql_rwlock_wrlock(&m_lock);
+  if (generation != m_generation)
+    goto end;
+
+  if (strcmp(log_name, m_log_name) || m_events.empty() || pos > m_end_pos)
+  {
+    /* A new binary log, or the cached events are behind this one. */
+    clear();
+    strmake(m_log_name, log_name, sizeof(m_log_name) - 1);
+  }
+  else if (pos < m_end_pos)
+    goto end;                                   // Already cached
+
+  if (len > max_size)
+  {
+    clear();
+    goto end;
+  }
+  while (m_size + len > max_size)
+  {
+    my_free(m_events.front().data);
+    m_size-= m_events.front().len;
+    m_events.pop_front();
+  }
+
+  if (!(ev.data= (uchar*) my_malloc(len, MYF(0))))
+    goto end;
+  memcpy(ev.data, event, len);
+  ev.pos= pos;
+  ev.len= len;
+  m_events.push_back(ev);
+  m_size+= len;
+  m_end_pos= pos + len;
+
+end:
+  mysql_rwlock_unlock(&m_lock);
 }
 
 /**
@@ -415,6 +584,30 @@ static int fake_rotate_event(NET* net, String* packet, char* log_file_name,
   DBUG_RETURN(0);
 }
 
+/**
+  Read the next event of a binary log into the transmit packet, and add
+  it to binlog_dump_cache if the binary log is the active one.
+
+  The arguments are those of Log_event::read_log_event().
+*/
+static int read_log_event_and_cache(IO_CACHE *log, String *packet,
+                                    mysql_mutex_t *log_lock,
+                                    uint8 checksum_alg,
+                                    const char *log_file_name,
+                                    bool *is_active_binlog,
+                                    ulonglong cache_generation)
+{
+  my_off_t pos= my_b_tell(log);
+  ulong ev_offset= packet->length();
+  int error= Log_event::read_log_event(log, packet, log_lock, checksum_alg,
+                                       log_file_name, is_active_binlog);
+  if (!error && *is_active_binlog)
+    binlog_dump_cache.add(log_file_name, cache_generation, pos,
+                          packet->ptr() + ev_offset,
+                          packet->length() - ev_offset);
+  return error;
+}
+
 /*
   Reset thread transmit packet buffer for event sending
 
@@ -872,6 +1065,7 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
   uint8 current_checksum_alg= BINLOG_CHECKSUM_ALG_UNDEF;
   Format_description_log_event fdle(BINLOG_VERSION), *p_fdle= &fdle;
   Gtid first_gtid;
+  ulonglong cache_generation= 0;
 
 #ifndef DBUG_OFF
   int left_events = max_binlog_dump_events;
@@ -1043,6 +1237,7 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
   thd->current_linfo = &linfo;
   mysql_mutex_unlock(&LOCK_thread_count);
 
+  cache_generation= binlog_dump_cache.get_generation();
   if ((file=open_binlog_file(&log, log_file_name, &errmsg)) < 0)
   {
     my_errno= ER_MASTER_FATAL_ERROR_READING_BINLOG;
@@ -1245,10 +1440,13 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
                     };);
     bool is_active_binlog= false;
     while (!thd->killed &&
-           !(error= Log_event::read_log_event(&log, packet, log_lock,
+           (binlog_dump_cache.read(log_file_name, cache_generation, &log,
+                                   packet) ||
+            !(error= read_log_event_and_cache(&log, packet, log_lock,
                                               current_checksum_alg,
                                               log_file_name,
-                                              &is_active_binlog)))
+                                              &is_active_binlog,
+                                              cache_generation))))
     {
       DBUG_EXECUTE_IF("simulate_dump_thread_kill",
                       {
@@ -1606,16 +1804,25 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
           Add an counter that is incremented for each time we update the
           binary log.  We can avoid the following read if the counter
           has not been updated since last read.
-	*/
 
-        mysql_mutex_lock(log_lock);
-        switch (error= Log_event::read_log_event(&log, packet, (mysql_mutex_t*) 0,
-                                                 current_checksum_alg)) {
+          Another dump thread may already have read the event, then it
+          is copied from the cache without LOCK_log.
+	*/
+        bool cached= binlog_dump_cache.read(log_file_name, cache_generation,
+                                            &log, packet);
+        if (!cached)
+          mysql_mutex_lock(log_lock);
+        switch (error= cached ? 0 :
+                read_log_event_and_cache(&log, packet, (mysql_mutex_t*) 0,
+                                         current_checksum_alg,
+                                         log_file_name, &is_active_binlog,
+                                         cache_generation)) {
 	case 0:
           DBUG_PRINT("info", ("read_log_event returned 0 on line %d",
                               __LINE__));
 	  /* we read successfully, so we'll need to send it to the slave */
-          mysql_mutex_unlock(log_lock);
+          if (!cached)
+            mysql_mutex_unlock(log_lock);
 	  read_packet = 1;
           p_coord->pos= uint4korr(packet->ptr() + ev_offset + LOG_POS_OFFSET);
           event_type= (Log_event_type)((*packet)[LOG_EVENT_OFFSET+ev_offset]);
@@ -1942,6 +2149,7 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
         position.  If the binlog is 5.0 or later, the next event we
         are going to read and send is Format_description_log_event.
       */
+      cache_generation= binlog_dump_cache.get_generation();
       if ((file=open_binlog_file(&log, log_file_name, &errmsg)) < 0 ||
           fake_rotate_event(net, packet, log_file_name, BIN_LOG_HEADER_SIZE,
                             &errmsg, current_checksum_alg))
@@ -20,10 +20,14 @@
 
 #ifdef HAVE_REPLICATION
 
+#include <deque>
+
 extern bool server_id_supplied;
 extern int max_binlog_dump_events;
 extern my_bool opt_sporadic_binlog_dump_fail;
 extern my_bool opt_show_slave_auth_info;
+extern ulonglong binlog_dump_cache_size;
+extern ulonglong binlog_dump_cache_hits, binlog_dump_cache_misses;
 
 typedef struct st_slave_info
 {
@@ -100,6 +104,83 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
 
 int reset_master(THD* thd);
 
+/**
+  @class Binlog_dump_cache
+
+  The last events of the active binary log, shared by all dump threads.
+
+  A dump thread which reads an event of the active binary log from the
+  file adds it to the cache, and the dump threads which are caught up
+  copy the next event from the cache instead of reading it from the
+  file under LOCK_log. A dump thread reading an older part of the
+  binary log misses the cache and reads the file as before.
+
+  The cache holds the consecutive events of one binary log, up to
+  binlog_dump_cache_size bytes, and drops the oldest events first.
+  Files are identified by name, so RESET MASTER, which reuses the
+  names, changes the generation of the cache with invalidate().
+*/
+class Binlog_dump_cache
+{
+public:
+  Binlog_dump_cache() : m_generation(0), m_size(0), m_inited(false) {}
+
+  void init();
+  void destroy();
+
+  /**
+    The current generation. A dump thread takes it before it opens a
+    binary log and passes it to read() and add() for that file.
+  */
+  ulonglong get_generation();
+
+  /** Drop all events and start a new generation. */
+  void invalidate();
+
+  /** Apply a smaller binlog_dump_cache_size. */
+  void trim();
+
+  /**
+    Append the event at the position of 'log' to 'packet' and move
+    'log' past it.
+
+    @retval true  the event was copied
+    @retval false the event is not cached, read it from the file
+  */
+  bool read(const char *log_name, ulonglong generation, IO_CACHE *log,
+            String *packet);
+
+  /**
+    Add the event of 'len' bytes at position 'pos' of the active binary
+    log, just read from the file.
+  */
+  void add(const char *log_name, ulonglong generation, my_off_t pos,
+           const char *event, ulong len);
+
+private:
+  struct Event
+  {
+    my_off_t pos;
+    ulong len;
+    uchar *data;
+  };
+
+  void clear();
+  static bool event_pos_less(const Event &event, my_off_t pos);
+
+  std::deque<Event> m_events;
+  /* The binary log of the events, and where the cached part ends. */
+  char m_log_name[FN_REFLEN];
+  my_off_t m_end_pos;
+  ulonglong m_generation;
+  /* The total size of the events. */
+  ulonglong m_size;
+  bool m_inited;
+  mysql_rwlock_t m_lock;
+};
+
+extern Binlog_dump_cache binlog_dump_cache;
+
 #endif /* HAVE_REPLICATION */
 
 #endif /* RPL_MASTER_H_INCLUDED */
@@ -89,7 +89,11 @@ Relay_log_info::Relay_log_info(bool is_slave_recovery
    until_sql_gtids_first_event(true),
    retried_trans(0),
    tables_to_lock(0), tables_to_lock_count(0),
-   rows_query_ev(NULL), last_event_start_time(0), deferred_events(NULL),
+   rows_query_ev(NULL), payload_buf(NULL), payload_len(0), payload_offset(0),
+   payload_log_pos(0), payload_start_relay_log_pos(0),
+   payload_end_relay_log_pos(0),
+   pipeline_head(NULL), pipeline_tail(NULL), pipeline_size(0),
+   last_event_start_time(0), deferred_events(NULL),
    slave_parallel_workers(0),
    exit_counter(0),
    max_updated_index(0),
@@ -97,6 +101,9 @@ Relay_log_info::Relay_log_info(bool is_slave_recovery
    checkpoint_group(opt_mts_checkpoint_group),
    recovery_groups_inited(false), mts_recovery_group_cnt(0),
    mts_recovery_index(0), mts_recovery_group_seen_begin(0),
+   mts_parallel_type(MTS_PARALLEL_TYPE_DB_NAME),
+   mts_preserve_commit_order(false), mts_last_commit_group(0),
+   mts_commit_order_seqno(0), mts_commit_order_aborted(false),
    mts_group_status(MTS_NOT_IN_GROUP), reported_unsafe_warning(false),
    rli_description_event(NULL),
    sql_delay(0), sql_delay_end(0), m_flags(0), row_stmt_start_timestamp(0),
@@ -127,6 +134,7 @@ Relay_log_info::Relay_log_info(bool is_slave_recovery
   set_timespec_nsec(last_clock, 0);
   memset(&cache_buf, 0, sizeof(cache_buf));
   cached_charset_invalidate();
+  mts_clock_partition[0]= 0;
 
   mysql_mutex_init(key_relay_log_info_log_space_lock,
                    &log_space_lock, MY_MUTEX_INIT_FAST);
@@ -136,6 +144,10 @@ Relay_log_info::Relay_log_info(bool is_slave_recovery
   mysql_cond_init(key_cond_slave_parallel_pend_jobs, &pending_jobs_cond, NULL);
   mysql_mutex_init(key_mutex_slave_parallel_worker_count, &exit_count_lock,
                    MY_MUTEX_INIT_FAST);
+  mysql_mutex_init(key_mutex_slave_parallel_commit_order,
+                   &mts_commit_order_lock, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_cond_slave_parallel_commit_order,
+                  &mts_commit_order_cond, NULL);
   my_atomic_rwlock_init(&slave_open_temp_tables_lock);
 
   relay_log.init_pthread_objects();
@@ -179,9 +191,13 @@ Relay_log_info::~Relay_log_info()
   mysql_mutex_destroy(&pending_jobs_lock);
   mysql_cond_destroy(&pending_jobs_cond);
   mysql_mutex_destroy(&exit_count_lock);
+  mysql_mutex_destroy(&mts_commit_order_lock);
+  mysql_cond_destroy(&mts_commit_order_cond);
   my_atomic_rwlock_destroy(&slave_open_temp_tables_lock);
   relay_log.cleanup();
   set_rli_description_event(NULL);
+  clear_payload();
+  clear_pipeline();
   last_retrieved_gtid.clear();
 
   DBUG_VOID_RETURN;
@@ -379,6 +395,129 @@ void Relay_log_info::clear_until_condition()
   DBUG_VOID_RETURN;
 }
 
+/**
+  Hands an event which the I/O thread has just appended to the relay log
+  over to the SQL thread, which then does not have to read it back from
+  the file if it is caught up, see pop_pipelined_event().
+
+  @param ev          The event, parsed from the buffer that was appended.
+  @param open_count  relay_log.get_open_count() of the file it is in.
+  @param start_pos   The position of the event in that file.
+  @param end_pos     The position of the next event.
+  @param fdle        The description event it was parsed with.
+
+  @retval true  the event was queued and is now owned by the pipeline.
+  @retval false relay_log_pipeline_size would be exceeded, the caller
+                keeps the event.
+*/
+bool Relay_log_info::push_pipelined_event(Log_event *ev, uint open_count,
+                                          my_off_t start_pos,
+                                          my_off_t end_pos,
+                                          const Format_description_log_event
+                                          *fdle)
+{
+  mysql_mutex_assert_owner(relay_log.get_log_lock());
+
+  if (pipeline_size + (end_pos - start_pos) > opt_relay_log_pipeline_size)
+    return false;
+
+  Pipelined_event *entry= (Pipelined_event *)
+    my_malloc(sizeof(Pipelined_event), MYF(0));
+  if (entry == NULL)
+    return false;
+  entry->ev= ev;
+  entry->open_count= open_count;
+  entry->start_pos= start_pos;
+  entry->end_pos= end_pos;
+  entry->checksum_alg= fdle->checksum_alg;
+  entry->common_header_len= fdle->common_header_len;
+  entry->next= NULL;
+
+  if (pipeline_tail)
+    pipeline_tail->next= entry;
+  else
+    pipeline_head= entry;
+  pipeline_tail= entry;
+  pipeline_size+= end_pos - start_pos;
+  return true;
+}
+
+/**
+  Returns the pipelined event at the SQL thread's position in the hot
+  relay log, if the I/O thread queued it. Events the SQL thread has
+  already passed, or which belong to a relay log it is no longer reading,
+  are dropped.
+
+  @param      pos      my_b_tell() of the hot relay log.
+  @param[out] end_pos  The position after the event returned.
+
+  @return The event, which the caller owns, or NULL if it has to be read
+          from the relay log.
+*/
+Log_event *Relay_log_info::pop_pipelined_event(my_off_t pos,
+                                               my_off_t *end_pos)
+{
+  mysql_mutex_assert_owner(relay_log.get_log_lock());
+
+  while (pipeline_head &&
+         (pipeline_head->open_count != cur_log_old_open_count ||
+          pipeline_head->start_pos < pos))
+  {
+    Pipelined_event *entry= pipeline_head;
+    pipeline_head= entry->next;
+    pipeline_size-= entry->end_pos - entry->start_pos;
+    delete entry->ev;
+    my_free(entry);
+  }
+  if (pipeline_head == NULL)
+  {
+    pipeline_tail= NULL;
+    return NULL;
+  }
+  if (pipeline_head->start_pos != pos)
+    return NULL;
+
+  Pipelined_event *entry= pipeline_head;
+  Log_event *ev= entry->ev;
+  const Format_description_log_event *fdle= get_rli_description_event();
+  /*
+    The I/O thread parsed the event with the description event it last
+    received from the master; use it only if that is the one the SQL
+    thread has read from the relay log too.
+  */
+  if (fdle == NULL || entry->checksum_alg != fdle->checksum_alg ||
+      entry->common_header_len != fdle->common_header_len)
+  {
+    delete ev;
+    ev= NULL;
+  }
+  else
+    *end_pos= entry->end_pos;
+
+  pipeline_head= entry->next;
+  if (pipeline_head == NULL)
+    pipeline_tail= NULL;
+  pipeline_size-= entry->end_pos - entry->start_pos;
+  my_free(entry);
+  return ev;
+}
+
+/**
+  Drops the events queued by the I/O thread for the SQL thread.
+*/
+void Relay_log_info::clear_pipeline()
+{
+  while (pipeline_head)
+  {
+    Pipelined_event *entry= pipeline_head;
+    pipeline_head= entry->next;
+    delete entry->ev;
+    my_free(entry);
+  }
+  pipeline_tail= NULL;
+  pipeline_size= 0;
+}
+
 /**
   Opens and intialize the given relay log. Specifically, it does what follows:
 
@@ -447,6 +586,7 @@ int Relay_log_info::init_relay_log_pos(const char* log,
   }
 
   group_relay_log_pos= event_relay_log_pos= pos;
+  clear_payload();
 
   /*
     Test to see if the previous run was with the skip of purging
@@ -30,6 +30,18 @@ struct RPL_TABLE_LIST;
 class Master_info;
 extern uint sql_slave_skip_counter;
 
+/**
+  How the MTS Coordinator decides which groups may be applied in parallel,
+  see @@global.slave_parallel_type.
+*/
+enum enum_mts_parallel_type
+{
+  /* Groups updating different databases run in parallel */
+  MTS_PARALLEL_TYPE_DB_NAME= 0,
+  /* Groups of the same binlog group commit on the master run in parallel */
+  MTS_PARALLEL_TYPE_LOGICAL_CLOCK= 1
+};
+
 /*******************************************************************************
 Replication SQL Thread
 
@@ -427,6 +439,53 @@ public:
   /* RBR: Record Rows_query log event */
   Rows_query_log_event* rows_query_ev;
 
+  /*
+    The uncompressed events of the Transaction_payload_log_event being
+    applied, which next_event() hands out one at a time, from
+    payload_offset on. They are given the log_pos of the payload event,
+    and the relay log position of its end once the last one is read.
+  */
+  uchar *payload_buf;
+  ulong payload_len;
+  ulong payload_offset;
+  my_off_t payload_log_pos;
+  ulonglong payload_start_relay_log_pos;
+  ulonglong payload_end_relay_log_pos;
+
+  void clear_payload()
+  {
+    my_free(payload_buf);
+    payload_buf= NULL;
+    payload_len= payload_offset= 0;
+  }
+
+  /*
+    Events which the I/O thread has appended to the active relay log and
+    already parsed, oldest first, so that the SQL thread does not read
+    them back from the file. See push_pipelined_event().
+    Protected by relay_log.LOCK_log.
+  */
+  struct Pipelined_event
+  {
+    Log_event *ev;
+    /* relay_log.get_open_count() of the file the event is in */
+    uint open_count;
+    my_off_t start_pos;
+    my_off_t end_pos;
+    /* the description event the event was parsed with */
+    uint8 checksum_alg;
+    uint8 common_header_len;
+    Pipelined_event *next;
+  };
+  Pipelined_event *pipeline_head, *pipeline_tail;
+  ulonglong pipeline_size;
+
+  bool push_pipelined_event(Log_event *ev, uint open_count,
+                            my_off_t start_pos, my_off_t end_pos,
+                            const Format_description_log_event *fdle);
+  Log_event *pop_pipelined_event(my_off_t pos, my_off_t *end_pos);
+  void clear_pipeline();
+
   bool get_table_data(TABLE *table_arg, table_def **tabledef_var, TABLE **conv_table_var) const
   {
     DBUG_ASSERT(tabledef_var && conv_table_var);
@@ -537,6 +596,29 @@ public:
   ulong mts_recovery_index;     // running index of recoverable groups
   bool mts_recovery_group_seen_begin;
 
+  /* cache for ::opt_mts_parallel_type and ::opt_slave_preserve_commit_order */
+  enum_mts_parallel_type mts_parallel_type;
+  bool mts_preserve_commit_order;
+  /*
+    Binlog group commit of the last scheduled group, in the
+    MTS_PARALLEL_TYPE_LOGICAL_CLOCK mode. 0 when unknown.
+  */
+  ulonglong mts_last_commit_group;
+  /*
+    Name of the pseudo database the rows events of the current group are
+    mapped to in the MTS_PARALLEL_TYPE_LOGICAL_CLOCK mode.
+  */
+  char mts_clock_partition[NAME_LEN + 1];
+  /*
+    Commit order of the Workers, with slave_preserve_commit_order.
+    mts_commit_order_seqno is the total_seqno of the last group that
+    committed; a group waits for its predecessor before committing.
+  */
+  mysql_mutex_t mts_commit_order_lock;
+  mysql_cond_t mts_commit_order_cond;
+  ulonglong mts_commit_order_seqno;
+  bool mts_commit_order_aborted; // a Worker failed, waiters must give up
+
   /*
     While distibuting events basing on their properties MTS
     Coordinator changes its mts group status.
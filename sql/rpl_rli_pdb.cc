@@ -1160,6 +1160,64 @@ Slave_worker *get_least_occupied_worker(DYNAMIC_ARRAY *ws)
    @param ev     a pointer to Log_event
    @param error  error code after processing the event by caller.
 */
+/**
+   With slave_preserve_commit_order, waits until the group preceding the
+   one terminated by @c ev in the relay log has committed.
+   The terminal event of a group is applied only after the wait, so the
+   Workers commit in the relay log order.
+
+   @param  ev  the terminal event of the group
+
+   @return false  the group may commit now
+           true   the Worker was killed or a preceding group failed
+*/
+bool Slave_worker::wait_for_commit_order(Log_event *ev)
+{
+  DBUG_ENTER("Slave_worker::wait_for_commit_order");
+  if (!c_rli->mts_preserve_commit_order)
+    DBUG_RETURN(false);
+
+  THD *thd= info_thd;
+  PSI_stage_info old_stage;
+  ulonglong seqno= c_rli->gaq->get_job_group(ev->mts_group_idx)->total_seqno;
+  bool ret;
+
+  mysql_mutex_lock(&c_rli->mts_commit_order_lock);
+  thd->ENTER_COND(&c_rli->mts_commit_order_cond, &c_rli->mts_commit_order_lock,
+                  &stage_slave_waiting_for_commit_order, &old_stage);
+  while (c_rli->mts_commit_order_seqno + 1 < seqno &&
+         !c_rli->mts_commit_order_aborted && !thd->killed)
+    mysql_cond_wait(&c_rli->mts_commit_order_cond,
+                    &c_rli->mts_commit_order_lock);
+  ret= c_rli->mts_commit_order_seqno + 1 < seqno;
+  thd->EXIT_COND(&old_stage);
+  DBUG_RETURN(ret);
+}
+
+/**
+   Lets the group following the one terminated by @c ev commit, or makes
+   all the waiting groups give up when this one has failed.
+   @c ev may be NULL in the latter case.
+*/
+void Slave_worker::commit_order_done(Log_event *ev, int error)
+{
+  if (!c_rli->mts_preserve_commit_order)
+    return;
+
+  mysql_mutex_lock(&c_rli->mts_commit_order_lock);
+  if (error)
+    c_rli->mts_commit_order_aborted= true;
+  else
+  {
+    ulonglong seqno=
+      c_rli->gaq->get_job_group(ev->mts_group_idx)->total_seqno;
+    if (seqno > c_rli->mts_commit_order_seqno)
+      c_rli->mts_commit_order_seqno= seqno;
+  }
+  mysql_cond_broadcast(&c_rli->mts_commit_order_cond);
+  mysql_mutex_unlock(&c_rli->mts_commit_order_lock);
+}
+
 void Slave_worker::slave_worker_ends_group(Log_event* ev, int error)
 {
   DBUG_ENTER("Slave_worker::slave_worker_ends_group");
@@ -1271,6 +1329,8 @@ void Slave_worker::slave_worker_ends_group(Log_event* ev, int error)
 
   curr_group_seen_gtid= curr_group_seen_begin= false;
 
+  commit_order_done(ev, error);
+
   if (error)
   {
     // Awakening Coordinator that could be waiting for entry release
@@ -2080,7 +2140,12 @@ int slave_worker_exec_job(Slave_worker *worker, Relay_log_info *rli)
   worker->set_gaq_index(ev->mts_group_idx);
   thd->print_proc_info("Executing %s event at position %lu",
                        ev->get_type_str(), ev->log_pos);
-  error= ev->do_apply_event_worker(worker);
+  if ((ev->ends_group() || (!worker->curr_group_seen_begin &&
+                            part_event && !is_gtid_event(ev))) &&
+      worker->wait_for_commit_order(ev))
+    error= -1;
+  else
+    error= ev->do_apply_event_worker(worker);
   if (ev->ends_group() || (!worker->curr_group_seen_begin &&
                            /*
                               p-events of B/T-less {p,g} group (see
@@ -397,6 +397,8 @@ public:
   int flush_info(bool force= FALSE);
   static size_t get_number_worker_fields();
   void slave_worker_ends_group(Log_event*, int);
+  bool wait_for_commit_order(Log_event *ev);
+  void commit_order_done(Log_event *ev, int error);
   const char *get_master_log_name();
   ulonglong get_master_log_pos() { return master_log_pos; };
   ulonglong set_master_log_pos(ulong val) { return master_log_pos= val; };
@@ -79,6 +79,16 @@ char* slave_load_tmpdir = 0;
 Master_info *active_mi= 0;
 my_bool replicate_same_server_id;
 ulonglong relay_log_space_limit = 0;
+ulonglong opt_relay_log_pipeline_size= 0;
+/* Events the SQL thread took from Relay_log_info::pipeline_head */
+ulonglong relay_log_pipeline_events= 0;
+/*
+  Groups scheduled by slave_parallel_type=LOGICAL_CLOCK, which had to
+  wait for the preceding groups to commit, or which were applied in
+  parallel with them. Updated by the Coordinator only.
+*/
+ulonglong mts_commit_group_waits= 0;
+ulonglong mts_commit_group_parallel= 0;
 
 const char *relay_log_index= 0;
 const char *relay_log_basename= 0;
@@ -5786,6 +5796,12 @@ int slave_start_workers(Relay_log_info *rli, ulong n, bool *mts_inited)
   rli->checkpoint_seqno= 0;
   rli->mts_last_online_stat= my_time(0);
   rli->mts_group_status= Relay_log_info::MTS_NOT_IN_GROUP;
+  rli->mts_parallel_type= (enum_mts_parallel_type) opt_mts_parallel_type;
+  rli->mts_preserve_commit_order= opt_slave_preserve_commit_order;
+  rli->mts_last_commit_group= 0;
+  // total_seqno of the first group to be assigned is one more
+  rli->mts_commit_order_seqno= rli->mts_groups_assigned;
+  rli->mts_commit_order_aborted= false;
 
   if (init_hash_workers(n))  // MTS: mapping_db_to_worker
   {
@@ -6292,6 +6308,10 @@ llstr(rli->get_group_master_log_pos(), llbuff));
   rli->slave_running= 0;
   /* Forget the relay log's format */
   rli->set_rli_description_event(NULL);
+  /* Drop the events the I/O thread has parsed for us */
+  mysql_mutex_lock(rli->relay_log.get_log_lock());
+  rli->clear_pipeline();
+  mysql_mutex_unlock(rli->relay_log.get_log_lock());
   /* Wake up master_pos_wait() */
   mysql_mutex_unlock(&rli->data_lock);
   DBUG_PRINT("info",("Signaling possibly waiting master_pos_wait() functions"));
@@ -6718,6 +6738,36 @@ static int queue_old_event(Master_info *mi, const char *buf,
   }
 }
 
+/**
+  Parses an event the slave I/O thread is about to append to the relay
+  log, for Relay_log_info::push_pipelined_event(). The event gets its own
+  copy of the buffer, as if read_log_event() had read it from the relay
+  log.
+
+  @return The event, or NULL if it could not be parsed, in which case
+          the SQL thread reads it from the relay log and reports the
+          error there.
+*/
+static Log_event* parse_pipelined_event(const char* buf, ulong event_len,
+                                        const Format_description_log_event
+                                        *fdle)
+{
+  const char *errmsg= NULL;
+  char *copy= (char*) my_malloc(event_len + 1, MYF(0));
+  if (copy == NULL)
+    return NULL;
+  memcpy(copy, buf, event_len);
+  // some events use the extra byte to null-terminate strings
+  copy[event_len]= 0;
+  Log_event *ev= Log_event::read_log_event(copy, event_len, &errmsg, fdle,
+                                           opt_slave_sql_verify_checksum);
+  if (ev)
+    ev->register_temp_buf(copy);
+  else
+    my_free(copy);
+  return ev;
+}
+
 /*
   queue_event()
 
@@ -6752,6 +6802,7 @@ static int queue_event(Master_info* mi,const char* buf, ulong event_len)
   Gtid gtid= { 0, 0 };
   Gtid old_retrieved_gtid= { 0, 0 };
   Log_event_type event_type= (Log_event_type)buf[EVENT_TYPE_OFFSET];
+  Log_event *pipelined_ev= NULL;
 
   DBUG_ASSERT(checksum_alg == BINLOG_CHECKSUM_ALG_OFF || 
               checksum_alg == BINLOG_CHECKSUM_ALG_UNDEF || 
@@ -7121,6 +7172,19 @@ static int queue_event(Master_info* mi,const char* buf, ulong event_len)
      direct master (an unsupported, useless setup!).
   */
 
+  /*
+    Parse the event for the SQL thread before taking LOCK_log, see
+    Relay_log_info::push_pipelined_event(). The events which change the
+    description event the relay log is read with are left to the SQL
+    thread.
+  */
+  if (opt_relay_log_pipeline_size > 0 && rli->slave_running &&
+      event_type != FORMAT_DESCRIPTION_EVENT &&
+      event_type != ROTATE_EVENT && event_type != STOP_EVENT &&
+      event_type != START_EVENT_V3)
+    pipelined_ev= parse_pipelined_event(buf, event_len,
+                                        mi->get_mi_description_event());
+
   mysql_mutex_lock(log_lock);
   s_id= uint4korr(buf + SERVER_ID_OFFSET);
 
@@ -7206,6 +7270,12 @@ static int queue_event(Master_info* mi,const char* buf, ulong event_len)
         goto err;
       }
     }
+    /*
+      Where the event goes, taken before append_buffer() possibly rotates
+      the relay log.
+    */
+    my_off_t start_pos= my_b_append_tell(rli->relay_log.get_log_file());
+    uint open_count= rli->relay_log.get_open_count();
     /* write the event to the relay log */
     if (!DBUG_EVALUATE_IF("simulate_append_buffer_error", 1, 0) &&
        likely(rli->relay_log.append_buffer(buf, event_len, mi) == 0))
@@ -7213,6 +7283,11 @@ static int queue_event(Master_info* mi,const char* buf, ulong event_len)
       mi->set_master_log_pos(mi->get_master_log_pos() + inc_pos);
       DBUG_PRINT("info", ("master_log_pos: %lu", (ulong) mi->get_master_log_pos()));
       rli->relay_log.harvest_bytes_written(&rli->log_space_total);
+      if (pipelined_ev &&
+          rli->push_pipelined_event(pipelined_ev, open_count, start_pos,
+                                    start_pos + event_len,
+                                    mi->get_mi_description_event()))
+        pipelined_ev= NULL;
     }
     else
     {
@@ -7241,6 +7316,7 @@ static int queue_event(Master_info* mi,const char* buf, ulong event_len)
 skip_relay_logging:
   
 err:
+  delete pipelined_ev;
   if (unlock_data_lock)
     mysql_mutex_unlock(&mi->data_lock);
   DBUG_PRINT("info", ("error: %d", error));
@@ -7529,6 +7605,68 @@ static IO_CACHE *reopen_relay_log(Relay_log_info *rli, const char **errmsg)
   error is reported through the sql_print_information() or
   sql_print_error() functions.
 */
+/**
+  Returns the next event of the Transaction_payload_log_event being
+  applied, see Relay_log_info::payload_buf.
+
+  The relay log position after the event is the start of the payload
+  until its last event is returned, so that the payload is read again
+  if the transaction does not complete.
+*/
+static Log_event* next_payload_event(Relay_log_info* rli, const char **errmsg)
+{
+  ulong event_len= 0;
+  Log_event *ev=
+    Transaction_payload_log_event::read_event(rli->payload_buf +
+                                              rli->payload_offset,
+                                              rli->payload_len -
+                                              rli->payload_offset,
+                                              &event_len,
+                                              rli->payload_log_pos,
+                                              rli->get_rli_description_event(),
+                                              errmsg);
+  if (ev == NULL)
+  {
+    rli->clear_payload();
+    return NULL;
+  }
+
+  rli->payload_offset+= event_len;
+  if (rli->payload_offset == rli->payload_len)
+  {
+    rli->clear_payload();
+    rli->set_future_event_relay_log_pos(rli->payload_end_relay_log_pos);
+  }
+  else
+    rli->set_future_event_relay_log_pos(rli->payload_start_relay_log_pos);
+  ev->future_event_relay_log_pos= rli->get_future_event_relay_log_pos();
+  return ev;
+}
+
+/**
+  Reads the event at the current position of the relay log. On the hot
+  relay log the event is taken from the ones the I/O thread has already
+  parsed, if it is there, see Relay_log_info::pop_pipelined_event().
+*/
+static Log_event* read_relay_log_event(Relay_log_info* rli, IO_CACHE* cur_log,
+                                       bool hot_log)
+{
+  if (hot_log && rli->pipeline_head != NULL)
+  {
+    my_off_t end_pos= 0;
+    Log_event *ev= rli->pop_pipelined_event(my_b_tell(cur_log), &end_pos);
+    if (ev != NULL)
+    {
+      my_b_seek(cur_log, end_pos);
+      relay_log_pipeline_events++;
+      return ev;
+    }
+  }
+  return Log_event::read_log_event(cur_log, 0,
+                                   rli->get_rli_description_event(),
+                                   opt_slave_sql_verify_checksum);
+}
+
 static Log_event* next_event(Relay_log_info* rli)
 {
   Log_event* ev;
@@ -7554,6 +7692,13 @@ static Log_event* next_event(Relay_log_info* rli)
   */
   mysql_mutex_assert_owner(&rli->data_lock);
 
+  if (rli->payload_buf != NULL)
+  {
+    if ((ev= next_payload_event(rli, &errmsg)))
+      DBUG_RETURN(ev);
+    goto err;
+  }
+
   while (!sql_slave_killed(thd,rli))
   {
     /*
@@ -7631,9 +7776,8 @@ static Log_event* next_event(Relay_log_info* rli)
       But if the relay log is created by new_file(): then the solution is:
       MYSQL_BIN_LOG::open() will write the buffered description event.
     */
-    if ((ev= Log_event::read_log_event(cur_log, 0,
-                                       rli->get_rli_description_event(),
-                                       opt_slave_sql_verify_checksum)))
+    my_off_t event_start_pos= my_b_tell(cur_log);
+    if ((ev= read_relay_log_event(rli, cur_log, hot_log)))
     {
       DBUG_ASSERT(thd==rli->info_thd);
       /*
@@ -7664,6 +7808,31 @@ static Log_event* next_event(Relay_log_info* rli)
                     sql_slave_killed(thd, rli));
         mysql_mutex_lock(&rli->data_lock);
       }
+
+      /*
+        A compressed transaction is applied event by event, so that it is
+        scheduled and accounted for like any other.
+      */
+      if (ev->get_type_code() == TRANSACTION_PAYLOAD_EVENT)
+      {
+        Transaction_payload_log_event *payload_ev=
+          static_cast<Transaction_payload_log_event*>(ev);
+        if (!payload_ev->is_valid() ||
+            !(rli->payload_buf= payload_ev->uncompress_payload()))
+        {
+          delete ev;
+          errmsg= "could not uncompress a Transaction_payload event";
+          goto err;
+        }
+        rli->payload_len= payload_ev->get_uncompressed_len();
+        rli->payload_offset= 0;
+        rli->payload_log_pos= ev->log_pos;
+        rli->payload_start_relay_log_pos= event_start_pos;
+        rli->payload_end_relay_log_pos= rli->get_future_event_relay_log_pos();
+        delete ev;
+        if (!(ev= next_payload_event(rli, &errmsg)))
+          goto err;
+      }
       DBUG_RETURN(ev);
     }
     DBUG_ASSERT(thd==rli->info_thd);
@@ -244,6 +244,8 @@ extern my_bool opt_skip_slave_start, opt_reckless_slave;
 extern my_bool opt_log_slave_updates;
 extern char *opt_slave_skip_errors;
 extern ulonglong relay_log_space_limit;
+extern ulonglong opt_relay_log_pipeline_size, relay_log_pipeline_events;
+extern ulonglong mts_commit_group_waits, mts_commit_group_parallel;
 
 extern const char *relay_log_index;
 extern const char *relay_log_basename;
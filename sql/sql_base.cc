@@ -231,7 +231,7 @@ static void modify_slave_open_temp_tables(THD *thd, int inc)
 HASH table_def_cache;
 static TABLE_SHARE *oldest_unused_share, end_of_unused_share;
 static bool table_def_inited= false;
-static bool table_def_shutdown_in_progress= false;
+bool table_def_shutdown_in_progress= false;
 
 static bool check_and_update_table_version(THD *thd, TABLE_LIST *tables,
                                            TABLE_SHARE *table_share);
@@ -1508,6 +1508,10 @@ void close_thread_table(THD *thd, TABLE **table_ptr)
 
   Table_cache *tc= table_cache_manager.get_cache(thd);
 
+  /* In the common case put TABLE back without locking the table cache. */
+  if (tc->fast_path_release_table(thd, table))
+    DBUG_VOID_RETURN;
+
   tc->lock();
 
   if (table->s->has_old_version() || table->needs_reopen() ||
@@ -2941,6 +2945,22 @@ retry_share:
   {
     Table_cache *tc= table_cache_manager.get_cache(thd);
 
+    /*
+      In the common case we can get unused TABLE object from the table
+      cache without locking it. All other cases are handled below.
+    */
+    if ((table= tc->fast_path_get_table(thd, hash_value, key, key_length,
+                                        MY_TEST(flags & MYSQL_OPEN_IGNORE_FLUSH))))
+    {
+      /* Call rebind_psi outside of the critical section. */
+      DBUG_ASSERT(table->file != NULL);
+      table->file->rebind_psi();
+
+      thd->status_var.table_open_cache_hits++;
+      tc->inc_hits();
+      goto table_found;
+    }
+
     tc->lock();
 
     /*
@@ -2995,6 +3015,7 @@ retry_share:
       table->file->rebind_psi();
 
       thd->status_var.table_open_cache_hits++;
+      tc->inc_hits();
       goto table_found;
     }
     else if (share)
@@ -3196,6 +3217,7 @@ share_found:
       goto err_lock;
     }
     tc->unlock();
+    tc->inc_misses();
   }
   thd->status_var.table_open_cache_misses++;
 
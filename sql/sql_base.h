@@ -306,6 +306,7 @@ extern Item **not_found_item;
 extern Field *not_found_field;
 extern Field *view_ref_found;
 extern HASH table_def_cache;
+extern bool table_def_shutdown_in_progress;
 
 /**
   clean/setup table fields and map.
@@ -56,6 +56,7 @@
 #include "transaction.h"
 #include "debug_sync.h"
 #include "sql_parse.h"                          // is_update_query
+#include "sql_prepare.h"                        // query_template_cache_clear
 #include "sql_callback.h"
 #include "lock.h"
 #include "global_threads.h"
@@ -911,6 +912,7 @@ THD::THD(bool enable_plugins)
    m_idle_psi(NULL),
    m_server_idle(false),
    next_to_commit(NULL),
+   binlog_commit_group(0),
    is_fatal_error(0),
    transaction_rollback_request(0),
    is_fatal_sub_stmt_error(false),
@@ -1025,6 +1027,7 @@ THD::THD(bool enable_plugins)
 
   sp_proc_cache= NULL;
   sp_func_cache= NULL;
+  query_template_cache= NULL;
 
   /* For user vars replication*/
   if (opt_bin_log)
@@ -1477,6 +1480,7 @@ void THD::change_user(void)
   cleanup_done= 0;
   init();
   stmt_map.reset();
+  query_template_cache_clear(this);
   my_hash_init(&user_vars, system_charset_info, USER_VARS_HASH_SIZE, 0, 0,
                (my_hash_get_key) get_var_key,
                (my_hash_free_key) free_user_var, 0);
@@ -1591,6 +1595,7 @@ void THD::release_resources()
   mysql_mutex_unlock(&LOCK_thd_data);
 
   stmt_map.reset();                     /* close all prepared statements */
+  query_template_cache_clear(this);
   if (!cleanup_done)
     cleanup();
 
@@ -4660,6 +4665,11 @@ void THD::inc_status_sort_scan()
 #endif
 }
 
+void THD::inc_status_sort_parallel()
+{
+  status_var_increment(status_var.filesort_parallel_count);
+}
+
 void THD::set_status_no_index_used()
 {
   server_status|= SERVER_QUERY_NO_INDEX_USED;
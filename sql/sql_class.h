@@ -83,6 +83,7 @@ class Query_log_event;
 class Load_log_event;
 class sp_rcontext;
 class sp_cache;
+class Query_template_cache;
 class Parser_state;
 class Rows_log_event;
 class Sroutine_hash_entry;
@@ -443,6 +444,7 @@ typedef struct system_variables
   ulonglong tmp_table_size;
   ulonglong long_query_time;
   my_bool end_markers_in_json;
+  my_bool prepared_stmt_plan_cache;
   /* A bitmap for switching optimizations on/off */
   ulonglong optimizer_switch;
   ulonglong optimizer_trace; ///< bitmap to tune optimizer tracing
@@ -484,12 +486,14 @@ typedef struct system_variables
   ulong read_rnd_buff_size;
   ulong div_precincrement;
   ulong sortbuff_size;
+  ulong filesort_max_threads;
   ulong max_sp_recursion_depth;
   ulong default_week_format;
   ulong max_seeks_for_key;
   ulong range_alloc_block_size;
   ulong query_alloc_block_size;
   ulong query_prealloc_size;
+  ulong query_template_cache_size;
   ulong trans_alloc_block_size;
   ulong trans_prealloc_size;
   ulong group_concat_max_len;
@@ -554,6 +558,7 @@ typedef struct system_variables
 
   my_bool sysdate_is_now;
   my_bool binlog_rows_query_log_events;
+  my_bool binlog_transaction_compression;
 
   double long_query_time_double;
 
@@ -620,6 +625,7 @@ typedef struct system_status_var
   ulonglong filesort_range_count;
   ulonglong filesort_rows;
   ulonglong filesort_scan_count;
+  ulonglong filesort_parallel_count;
   /* Prepared statements and binary protocol */
   ulonglong com_stmt_prepare;
   ulonglong com_stmt_reprepare;
@@ -628,6 +634,10 @@ typedef struct system_status_var
   ulonglong com_stmt_fetch;
   ulonglong com_stmt_reset;
   ulonglong com_stmt_close;
+  ulonglong ps_plan_cache_hits;
+  ulonglong ps_plan_cache_misses;
+  ulonglong query_template_cache_hits;
+  ulonglong query_template_cache_misses;
 
   ulonglong bytes_received;
   ulonglong bytes_sent;
@@ -2867,6 +2877,7 @@ public:
   void inc_status_sort_range();
   void inc_status_sort_rows(ha_rows count);
   void inc_status_sort_scan();
+  void inc_status_sort_parallel();
   void set_status_no_index_used();
   void set_status_no_good_index_used();
 
@@ -2958,6 +2969,13 @@ public:
   */
   THD *next_to_commit;
 
+  /**
+    Binary log group commit the transaction was flushed in, set by the
+    flush stage leader and recorded in the Gtid_log_event of the
+    transaction when binlog_gtid_commit_group is enabled.
+  */
+  ulonglong binlog_commit_group;
+
   /**
      Functions to set and get transaction position.
 
@@ -3120,6 +3138,8 @@ public:
   sp_rcontext *sp_runtime_ctx;
   sp_cache   *sp_proc_cache;
   sp_cache   *sp_func_cache;
+  /** SELECT statement templates of this connection, see sql_prepare.cc */
+  Query_template_cache *query_template_cache;
 
   /** number of name_const() substitutions, see sp_head.cc:subst_spvars() */
   uint       query_name_consts;
@@ -3352,6 +3372,17 @@ public:
   virtual bool notify_shared_lock(MDL_context_owner *ctx_in_use,
                                   bool needs_thr_lock_abort);
 
+  /**
+    Only INSERT DELAYED handler threads have to be notified about
+    conflicting requests for their weak metadata locks, see
+    notify_shared_lock(). Aborting of table-level lock waits is
+    requested through MDL_context::set_needs_thr_lock_abort() instead.
+  */
+  virtual bool needs_shared_lock_notification()
+  {
+    return system_thread & SYSTEM_THREAD_DELAYED_INSERT;
+  }
+
   // End implementation of MDL_context_owner interface.
 
   inline sql_mode_t datetime_flags() const
@@ -80,6 +80,7 @@
 
 #define DEFAULT_SORT_MEMORY (256UL* 1024UL)
 #define MIN_SORT_MEMORY     (32UL * 1024UL)
+#define MAX_FILESORT_THREADS 64  /* Max value of filesort_max_threads */
 
 /* Some portable defines */
 
@@ -1916,6 +1916,415 @@ enum_nested_loop_state JOIN_CACHE_BNL::join_matching_records(bool skip_last)
 }
 
      
+/*
+  Check whether a column can be used to hash integer values of a join key
+*/
+
+static bool is_hash_join_int_field(const Field *field)
+{
+  switch (field->real_type()) {
+  case MYSQL_TYPE_TINY:
+  case MYSQL_TYPE_SHORT:
+  case MYSQL_TYPE_INT24:
+  case MYSQL_TYPE_LONG:
+  case MYSQL_TYPE_LONGLONG:
+    return true;
+  default:
+    return false;
+  }
+}
+
+
+/*
+  Check whether a column can be used to hash string values of a join key
+*/
+
+static bool is_hash_join_str_field(const Field *field)
+{
+  switch (field->real_type()) {
+  case MYSQL_TYPE_STRING:
+  case MYSQL_TYPE_VARCHAR:
+    return true;
+  default:
+    return false;
+  }
+}
+
+
+/*
+  Add the equalities of a condition usable for hashing to an array
+
+  SYNOPSIS
+    add_hash_key_parts()
+      cond      the condition to look into
+      tab       the table joined with the records from the join buffer
+      parts     the array of the equalities
+      n         the number of the elements already in the array
+
+  DESCRIPTION
+    The function looks for the top level conjuncts of cond of the form
+    inner_col=outer_col where inner_col is a column of tab and outer_col is
+    a column of one of the preceding tables. Only integer columns compared
+    with integer columns, and string columns compared with string columns
+    of the same character set using this character set, are accepted. For
+    these pairs equal values always have equal hash values.
+
+  RETURN
+    the number of the elements in the array
+*/
+
+static uint
+add_hash_key_parts(Item *cond, const JOIN_TAB *tab,
+                   JOIN_CACHE_BNL_HASH::Hash_key_part *parts, uint n)
+{
+  if (cond->type() == Item::COND_ITEM &&
+      ((Item_cond*) cond)->functype() == Item_func::COND_AND_FUNC)
+  {
+    List_iterator<Item> li(*((Item_cond*) cond)->argument_list());
+    Item *item;
+    while ((item= li++) && n < MAX_REF_PARTS)
+      n= add_hash_key_parts(item, tab, parts, n);
+    return n;
+  }
+
+  if (cond->type() != Item::FUNC_ITEM ||
+      ((Item_func*) cond)->functype() != Item_func::EQ_FUNC)
+    return n;
+
+  Item_bool_func2 *eq= (Item_bool_func2*) cond;
+  Item **args= eq->arguments();
+  const table_map outer_tables= tab->prefix_tables() & ~tab->table->map;
+  for (uint i= 0; i < 2; i++)
+  {
+    Item *inner= args[i];
+    Item *outer= args[1 - i];
+    if (inner->real_item()->type() != Item::FIELD_ITEM ||
+        outer->real_item()->type() != Item::FIELD_ITEM)
+      return n;
+    const table_map outer_used= outer->used_tables();
+    if (inner->used_tables() != tab->table->map ||
+        !outer_used || (outer_used & ~outer_tables))
+      continue;
+
+    Field *inner_field= ((Item_field*) inner->real_item())->field;
+    Field *outer_field= ((Item_field*) outer->real_item())->field;
+    if (inner_field->table != tab->table)
+      continue;
+
+    bool is_int;
+    if (is_hash_join_int_field(inner_field) &&
+        is_hash_join_int_field(outer_field))
+      is_int= true;
+    else if (is_hash_join_str_field(inner_field) &&
+             is_hash_join_str_field(outer_field) &&
+             inner_field->charset() == outer_field->charset() &&
+             eq->compare_collation() == inner_field->charset())
+      is_int= false;
+    else
+      return n;
+
+    parts[n].inner_field= inner_field;
+    parts[n].outer_field= outer_field;
+    parts[n].is_int= is_int;
+    return n + 1;
+  }
+  return n;
+}
+
+
+/*
+  Collect the equalities usable for hashing from the condition of a table
+
+  SYNOPSIS
+    get_key_parts()
+      tab       the table joined with the records from the join buffer
+      parts     OUT the array to put the equalities to, at least
+                MAX_REF_PARTS elements
+
+  DESCRIPTION
+    The function is used both to decide whether the table is joined by a
+    JOIN_CACHE_BNL_HASH cache and, by the cache itself, to get the columns
+    the hash values are calculated over.
+
+  RETURN
+    the number of the found equalities, 0 if hashing cannot be used
+*/
+
+uint JOIN_CACHE_BNL_HASH::get_key_parts(const JOIN_TAB *tab,
+                                        Hash_key_part *parts)
+{
+  /* This is the condition check_match() evaluates for the joined rows */
+  Item *cond= tab->select ? tab->select->cond : NULL;
+  if (!cond)
+    return 0;
+  return add_hash_key_parts(cond, tab, parts, 0);
+}
+
+
+/* 
+  Initialize a BNL_HASH cache       
+
+  SYNOPSIS
+    init()
+
+  DESCRIPTION
+    The function initializes the cache structure. It supposed to be called
+    right after a constructor for the JOIN_CACHE_BNL_HASH.
+    Additionally to what JOIN_CACHE_BNL::init does the function collects
+    the columns the hash values are calculated over and reserves the
+    space for the hash table at the end of the join buffer.
+
+  RETURN
+    0   initialization with buffer allocations has been succeeded
+    1   otherwise
+*/
+
+int JOIN_CACHE_BNL_HASH::init()
+{
+  DBUG_ENTER("JOIN_CACHE_BNL_HASH::init");
+
+  n_key_parts= get_key_parts(join_tab, key_parts);
+
+  if (JOIN_CACHE_BNL::init())
+    DBUG_RETURN(1);
+
+  /*
+    The check for the last record in write_record_data() must leave space
+    for the hash entry and the bucket of the next record as well.
+  */
+  pack_length_with_blob_ptrs+= hash_space_per_record();
+
+  entries_end= (Hash_entry *) (buff + buff_size -
+                               buff_size % sizeof(Hash_entry));
+
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Get the space remaining in the JOIN_CACHE_BNL_HASH buffer
+
+  DESCRIPTION
+    Additionally to the space taken by the records this implementation
+    of the virtual function rem_space() takes into account the space
+    needed for the hash entries and the buckets of these records.
+*/
+
+ulong JOIN_CACHE_BNL_HASH::rem_space()
+{
+  ulong space= JOIN_CACHE::rem_space();
+  ulong reserved= (ulong) (buff + buff_size - (uchar *) entries_end) +
+                  (ulong) records * hash_space_per_record();
+  return space > reserved ? space - reserved : 0;
+}
+
+
+/*
+  Calculate the hash value of the join key of the current records
+
+  SYNOPSIS
+    calc_hash()
+      inner     calculate the value over the columns of join_tab if TRUE,
+                over the columns of the preceding tables otherwise
+      is_null   OUT set to TRUE if any of the columns is NULL
+
+  NOTES
+    A key with a NULL column never matches by an equality, so no hash
+    value is calculated for it.
+
+  RETURN
+    the hash value of the key
+*/
+
+uint32 JOIN_CACHE_BNL_HASH::calc_hash(bool inner, bool *is_null)
+{
+  ulong nr1= 1, nr2= 4;
+  Hash_key_part *part= key_parts;
+  Hash_key_part *part_end= key_parts + n_key_parts;
+  for ( ; part < part_end; part++)
+  {
+    Field *field= inner ? part->inner_field : part->outer_field;
+    if (field->is_null())
+    {
+      *is_null= TRUE;
+      return 0;
+    }
+    if (part->is_int)
+    {
+      uchar buf[8];
+      int8store(buf, field->val_int());
+      my_charset_bin.coll->hash_sort(&my_charset_bin, buf, sizeof(buf),
+                                     &nr1, &nr2);
+    }
+    else
+      field->hash(&nr1, &nr2);
+  }
+  *is_null= FALSE;
+  return (uint32) nr1;
+}
+
+
+/* 
+  Add a record into the JOIN_CACHE_BNL_HASH buffer
+
+  SYNOPSIS
+    put_record_in_cache()
+
+  DESCRIPTION
+    This implementation of the virtual function put_record writes the next
+    matching record into the join buffer of the JOIN_CACHE_BNL_HASH class.
+    Additionally to what the default implementation does this function
+    fills the hash entry for the record with the hash value of the columns
+    of the preceding tables. The entry is linked into the hash table in
+    join_matching_records.
+
+  RETURN
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer,
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNL_HASH::put_record_in_cache()
+{
+  bool is_full= JOIN_CACHE::put_record_in_cache();
+  if (n_key_parts)
+  {
+    bool is_null;
+    Hash_entry *entry= get_entry(records - 1);
+    entry->hash= calc_hash(FALSE, &is_null);
+    /* A record with a NULL key column has no matches */
+    entry->rec_ptr= is_null ? NULL : curr_rec_pos;
+    entry->next= NO_ENTRY;
+  }
+  return is_full;
+}
+
+
+/*
+  Using the hash table find matches from the next table for records
+  from the join buffer
+
+  SYNOPSIS
+    join_matching_records()
+      skip_last    do not look for matches for the last partial join record 
+
+  DESCRIPTION
+    The function does the same as JOIN_CACHE_BNL::join_matching_records
+    but for each retrieved row of the join_tab table it checks only those
+    records from the join buffer whose hash value is equal to the hash
+    value of the row. Before the rows are retrieved the hash entries of
+    the records are linked into the buckets of the hash table. The records
+    of a bucket are linked in the order they were put into the buffer.
+      
+  RETURN
+    return one of enum_nested_loop_state.
+*/
+
+enum_nested_loop_state
+JOIN_CACHE_BNL_HASH::join_matching_records(bool skip_last)
+{
+  int error;
+  READ_RECORD *info;
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+  SQL_SELECT *select= join_tab->cache_select;
+
+  if (!n_key_parts)
+    return JOIN_CACHE_BNL::join_matching_records(skip_last);
+
+  join_tab->table->null_row= 0;
+
+  /* Return at once if there are no records in the join buffer */
+  if (!records)     
+    return NESTED_LOOP_OK;   
+ 
+  /* See JOIN_CACHE_BNL::join_matching_records */
+  if (skip_last)     
+    put_record_in_cache();     
+
+  /* Build the hash table over the records to be joined */
+  uint n_entries= records - MY_TEST(skip_last);
+  uint n_buckets= max(n_entries, 1U);
+  uint32 *buckets= (uint32 *) get_entry(records - 1) - n_buckets;
+  for (uint i= 0; i < n_buckets; i++)
+    buckets[i]= NO_ENTRY;
+  for (uint i= n_entries; i-- > 0; )
+  {
+    Hash_entry *entry= get_entry(i);
+    if (!entry->rec_ptr)
+      continue;
+    uint32 *bucket= buckets + entry->hash % n_buckets;
+    entry->next= *bucket;
+    *bucket= i;
+  }
+ 
+  if (join_tab->use_quick == QS_DYNAMIC_RANGE && join_tab->select->quick)
+    /* A dynamic range access was used last. Clean up after it */
+    join_tab->select->set_quick(NULL);
+
+  /* Start retrieving all records of the joined table */
+  if ((error= (*join_tab->read_first_record)(join_tab))) 
+    return error < 0 ? NESTED_LOOP_OK : NESTED_LOOP_ERROR;
+
+  info= &join_tab->read_record;
+  do
+  {
+    if (join_tab->keep_current_rowid)
+      join_tab->table->file->position(join_tab->table->record[0]);
+
+    if (join->thd->killed)
+    {
+      /* The user has aborted the execution of the query */
+      join->thd->send_kill_message();
+      return NESTED_LOOP_KILLED;
+    }
+    
+    /* 
+      Do not look for matches if the last read record of the joined table
+      does not meet the conditions that have been pushed to this table
+    */
+    if (rc == NESTED_LOOP_OK)
+    {
+      bool skip_record;
+      bool consider_record= (!select || 
+                             (!select->skip_record(join->thd, &skip_record) &&
+                              !skip_record));
+      if (select && join->thd->is_error())
+        return NESTED_LOOP_ERROR;
+      bool is_null= FALSE;
+      uint32 hash= 0;
+      if (consider_record)
+        hash= calc_hash(TRUE, &is_null);
+      if (consider_record && !is_null)
+      {
+        /* Read the records with the same hash value and look for matches */
+        uint32 idx= buckets[hash % n_buckets];
+        while (idx != NO_ENTRY)
+        { 
+          Hash_entry *entry= get_entry(idx);
+          idx= entry->next;
+          if (entry->hash != hash)
+            continue;
+          /* 
+            If only the first match is needed and it has been already found
+            for the record then the record is skipped.
+          */
+          if (check_only_first_match && get_match_flag_by_pos(entry->rec_ptr))
+            continue;
+          get_record_by_pos(entry->rec_ptr);
+          rc= generate_full_extensions(entry->rec_ptr);
+          if (rc != NESTED_LOOP_OK)
+            return rc;
+        }
+      }
+    }
+  } while (!(error= info->read_record(info)));
+
+  if (error > 0)				// Fatal error
+    rc= NESTED_LOOP_ERROR; 
+  return rc;
+}
+
+
 /*
   Set match flag for a record in join buffer if it has not been set yet    
 
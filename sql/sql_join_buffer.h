@@ -494,9 +494,11 @@ public:
   }
 
   /** Bits describing cache's type @sa setup_join_buffering() */
-  enum {ALG_NONE= 0, ALG_BNL= 1, ALG_BKA= 2, ALG_BKA_UNIQUE= 4};
+  enum {ALG_NONE= 0, ALG_BNL= 1, ALG_BKA= 2, ALG_BKA_UNIQUE= 4,
+        ALG_BNL_HASH= 8};
 
   friend class JOIN_CACHE_BNL;
+  friend class JOIN_CACHE_BNL_HASH;
   friend class JOIN_CACHE_BKA;
   friend class JOIN_CACHE_BKA_UNIQUE;
 };
@@ -519,6 +521,96 @@ public:
 
 };
 
+/*
+  The class JOIN_CACHE_BNL_HASH supports a variant of the BNL join algorithm
+  for the case when the condition pushed to join_tab contains equalities
+  between columns of join_tab and columns of the preceding tables
+  (t2.a=t1.a AND ...). For each record put into the join buffer a hash value
+  of the columns of the preceding tables is calculated, and the records are
+  linked into a hash table placed at the very end of the join buffer. For
+  each row of join_tab only the records from the join buffer whose hash
+  value is equal to the hash value of the columns of join_tab are read and
+  checked against the pushed condition, instead of all the records of the
+  buffer.
+
+  Only integer and character string columns are used for hashing: for them
+  values that are equal by the comparison used in the condition always
+  have the same hash value. The full condition is still evaluated for every
+  candidate record, so hash collisions do not change the result. Records are
+  kept in the hash chains in the order they were put into the buffer, so the
+  order of the produced rows is the same as with JOIN_CACHE_BNL.
+
+  The layout of the end of the join buffer:
+
+           buckets           entries
+  ... |b_(n-1)| ... |b_0|e_(n-1)| ... |e_1|e_0| buff+buff_size
+
+  The entry e_i is written when the i-th record is put into the buffer,
+  the bucket array is built right before the rows of join_tab are read.
+*/
+
+class JOIN_CACHE_BNL_HASH :public JOIN_CACHE_BNL
+{
+public:
+  /* An equality between a column of join_tab and a preceding column */
+  struct Hash_key_part
+  {
+    Field *inner_field;
+    Field *outer_field;
+    bool is_int;
+  };
+
+private:
+
+  /* Entry of the hash table describing one record in the join buffer */
+  struct Hash_entry
+  {
+    uchar *rec_ptr;    /**< position of the record fields */
+    uint32 hash;       /**< hash value of the key of the record */
+    uint32 next;       /**< next entry in the bucket chain, or NO_ENTRY */
+  };
+
+  static const uint32 NO_ENTRY= 0xFFFFFFFF;
+
+  Hash_key_part key_parts[MAX_REF_PARTS];
+  /* Number of elements in key_parts, 0 if hashing cannot be used */
+  uint n_key_parts;
+
+  /* The entries of the hash table grow down from this position */
+  Hash_entry *entries_end;
+
+  /* Space taken at the end of the join buffer by one record */
+  static uint hash_space_per_record()
+  {
+    return sizeof(Hash_entry) + sizeof(uint32);
+  }
+
+  Hash_entry *get_entry(uint idx) { return entries_end - idx - 1; }
+
+  /* Calculate the hash value of the key using inner or outer columns */
+  uint32 calc_hash(bool inner, bool *is_null);
+
+protected:
+
+  ulong rem_space();
+
+  bool put_record_in_cache();
+
+  /* Using the hash table find matches for records from the join buffer */
+  enum_nested_loop_state join_matching_records(bool skip_last);
+
+public:
+  JOIN_CACHE_BNL_HASH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev)
+    : JOIN_CACHE_BNL(j, tab, prev), n_key_parts(0), entries_end(NULL)
+  {}
+
+  /* Initialize the BNL_HASH cache */
+  int init();
+
+  /* Collect the equalities of the condition of tab usable for hashing */
+  static uint get_key_parts(const JOIN_TAB *tab, Hash_key_part *parts);
+};
+
 class JOIN_CACHE_BKA :public JOIN_CACHE
 {
 protected:
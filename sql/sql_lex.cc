@@ -1707,6 +1707,235 @@ static int lex_one_token(YYSTYPE *yylval, THD *thd)
 }
 
 
+/**
+  Check if a literal following the token @c prev may be replaced by a
+  parameter marker in a statement template.
+
+  @param prev         token preceding the literal
+  @param between_and  whether @c prev is the AND of a BETWEEN predicate
+  @param in_list      whether the literal is an element of an IN list
+*/
+
+static bool is_template_literal_start(int prev, bool between_and,
+                                      bool in_list)
+{
+  switch (prev) {
+  case EQ:
+  case EQUAL_SYM:
+  case NE:
+  case LT:
+  case LE:
+  case GT_SYM:
+  case GE:
+  case LIKE:
+  case BETWEEN_SYM:
+    return true;
+  case AND_SYM:
+    return between_and;
+  case '(':
+  case ',':
+    return in_list;
+  default:
+    return false;
+  }
+}
+
+
+/**
+  Check if nothing binds tighter to a literal than the predicate it is an
+  operand of, given the token @c next that follows it.
+*/
+
+static bool is_template_literal_end(int next)
+{
+  switch (next) {
+  case END_OF_INPUT:
+  case AND_SYM:
+  case AND_AND_SYM:
+  case OR_SYM:
+  case OR2_SYM:
+  case XOR:
+  case ')':
+  case ',':
+  case GROUP_SYM:
+  case HAVING:
+  case ORDER_SYM:
+  case LIMIT:
+  case UNION_SYM:
+  case PROCEDURE_SYM:
+  case FOR_SYM:
+  case LOCK_SYM:
+    return true;
+  default:
+    return false;
+  }
+}
+
+
+/**
+  Build the template of a SELECT statement for the query template cache.
+
+  The template is the text of the statement where the numbers and strings
+  that are operands of comparison, LIKE, BETWEEN and IN predicates in the
+  WHERE clause are replaced by parameter markers. Literals anywhere else
+  are kept, since a parameter marker there may change the meaning of the
+  statement (select list item names, ORDER BY positions, LIMIT, etc.).
+
+  Only the lexical analyzer is run, so that a statement matching a cached
+  template does not have to be parsed. The tokens are passed to the digest
+  as the parser would do.
+
+  @param thd           thread handle
+  @param query         statement text
+  @param length        length of the statement text
+  @param digest        digest to compute, or NULL
+  @param[out] text     template text
+  @param[out] literals replaced literals, in the order of their markers
+
+  @retval false  the statement can be executed from a template
+  @retval true   the statement is not a single SELECT, or out of memory
+*/
+
+bool lex_query_template(THD *thd, char *query, uint length,
+                        sql_digest_state *digest, String *text,
+                        Query_template_literals *literals)
+{
+  Parser_state parser_state;
+  Lex_input_stream *lip= &parser_state.m_lip;
+  YYSTYPE yylval;
+  Query_template_literal literal;
+  const char *literal_start= NULL;
+  const char *literal_end= NULL;
+  const char *copied= query;
+  uint depth= 0;
+  uint in_list_depth= 0;
+  bool in_where= false;
+  bool in_between= false;
+  bool between_and= false;
+  bool error= false;
+  int prev= 0;
+  DBUG_ENTER("lex_query_template");
+
+  if (parser_state.init(thd, query, length))
+    DBUG_RETURN(true);
+
+  lip->m_digest= digest;
+  if (digest != NULL)
+    digest->m_digest_storage.m_charset_number= thd->charset()->number;
+
+  DBUG_ASSERT(thd->m_parser_state == NULL);
+  thd->m_parser_state= &parser_state;
+  text->length(0);
+
+  for (bool done= false; !done && !error; )
+  {
+    int token= MYSQLlex(&yylval, thd);
+
+    if (literal_start != NULL)
+    {
+      if (is_template_literal_end(token))
+      {
+        error= text->append(copied, literal_start - copied) ||
+               text->append('?') ||
+               literals->push_back(literal);
+        copied= literal_end;
+      }
+      literal_start= NULL;
+    }
+
+    if (prev == 0 && token != SELECT_SYM)
+      break;
+
+    switch (token) {
+    case END_OF_INPUT:
+      done= true;
+      break;
+    case '(':
+      if (prev == IN_SYM)
+        in_list_depth= depth + 1;
+      depth++;
+      break;
+    case ')':
+      if (depth == 0)
+        error= true;
+      else
+      {
+        if (in_list_depth == depth)
+          in_list_depth= 0;
+        depth--;
+      }
+      break;
+    case SELECT_SYM:
+      /* Subquery predicate, x IN (SELECT ...) */
+      if (in_list_depth == depth)
+        in_list_depth= 0;
+      break;
+    case WHERE:
+      if (depth == 0)
+        in_where= true;
+      break;
+    case GROUP_SYM:
+    case HAVING:
+    case ORDER_SYM:
+    case LIMIT:
+    case UNION_SYM:
+    case PROCEDURE_SYM:
+    case FOR_SYM:
+    case LOCK_SYM:
+      if (depth == 0)
+        in_where= false;
+      break;
+    case BETWEEN_SYM:
+      in_between= true;
+      break;
+    case AND_SYM:
+      between_and= in_between;
+      in_between= false;
+      break;
+    case NUM:
+    case LONG_NUM:
+    case DECIMAL_NUM:
+    case TEXT_STRING:
+      if (in_where &&
+          is_template_literal_start(prev, between_and,
+                                    in_list_depth != 0 &&
+                                    in_list_depth == depth))
+      {
+        literal.type= token == TEXT_STRING ?
+                      Query_template_literal::STRING_LITERAL :
+                      token == DECIMAL_NUM ?
+                      Query_template_literal::DECIMAL_LITERAL :
+                      Query_template_literal::INT_LITERAL;
+        literal.value= yylval.lex_str;
+        literal_start= lip->get_tok_start();
+        /* Numbers are copied verbatim, strings end at the closing quote */
+        literal_end= token == TEXT_STRING ?
+                     lip->get_ptr() : literal_start + yylval.lex_str.length;
+      }
+      break;
+    case 0:
+    case INTO:
+    case PARAM_MARKER:
+    case ABORT_SYM:
+    case ';':
+    case '?':
+      error= true;
+      break;
+    default:
+      break;
+    }
+    prev= token;
+  }
+
+  thd->m_parser_state= NULL;
+
+  if (prev != END_OF_INPUT || error)
+    DBUG_RETURN(true);
+
+  DBUG_RETURN(text->append(copied, query + length - copied));
+}
+
+
 void trim_whitespace(const CHARSET_INFO *cs, LEX_STRING *str)
 {
   /*
@@ -1810,6 +2039,7 @@ void st_select_lex::init_query()
   first_execution= 1;
   first_natural_join_processing= 1;
   first_cond_optimization= 1;
+  join_order_cache= NULL;
   parsing_place= NO_MATTER;
   exclude_from_table_unique_test= no_wrap_view_item= FALSE;
   nest_level= 0;
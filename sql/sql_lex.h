@@ -538,6 +538,7 @@ typedef class st_select_lex_node SELECT_LEX_NODE;
 class THD;
 class select_result;
 class JOIN;
+class Join_order_cache;
 class select_union;
 
 
@@ -830,6 +831,11 @@ public:
   bool first_execution;
   bool first_natural_join_processing;
   bool first_cond_optimization;
+  /**
+    Join order found by previous execution of the prepared statement
+    this query block belongs to, @sa Join_order_cache.
+  */
+  Join_order_cache *join_order_cache;
   /* do not wrap view fields with Item_ref */
   bool no_wrap_view_item;
   /* exclude this select from check of unique_table() */
@@ -2855,6 +2861,25 @@ digest_add_token(sql_digest_state *state, uint token, LEX_YYSTYPE yylval);
 extern sql_digest_state *
 digest_reduce_token(sql_digest_state *state, uint token_left, uint token_right);
 
+/**
+  A literal of a statement that is replaced by a parameter marker in the
+  statement template, see lex_query_template().
+*/
+struct Query_template_literal
+{
+  enum enum_type { INT_LITERAL, DECIMAL_LITERAL, STRING_LITERAL };
+
+  enum_type type;
+  /** Text of a number, or value of a string in character_set_client */
+  LEX_STRING value;
+};
+
+typedef Mem_root_array<Query_template_literal, true> Query_template_literals;
+
+bool lex_query_template(THD *thd, char *query, uint length,
+                        sql_digest_state *digest, String *text,
+                        Query_template_literals *literals);
+
 struct st_lex_local: public LEX
 {
   static void *operator new(size_t size) throw()
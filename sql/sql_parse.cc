@@ -101,6 +101,7 @@
 #include "sql_analyse.h"
 #include "table_cache.h" // table_cache_manager
 #include "sql_timer.h"   // thd_timer_set, thd_timer_reset
+#include "sql_throttle.h" // throttle_queue_wait
 #include "sp_rcontext.h"
  
 
@@ -1886,6 +1887,7 @@ done:
   thd->m_digest= NULL;
 
   dec_thread_running();
+  throttle_queue_release();
   thd->packet.shrink(thd->variables.net_buffer_length);	// Reclaim some memory
   free_root(thd->mem_root,MYF(MY_KEEP_PREALLOC));
 
@@ -6457,6 +6459,28 @@ static bool throttle_query_if_needed(THD* thd)
     throttle_query= (write_limit && qry_type == THROTTLE_QUERY_WRITE
                      && get_write_query_running() > write_limit);
 
+  /* With the admission queue enabled, a throttled query waits for a
+  running query to finish before it is rejected. A query which is not
+  throttled still queues behind earlier waiters to keep them in order. */
+  if (opt_query_throttling_queue_size &&
+      (throttle_query || throttle_queue_waiting))
+  {
+    throttle_query= throttle_queue_wait(thd, qry_type == THROTTLE_QUERY_WRITE);
+    if (throttle_query && thd->killed)
+    {
+      /* The statement is not executed, so reset a query kill here
+      like mysql_execute_command() would have done. */
+      thd->send_kill_message();
+      if (thd->killed == THD::KILL_QUERY ||
+          thd->killed == THD::KILL_TIMEOUT)
+      {
+        thd->killed= THD::NOT_KILLED;
+        thd->mysys_var->abort= 0;
+      }
+      DBUG_RETURN(true);
+    }
+  }
+
   if (throttle_query)
   {
     my_error(ER_QUERY_THROTTLED, MYF(0));
@@ -6516,8 +6540,15 @@ void mysql_parse(THD *thd, char *rawbuf, uint length,
   if (query_cache_send_result_to_client(thd, rawbuf, length) <= 0)
   {
     LEX *lex= thd->lex;
+    Prepared_statement *query_template= NULL;
 
-    bool err= parse_sql(thd, parser_state, NULL);
+    /*
+      SELECT statements matching a template in the query template cache are
+      executed from the cache instead of being parsed.
+    */
+    bool err= (thd->variables.query_template_cache_size &&
+               query_template_find(thd, parser_state, &query_template)) ||
+              (!query_template && parse_sql(thd, parser_state, NULL));
 
     const char *found_semicolon= parser_state->m_lip.found_semicolon;
     size_t      qlen= found_semicolon
@@ -6615,6 +6646,8 @@ void mysql_parse(THD *thd, char *rawbuf, uint length,
             my_error(ER_MUST_CHANGE_PASSWORD, MYF(0));
             error= 1;
           }
+          else if (query_template)
+            error= query_template_execute(thd, query_template);
           else
             error= mysql_execute_command(thd);
           if (error == 0 &&
@@ -6692,7 +6725,10 @@ void mysql_parse(THD *thd, char *rawbuf, uint length,
   }
 
   if (get_throttle_query_type(thd->lex) == THROTTLE_QUERY_WRITE)
+  {
     dec_write_query_running();
+    throttle_queue_release();
+  }
 
   DBUG_VOID_RETURN;
 }
@@ -1136,16 +1136,23 @@ bool Optimize_table_order::choose_table_order()
     join_tables= join->all_table_map & ~join->const_table_map;
   }
 
+  Join_order_cache *const cache= straight_join ? NULL : get_join_order_cache();
+  const bool reuse_order= cache && reuse_join_order(cache);
+
   Opt_trace_object wrapper(&join->thd->opt_trace);
+  if (cache)
+    wrapper.add("join_order_from_cache", reuse_order);
   Opt_trace_array
     trace_plan(&join->thd->opt_trace, "considered_execution_plans",
                Opt_trace_context::GREEDY_SEARCH);
-  if (straight_join)
+  if (straight_join || reuse_order)
     optimize_straight_join(join_tables);
   else
   {
     if (greedy_search(join_tables))
       DBUG_RETURN(true);
+    if (cache)
+      save_join_order(cache);
   }
 
   // Remaining part of this function not needed when processing semi-join nests.
@@ -1160,6 +1167,147 @@ bool Optimize_table_order::choose_table_order()
 }
 
 
+bool Join_order_cache::init(MEM_ROOT *mem_root, uint tables)
+{
+  table_count= tables;
+  order= (table_map *) alloc_root(mem_root, tables * sizeof(table_map));
+  rows_bucket= (uint *) alloc_root(mem_root, tables * sizeof(uint));
+  share_version= (ulonglong *) alloc_root(mem_root,
+                                          tables * sizeof(ulonglong));
+  return order == NULL || rows_bucket == NULL || share_version == NULL;
+}
+
+
+/**
+  Find the join order cache of the query block being optimized, creating
+  it on first use.
+
+  Only complete plans of query blocks without semi-join nests, executed
+  as part of a prepared statement with @@prepared_stmt_plan_cache enabled,
+  are cached.
+
+  @return the cache, or NULL if the join order should not be cached
+*/
+
+Join_order_cache *Optimize_table_order::get_join_order_cache()
+{
+  SELECT_LEX *const select_lex= join->select_lex;
+  Query_arena *const arena= thd->stmt_arena;
+
+  if (emb_sjm_nest || !thd->variables.prepared_stmt_plan_cache ||
+      arena->type() != Query_arena::PREPARED_STATEMENT ||
+      arena->is_conventional() ||
+      !select_lex->sj_nests.is_empty() ||
+      join->tables - join->const_tables < 2)
+    return NULL;
+
+  if (select_lex->join_order_cache == NULL)
+  {
+    Join_order_cache *cache= new (arena->mem_root) Join_order_cache;
+    if (cache == NULL || cache->init(arena->mem_root, join->tables))
+      return NULL;
+    select_lex->join_order_cache= cache;
+  }
+  else if (select_lex->join_order_cache->table_count != join->tables)
+    return NULL;
+
+  return select_lex->join_order_cache;
+}
+
+
+/**
+  Reorder join->best_ref after a join order found by a previous execution
+  of the statement, if it is still applicable.
+
+  On success the nested join counters are reset, so that the caller may
+  evaluate the order with optimize_straight_join(). On failure best_ref is
+  left untouched.
+
+  @param cache  the join order cache of the query block
+
+  @return true if best_ref now holds the cached order, false otherwise
+*/
+
+bool Optimize_table_order::reuse_join_order(const Join_order_cache *cache)
+{
+  if (!cache->valid || cache->const_table_map != join->const_table_map)
+  {
+    thd->status_var.ps_plan_cache_misses++;
+    return false;
+  }
+
+  const uint first= join->const_tables;
+  const uint count= join->tables - first;
+  JOIN_TAB **const order= (JOIN_TAB **) my_alloca(count * sizeof(JOIN_TAB *));
+  table_map prefix= join->const_table_map;
+  bool usable= true;
+
+  for (uint i= 0; usable && i < count; i++)
+  {
+    JOIN_TAB *tab= NULL;
+    for (uint j= first; j < join->tables; j++)
+    {
+      if (join->best_ref[j]->table->map == cache->order[i])
+      {
+        tab= join->best_ref[j];
+        break;
+      }
+    }
+    usable= tab != NULL &&
+            Join_order_cache::get_rows_bucket(tab->found_records) ==
+              cache->rows_bucket[i] &&
+            tab->table->s->get_table_ref_version() ==
+              cache->share_version[i] &&
+            !(tab->dependent & join->all_table_map & ~prefix) &&
+            !check_interleaving_with_nj(tab);
+    if (usable)
+    {
+      order[i]= tab;
+      prefix|= tab->table->map;
+    }
+  }
+
+  // check_interleaving_with_nj() has advanced the nested join counters.
+  reset_nj_counters(join->join_list);
+  cur_embedding_map= 0;
+
+  if (usable)
+  {
+    memcpy(join->best_ref + first, order, count * sizeof(JOIN_TAB *));
+    thd->status_var.ps_plan_cache_hits++;
+  }
+  else
+    thd->status_var.ps_plan_cache_misses++;
+
+  my_afree(order);
+  return usable;
+}
+
+
+/**
+  Remember the join order just chosen by greedy_search() for the following
+  executions of the statement.
+
+  @param cache  the join order cache of the query block
+*/
+
+void Optimize_table_order::save_join_order(Join_order_cache *cache)
+{
+  const uint first= join->const_tables;
+
+  for (uint i= 0; i < join->tables - first; i++)
+  {
+    const JOIN_TAB *const tab= join->best_positions[first + i].table;
+    cache->order[i]= tab->table->map;
+    cache->rows_bucket[i]=
+      Join_order_cache::get_rows_bucket(tab->found_records);
+    cache->share_version[i]= tab->table->s->get_table_ref_version();
+  }
+  cache->const_table_map= join->const_table_map;
+  cache->valid= true;
+}
+
+
 /**
   Heuristic procedure to automatically guess a reasonable degree of
   exhaustiveness for the greedy search procedure.
@@ -25,6 +25,52 @@
 
 class Opt_trace_object;
 
+/**
+  Join order chosen by the greedy search for a query block of a prepared
+  statement, remembered so that later executions can skip the search.
+
+  The order is only replayed when the statement is executed with the same
+  set of const tables, every table's estimated row count falls in the same
+  power-of-two bucket as when the order was found, and no table definition
+  has changed in the meantime. Access methods are always recomputed, so
+  the reused plan still adapts to the current parameter values.
+
+  The cache is allocated on the statement mem_root and lives as long as
+  the prepared statement does.
+*/
+
+class Join_order_cache : public Sql_alloc
+{
+public:
+  Join_order_cache()
+    : table_count(0), valid(false), const_table_map(0),
+      order(NULL), rows_bucket(NULL), share_version(NULL)
+  {}
+
+  bool init(MEM_ROOT *mem_root, uint tables);
+
+  static uint get_rows_bucket(ha_rows rows)
+  {
+    uint bucket= 0;
+    for (; rows; rows>>= 1)
+      bucket++;
+    return bucket;
+  }
+
+  /// Number of tables in the query block, including const tables
+  uint table_count;
+  /// Whether the arrays below hold a join order
+  bool valid;
+  /// Const tables of the execution that stored the order
+  table_map const_table_map;
+  /// Non-const tables in join order
+  table_map *order;
+  /// get_rows_bucket() of JOIN_TAB::found_records, indexed like order
+  uint *rows_bucket;
+  /// TABLE_SHARE::get_table_ref_version(), indexed like order
+  ulonglong *share_version;
+};
+
 /**
   This class determines the optimal join order for tables within
   a basic query block, ie a query specification clause, possibly extended
@@ -101,6 +147,9 @@ private:
   void backout_nj_state(const table_map remaining_tables,
                         const JOIN_TAB *tab);
   void optimize_straight_join(table_map join_tables);
+  Join_order_cache *get_join_order_cache();
+  bool reuse_join_order(const Join_order_cache *cache);
+  void save_join_order(Join_order_cache *cache);
   bool greedy_search(table_map remaining_tables);
   bool best_extension_by_limited_search(table_map remaining_tables,
                                         uint idx,
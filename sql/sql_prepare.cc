@@ -81,7 +81,16 @@ When one supplies long data for a placeholder:
     server doesn't care; also, the server doesn't notify the client whether
     it got the data or not; if there is any error, then it will be returned
     at statement execute.
-*/
+
+When one sends a SELECT with COM_QUERY and @@query_template_cache_size > 0:
+
+  - Only the lexical analyzer is run on the query, to build its template:
+    the query text with the literals of the WHERE clause replaced by
+    parameter markers (see lex_query_template()).
+  - If the template is not in the connection's query template cache yet,
+    it is prepared as a prepared statement, which is added to the cache.
+  - The literals are assigned to the parameters of the prepared statement,
+    which is executed instead of parsing the query.
 
 #include "my_global.h"                          /* NO_EMBEDDED_ACCESS_CHECKS */
 #include "sql_priv.h"
@@ -153,7 +162,8 @@ public:
   enum flag_values
   {
     IS_IN_USE= 1,
-    IS_SQL_PREPARE= 2
+    IS_SQL_PREPARE= 2,
+    IS_QUERY_TEMPLATE= 4
   };
 
   THD *thd;
@@ -184,6 +194,9 @@ public:
   inline bool is_in_use() { return flags & (uint) IS_IN_USE; }
   inline bool is_sql_prepare() const { return flags & (uint) IS_SQL_PREPARE; }
   void set_sql_prepare() { flags|= (uint) IS_SQL_PREPARE; }
+  inline bool is_query_template() const
+  { return flags & (uint) IS_QUERY_TEMPLATE; }
+  void set_query_template() { flags|= (uint) IS_QUERY_TEMPLATE; }
   bool prepare(const char *packet, uint packet_length);
   bool execute_loop(String *expanded_query,
                     bool open_cursor,
@@ -3366,8 +3379,10 @@ bool Prepared_statement::prepare(const char *packet, uint packet_len)
     If this is an SQLCOM_PREPARE, we also increase Com_prepare_sql.
     However, it seems handy if com_stmt_prepare is increased always,
     no matter what kind of prepare is processed.
+    Query templates are internal and not accounted for.
   */
-  status_var_increment(thd->status_var.com_stmt_prepare);
+  if (!is_query_template())
+    status_var_increment(thd->status_var.com_stmt_prepare);
 
   if (! (lex= new (mem_root) st_lex_local))
     DBUG_RETURN(TRUE);
@@ -3531,8 +3546,11 @@ bool Prepared_statement::prepare(const char *packet, uint packet_len)
       we're inside a stored procedure (also called Dynamic SQL) --
       sub-statements inside stored procedures are not logged into
       the general log.
+
+      Query templates are not logged either, the query they are prepared
+      for is.
     */
-    if (thd->sp_runtime_ctx == NULL)
+    if (thd->sp_runtime_ctx == NULL && !is_query_template())
     {
       if (thd->rewritten_query.length())
         general_log_write(thd, COM_STMT_PREPARE,
@@ -3579,6 +3597,12 @@ Prepared_statement::set_parameters(String *expanded_query,
   bool is_sql_ps= packet == NULL;
   bool res= FALSE;
 
+  if (is_query_template())
+  {
+    /* Assigned from the query literals by query_template_find() */
+    return FALSE;
+  }
+
   if (is_sql_ps)
   {
     /* SQL prepared statement */
@@ -3768,6 +3792,8 @@ Prepared_statement::reprepare()
   Prepared_statement copy(thd);
 
   copy.set_sql_prepare(); /* To suppress sending metadata to the client. */
+  if (is_query_template())
+    copy.set_query_template();
 
   status_var_increment(thd->status_var.com_stmt_reprepare);
 
@@ -3925,7 +3951,8 @@ bool Prepared_statement::execute(String *expanded_query, bool open_cursor)
 
   LEX_STRING stmt_db_name= { db, db_length };
 
-  status_var_increment(thd->status_var.com_stmt_execute);
+  if (!is_query_template())
+    status_var_increment(thd->status_var.com_stmt_execute);
 
   if (flags & (uint) IS_IN_USE)
   {
@@ -4051,7 +4078,8 @@ bool Prepared_statement::execute(String *expanded_query, bool open_cursor)
         a hash of that hash.
       */
       rewrite_query_if_needed(thd);
-      log_execute_line(thd);
+      if (!is_query_template())
+        log_execute_line(thd);
 
       error= mysql_execute_command(thd);
       thd->m_statement_psi= parent_locker;
@@ -4107,6 +4135,374 @@ void Prepared_statement::deallocate()
 }
 
 
+/***************************************************************************
+* Query template cache
+***************************************************************************/
+
+/**
+  An entry of the query template cache: the template key, followed
+  in memory by the entry, and the statement prepared from the template.
+  A NULL statement marks a template which can not be executed as a
+  prepared statement, so that the query is parsed as usual.
+*/
+
+struct Query_template
+{
+  uchar *key;
+  size_t key_length;
+  Prepared_statement *stmt;
+};
+
+
+extern "C" uchar *get_query_template_key(const uchar *ptr, size_t *length,
+                                         my_bool not_used __attribute__((unused)))
+{
+  const Query_template *entry= (const Query_template *) ptr;
+  *length= entry->key_length;
+  return entry->key;
+}
+
+
+extern "C" void free_query_template(void *ptr)
+{
+  Query_template *entry= (Query_template *) ptr;
+  delete entry->stmt;
+  my_free(entry);
+}
+
+
+/**
+  SELECT statement templates of one connection, with the prepared
+  statements to execute them.
+*/
+
+class Query_template_cache
+{
+public:
+  Query_template_cache()
+  {
+    my_hash_init(&m_hash, &my_charset_bin, 16, 0, 0,
+                 get_query_template_key, free_query_template, 0);
+  }
+
+  ~Query_template_cache()
+  {
+    my_hash_free(&m_hash);
+  }
+
+  Query_template *find(const String *key)
+  {
+    return (Query_template *) my_hash_search(&m_hash,
+                                             (const uchar *) key->ptr(),
+                                             key->length());
+  }
+
+  /**
+    Add a template to the cache.
+
+    @param key   template key
+    @param stmt  statement prepared from the template, or NULL
+
+    @return Error status
+      @retval TRUE   out of memory, the statement is not freed
+      @retval FALSE  success, the cache owns the statement
+  */
+  bool insert(const String *key, Prepared_statement *stmt)
+  {
+    Query_template *entry=
+      (Query_template *) my_malloc(sizeof(Query_template) + key->length(),
+                                   MYF(MY_WME));
+    if (entry == NULL)
+      return TRUE;
+    entry->key= (uchar *) (entry + 1);
+    entry->key_length= key->length();
+    entry->stmt= stmt;
+    memcpy(entry->key, key->ptr(), key->length());
+    if (my_hash_insert(&m_hash, (uchar *) entry))
+    {
+      my_free(entry);
+      return TRUE;
+    }
+    return FALSE;
+  }
+
+  /**
+    Remove all templates from the cache if the number of templates
+    reached the argument value.
+
+    @param upper_limit_for_elements  upper limit of templates in the cache
+  */
+  void enforce_limit(ulong upper_limit_for_elements)
+  {
+    if (m_hash.records >= upper_limit_for_elements)
+      my_hash_reset(&m_hash);
+  }
+
+private:
+  HASH m_hash;
+};
+
+
+/**
+  Assign the literals cut out of a query to the parameters of the
+  statement prepared from the query template, the same way as values
+  sent by a client would be.
+
+  @param thd       current thread
+  @param stmt      statement prepared from the template
+  @param literals  literals of the query, one per parameter
+
+  @return Error status
+*/
+
+static bool insert_params_from_literals(THD *thd, Prepared_statement *stmt,
+                                        Query_template_literals *literals)
+{
+  Item_param **param= stmt->param_array;
+  DBUG_ENTER("insert_params_from_literals");
+
+  for (size_t i= 0; i < literals->size(); i++, param++)
+  {
+    const Query_template_literal &literal= literals->at(i);
+    Item_param *item= *param;
+
+    item->query_literal= TRUE;
+    switch (literal.type) {
+    case Query_template_literal::INT_LITERAL:
+    {
+      int error;
+      char *end= literal.value.str + literal.value.length;
+      item->set_int(my_strtoll10(literal.value.str, &end, &error),
+                    MY_INT64_NUM_DECIMAL_DIGITS);
+      item->item_type= Item::INT_ITEM;
+      item->item_result_type= INT_RESULT;
+      item->param_type= MYSQL_TYPE_LONGLONG;
+      break;
+    }
+    case Query_template_literal::DECIMAL_LITERAL:
+      item->set_decimal(literal.value.str, literal.value.length);
+      item->item_type= Item::DECIMAL_ITEM;
+      item->item_result_type= DECIMAL_RESULT;
+      item->param_type= MYSQL_TYPE_NEWDECIMAL;
+      break;
+    case Query_template_literal::STRING_LITERAL:
+    {
+      const CHARSET_INFO *fromcs= thd->variables.character_set_client;
+      const CHARSET_INFO *tocs= thd->variables.collation_connection;
+      uint32 dummy_offset;
+
+      /*
+        Like a string literal, the value gets the collation of the
+        connection, even if it does not have to be converted.
+      */
+      item->value.cs_info.character_set_of_placeholder=
+        String::needs_conversion(0, fromcs, tocs, &dummy_offset) ?
+        fromcs : tocs;
+      item->value.cs_info.character_set_client= fromcs;
+      item->value.cs_info.final_character_set_of_str_value= tocs;
+      item->item_type= Item::STRING_ITEM;
+      item->item_result_type= STRING_RESULT;
+      item->param_type= MYSQL_TYPE_VARCHAR;
+      if (item->set_str(literal.value.str, literal.value.length) ||
+          item->convert_str_value(thd))
+        DBUG_RETURN(TRUE);
+      break;
+    }
+    }
+  }
+  DBUG_RETURN(FALSE);
+}
+
+
+/**
+  Look up the template of a COM_QUERY statement in the query template cache
+  of the connection, preparing and adding the template on a miss.
+
+    The template is the query text with the literals of the WHERE clause
+    replaced by parameter markers, see lex_query_template(). It is found by
+    running the lexical analyzer only, and a matching statement is executed
+    by query_template_execute() instead of being parsed.
+
+  @param thd           current thread
+  @param parser_state  parser state of the query
+  @param[out] stmt     statement to execute, with its parameters assigned,
+                       or NULL if the query has to be parsed as usual
+
+  @return Error status
+    @retval TRUE   an error which must be reported to the client is set
+    @retval FALSE  success
+*/
+
+bool query_template_find(THD *thd, Parser_state *parser_state,
+                         Prepared_statement **stmt)
+{
+  PSI_digest_locker *digest_psi= NULL;
+  sql_digest_state *digest= NULL;
+  Query_template_literals literals(thd->mem_root);
+  Query_template *entry;
+  String key;
+  uint text_length;
+  DBUG_ENTER("query_template_find");
+
+  *stmt= NULL;
+
+  if (thd->m_digest != NULL)
+  {
+    digest_psi= MYSQL_DIGEST_START(thd->m_statement_psi);
+    if (parser_state->m_input.m_compute_digest || digest_psi != NULL)
+      digest= thd->m_digest;
+  }
+
+  /*
+    Statements without literals to cut out are not worth a template: they
+    would be executed from the cache only when repeated verbatim.
+  */
+  if (lex_query_template(thd, thd->query(), thd->query_length(), digest,
+                         &key, &literals) ||
+      literals.empty())
+    goto not_cached;
+
+  /*
+    Parsing and resolving a statement depends on the default database and
+    on the session variables which the parser copies into the parse tree.
+  */
+  text_length= key.length();
+  if (key.append('\0') ||
+      (thd->db && key.append(thd->db, thd->db_length)) ||
+      key.append('\0') ||
+      key.append((const char *) &thd->variables.sql_mode,
+                 sizeof(thd->variables.sql_mode)) ||
+      key.append((const char *) &thd->variables.character_set_client->number,
+                 sizeof(uint)) ||
+      key.append((const char *) &thd->variables.collation_connection->number,
+                 sizeof(uint)) ||
+      key.append((const char *) &thd->variables.collation_database->number,
+                 sizeof(uint)) ||
+      key.append((const char *) &thd->variables.default_week_format,
+                 sizeof(thd->variables.default_week_format)) ||
+      key.append((const char *) &thd->variables.old_passwords,
+                 sizeof(thd->variables.old_passwords)) ||
+      key.append((const char *) &thd->variables.lc_time_names->number,
+                 sizeof(uint)))
+    goto not_cached;
+
+  if (thd->query_template_cache == NULL &&
+      !(thd->query_template_cache= new Query_template_cache()))
+    goto not_cached;
+
+  if ((entry= thd->query_template_cache->find(&key)))
+  {
+    if (entry->stmt == NULL)
+      goto not_cached;
+    if (insert_params_from_literals(thd, entry->stmt, &literals))
+      DBUG_RETURN(TRUE);
+    status_var_increment(thd->status_var.query_template_cache_hits);
+    *stmt= entry->stmt;
+  }
+  else
+  {
+    Prepared_statement *new_stmt;
+
+    status_var_increment(thd->status_var.query_template_cache_misses);
+    thd->query_template_cache->enforce_limit(
+      thd->variables.query_template_cache_size);
+
+    if (!(new_stmt= new Prepared_statement(thd)))
+      DBUG_RETURN(TRUE);
+    new_stmt->set_sql_prepare();
+    new_stmt->set_query_template();
+
+    if (new_stmt->prepare(key.ptr(), text_length))
+    {
+      delete new_stmt;
+      /*
+        Errors which abort the transaction are reported, others come
+        again when the query is parsed and are reported from there.
+      */
+      if (thd->is_fatal_error || thd->killed ||
+          thd->get_stmt_da()->sql_errno() == ER_LOCK_DEADLOCK ||
+          thd->get_stmt_da()->sql_errno() == ER_LOCK_WAIT_TIMEOUT)
+        DBUG_RETURN(TRUE);
+      thd->clear_error();
+      thd->get_stmt_da()->clear_warning_info(thd->query_id);
+      goto not_cached;
+    }
+
+    /*
+      Only plain SELECT statements with a parameter for each literal are
+      executed from the cache. Statements using stored routines could
+      behave differently when prepared, and statements with warnings
+      from preparing would lose them when executed from the cache.
+    */
+    if (new_stmt->lex->sql_command != SQLCOM_SELECT ||
+        new_stmt->lex->uses_stored_routines() ||
+        new_stmt->param_count != literals.size() ||
+        thd->get_stmt_da()->current_statement_warn_count() != 0)
+    {
+      delete new_stmt;
+      thd->get_stmt_da()->clear_warning_info(thd->query_id);
+      new_stmt= NULL;
+    }
+
+    if (thd->query_template_cache->insert(&key, new_stmt))
+    {
+      delete new_stmt;
+      DBUG_RETURN(TRUE);
+    }
+
+    if (new_stmt == NULL)
+      goto not_cached;
+
+    if (insert_params_from_literals(thd, new_stmt, &literals))
+      DBUG_RETURN(TRUE);
+    *stmt= new_stmt;
+  }
+
+  if (digest_psi != NULL)
+    MYSQL_DIGEST_END(digest_psi, &thd->m_digest->m_digest_storage);
+  thd->lex->sql_command= SQLCOM_SELECT;
+  DBUG_RETURN(FALSE);
+
+not_cached:
+  /* The query is parsed as usual, which computes its digest again */
+  if (thd->m_digest != NULL)
+    thd->m_digest->reset(thd->m_token_array, max_digest_length);
+  DBUG_RETURN(thd->is_error());
+}
+
+
+/**
+  Execute a statement found by query_template_find().
+
+  @param thd   current thread
+  @param stmt  statement prepared from the template of the query
+
+  @return Error status
+*/
+
+bool query_template_execute(THD *thd, Prepared_statement *stmt)
+{
+  /*
+    The query, not the template, is what the logs, the query cache and
+    SHOW PROCESSLIST get to see.
+  */
+  String expanded_query(thd->query(), thd->query_length(), thd->charset());
+
+  return stmt->execute_loop(&expanded_query, FALSE, NULL, NULL);
+}
+
+
+/**
+  Free the query template cache of a connection.
+*/
+
+void query_template_cache_clear(THD *thd)
+{
+  delete thd->query_template_cache;
+  thd->query_template_cache= NULL;
+}
+
+
 /***************************************************************************
 * Ed_result_set
 ***************************************************************************/
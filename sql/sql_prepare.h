@@ -19,6 +19,8 @@
 
 class THD;
 struct LEX;
+class Parser_state;
+class Prepared_statement;
 
 /**
   An interface that is used to take an action when
@@ -75,6 +77,10 @@ void mysqld_stmt_fetch(THD *thd, char *packet, uint packet_length);
 void mysqld_stmt_reset(THD *thd, char *packet, uint packet_length);
 void mysql_stmt_get_longdata(THD *thd, char *pos, ulong packet_length);
 void reinit_stmt_before_use(THD *thd, LEX *lex);
+bool query_template_find(THD *thd, Parser_state *parser_state,
+                         Prepared_statement **stmt);
+bool query_template_execute(THD *thd, Prepared_statement *stmt);
+void query_template_cache_clear(THD *thd);
 
 /**
   Execute a fragment of server code in an isolated context, so that
@@ -2512,14 +2512,28 @@ static bool setup_join_buffering(JOIN_TAB *tab, JOIN *join,
       goto no_join_cache;
     }
 
-    if ((options & SELECT_DESCRIBE) ||
-        ((tab->op= new JOIN_CACHE_BNL(join, tab, prev_cache)) &&
-         !tab->op->init()))
     {
-      *icp_other_tables_ok= FALSE;
-      DBUG_ASSERT(might_do_join_buffering(join_buffer_alg(join->thd), tab));
-      tab->use_join_cache= JOIN_CACHE::ALG_BNL;
-      return false;
+      /*
+        Use the hashed variant of BNL if the condition of the table has
+        equalities with columns of the preceding tables.
+      */
+      JOIN_CACHE_BNL_HASH::Hash_key_part key_parts[MAX_REF_PARTS];
+      const bool use_hash=
+        join->thd->optimizer_switch_flag(OPTIMIZER_SWITCH_HASH_JOIN) &&
+        JOIN_CACHE_BNL_HASH::get_key_parts(tab, key_parts) > 0;
+
+      if ((options & SELECT_DESCRIBE) ||
+          ((tab->op= use_hash ?
+              new JOIN_CACHE_BNL_HASH(join, tab, prev_cache) :
+              new JOIN_CACHE_BNL(join, tab, prev_cache)) &&
+           !tab->op->init()))
+      {
+        *icp_other_tables_ok= FALSE;
+        DBUG_ASSERT(might_do_join_buffering(join_buffer_alg(join->thd), tab));
+        tab->use_join_cache= use_hash ? JOIN_CACHE::ALG_BNL_HASH :
+                                        JOIN_CACHE::ALG_BNL;
+        return false;
+      }
     }
     goto no_join_cache;
   case JT_SYSTEM:
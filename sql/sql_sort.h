@@ -88,6 +88,9 @@ public:
   uchar *unique_buff;
   bool not_killable;
   char* tmp_buffer;
+  uint max_sort_threads;      // Max threads for sorting a buffer in memory.
+  uint parallel_sort_buffers; // Buffers which were sorted by several threads.
+  uint parallel_sort_threads; // Most threads used for sorting one buffer.
   // The fields below are used only by Unique class.
   qsort2_cmp compare;
   BUFFPEK_COMPARE_CONTEXT cmp_context;
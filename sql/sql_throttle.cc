@@ -0,0 +1,229 @@
+/* Copyright (c) 2014, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql_class.h"          /* THD */
+#include "sql_throttle.h"
+#include "mysqld.h"
+
+#include <list>
+
+namespace {
+
+/** A query waiting for admission, lives on the stack of its thread. */
+struct Throttle_waiter
+{
+  Throttle_waiter(bool write) : is_write(write), admitted(false) {}
+  bool is_write;
+  /** Set, under LOCK_throttle_queue, when the query may run. */
+  bool admitted;
+};
+
+/** The waiting queries of one user, in arrival order. */
+struct Throttle_user_queue
+{
+  char user[USERNAME_LENGTH + 1];
+  std::list<Throttle_waiter*> waiters;
+};
+
+/**
+  Users with waiting queries. The user at the front is the next one to
+  get a query admitted, after which it moves to the back.
+  Protected by LOCK_throttle_queue.
+*/
+std::list<Throttle_user_queue> user_queues;
+
+/** Upper bounds, in microseconds, of the wait time histogram buckets. */
+const ulonglong wait_bucket_limit[]= { 1000, 10000, 100000, 1000000 };
+const uint WAIT_BUCKETS= array_elements(wait_bucket_limit) + 1;
+ulonglong wait_bucket_count[WAIT_BUCKETS];
+
+std::list<Throttle_user_queue>::iterator find_user_queue(const char *user)
+{
+  std::list<Throttle_user_queue>::iterator it= user_queues.begin();
+  for (; it != user_queues.end(); ++it)
+    if (!strcmp(it->user, user))
+      break;
+  return it;
+}
+
+
+/**
+  Admit as many waiting queries as the throttling limits allow.
+  A waiter leaves the running counters while it waits, so it fits when
+  running + 1 <= limit. The counters are incremented here on behalf of
+  the admitted query, so that two waiters cannot both take the last slot.
+*/
+void admit_waiters()
+{
+  mysql_mutex_assert_owner(&LOCK_throttle_queue);
+  int32 general_limit= (int32) opt_general_query_throttling_limit;
+  int32 write_limit= (int32) opt_write_query_throttling_limit;
+  bool admitted= false;
+
+  while (!user_queues.empty())
+  {
+    if (general_limit && get_thread_running() >= general_limit)
+      break;
+    bool write_full= write_limit && get_write_query_running() >= write_limit;
+
+    std::list<Throttle_user_queue>::iterator it= user_queues.begin();
+    for (; it != user_queues.end(); ++it)
+      if (!(write_full && it->waiters.front()->is_write))
+        break;
+    if (it == user_queues.end())
+      break;
+
+    Throttle_waiter *waiter= it->waiters.front();
+    it->waiters.pop_front();
+    if (it->waiters.empty())
+      user_queues.erase(it);
+    else
+      user_queues.splice(user_queues.end(), user_queues, it);
+
+    inc_thread_running();
+    if (waiter->is_write)
+      inc_write_query_running();
+    waiter->admitted= true;
+    throttle_queue_waiting--;
+    throttle_queue_admitted++;
+    admitted= true;
+  }
+
+  if (admitted)
+    mysql_cond_broadcast(&COND_throttle_queue);
+}
+
+
+void remove_waiter(const char *user, Throttle_waiter *waiter)
+{
+  mysql_mutex_assert_owner(&LOCK_throttle_queue);
+  std::list<Throttle_user_queue>::iterator it= find_user_queue(user);
+  DBUG_ASSERT(it != user_queues.end());
+  it->waiters.remove(waiter);
+  if (it->waiters.empty())
+    user_queues.erase(it);
+  throttle_queue_waiting--;
+}
+
+} // namespace
+
+int32 throttle_queue_waiting= 0;
+ulonglong throttle_queue_admitted= 0, throttle_queue_timed_out= 0;
+
+SHOW_VAR throttle_queue_wait_status[]=
+{
+  {"1ms",   (char*) &wait_bucket_count[0], SHOW_LONGLONG},
+  {"10ms",  (char*) &wait_bucket_count[1], SHOW_LONGLONG},
+  {"100ms", (char*) &wait_bucket_count[2], SHOW_LONGLONG},
+  {"1s",    (char*) &wait_bucket_count[3], SHOW_LONGLONG},
+  {"more",  (char*) &wait_bucket_count[4], SHOW_LONGLONG},
+  {NullS, NullS, SHOW_LONG}
+};
+
+
+/**
+  Wait in the admission queue until the query may run.
+
+  The caller has counted the query in the running counters; they are
+  left while waiting and are incremented again before returning,
+  whether or not the query was admitted.
+
+  @param thd       Thread running the query.
+  @param is_write  The query is counted against write_query_throttling_limit.
+
+  @retval false  The query was admitted.
+  @retval true   The queue is full, the wait timed out or the query was
+                 killed. No error has been set.
+*/
+
+bool throttle_queue_wait(THD *thd, bool is_write)
+{
+  DBUG_ENTER("throttle_queue_wait");
+  const char *user= thd->security_ctx->priv_user;
+  Throttle_waiter waiter(is_write);
+  PSI_stage_info old_stage;
+  struct timespec abstime;
+
+  mysql_mutex_lock(&LOCK_throttle_queue);
+  if ((uint) throttle_queue_waiting >= opt_query_throttling_queue_size)
+  {
+    mysql_mutex_unlock(&LOCK_throttle_queue);
+    DBUG_RETURN(true);
+  }
+
+  std::list<Throttle_user_queue>::iterator it= find_user_queue(user);
+  if (it == user_queues.end())
+  {
+    user_queues.push_back(Throttle_user_queue());
+    it= --user_queues.end();
+    strmake(it->user, user, USERNAME_LENGTH);
+  }
+  it->waiters.push_back(&waiter);
+  throttle_queue_waiting++;
+
+  dec_thread_running();
+  if (is_write)
+    dec_write_query_running();
+
+  ulonglong start_utime= my_micro_time();
+  set_timespec_nsec(abstime, opt_query_throttling_queue_timeout * 1000000ULL);
+  admit_waiters();
+
+  thd->ENTER_COND(&COND_throttle_queue, &LOCK_throttle_queue,
+                  &stage_waiting_for_query_admission, &old_stage);
+  while (!waiter.admitted && !thd->killed)
+  {
+    int error= mysql_cond_timedwait(&COND_throttle_queue,
+                                    &LOCK_throttle_queue, &abstime);
+    if (error == ETIMEDOUT || error == ETIME)
+      break;
+  }
+
+  if (!waiter.admitted)
+  {
+    remove_waiter(user, &waiter);
+    if (!thd->killed)
+      throttle_queue_timed_out++;
+    inc_thread_running();
+    if (is_write)
+      inc_write_query_running();
+  }
+
+  ulonglong wait_time= my_micro_time() - start_utime;
+  uint bucket= 0;
+  while (bucket < array_elements(wait_bucket_limit) &&
+         wait_time > wait_bucket_limit[bucket])
+    bucket++;
+  wait_bucket_count[bucket]++;
+
+  thd->EXIT_COND(&old_stage);
+  DBUG_RETURN(!waiter.admitted);
+}
+
+
+/**
+  Called when a query has stopped running, to admit waiting queries into
+  the freed slot.
+*/
+
+void throttle_queue_release()
+{
+  /* Dirty read: a waiter also tries to admit itself when it enqueues. */
+  if (!throttle_queue_waiting)
+    return;
+  mysql_mutex_lock(&LOCK_throttle_queue);
+  admit_waiters();
+  mysql_mutex_unlock(&LOCK_throttle_queue);
+}
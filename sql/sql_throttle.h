@@ -0,0 +1,43 @@
+/* Copyright (c) 2014, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef SQL_THROTTLE_INCLUDED
+#define SQL_THROTTLE_INCLUDED
+
+#include "my_global.h"
+
+class THD;
+struct st_mysql_show_var;
+
+/**
+  Admission queue for throttled queries.
+
+  When query throttling (general_query_throttling_limit,
+  write_query_throttling_limit) would reject a query and
+  query_throttling_queue_size is not 0, the query waits in this queue
+  instead, for at most query_throttling_queue_timeout milliseconds.
+  Waiting queries are admitted one user at a time, round robin between
+  the users, and in arrival order for each user.
+*/
+
+bool throttle_queue_wait(THD *thd, bool is_write);
+void throttle_queue_release();
+
+/** Number of queries currently waiting in the admission queue. */
+extern int32 throttle_queue_waiting;
+extern ulonglong throttle_queue_admitted, throttle_queue_timed_out;
+extern struct st_mysql_show_var throttle_queue_wait_status[];
+
+#endif /* SQL_THROTTLE_INCLUDED */
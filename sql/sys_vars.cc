@@ -62,6 +62,7 @@
 
 #include "log_event.h"
 #include "binlog.h"
+#include "rpl_master.h"
 
 #ifdef WITH_PERFSCHEMA_STORAGE_ENGINE
 #include "../storage/perfschema/pfs_server.h"
@@ -929,6 +930,14 @@ static Sys_var_mybool Sys_binlog_rows_query(
        SESSION_VAR(binlog_rows_query_log_events),
        CMD_LINE(OPT_ARG), DEFAULT(FALSE));
 
+static Sys_var_mybool Sys_binlog_transaction_compression(
+       "binlog_transaction_compression",
+       "Compress the events of each transaction into a single "
+       "Transaction_payload event when writing them to the binary log. "
+       "Slaves and mysqlbinlog must be able to read the event.",
+       SESSION_VAR(binlog_transaction_compression),
+       CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 static Sys_var_mybool Sys_binlog_order_commits(
        "binlog_order_commits",
        "Issue internal commit calls in the same order as transactions are"
@@ -936,6 +945,56 @@ static Sys_var_mybool Sys_binlog_order_commits(
        GLOBAL_VAR(opt_binlog_order_commits),
        CMD_LINE(OPT_ARG), DEFAULT(TRUE));
 
+static Sys_var_ulong Sys_binlog_group_commit_sync_delay(
+       "binlog_group_commit_sync_delay",
+       "The number of microseconds the leader of a binary log group commit"
+       " waits for more transactions to join the group before the binary"
+       " log is synchronized to disk. Only applies when sync_binlog is"
+       " non-zero. Default is 0, no delay.",
+       GLOBAL_VAR(opt_binlog_group_commit_sync_delay),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 1000000), DEFAULT(0),
+       BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_binlog_group_commit_sync_no_delay_count(
+       "binlog_group_commit_sync_no_delay_count",
+       "Stop waiting for binlog_group_commit_sync_delay as soon as this"
+       " many transactions have joined the group. Default is 0, wait for"
+       " the whole delay.",
+       GLOBAL_VAR(opt_binlog_group_commit_sync_no_delay_count),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 100000), DEFAULT(0),
+       BLOCK_SIZE(1));
+
+static Sys_var_mybool Sys_binlog_gtid_commit_group(
+       "binlog_gtid_commit_group",
+       "Record in each GTID event the binary log group commit that wrote the "
+       "transaction, so that a slave with "
+       "slave_parallel_type=LOGICAL_CLOCK can apply the transactions of one "
+       "group in parallel. Only used when gtid_mode is not OFF",
+       GLOBAL_VAR(opt_binlog_gtid_commit_group), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
+static const char *binlog_dependency_tracking_names[]=
+  {"COMMIT_ORDER", "WRITESET", 0};
+static Sys_var_enum Sys_binlog_transaction_dependency_tracking(
+       "binlog_transaction_dependency_tracking",
+       "How binlog_gtid_commit_group finds the transactions that a slave may "
+       "apply in parallel. COMMIT_ORDER: the transactions of one binary log "
+       "group commit. WRITESET: also the transactions of later group commits, "
+       "as long as they did not change a row with the same primary or "
+       "unique key value",
+       GLOBAL_VAR(opt_binlog_transaction_dependency_tracking),
+       CMD_LINE(REQUIRED_ARG), binlog_dependency_tracking_names,
+       DEFAULT(DEPENDENCY_TRACKING_COMMIT_ORDER));
+
+static Sys_var_ulong Sys_binlog_transaction_dependency_history_size(
+       "binlog_transaction_dependency_history_size",
+       "Maximum number of row hashes kept to find the transactions that "
+       "conflict, with binlog_transaction_dependency_tracking=WRITESET. "
+       "Larger transactions are never applied in parallel",
+       GLOBAL_VAR(opt_binlog_transaction_dependency_history_size),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(1, 1000000), DEFAULT(25000),
+       BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_bulk_insert_buff_size(
        "bulk_insert_buffer_size", "Size of tree cache used in bulk "
        "insert optimisation. Note that this is a limit per thread!",
@@ -2091,7 +2150,7 @@ static const char *optimizer_switch_names[]=
   "materialization", "semijoin", "loosescan", "firstmatch",
   "subquery_materialization_cost_based",
 #endif
-  "use_index_extensions", "default", NullS
+  "use_index_extensions", "hash_join", "default", NullS
 };
 /** propagates changes to @@engine_condition_pushdown */
 static bool fix_optimizer_switch(sys_var *self, THD *thd,
@@ -2113,8 +2172,8 @@ static Sys_var_flagset Sys_optimizer_switch(
        ", materialization, semijoin, loosescan, firstmatch,"
        " subquery_materialization_cost_based"
 #endif
-       ", block_nested_loop, batched_key_access, use_index_extensions"
-       "} and val is one of {on, off, default}",
+       ", block_nested_loop, batched_key_access, use_index_extensions,"
+       " hash_join} and val is one of {on, off, default}",
        SESSION_VAR(optimizer_switch), CMD_LINE(REQUIRED_ARG),
        optimizer_switch_names, DEFAULT(OPTIMIZER_SWITCH_DEFAULT),
        NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(NULL),
@@ -2128,6 +2187,15 @@ static Sys_var_mybool Sys_var_end_markers_in_json(
        SESSION_VAR(end_markers_in_json), CMD_LINE(OPT_ARG),
        DEFAULT(FALSE));
 
+static Sys_var_mybool Sys_prepared_stmt_plan_cache(
+       "prepared_stmt_plan_cache",
+       "If set to 1, executions of a prepared statement reuse the join order "
+       "chosen by a previous execution, as long as the estimated number of "
+       "rows of every table stays within the same order of magnitude and no "
+       "table definition has changed",
+       SESSION_VAR(prepared_stmt_plan_cache), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 #ifdef OPTIMIZER_TRACE
 
 static Sys_var_flagset Sys_optimizer_trace(
@@ -2666,7 +2734,39 @@ static Sys_var_uint Sys_write_query_throttling_limit(
        VALID_RANGE(0, 5000), DEFAULT(0),
        BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0), ON_UPDATE(0));
 
+static Sys_var_uint Sys_query_throttling_queue_size(
+       "query_throttling_queue_size",
+       "Maximum number of throttled queries which wait for a running query "
+       "to finish instead of being rejected. 0 rejects throttled queries "
+       "immediately.",
+       GLOBAL_VAR(opt_query_throttling_queue_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 100000), DEFAULT(0),
+       BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0), ON_UPDATE(0));
+
+static Sys_var_ulong Sys_query_throttling_queue_timeout(
+       "query_throttling_queue_timeout",
+       "Maximum time in milliseconds a throttled query waits for admission "
+       "before it is rejected.",
+       GLOBAL_VAR(opt_query_throttling_queue_timeout), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 3600 * 1000), DEFAULT(1000), BLOCK_SIZE(1));
+
 #ifdef HAVE_REPLICATION
+static bool fix_binlog_dump_cache_size(sys_var *self, THD *thd,
+                                       enum_var_type type)
+{
+  binlog_dump_cache.trim();
+  return false;
+}
+static Sys_var_ulonglong Sys_binlog_dump_cache_size(
+       "binlog_dump_cache_size",
+       "The size of the cache of the last events of the active binary log, "
+       "from which the binlog dump threads which are caught up send the "
+       "events instead of reading the file. 0 disables the cache",
+       GLOBAL_VAR(binlog_dump_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, ULONGLONG_MAX), DEFAULT(8 * 1024 * 1024),
+       BLOCK_SIZE(1024), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_binlog_dump_cache_size));
+
 static const char *slave_exec_mode_names[]=
        {"STRICT", "IDEMPOTENT", 0};
 static Sys_var_enum Slave_exec_mode(
@@ -2792,6 +2892,14 @@ static Sys_var_ulong Sys_sort_buffer(
        VALID_RANGE(MIN_SORT_MEMORY, ULONG_MAX), DEFAULT(DEFAULT_SORT_MEMORY),
        BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_filesort_max_threads(
+       "filesort_max_threads",
+       "Maximum number of threads used to sort the in-memory sort buffer "
+       "of a filesort. 1 means the buffer is always sorted by the thread "
+       "running the query",
+       SESSION_VAR(filesort_max_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_FILESORT_THREADS), DEFAULT(1), BLOCK_SIZE(1));
+
 void sql_mode_deprecation_warnings(sql_mode_t sql_mode)
 {
   /**
@@ -4135,6 +4243,15 @@ static Sys_var_ulonglong Sys_relay_log_space_limit(
        READ_ONLY GLOBAL_VAR(relay_log_space_limit), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, ULONG_MAX), DEFAULT(0), BLOCK_SIZE(1));
 
+static Sys_var_ulonglong Sys_relay_log_pipeline_size(
+       "relay_log_pipeline_size",
+       "Maximum size of the events which the slave I/O thread keeps in "
+       "memory, already parsed, for the slave SQL thread after appending "
+       "them to the relay log, so that a slave which is caught up does not "
+       "read them back from the relay log. Use 0 to disable",
+       GLOBAL_VAR(opt_relay_log_pipeline_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, ULONG_MAX), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_uint Sys_sync_relaylog_period(
        "sync_relay_log", "Synchronously flush relay log to disk after "
        "every #th event. Use 0 to disable synchronous flushing",
@@ -4198,6 +4315,25 @@ static Sys_var_ulong Sys_slave_parallel_workers(
        GLOBAL_VAR(opt_mts_slave_parallel_workers), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, MTS_MAX_WORKERS), DEFAULT(0), BLOCK_SIZE(1));
 
+static const char *mts_parallel_type_names[]= {"DATABASE", "LOGICAL_CLOCK", 0};
+static Sys_var_enum Sys_mts_parallel_type(
+       "slave_parallel_type",
+       "Specifies how the multi-threaded slave decides which transactions "
+       "are applied in parallel. DATABASE: transactions updating different "
+       "databases. LOGICAL_CLOCK: transactions that were committed in the "
+       "same binary log group commit on the master, which requires the "
+       "master to run with binlog_gtid_commit_group. Takes effect at the "
+       "next START SLAVE",
+       GLOBAL_VAR(opt_mts_parallel_type), CMD_LINE(REQUIRED_ARG),
+       mts_parallel_type_names, DEFAULT(MTS_PARALLEL_TYPE_DB_NAME));
+
+static Sys_var_mybool Sys_slave_preserve_commit_order(
+       "slave_preserve_commit_order",
+       "Make the slave worker threads commit transactions in the order they "
+       "appear in the relay log. Takes effect at the next START SLAVE",
+       GLOBAL_VAR(opt_slave_preserve_commit_order), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static Sys_var_ulonglong Sys_mts_pending_jobs_size_max(
        "slave_pending_jobs_size_max",
        "Max size of Slave Worker queues holding yet not applied events."
@@ -4375,6 +4511,16 @@ static Sys_var_ulong Sys_sp_cache_size(
        GLOBAL_VAR(stored_program_cache_size), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(256, 512 * 1024), DEFAULT(256), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_query_template_cache_size(
+       "query_template_cache_size",
+       "The upper limit for number of SELECT statement templates cached "
+       "for one connection. A template is the statement text with the "
+       "literals of its WHERE clause replaced by parameter markers; "
+       "statements matching a cached template are executed without being "
+       "parsed again. 0 disables the cache.",
+       SESSION_VAR(query_template_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 64 * 1024), DEFAULT(0), BLOCK_SIZE(1));
+
 static bool check_pseudo_slave_mode(sys_var *self, THD *thd, set_var *var)
 {
   longlong previous_val= thd->variables.pseudo_slave_mode;
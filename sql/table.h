@@ -338,9 +338,9 @@ public:
   ha_rows   found_records;      /* How many records in sort */
 
   Filesort_info(): record_pointers(0) {};
-  /** Sort filesort_buffer */
-  void sort_buffer(Sort_param *param, uint count)
-  { filesort_buffer.sort_buffer(param, count); }
+  /** Sort filesort_buffer, returns the number of threads used */
+  uint sort_buffer(Sort_param *param, uint count)
+  { return filesort_buffer.sort_buffer(param, count); }
 
   /**
      Accessors for Filesort_buffer (which @c).
@@ -988,19 +988,23 @@ struct TABLE
 
 private:
   /**
-     Links for the lists of used/unused TABLE objects for the particular
-     table in the specific instance of Table_cache (in other words for
-     specific Table_cache_element object).
-     Declared as private to avoid direct manipulation with those objects.
-     One should use methods of I_P_List template instead.
+     Position of this TABLE object in the array of TABLE objects for
+     the particular table in the specific instance of Table_cache (in
+     other words for specific Table_cache_element object).
+     Declared as private to avoid direct manipulation with it.
   */
-  TABLE *cache_next, **cache_prev;
+  uint cache_slot;
+  /**
+     Value of Table_cache LRU clock at the moment this TABLE object was
+     put back into the table cache as unused.
+  */
+  ulonglong cache_last_used;
 
   /*
-    Give Table_cache_element access to the above two members to allow
-    using them for linking TABLE objects in a list.
+    Give table cache classes access to the above two members.
   */
   friend class Table_cache_element;
+  friend class Table_cache;
 
 public:
 
@@ -57,8 +57,10 @@ extern "C" void table_cache_free_entry(Table_cache_element *element)
 bool Table_cache::init()
 {
   mysql_mutex_init(m_lock_key, &m_lock, MY_MUTEX_INIT_FAST);
-  m_unused_tables= NULL;
+  m_fast_path_state= 0;
   m_table_count= 0;
+  m_lru_clock= 0;
+  m_hits= m_misses= m_overflows= 0;
 
   if (my_hash_init(&m_cache, &my_charset_bin,
                    table_cache_size_per_instance, 0, 0,
@@ -76,6 +78,7 @@ bool Table_cache::init()
 
 void Table_cache::destroy()
 {
+  m_elements.empty();
   my_hash_free(&m_cache);
   mysql_mutex_destroy(&m_lock);
 }
@@ -91,57 +94,49 @@ void Table_cache::init_psi_keys()
 }
 
 
-#ifdef EXTRA_DEBUG
-void Table_cache::check_unused()
+/**
+  Wait until all threads which have entered the fast path before
+  we have blocked it leave it.
+*/
+
+void Table_cache::wait_for_fast_path_exit()
 {
-  uint count= 0;
+  assert_owner();
+
+  while (my_atomic_load32(&m_fast_path_state) != FAST_PATH_BLOCKED)
+    pthread_yield();
+}
 
-  if (m_unused_tables != NULL)
-  {
-    TABLE *cur_link= m_unused_tables;
-    TABLE *start_link= m_unused_tables;
-    do
-    {
-      if (cur_link != cur_link->next->prev || cur_link != cur_link->prev->next)
-      {
-	DBUG_PRINT("error",("Unused_links aren't linked properly"));
-	return;
-      }
-    } while (count++ < m_table_count &&
-	     (cur_link= cur_link->next) != start_link);
-    if (cur_link != start_link)
-      DBUG_PRINT("error",("Unused_links aren't connected"));
-  }
 
+#ifdef EXTRA_DEBUG
+void Table_cache::check_unused()
+{
   for (uint idx= 0; idx < m_cache.records; idx++)
   {
     Table_cache_element *el=
       (Table_cache_element*) my_hash_element(&m_cache, idx);
 
-    Table_cache_element::TABLE_list::Iterator it(el->free_tables);
-    TABLE *entry;
-    while ((entry= it++))
+    for (uint i= 0; i < el->table_count; i++)
     {
-      /* We must not have TABLEs in the free list that have their file closed. */
-      DBUG_ASSERT(entry->db_stat && entry->file);
-      /* Merge children should be detached from a merge parent */
-      DBUG_ASSERT(! entry->file->extra(HA_EXTRA_IS_ATTACHED_CHILDREN));
-
-      if (entry->in_use)
-        DBUG_PRINT("error",("Used table is in share's list of unused tables"));
-      count--;
-    }
-    it.init(el->used_tables);
-    while ((entry= it++))
-    {
-      if (!entry->in_use)
-        DBUG_PRINT("error",("Unused table is in share's list of used tables"));
+      TABLE *entry= el->tables[i];
+
+      if (entry->cache_slot != i)
+        DBUG_PRINT("error",("TABLE is in wrong slot of share's array"));
+
+      if (el->is_free(i))
+      {
+        /* We must not have unused TABLEs that have their file closed. */
+        DBUG_ASSERT(entry->db_stat && entry->file);
+        /* Merge children should be detached from a merge parent */
+        DBUG_ASSERT(! entry->file->extra(HA_EXTRA_IS_ATTACHED_CHILDREN));
+
+        if (entry->in_use)
+          DBUG_PRINT("error",("Used table is marked as unused"));
+      }
+      else if (!entry->in_use)
+        DBUG_PRINT("error",("Unused table is marked as used"));
     }
   }
-
-  if (count != 0)
-    DBUG_PRINT("error",("Unused_links doesn't match open_cache: diff: %d",
-                        count));
 }
 #endif
 
@@ -152,11 +147,25 @@ void Table_cache::free_all_unused_tables()
 {
   assert_owner();
 
-  while (m_unused_tables)
+  Element_list::Iterator it(m_elements);
+  Table_cache_element *el;
+
+  while ((el= it++))
   {
-    TABLE *table_to_free= m_unused_tables;
-    remove_table(table_to_free);
-    intern_close_table(table_to_free);
+    /*
+      Iterate backwards as removal of TABLE moves the last TABLE of
+      the element to its place. The element itself is destroyed when
+      its last TABLE is removed, so don't touch it after that.
+    */
+    for (uint i= el->table_count; i-- > 0; )
+    {
+      if (el->is_free(i))
+      {
+        TABLE *table_to_free= el->tables[i];
+        remove_table(table_to_free);
+        intern_close_table(table_to_free);
+      }
+    }
   }
 }
 
@@ -168,9 +177,6 @@ void Table_cache::free_all_unused_tables()
 
 void Table_cache::print_tables()
 {
-  uint unused= 0;
-  uint count=0;
-
   compile_time_assert(TL_WRITE_ONLY+1 == array_elements(lock_descriptions));
 
   for (uint idx= 0; idx < m_cache.records; idx++)
@@ -178,44 +184,21 @@ void Table_cache::print_tables()
     Table_cache_element *el=
       (Table_cache_element*) my_hash_element(&m_cache, idx);
 
-    Table_cache_element::TABLE_list::Iterator it(el->used_tables);
-    TABLE *entry;
-    while ((entry= it++))
-    {
-      printf("%-14.14s %-32s%6ld%8ld%6d  %s\n",
-             entry->s->db.str, entry->s->table_name.str, entry->s->version,
-             entry->in_use->thread_id, entry->db_stat ? 1 : 0,
-             lock_descriptions[(int)entry->reginfo.lock_type]);
-    }
-    it.init(el->free_tables);
-    while ((entry= it++))
+    for (uint i= 0; i < el->table_count; i++)
     {
-      unused++;
-      printf("%-14.14s %-32s%6ld%8ld%6d  %s\n",
-             entry->s->db.str, entry->s->table_name.str, entry->s->version,
-             0L, entry->db_stat ? 1 : 0, "Not in use");
+      TABLE *entry= el->tables[i];
+
+      if (el->is_free(i))
+        printf("%-14.14s %-32s%6ld%8ld%6d  %s\n",
+               entry->s->db.str, entry->s->table_name.str, entry->s->version,
+               0L, entry->db_stat ? 1 : 0, "Not in use");
+      else
+        printf("%-14.14s %-32s%6ld%8ld%6d  %s\n",
+               entry->s->db.str, entry->s->table_name.str, entry->s->version,
+               entry->in_use->thread_id, entry->db_stat ? 1 : 0,
+               lock_descriptions[(int)entry->reginfo.lock_type]);
     }
   }
-
-  if (m_unused_tables != NULL)
-  {
-    TABLE *start_link= m_unused_tables;
-    TABLE *lnk= m_unused_tables;
-    do
-    {
-      if (lnk != lnk->next->prev || lnk != lnk->prev->next)
-      {
-	printf("unused_links isn't linked properly\n");
-	return;
-      }
-    } while (count++ < m_table_count && (lnk= lnk->next) != start_link);
-    if (lnk != start_link)
-      printf("Unused_links aren't connected\n");
-  }
-
-  if (count != unused)
-    printf("Unused_links (%d) doesn't match table_def_cache: %d\n", count,
-           unused);
 }
 #endif
 
@@ -240,6 +223,66 @@ bool Table_cache_manager::init()
     }
   }
 
+  if (init_status_vars())
+  {
+    for (uint i= 0; i < table_cache_instances; i++)
+      m_table_cache[i].destroy();
+    return true;
+  }
+
+  return false;
+}
+
+
+/**
+  Build array of status variables with per-instance counters of
+  table cache hits, misses and overflows (e.g. 0_hits, 0_misses,
+  0_overflows, 1_hits, ...).
+
+  @retval false - success.
+  @retval true  - failure.
+*/
+
+bool Table_cache_manager::init_status_vars()
+{
+  const uint NAME_SIZE= 16;
+  uint count= table_cache_instances * 3;
+  char *name;
+
+  if (!(m_status_vars= (SHOW_VAR*) my_malloc((count + 1) *
+                                             (sizeof(SHOW_VAR) + NAME_SIZE),
+                                             MYF(MY_WME))))
+    return true;
+
+  name= (char*) (m_status_vars + count + 1);
+
+  for (uint i= 0; i < table_cache_instances; i++)
+  {
+    SHOW_VAR *var= &m_status_vars[i * 3];
+
+    my_snprintf(name, NAME_SIZE, "%u_hits", i);
+    var[0].name= name;
+    var[0].value= (char*) &m_table_cache[i].m_hits;
+    var[0].type= SHOW_LONGLONG;
+    name+= NAME_SIZE;
+
+    my_snprintf(name, NAME_SIZE, "%u_misses", i);
+    var[1].name= name;
+    var[1].value= (char*) &m_table_cache[i].m_misses;
+    var[1].type= SHOW_LONGLONG;
+    name+= NAME_SIZE;
+
+    my_snprintf(name, NAME_SIZE, "%u_overflows", i);
+    var[2].name= name;
+    var[2].value= (char*) &m_table_cache[i].m_overflows;
+    var[2].type= SHOW_LONGLONG;
+    name+= NAME_SIZE;
+  }
+
+  m_status_vars[count].name= NullS;
+  m_status_vars[count].value= NullS;
+  m_status_vars[count].type= SHOW_LONG;
+
   return false;
 }
 
@@ -250,6 +293,9 @@ void Table_cache_manager::destroy()
 {
   for (uint i= 0; i < table_cache_instances; i++)
     m_table_cache[i].destroy();
+
+  my_free(m_status_vars);
+  m_status_vars= NULL;
 }
 
 
@@ -356,28 +402,33 @@ void Table_cache_manager::free_table(THD *thd,
   {
     if (cache_el[i])
     {
-      Table_cache_element::TABLE_list::Iterator it(cache_el[i]->free_tables);
-      TABLE *table;
+      Table_cache_element *el= cache_el[i];
 
 #ifndef DBUG_OFF
-      if (remove_type == TDC_RT_REMOVE_ALL)
-        DBUG_ASSERT(cache_el[i]->used_tables.is_empty());
-      else if (remove_type == TDC_RT_REMOVE_NOT_OWN ||
-               remove_type == TDC_RT_REMOVE_NOT_OWN_KEEP_SHARE)
+      for (uint j= 0; j < el->table_count; j++)
       {
-        Table_cache_element::TABLE_list::Iterator it2(cache_el[i]->used_tables);
-        while ((table= it2++))
+        if (el->is_free(j))
+          continue;
+        if (remove_type == TDC_RT_REMOVE_ALL)
+          DBUG_ASSERT(0);
+        else if (remove_type == TDC_RT_REMOVE_NOT_OWN ||
+                 remove_type == TDC_RT_REMOVE_NOT_OWN_KEEP_SHARE)
         {
-          if (table->in_use != thd)
+          if (el->tables[j]->in_use != thd)
             DBUG_ASSERT(0);
         }
       }
 #endif
 
-      while ((table= it++))
+      /* @sa Table_cache::free_all_unused_tables() */
+      for (uint j= el->table_count; j-- > 0; )
       {
-        m_table_cache[i].remove_table(table);
-        intern_close_table(table);
+        if (el->is_free(j))
+        {
+          TABLE *table= el->tables[j];
+          m_table_cache[i].remove_table(table);
+          intern_close_table(table);
+        }
       }
     }
   }
@@ -17,9 +17,84 @@
 #define TABLE_CACHE_INCLUDED
 
 #include "my_global.h"
+#include "my_atomic.h"
+#include "my_bit.h"
 #include "sql_class.h"
 #include "sql_base.h"
 
+/**
+  Element that represents the table in the specific table cache.
+  Plays for table cache instance role similar to role of TABLE_SHARE
+  for table definition cache.
+
+  It is an implementation detail of Table_cache and is present
+  in the header file only to allow inlining of some methods.
+*/
+
+class Table_cache_element
+{
+private:
+  /*
+    Array with all TABLE objects for this table in this table cache
+    (one such array per table cache), both used and unused. Each TABLE
+    knows its position in this array (TABLE::cache_slot).
+    The array can only be changed by owner of the table cache lock,
+    so it is stable for threads on the fast path.
+  */
+  TABLE **tables;
+  uint table_count;
+  /** Number of slots allocated for the above array. */
+  uint table_slots;
+  /*
+    Bitmap of slots in the above array which hold unused TABLE objects,
+    64 slots per word. To get an unused TABLE object one has to clear
+    its bit, to put it back - to set it. Both are done atomically, so
+    it is possible without table cache lock.
+  */
+  volatile int64 *free_map;
+  TABLE_SHARE *share;
+  /* Links for the list of all elements in the table cache. */
+  Table_cache_element *cache_next, **cache_prev;
+
+  static int64 slot_bit(uint slot)
+  {
+    return (int64) (((ulonglong) 1) << (slot % 64));
+  }
+
+  bool is_free(uint slot) const
+  {
+    return free_map[slot / 64] & slot_bit(slot);
+  }
+
+  bool is_empty() const { return table_count == 0; }
+
+  inline bool add_table(TABLE *table);
+  inline void remove_table(TABLE *table);
+  inline TABLE *get_free_table();
+  inline void put_free_table(TABLE *table);
+
+public:
+
+  Table_cache_element(TABLE_SHARE *share_arg)
+    : tables(NULL), table_count(0), table_slots(0), free_map(NULL),
+      share(share_arg), cache_next(NULL), cache_prev(NULL)
+  {
+  }
+
+  ~Table_cache_element()
+  {
+    my_free(tables);
+    my_free((void *) free_map);
+  }
+
+  TABLE_SHARE * get_share() const { return share; };
+
+  friend class Table_cache;
+  friend class Table_cache_manager;
+  friend class Table_cache_iterator;
+};
+
+
 /**
   Cache for open TABLE objects.
 
@@ -28,7 +103,8 @@
   therefore don't need to lock LOCK_open mutex.
   Instead they only need to go to one Table_cache instance (the
   specific instance is determined by thread id) and only lock the
-  mutex protecting this cache.
+  mutex protecting this cache. Getting a TABLE object which is already
+  in this cache and putting it back usually don't need even this mutex.
   DDL statements that need to remove all TABLE objects from all caches
   need to lock mutexes for all Table_cache instances, but they are rare.
 
@@ -41,15 +117,13 @@ private:
   /**
     The table cache lock protects the following data:
 
-    1) m_unused_tables list.
-    2) m_cache hash.
-    3) used_tables, free_tables lists in Table_cache_element objects in
-       this cache.
-    4) m_table_count - total number of TABLE objects in this cache.
-    5) the element in TABLE_SHARE::cache_element[] array that corresponds
+    1) m_cache hash and m_elements list.
+    2) set of TABLE objects in Table_cache_element objects in this cache
+       (but not the used/unused state of these objects, see below).
+    3) m_table_count - total number of TABLE objects in this cache.
+    4) the element in TABLE_SHARE::cache_element[] array that corresponds
        to this cache,
-    6) in_use member in TABLE object.
-    7) Also ownership of mutexes for all caches are required to update
+    5) Also ownership of mutexes for all caches are required to update
        the refresh_version and table_def_shutdown_in_progress variables
        and TABLE_SHARE::version member.
 
@@ -60,25 +134,47 @@ private:
     most usage of the MySQL Server should be able to set the cache size
     big enough so that the majority of the queries only need to lock this
     mutex instance and not LOCK_open.
+
+    Moreover, getting an unused TABLE object from the cache and putting
+    it back in the common case doesn't need this mutex either. Such
+    requests are served on the "fast path" (@sa fast_path_get_table()
+    and fast_path_release_table()), which only reads the data listed
+    above and flips bits in Table_cache_element::free_map. Owner of the
+    lock excludes the fast path by means of m_fast_path_state, so data
+    protected by the lock (including TABLE::in_use members) is stable
+    while it is held, exactly as if all accesses were serialized by it.
   */
   mysql_mutex_t m_lock;
 
+  /**
+    Number of threads which are on the fast path in this cache plus
+    FAST_PATH_BLOCKED if the lock on the cache is owned, which prevents
+    new threads from entering the fast path.
+  */
+  volatile int32 m_fast_path_state;
+
+  static const int32 FAST_PATH_BLOCKED= 1 << 30;
+
   /**
     The hash of Table_cache_element objects, each table/table share that
     has any TABLE object in the Table_cache has a Table_cache_element from
-    which the list of free TABLE objects in this table cache AND the list
-    of used TABLE objects in this table cache is stored.
+    which both free and used TABLE objects for this table in this table
+    cache can be found.
     We use Table_cache_element::share::table_cache_key as key for this hash.
   */
   HASH m_cache;
 
   /**
-    List that contains all TABLE instances for tables in this particular
-    table cache that are in not use by any thread. Recently used TABLE
-    instances are appended to the end of the list. Thus the beginning of
-    the list contains which have been least recently used.
+    List of all Table_cache_element objects in m_cache. Allows to iterate
+    over elements while some of them are deleted from the hash.
   */
-  TABLE *m_unused_tables;
+  typedef I_P_List <Table_cache_element,
+                    I_P_List_adapter<Table_cache_element,
+                                     &Table_cache_element::cache_next,
+                                     &Table_cache_element::cache_prev> >
+          Element_list;
+
+  Element_list m_elements;
 
   /**
     Total number of TABLE instances for tables in this particular table
@@ -88,6 +184,23 @@ private:
   */
   uint m_table_count;
 
+  /**
+    Counter incremented each time a TABLE is put back into this cache.
+    Its value is stored in TABLE::cache_last_used, which allows to find
+    the least recently used unused TABLE instance without maintaining
+    a list of them (which could not be updated on the fast path).
+  */
+  volatile int64 m_lru_clock;
+
+  /*
+    Number of cache hits, misses and overflows for this cache instance.
+    Same as Table_open_cache_* status variables, but accounted per
+    instance rather than per connection.
+  */
+  volatile int64 m_hits;
+  volatile int64 m_misses;
+  volatile int64 m_overflows;
+
 #ifdef HAVE_PSI_INTERFACE
   static PSI_mutex_key m_lock_key;
   static PSI_mutex_info m_mutex_keys[];
@@ -100,21 +213,54 @@ private:
 #else
   void check_unused() {}
 #endif
-  inline void link_unused_table(TABLE *table);
-  inline void unlink_unused_table(TABLE *table);
+  inline TABLE* get_lru_unused_table();
 
   inline void free_unused_tables_if_necessary(THD *thd);
 
+  /**
+    Try to enter the fast path.
+
+    @retval true  - success, caller should call fast_path_exit() later.
+    @retval false - the table cache is locked, caller should use
+                    the locked path.
+  */
+  bool fast_path_enter()
+  {
+    if (my_atomic_add32(&m_fast_path_state, 1) & FAST_PATH_BLOCKED)
+    {
+      my_atomic_add32(&m_fast_path_state, -1);
+      return false;
+    }
+    return true;
+  }
+  void fast_path_exit() { my_atomic_add32(&m_fast_path_state, -1); }
+
+  void wait_for_fast_path_exit();
+
 public:
 
   bool init();
   void destroy();
   static void init_psi_keys();
 
-  /** Acquire lock on table cache instance. */
-  void lock() { mysql_mutex_lock(&m_lock); }
+  /**
+    Acquire lock on table cache instance.
+
+    Also blocks the fast path and waits until threads which are on it
+    leave, so the caller gets exclusive access to the cache.
+  */
+  void lock()
+  {
+    mysql_mutex_lock(&m_lock);
+    if (my_atomic_add32(&m_fast_path_state, FAST_PATH_BLOCKED) != 0)
+      wait_for_fast_path_exit();
+  }
   /** Release lock on table cache instance. */
-  void unlock() { mysql_mutex_unlock(&m_lock); }
+  void unlock()
+  {
+    my_atomic_add32(&m_fast_path_state, -FAST_PATH_BLOCKED);
+    mysql_mutex_unlock(&m_lock);
+  }
   /** Assert that caller owns lock on the table cache. */
   void assert_owner() { mysql_mutex_assert_owner(&m_lock); }
 
@@ -124,17 +270,30 @@ public:
 
   inline void release_table(THD *thd, TABLE *table);
 
+  inline TABLE* fast_path_get_table(THD *thd, my_hash_value_type hash_value,
+                                    const char *key, uint key_length,
+                                    bool ignore_flush);
+
+  inline bool fast_path_release_table(THD *thd, TABLE *table);
+
   inline bool add_used_table(THD *thd, TABLE *table);
   inline void remove_table(TABLE *table);
 
   /** Get number of TABLE instances in the cache. */
   uint cached_tables() const { return m_table_count; }
 
+  /** Account for request satisfied by unused TABLE from the cache. */
+  void inc_hits() { my_atomic_add64(&m_hits, 1); }
+  /** Account for request which had to create new TABLE for the cache. */
+  void inc_misses() { my_atomic_add64(&m_misses, 1); }
+
   void free_all_unused_tables();
 
 #ifndef DBUG_OFF
   void print_tables();
 #endif
+
+  friend class Table_cache_manager;
 };
 
 
@@ -181,61 +340,32 @@ public:
   void print_tables();
 #endif
 
+  /**
+    Get array with status variables for hit, miss and overflow counters
+    of each table cache instance.
+  */
+  SHOW_VAR *status_vars() { return m_status_vars; }
+
   friend class Table_cache_iterator;
 
 private:
 
+  bool init_status_vars();
+
   /**
     An array of Table_cache instances.
     Only the first table_cache_instances elements in it are used.
   */
   Table_cache m_table_cache[MAX_TABLE_CACHES];
+
+  /** @sa status_vars() */
+  SHOW_VAR *m_status_vars;
 };
 
 
 extern Table_cache_manager table_cache_manager;
 
 
-/**
-  Element that represents the table in the specific table cache.
-  Plays for table cache instance role similar to role of TABLE_SHARE
-  for table definition cache.
-
-  It is an implementation detail of Table_cache and is present
-  in the header file only to allow inlining of some methods.
-*/
-
-class Table_cache_element
-{
-private:
-  /*
-    Doubly-linked (back-linked) lists of used and unused TABLE objects
-    for this table in this table cache (one such list per table cache).
-  */
-  typedef I_P_List <TABLE,
-                    I_P_List_adapter<TABLE,
-                                     &TABLE::cache_next,
-                                     &TABLE::cache_prev> > TABLE_list;
-
-  TABLE_list used_tables;
-  TABLE_list free_tables;
-  TABLE_SHARE *share;
-
-public:
-
-  Table_cache_element(TABLE_SHARE *share_arg)
-    : share(share_arg)
-  {
-  }
-
-  TABLE_SHARE * get_share() const { return share; };
-
-  friend class Table_cache;
-  friend class Table_cache_manager;
-  friend class Table_cache_iterator;
-};
-
-
 /**
   Iterator which allows to go through all used TABLE instances
   for the table in all table caches.
@@ -245,6 +375,7 @@ class Table_cache_iterator
 {
   const TABLE_SHARE *share;
   uint current_cache_index;
+  uint current_slot;
   TABLE *current_table;
 
   inline void move_to_next_table();
@@ -262,38 +393,156 @@ public:
 
 
 /**
-  Add table to the tail of unused tables list for table cache
-  (i.e. as the most recently used table in this list).
+  Add used TABLE object to the array of TABLE objects for the element.
+
+  @note Caller should own lock on the table cache.
+
+  @retval false - success.
+  @retval true  - failure (out of memory).
 */
 
-void Table_cache::link_unused_table(TABLE *table)
+bool Table_cache_element::add_table(TABLE *table)
 {
-  if (m_unused_tables)
+  if (table_count == table_slots)
   {
-    table->next= m_unused_tables;
-    table->prev= m_unused_tables->prev;
-    m_unused_tables->prev= table;
-    table->prev->next= table;
+    uint new_slots= table_slots ? table_slots * 2 : 8;
+    uint words= (table_slots + 63) / 64;
+    uint new_words= (new_slots + 63) / 64;
+    TABLE **new_tables;
+
+    if (!(new_tables= (TABLE**) my_realloc(tables,
+                                           new_slots * sizeof(TABLE*),
+                                           MYF(MY_WME | MY_ALLOW_ZERO_PTR))))
+      return true;
+    tables= new_tables;
+
+    if (new_words != words)
+    {
+      volatile int64 *new_map;
+      if (!(new_map= (volatile int64*) my_realloc((void *) free_map,
+                                                  new_words * sizeof(int64),
+                                                  MYF(MY_WME |
+                                                      MY_ALLOW_ZERO_PTR))))
+        return true;
+      for (uint i= words; i < new_words; i++)
+        new_map[i]= 0;
+      free_map= new_map;
+    }
+    table_slots= new_slots;
   }
-  else
-    m_unused_tables= table->next= table->prev= table;
-  check_unused();
+
+  table->cache_slot= table_count;
+  tables[table_count++]= table;
+  return false;
+}
+
+
+/**
+  Remove used or unused TABLE object from the array of TABLE objects
+  for the element. The last TABLE in the array takes its place.
+
+  @note Caller should own lock on the table cache.
+*/
+
+void Table_cache_element::remove_table(TABLE *table)
+{
+  uint slot= table->cache_slot;
+  uint last= --table_count;
+
+  DBUG_ASSERT(tables[slot] == table);
+
+  free_map[slot / 64]&= ~slot_bit(slot);
+
+  if (slot != last)
+  {
+    tables[slot]= tables[last];
+    tables[slot]->cache_slot= slot;
+    if (is_free(last))
+    {
+      free_map[last / 64]&= ~slot_bit(last);
+      free_map[slot / 64]|= slot_bit(slot);
+    }
+  }
+}
+
+
+/**
+  Get an unused TABLE object for the element and mark it as used.
+
+  @note Caller should either own lock on the table cache or be on
+        the fast path.
+
+  @retval non-NULL - TABLE object which is now owned by the caller.
+  @retval NULL     - there are no unused TABLE objects.
+*/
+
+TABLE *Table_cache_element::get_free_table()
+{
+  uint words= (table_count + 63) / 64;
+
+  for (uint i= 0; i < words; i++)
+  {
+    int64 map= my_atomic_load64(&free_map[i]);
+
+    while (map)
+    {
+      /* Clear the lowest bit set and grab the TABLE in this slot. */
+      ulonglong bit= ((ulonglong) map) & (~((ulonglong) map) + 1);
+      if (my_atomic_cas64(&free_map[i], &map, (int64) (map & ~bit)))
+        return tables[i * 64 + my_count_bits(bit - 1)];
+    }
+  }
+  return NULL;
 }
 
 
-/** Remove table from the unused tables list for table cache. */
+/**
+  Mark TABLE object, which was previously returned by get_free_table()
+  or added by add_table(), as unused.
+
+  @note Caller should either own lock on the table cache or be on
+        the fast path.
+*/
+
+void Table_cache_element::put_free_table(TABLE *table)
+{
+  DBUG_ASSERT(!is_free(table->cache_slot));
+  /* The bit is known to be clear, so adding it is the same as setting it. */
+  my_atomic_add64(&free_map[table->cache_slot / 64],
+                  slot_bit(table->cache_slot));
+}
+
+
+/**
+  Find the least recently used unused TABLE object in the table cache.
+
+  @note Caller should own lock on the table cache.
+
+  @note Has to scan all TABLE objects in the cache. This is acceptable
+        as it only happens when a new TABLE object is added to a full
+        cache, which is much more expensive anyway.
+
+  @retval non-NULL - unused TABLE object.
+  @retval NULL     - there are no unused TABLE objects in the cache.
+*/
 
-void Table_cache::unlink_unused_table(TABLE *table)
+TABLE* Table_cache::get_lru_unused_table()
 {
-  table->next->prev= table->prev;
-  table->prev->next= table->next;
-  if (table == m_unused_tables)
+  TABLE *lru= NULL;
+
+  for (uint idx= 0; idx < m_cache.records; idx++)
   {
-    m_unused_tables= m_unused_tables->next;
-    if (table == m_unused_tables)
-      m_unused_tables= NULL;
+    Table_cache_element *el=
+      (Table_cache_element*) my_hash_element(&m_cache, idx);
+
+    for (uint i= 0; i < el->table_count; i++)
+    {
+      if (el->is_free(i) &&
+          (!lru || el->tables[i]->cache_last_used < lru->cache_last_used))
+        lru= el->tables[i];
+    }
   }
-  check_unused();
+  return lru;
 }
 
 
@@ -315,18 +564,26 @@ void Table_cache::free_unused_tables_if_necessary(THD *thd)
     need the below loop, in case when table_cache_size is changed dynamically,
     at server run time.
   */
-  if (m_table_count > table_cache_size_per_instance && m_unused_tables)
+  if (m_table_count > table_cache_size_per_instance)
   {
-    mysql_mutex_lock(&LOCK_open);
+    TABLE *table_to_free;
+    bool locked= false;
+
     while (m_table_count > table_cache_size_per_instance &&
-           m_unused_tables)
+           (table_to_free= get_lru_unused_table()))
     {
-      TABLE *table_to_free= m_unused_tables;
+      if (!locked)
+      {
+        mysql_mutex_lock(&LOCK_open);
+        locked= true;
+      }
       remove_table(table_to_free);
       intern_close_table(table_to_free);
       thd->status_var.table_open_cache_overflows++;
+      my_atomic_add64(&m_overflows, 1);
     }
-    mysql_mutex_unlock(&LOCK_open);
+    if (locked)
+      mysql_mutex_unlock(&LOCK_open);
   }
 }
 
@@ -380,11 +637,21 @@ bool Table_cache::add_used_table(THD *thd, TABLE *table)
       return true;
     }
 
+    m_elements.push_front(el);
     table->s->cache_element[table_cache_manager.cache_index(this)]= el;
   }
 
-  /* Add table to the used tables list */
-  el->used_tables.push_front(table);
+  /* Add table to the array of TABLE objects for the table as used one. */
+  if (el->add_table(table))
+  {
+    if (el->is_empty())
+    {
+      m_elements.remove(el);
+      (void) my_hash_delete(&m_cache, (uchar*) el);
+      table->s->cache_element[table_cache_manager.cache_index(this)]= NULL;
+    }
+    return true;
+  }
 
   m_table_count++;
 
@@ -408,24 +675,13 @@ void Table_cache::remove_table(TABLE *table)
 
   assert_owner();
 
-  if (table->in_use)
-  {
-    /* Remove from per-table chain of used TABLE objects. */
-    el->used_tables.remove(table);
-  }
-  else
-  {
-    /* Remove from per-table chain of unused TABLE objects. */
-    el->free_tables.remove(table);
-
-    /* And per-cache unused chain. */
-    unlink_unused_table(table);
-  }
+  el->remove_table(table);
 
   m_table_count--;
 
-  if (el->used_tables.is_empty() && el->free_tables.is_empty())
+  if (el->is_empty())
   {
+    m_elements.remove(el);
     (void) my_hash_delete(&m_cache, (uchar*) el);
     /*
       Remove reference to deleted cache element from array
@@ -475,25 +731,10 @@ TABLE* Table_cache::get_table(THD *thd, my_hash_value_type hash_value,
 
   *share= el->share;
 
-  if ((table= el->free_tables.front()))
+  if ((table= el->get_free_table()))
   {
     DBUG_ASSERT(!table->in_use);
 
-    /*
-      Unlink table from list of unused TABLE objects for this
-      table in this cache.
-    */
-    el->free_tables.remove(table);
-
-    /* Unlink table from unused tables list for this cache. */
-    unlink_unused_table(table);
-
-    /*
-      Add table to list of used TABLE objects for this table
-      in the table cache.
-    */
-    el->used_tables.push_front(table);
-
     table->in_use= thd;
     /* The ex-unused table must be fully functional. */
     DBUG_ASSERT(table->db_stat && table->file);
@@ -527,13 +768,10 @@ void Table_cache::release_table(THD *thd, TABLE *table)
   DBUG_ASSERT(! table->s->has_old_version());
 
   table->in_use= NULL;
+  table->cache_last_used= my_atomic_add64(&m_lru_clock, 1);
 
-  /* Remove TABLE from the list of used objects for the table in this cache. */
-  el->used_tables.remove(table);
-  /* Add TABLE to the list of unused objects for the table in this cache. */
-  el->free_tables.push_front(table);
-  /* Also link it last in the list of unused TABLE objects for the cache. */
-  link_unused_table(table);
+  /* Mark TABLE as unused object for the table in this cache. */
+  el->put_free_table(table);
 
   /*
     We free the least used tables, not the subject table, to keep the LRU order.
@@ -543,33 +781,147 @@ void Table_cache::release_table(THD *thd, TABLE *table)
 }
 
 
+/**
+  Try to get an unused TABLE instance from the table cache without
+  acquiring lock on it.
+
+  @param  thd           Thread context.
+  @param  hash_value    Hash value for the key identifying table.
+  @param  key           Key identifying table.
+  @param  key_length    Length of key for the table.
+  @param  ignore_flush  Don't check if TABLE object has the same
+                        version as tables already opened by thread.
+
+  @note Sets TABLE::in_use member as side effect.
+
+  @retval non-NULL - pointer to unused TABLE object.
+  @retval NULL     - request can't be satisfied on the fast path (there
+                     are no unused TABLE objects for the table, it needs
+                     to be reopened or the cache is locked). Caller
+                     should lock the table cache and use get_table().
+*/
+
+TABLE* Table_cache::fast_path_get_table(THD *thd,
+                                        my_hash_value_type hash_value,
+                                        const char *key, uint key_length,
+                                        bool ignore_flush)
+{
+  Table_cache_element *el;
+  TABLE *table= NULL;
+
+  if (!fast_path_enter())
+    return NULL;
+
+  if ((el= (Table_cache_element*) my_hash_search_using_hash_value(&m_cache,
+                                    hash_value, (uchar*) key, key_length)) &&
+      (table= el->get_free_table()))
+  {
+    DBUG_ASSERT(!table->in_use);
+    /*
+      Versions can't change while we are on the fast path, so it is safe
+      to compare them. Leave the case when they differ to the locked path.
+      @sa open_table().
+    */
+    if (!ignore_flush && thd->open_tables &&
+        thd->open_tables->s->version != el->share->version)
+    {
+      el->put_free_table(table);
+      table= NULL;
+    }
+    else
+    {
+      table->in_use= thd;
+      /* The ex-unused table must be fully functional. */
+      DBUG_ASSERT(table->db_stat && table->file);
+      /* The children must be detached from the table. */
+      DBUG_ASSERT(! table->file->extra(HA_EXTRA_IS_ATTACHED_CHILDREN));
+    }
+  }
+
+  fast_path_exit();
+  return table;
+}
+
+
+/**
+  Try to put used TABLE instance back to the table cache and mark
+  it as unused without acquiring lock on the table cache.
+
+  @note Sets TABLE::in_use member as side effect.
+
+  @retval true  - success.
+  @retval false - TABLE object can't be released on the fast path
+                  (it has to be freed, table cache needs to be trimmed
+                  or the cache is locked). Caller should lock the table
+                  cache and use release_table() or remove_table().
+*/
+
+bool Table_cache::fast_path_release_table(THD *thd, TABLE *table)
+{
+  DBUG_ASSERT(table->in_use == thd);
+  DBUG_ASSERT(table->file);
+
+  if (!fast_path_enter())
+    return false;
+
+  if (table->s->has_old_version() || table->needs_reopen() ||
+      table_def_shutdown_in_progress ||
+      m_table_count > table_cache_size_per_instance)
+  {
+    fast_path_exit();
+    return false;
+  }
+
+  table->in_use= NULL;
+  table->cache_last_used= my_atomic_add64(&m_lru_clock, 1);
+
+  table->s->cache_element[table_cache_manager.cache_index(this)]->
+    put_free_table(table);
+
+  fast_path_exit();
+  return true;
+}
+
+
 /**
   Construct iterator over all used TABLE objects for the table share.
 
   @note Assumes that caller owns locks on all table caches.
 */
 Table_cache_iterator::Table_cache_iterator(const TABLE_SHARE *share_arg)
-  : share(share_arg), current_cache_index(0), current_table(NULL)
+  : share(share_arg), current_cache_index(0), current_slot(0),
+    current_table(NULL)
 {
   table_cache_manager.assert_owner_all();
   move_to_next_table();
 }
 
 
-/** Helper that moves iterator to the next used TABLE for the table share. */
+/**
+  Helper that moves iterator to the next used TABLE for the table share
+  starting from the current position.
+*/
 
 void Table_cache_iterator::move_to_next_table()
 {
-  for (; current_cache_index < table_cache_instances; ++current_cache_index)
+  for (; current_cache_index < table_cache_instances;
+       ++current_cache_index, current_slot= 0)
   {
     Table_cache_element *el;
 
     if ((el= share->cache_element[current_cache_index]))
     {
-      if ((current_table= el->used_tables.front()))
-        break;
+      for (; current_slot < el->table_count; ++current_slot)
+      {
+        if (!el->is_free(current_slot))
+        {
+          current_table= el->tables[current_slot];
+          return;
+        }
+      }
     }
   }
+  current_table= NULL;
 }
 
 
@@ -587,16 +939,8 @@ TABLE* Table_cache_iterator::operator ++(int)
 
   if (current_table)
   {
-    Table_cache_element::TABLE_list::Iterator
-      it(share->cache_element[current_cache_index]->used_tables, current_table);
-
-    current_table= ++it;
-
-    if (!current_table)
-    {
-      ++current_cache_index;
-      move_to_next_table();
-    }
+    ++current_slot;
+    move_to_next_table();
   }
 
   return result;
@@ -606,6 +950,7 @@ TABLE* Table_cache_iterator::operator ++(int)
 void Table_cache_iterator::rewind()
 {
   current_cache_index= 0;
+  current_slot= 0;
   current_table= NULL;
   move_to_next_table();
 }
@@ -0,0 +1,461 @@
+/*****************************************************************************
+
+Copyright (c) 2014, Oracle and/or its affiliates. All Rights Reserved.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file btr/btr0bulk.cc
+Bulk loading of an empty B-tree from sorted records
+*******************************************************/
+
+#include "btr0bulk.h"
+#include "btr0btr.h"
+#include "btr0cur.h"
+#include "dict0dict.h"
+#include "ibuf0ibuf.h"
+#include "log0log.h"
+#include "page0page.h"
+#include "page0zip.h"
+#include "rem0rec.h"
+#include "srv0srv.h"
+
+/*********************************************************************//**
+Starts a bulk load of an empty index tree. */
+UNIV_INTERN
+void
+btr_bulk_init(
+/*==========*/
+	btr_bulk_t*	bulk,	/*!< out: bulk load */
+	dict_index_t*	index,	/*!< in: index; must be empty and must
+				not be in a compressed table */
+	trx_id_t	trx_id)	/*!< in: transaction identifier */
+{
+	ut_ad(!dict_table_zip_size(index->table));
+	ut_ad(!dict_index_is_ibuf(index));
+
+	bulk->index = index;
+	bulk->trx_id = trx_id;
+	bulk->reserved = UNIV_PAGE_SIZE * (100 - srv_fill_factor) / 100;
+	bulk->level = 0;
+	bulk->first_page_no = FIL_NULL;
+	bulk->n_pages = 0;
+	bulk->block = NULL;
+	bulk->heap = mem_heap_create(1024);
+}
+
+/*********************************************************************//**
+Allocates and creates a page at the end of the level that is being built.
+@return the new page, or NULL if the tablespace is full */
+static
+buf_block_t*
+btr_bulk_page_alloc(
+/*================*/
+	btr_bulk_t*	bulk,	/*!< in/out: bulk load */
+	buf_block_t*	prev,	/*!< in/out: last page of the level, or
+				NULL if the new page is the first one */
+	mtr_t*		mtr)	/*!< in/out: mini-transaction */
+{
+	dict_index_t*	index = bulk->index;
+	buf_block_t*	block;
+	ulint		prev_page_no;
+	ulint		hint_page_no;
+
+	if (prev != NULL) {
+		prev_page_no = buf_block_get_page_no(prev);
+		hint_page_no = prev_page_no + 1;
+	} else {
+		prev_page_no = FIL_NULL;
+		hint_page_no = dict_index_get_page(index) + 1;
+	}
+
+	block = btr_page_alloc(index, hint_page_no, FSP_UP, bulk->level,
+			       mtr, mtr);
+
+	if (block == NULL) {
+		return(NULL);
+	}
+
+	btr_page_create(block, NULL, index, bulk->level, mtr);
+	btr_page_set_prev(buf_block_get_frame(block), NULL, prev_page_no, mtr);
+	btr_page_set_next(buf_block_get_frame(block), NULL, FIL_NULL, mtr);
+
+	if (prev != NULL) {
+		btr_page_set_next(buf_block_get_frame(prev), NULL,
+				  buf_block_get_page_no(block), mtr);
+	} else {
+		bulk->first_page_no = buf_block_get_page_no(block);
+	}
+
+	if (!dict_index_is_clust(index) && bulk->level == 0) {
+		/* We play safe and reset the free bits for the new page */
+		ibuf_reset_free_bits(block);
+	}
+
+	bulk->n_pages++;
+
+	return(block);
+}
+
+/*********************************************************************//**
+Moves the records of the root page to a new first page of the level that
+is being built, as btr_root_raise_and_insert() does, and leaves the root
+empty for the level above.
+@return the new page, or NULL if the tablespace is full */
+static
+buf_block_t*
+btr_bulk_move_root(
+/*===============*/
+	btr_bulk_t*	bulk)	/*!< in/out: bulk load */
+{
+	dict_index_t*	index = bulk->index;
+	buf_block_t*	root = bulk->block;
+	buf_block_t*	block;
+	rec_t*		rec;
+
+	ut_ad(buf_block_get_page_no(root) == dict_index_get_page(index));
+	ut_ad(bulk->n_pages == 1);
+
+	block = btr_bulk_page_alloc(bulk, NULL, &bulk->mtr);
+
+	if (block == NULL) {
+		return(NULL);
+	}
+
+	/* The root no longer belongs to this level */
+	bulk->n_pages--;
+
+	rec = page_copy_rec_list_end(
+		block, root, page_get_infimum_rec(buf_block_get_frame(root)),
+		index, &bulk->mtr);
+	ut_a(rec != NULL);
+
+	btr_page_empty(root, NULL, index, bulk->level + 1, &bulk->mtr);
+
+	return(block);
+}
+
+/*********************************************************************//**
+Starts to fill the root page or a page that was created by
+btr_bulk_page_alloc(). */
+static
+void
+btr_bulk_page_start(
+/*================*/
+	btr_bulk_t*	bulk,	/*!< in/out: bulk load */
+	ulint		page_no)/*!< in: page number */
+{
+	dict_index_t*	index = bulk->index;
+
+	ut_ad(bulk->block == NULL);
+
+	mtr_start(&bulk->mtr);
+
+	if (bulk->level == 0 && dict_index_is_clust(index)) {
+		/* btr_store_big_rec_extern_fields() expects the
+		index tree to be X-latched. */
+		mtr_x_lock(dict_index_get_lock(index), &bulk->mtr);
+	}
+
+	bulk->block = btr_block_get(dict_index_get_space(index), 0, page_no,
+				    RW_X_LATCH, index, &bulk->mtr);
+
+	ut_ad(page_get_n_recs(buf_block_get_frame(bulk->block)) == 0);
+	ut_ad(btr_page_get_level(buf_block_get_frame(bulk->block),
+				 &bulk->mtr) == bulk->level);
+
+	page_bulk_start(&bulk->page, buf_block_get_frame(bulk->block),
+			index, &bulk->mtr);
+}
+
+/*********************************************************************//**
+Completes the page that is being filled and commits its mini-transaction.
+@return number of the page that was created after it, or FIL_NULL */
+static
+ulint
+btr_bulk_page_commit(
+/*=================*/
+	btr_bulk_t*	bulk,		/*!< in/out: bulk load */
+	bool		alloc_next)	/*!< in: whether to create the
+					next page of the level */
+{
+	dict_index_t*	index = bulk->index;
+	bool		sec_leaf = !dict_index_is_clust(index)
+		&& bulk->level == 0;
+	buf_block_t*	block = bulk->block;
+	ulint		next_page_no = FIL_NULL;
+
+	page_bulk_finish(&bulk->page, index, &bulk->mtr);
+
+	if (sec_leaf) {
+		page_update_max_trx_id(block, NULL, bulk->trx_id,
+				       &bulk->mtr);
+	}
+
+	if (alloc_next
+	    && buf_block_get_page_no(block) == dict_index_get_page(index)) {
+		/* The level does not fit in the root page */
+		block = btr_bulk_move_root(bulk);
+	}
+
+	if (alloc_next && block != NULL) {
+		buf_block_t*	next = btr_bulk_page_alloc(bulk, block,
+							   &bulk->mtr);
+
+		if (next != NULL) {
+			next_page_no = buf_block_get_page_no(next);
+		}
+	}
+
+	if (sec_leaf && block != NULL) {
+		/* The free bits were reset when the page was created. */
+		ibuf_update_free_bits_low(block, 0, &bulk->mtr);
+	}
+
+	ut_ad(!block || page_validate(buf_block_get_frame(block), index));
+
+	mtr_commit(&bulk->mtr);
+	bulk->block = NULL;
+
+	return(next_page_no);
+}
+
+/*********************************************************************//**
+Appends a record to the level that is being built. Starts a new page if
+the record does not fit on the current page.
+@return the record on the page, or NULL if the tablespace is full */
+static
+rec_t*
+btr_bulk_append(
+/*============*/
+	btr_bulk_t*	bulk,	/*!< in/out: bulk load */
+	const rec_t*	rec,	/*!< in: record, not on a page */
+	ulint*		offsets)/*!< in/out: rec_get_offsets(rec);
+				on return, of the record on the page */
+{
+	ulint	rec_size = rec_offs_size(offsets);
+	ulint	page_no;
+
+	if (bulk->block == NULL) {
+		/* Each level is built in the root page until it does
+		not fit there. */
+		ut_ad(bulk->n_pages == 0);
+
+		page_no = dict_index_get_page(bulk->index);
+		bulk->first_page_no = page_no;
+		bulk->n_pages = 1;
+	} else if (!page_bulk_has_space(&bulk->page, rec_size,
+					bulk->reserved)) {
+		page_no = btr_bulk_page_commit(bulk, true);
+
+		if (page_no == FIL_NULL) {
+			return(NULL);
+		}
+	} else {
+		return(page_bulk_append(&bulk->page, rec, offsets,
+					bulk->index, &bulk->mtr));
+	}
+
+	/* No page is latched: make sure that the redo log has room
+	for the records of the new page. */
+	log_free_check();
+
+	btr_bulk_page_start(bulk, page_no);
+
+	/* The size of a record is limited to half a page. */
+	ut_a(page_bulk_has_space(&bulk->page, rec_size, 0));
+
+	return(page_bulk_append(&bulk->page, rec, offsets,
+				bulk->index, &bulk->mtr));
+}
+
+/*********************************************************************//**
+Appends a leaf record to the index tree. The records must be appended in
+ascending order. No other mini-transaction may latch pages of the index
+until btr_bulk_finish() has been called.
+@return DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+btr_bulk_insert(
+/*============*/
+	btr_bulk_t*	bulk,	/*!< in/out: bulk load */
+	dtuple_t*	tuple)	/*!< in/out: index entry; fields may be
+				stored externally and converted back */
+{
+	dict_index_t*	index = bulk->index;
+	big_rec_t*	big_rec = NULL;
+	ulint		n_ext = dtuple_get_n_ext(tuple);
+	ulint		rec_size;
+	rec_t*		rec;
+	rec_t*		ins_rec;
+	ulint*		offsets;
+	dberr_t		err = DB_SUCCESS;
+
+	ut_ad(bulk->level == 0);
+	ut_ad(dtuple_check_typed(tuple));
+
+	rec_size = rec_get_converted_size(index, tuple, n_ext);
+
+	if (page_zip_rec_needs_ext(rec_size, dict_table_is_comp(index->table),
+				   dtuple_get_n_fields(tuple), 0)) {
+
+		/* The record is so big that we have to store some fields
+		externally on separate database pages */
+		big_rec = dtuple_convert_big_rec(index, tuple, &n_ext);
+
+		if (big_rec == NULL) {
+
+			return(DB_TOO_BIG_RECORD);
+		}
+
+		rec_size = rec_get_converted_size(index, tuple, n_ext);
+	}
+
+	rec = rec_convert_dtuple_to_rec(
+		static_cast<byte*>(mem_heap_alloc(bulk->heap, rec_size)),
+		index, tuple, n_ext);
+
+	offsets = rec_get_offsets(rec, index, NULL, ULINT_UNDEFINED,
+				  &bulk->heap);
+
+	ins_rec = btr_bulk_append(bulk, rec, offsets);
+
+	if (ins_rec == NULL) {
+		err = DB_OUT_OF_FILE_SPACE;
+	} else if (big_rec != NULL) {
+		ut_ad(dict_index_is_clust(index));
+
+		/* The appended record is logged only when the next
+		record is appended or the page is completed, so the
+		redo log will contain the BLOB pointers written here. */
+		err = btr_store_big_rec_extern_fields(
+			index, bulk->block, ins_rec, offsets, big_rec,
+			&bulk->mtr, BTR_STORE_INSERT);
+	}
+
+	if (big_rec != NULL) {
+		dtuple_convert_back_big_rec(index, tuple, big_rec);
+	}
+
+	mem_heap_empty(bulk->heap);
+
+	return(err);
+}
+
+/*********************************************************************//**
+Builds the level above the level that was completed last, with a node
+pointer to each page of that level.
+@return DB_SUCCESS or DB_OUT_OF_FILE_SPACE */
+static
+dberr_t
+btr_bulk_build_level(
+/*=================*/
+	btr_bulk_t*	bulk)	/*!< in/out: bulk load */
+{
+	dict_index_t*	index = bulk->index;
+	ulint		space = dict_index_get_space(index);
+	ulint		level = bulk->level;
+	ulint		page_no = bulk->first_page_no;
+
+	ut_ad(bulk->block == NULL);
+	ut_ad(bulk->n_pages > 1);
+	ut_a(level + 1 < BTR_MAX_LEVELS);
+
+	bulk->level++;
+	bulk->first_page_no = FIL_NULL;
+	bulk->n_pages = 0;
+
+	do {
+		mtr_t		mtr;
+		buf_block_t*	block;
+		const rec_t*	first_rec;
+		dtuple_t*	node_ptr;
+		rec_t*		rec;
+		ulint*		offsets;
+		ulint		rec_size;
+
+		mtr_start(&mtr);
+
+		block = btr_block_get(space, 0, page_no, RW_S_LATCH,
+				      index, &mtr);
+
+		first_rec = page_rec_get_next_const(
+			page_get_infimum_rec(buf_block_get_frame(block)));
+
+		node_ptr = dict_index_build_node_ptr(
+			index, first_rec, page_no, bulk->heap, level);
+
+		if (bulk->n_pages == 0) {
+			/* The first node pointer of each non-leaf
+			level is the minimum record. */
+			dtuple_set_info_bits(node_ptr,
+					     dtuple_get_info_bits(node_ptr)
+					     | REC_INFO_MIN_REC_FLAG);
+		}
+
+		rec_size = rec_get_converted_size(index, node_ptr, 0);
+
+		rec = rec_convert_dtuple_to_rec(
+			static_cast<byte*>(
+				mem_heap_alloc(bulk->heap, rec_size)),
+			index, node_ptr, 0);
+
+		page_no = btr_page_get_next(buf_block_get_frame(block), &mtr);
+
+		mtr_commit(&mtr);
+
+		offsets = rec_get_offsets(rec, index, NULL, ULINT_UNDEFINED,
+					  &bulk->heap);
+
+		if (btr_bulk_append(bulk, rec, offsets) == NULL) {
+			mem_heap_empty(bulk->heap);
+			return(DB_OUT_OF_FILE_SPACE);
+		}
+
+		mem_heap_empty(bulk->heap);
+	} while (page_no != FIL_NULL);
+
+	btr_bulk_page_commit(bulk, false);
+
+	return(DB_SUCCESS);
+}
+
+/*********************************************************************//**
+Finishes a bulk load: builds the non-leaf levels of the tree. On error, only releases the pages; the
+index must then be dropped.
+@return DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+btr_bulk_finish(
+/*============*/
+	btr_bulk_t*	bulk,	/*!< in/out: bulk load; freed */
+	dberr_t		err)	/*!< in: error of btr_bulk_insert(),
+				or DB_SUCCESS */
+{
+	if (bulk->block != NULL) {
+		btr_bulk_page_commit(bulk, false);
+	}
+
+	/* The level that fits in the root page is the top level */
+	while (err == DB_SUCCESS && bulk->n_pages > 1) {
+		log_free_check();
+
+		err = btr_bulk_build_level(bulk);
+	}
+
+	mem_heap_free(bulk->heap);
+
+	return(err);
+}
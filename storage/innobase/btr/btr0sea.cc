@@ -44,9 +44,12 @@ Created 2/17/1996 Heikki Tuuri
 #include "ha0ha.h"
 
 /** Flag: has the search system been enabled?
-Protected by btr_search_latch. */
+Protected by the latches of all the adaptive hash index partitions. */
 UNIV_INTERN char		btr_search_enabled	= TRUE;
 
+/** Number of partitions of the adaptive hash index */
+UNIV_INTERN ulong		btr_ahi_parts		= 8;
+
 /** A dummy variable to fool the compiler */
 UNIV_INTERN ulint		btr_search_this_is_zero = 0;
 
@@ -57,30 +60,11 @@ UNIV_INTERN ulint		btr_search_n_succ	= 0;
 UNIV_INTERN ulint		btr_search_n_hash_fail	= 0;
 #endif /* UNIV_SEARCH_PERF_STAT */
 
-/** padding to prevent other memory update
-hotspots from residing on the same memory
-cache line as btr_search_latch */
-UNIV_INTERN byte		btr_sea_pad1[64];
-
-/** The latch protecting the adaptive search system: this latch protects the
-(1) positions of records on those pages where a hash index has been built.
-NOTE: It does not protect values of non-ordering fields within a record from
-being updated in-place! We can use fact (1) to perform unique searches to
-indexes. */
-
-/* We will allocate the latch from dynamic memory to get it to the
-same DRAM page as other hotspot semaphores */
-UNIV_INTERN rw_lock_t*		btr_search_latch_temp;
-
-/** padding to prevent other memory update hotspots from residing on
-the same memory cache line */
-UNIV_INTERN byte		btr_sea_pad2[64];
-
 /** The adaptive hash index */
 UNIV_INTERN btr_search_sys_t*	btr_search_sys;
 
 #ifdef UNIV_PFS_RWLOCK
-/* Key to register btr_search_sys with performance schema */
+/* Key to register the latches of btr_search_sys with performance schema */
 UNIV_INTERN mysql_pfs_key_t	btr_search_latch_key;
 #endif /* UNIV_PFS_RWLOCK */
 
@@ -116,26 +100,24 @@ the intended operation might add nodes to the search system hash table.
 Because of the latching order, once we have reserved the btr search system
 latch, we cannot allocate a free frame from the buffer pool. Checks that
 there is a free buffer frame allocated for hash table heap in the btr search
-system. If not, allocates a free frames for the heap. This check makes it
-probable that, when have reserved the btr search system latch and we need to
-allocate a new node to the hash table, it will succeed. However, the check
-will not guarantee success. */
+system partition. If not, allocates a free frames for the heap. This check
+makes it probable that, when have reserved the latch of the partition and we
+need to allocate a new node to the hash table, it will succeed. However, the
+check will not guarantee success. */
 static
 void
-btr_search_check_free_space_in_heap(void)
-/*=====================================*/
+btr_search_check_free_space_in_heap(
+/*================================*/
+	btr_search_part_t*	part)	/*!< in/out: partition */
 {
-	hash_table_t*	table;
 	mem_heap_t*	heap;
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!btr_search_own_any(RW_LOCK_SHARED));
+	ut_ad(!btr_search_own_any(RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
-	table = btr_search_sys->hash_index;
-
-	heap = table->heap;
+	heap = part->hash_index->heap;
 
 	/* Note that we peek the value of heap->free_block without reserving
 	the latch: this is ok, because we will not guarantee that there will
@@ -144,7 +126,7 @@ btr_search_check_free_space_in_heap(void)
 	if (heap->free_block == NULL) {
 		buf_block_t*	block = buf_block_alloc(NULL);
 
-		rw_lock_x_lock(&btr_search_latch);
+		btr_search_x_lock(part);
 
 		if (heap->free_block == NULL) {
 			heap->free_block = block;
@@ -152,7 +134,7 @@ btr_search_check_free_space_in_heap(void)
 			buf_block_free(block);
 		}
 
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 	}
 }
 
@@ -162,25 +144,29 @@ UNIV_INTERN
 void
 btr_search_sys_create(
 /*==================*/
-	ulint	hash_size)	/*!< in: hash index hash table size */
+	ulint	hash_size)	/*!< in: hash index hash table size,
+				divided among the btr_ahi_parts partitions */
 {
-	/* We allocate the search latch from dynamic memory:
-	see above at the global variable definition */
-
-	btr_search_latch_temp = (rw_lock_t*) mem_alloc(sizeof(rw_lock_t));
-
-	rw_lock_create(btr_search_latch_key, &btr_search_latch,
-		       SYNC_SEARCH_SYS);
+	ulint	i;
 
 	btr_search_sys = (btr_search_sys_t*)
 		mem_alloc(sizeof(btr_search_sys_t));
 
-	btr_search_sys->hash_index = ha_create(hash_size, 0,
-					MEM_HEAP_FOR_BTR_SEARCH, 0);
+	btr_search_sys->parts = (btr_search_part_t*)
+		mem_zalloc(btr_ahi_parts * sizeof(btr_search_part_t));
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		btr_search_part_t*	part = &btr_search_sys->parts[i];
+
+		rw_lock_create(btr_search_latch_key, &part->latch,
+			       SYNC_SEARCH_SYS);
+
+		part->hash_index = ha_create(hash_size / btr_ahi_parts, 0,
+					     MEM_HEAP_FOR_BTR_SEARCH, 0);
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
-	btr_search_sys->hash_index->adaptive = TRUE;
+		part->hash_index->adaptive = TRUE;
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
-
+	}
 }
 
 /*****************************************************************//**
@@ -190,15 +176,142 @@ void
 btr_search_sys_free(void)
 /*=====================*/
 {
-	rw_lock_free(&btr_search_latch);
-	mem_free(btr_search_latch_temp);
-	btr_search_latch_temp = NULL;
-	mem_heap_free(btr_search_sys->hash_index->heap);
-	hash_table_free(btr_search_sys->hash_index);
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		btr_search_part_t*	part = &btr_search_sys->parts[i];
+
+		rw_lock_free(&part->latch);
+		mem_heap_free(part->hash_index->heap);
+		hash_table_free(part->hash_index);
+	}
+
+	mem_free(btr_search_sys->parts);
 	mem_free(btr_search_sys);
 	btr_search_sys = NULL;
 }
 
+/********************************************************************//**
+X-latches all the adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_x_lock_all(void)
+/*=======================*/
+{
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		rw_lock_x_lock(&btr_search_sys->parts[i].latch);
+	}
+}
+
+/********************************************************************//**
+Releases the x-latches on all the adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_x_unlock_all(void)
+/*=========================*/
+{
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		rw_lock_x_unlock(&btr_search_sys->parts[i].latch);
+	}
+}
+
+#ifdef UNIV_SYNC_DEBUG
+/********************************************************************//**
+Checks if the thread owns the latch of any adaptive hash index partition
+in the given mode.
+@return	TRUE if owns */
+UNIV_INTERN
+ibool
+btr_search_own_any(
+/*===============*/
+	ulint	lock_type)	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+{
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		if (rw_lock_own(&btr_search_sys->parts[i].latch, lock_type)) {
+			return(TRUE);
+		}
+	}
+
+	return(FALSE);
+}
+
+/********************************************************************//**
+Checks if the thread owns the latches of all adaptive hash index
+partitions in the given mode.
+@return	TRUE if owns */
+UNIV_INTERN
+ibool
+btr_search_own_all(
+/*===============*/
+	ulint	lock_type)	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+{
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		if (!rw_lock_own(&btr_search_sys->parts[i].latch, lock_type)) {
+			return(FALSE);
+		}
+	}
+
+	return(TRUE);
+}
+#endif /* UNIV_SYNC_DEBUG */
+
+/********************************************************************//**
+Prints the size and the hit, miss and latch wait counts of each adaptive
+hash index partition. */
+UNIV_INTERN
+void
+btr_search_print_info(
+/*==================*/
+	FILE*	file)	/*!< in: file where to print */
+{
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		btr_search_part_t*	part = &btr_search_sys->parts[i];
+
+		fprintf(file, "AHI partition %lu: ", (ulong) i);
+		ha_print_info(file, part->hash_index);
+		fprintf(file,
+			"%lu hits, %lu misses, %lu latch waits\n",
+			(ulong) part->n_hits,
+			(ulong) part->n_misses,
+			(ulong) part->n_latch_waits);
+	}
+}
+
+/********************************************************************//**
+Sums the lookup and latch wait counts of all the adaptive hash index
+partitions. */
+UNIV_INTERN
+void
+btr_search_get_stats(
+/*=================*/
+	ulint*	n_hits,		/*!< out: successful lookups */
+	ulint*	n_misses,	/*!< out: failed lookups */
+	ulint*	n_latch_waits)	/*!< out: times a partition latch could
+				not be acquired at once */
+{
+	ulint	i;
+
+	*n_hits = *n_misses = *n_latch_waits = 0;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		const btr_search_part_t*	part = &btr_search_sys->parts[i];
+
+		*n_hits += part->n_hits;
+		*n_misses += part->n_misses;
+		*n_latch_waits += part->n_latch_waits;
+	}
+}
+
 /********************************************************************//**
 Set index->ref_count = 0 on all indexes of a table. */
 static
@@ -211,7 +324,7 @@ btr_search_disable_ref_count(
 
 	ut_ad(mutex_own(&dict_sys->mutex));
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(btr_search_own_all(RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
 	for (index = dict_table_get_first_index(table); index;
@@ -229,9 +342,10 @@ btr_search_disable(void)
 /*====================*/
 {
 	dict_table_t*	table;
+	ulint		i;
 
 	mutex_enter(&dict_sys->mutex);
-	rw_lock_x_lock(&btr_search_latch);
+	btr_search_x_lock_all();
 
 	btr_search_enabled = FALSE;
 
@@ -255,10 +369,15 @@ btr_search_disable(void)
 	buf_pool_clear_hash_index();
 
 	/* Clear the adaptive hash index. */
-	hash_table_clear(btr_search_sys->hash_index);
-	mem_heap_empty(btr_search_sys->hash_index->heap);
+	for (i = 0; i < btr_ahi_parts; i++) {
+		hash_table_t*	hash_index
+			= btr_search_sys->parts[i].hash_index;
 
-	rw_lock_x_unlock(&btr_search_latch);
+		hash_table_clear(hash_index);
+		mem_heap_empty(hash_index->heap);
+	}
+
+	btr_search_x_unlock_all();
 }
 
 /********************************************************************//**
@@ -268,11 +387,11 @@ void
 btr_search_enable(void)
 /*====================*/
 {
-	rw_lock_x_lock(&btr_search_latch);
+	btr_search_x_lock_all();
 
 	btr_search_enabled = TRUE;
 
-	rw_lock_x_unlock(&btr_search_latch);
+	btr_search_x_unlock_all();
 }
 
 /*****************************************************************//**
@@ -317,27 +436,31 @@ btr_search_info_create(
 }
 
 /*****************************************************************//**
-Returns the value of ref_count. The value is protected by
-btr_search_latch.
+Returns the value of ref_count. The value is protected by the latch
+of the adaptive hash index partition of the index.
 @return	ref_count value. */
 UNIV_INTERN
 ulint
 btr_search_info_get_ref_count(
 /*==========================*/
-	btr_search_t*   info)	/*!< in: search info. */
+	btr_search_t*		info,	/*!< in: search info. */
+	const dict_index_t*	index)	/*!< in: index */
 {
-	ulint ret;
+	ulint		ret;
+	rw_lock_t*	latch;
 
 	ut_ad(info);
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!btr_search_own_any(RW_LOCK_SHARED));
+	ut_ad(!btr_search_own_any(RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
-	rw_lock_s_lock(&btr_search_latch);
+	latch = btr_search_get_latch(index);
+
+	rw_lock_s_lock(latch);
 	ret = info->ref_count;
-	rw_lock_s_unlock(&btr_search_latch);
+	rw_lock_s_unlock(latch);
 
 	return(ret);
 }
@@ -358,8 +481,8 @@ btr_search_info_update_hash(
 	int		cmp;
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!btr_search_own_any(RW_LOCK_SHARED));
+	ut_ad(!btr_search_own_any(RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
 	index = cursor->index;
@@ -477,8 +600,8 @@ btr_search_update_block_hash_info(
 				/*!< in: cursor */
 {
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!btr_search_own_any(RW_LOCK_SHARED));
+	ut_ad(!btr_search_own_any(RW_LOCK_EX));
 	ut_ad(rw_lock_own(&block->lock, RW_LOCK_SHARED)
 	      || rw_lock_own(&block->lock, RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
@@ -562,7 +685,7 @@ btr_search_update_hash_ref(
 
 	ut_ad(cursor->flag == BTR_CUR_HASH_FAIL);
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(rw_lock_own(btr_search_get_latch(cursor->index), RW_LOCK_EX));
 	ut_ad(rw_lock_own(&(block->lock), RW_LOCK_SHARED)
 	      || rw_lock_own(&(block->lock), RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
@@ -603,11 +726,11 @@ btr_search_update_hash_ref(
 			mem_heap_free(heap);
 		}
 #ifdef UNIV_SYNC_DEBUG
-		ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+		ut_ad(rw_lock_own(btr_search_get_latch(index), RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
-		ha_insert_for_fold(btr_search_sys->hash_index, fold,
-				   block, rec);
+		ha_insert_for_fold(btr_search_get_part(index)->hash_index,
+				   fold, block, rec);
 
 		MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 	}
@@ -622,14 +745,15 @@ btr_search_info_update_slow(
 	btr_search_t*	info,	/*!< in/out: search info */
 	btr_cur_t*	cursor)	/*!< in: cursor which was just positioned */
 {
-	buf_block_t*	block;
-	ibool		build_index;
-	ulint*		params;
-	ulint*		params2;
+	buf_block_t*		block;
+	ibool			build_index;
+	ulint*			params;
+	ulint*			params2;
+	btr_search_part_t*	part;
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!btr_search_own_any(RW_LOCK_SHARED));
+	ut_ad(!btr_search_own_any(RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
 	block = btr_cur_get_block(cursor);
@@ -643,9 +767,11 @@ btr_search_info_update_slow(
 
 	build_index = btr_search_update_block_hash_info(info, block, cursor);
 
+	part = btr_search_get_part(cursor->index);
+
 	if (build_index || (cursor->flag == BTR_CUR_HASH_FAIL)) {
 
-		btr_search_check_free_space_in_heap();
+		btr_search_check_free_space_in_heap(part);
 	}
 
 	if (cursor->flag == BTR_CUR_HASH_FAIL) {
@@ -655,11 +781,11 @@ btr_search_info_update_slow(
 		btr_search_n_hash_fail++;
 #endif /* UNIV_SEARCH_PERF_STAT */
 
-		rw_lock_x_lock(&btr_search_latch);
+		btr_search_x_lock(part);
 
 		btr_search_update_hash_ref(info, block, cursor);
 
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 	}
 
 	if (build_index) {
@@ -702,8 +828,8 @@ btr_search_check_guess(
 	btr_cur_t*	cursor,	/*!< in: guessed cursor position */
 	ibool		can_only_compare_to_cursor_rec,
 				/*!< in: if we do not have a latch on the page
-				of cursor, but only a latch on
-				btr_search_latch, then ONLY the columns
+				of cursor, but only the adaptive hash index
+				latch of the index, then ONLY the columns
 				of the record UNDER the cursor are
 				protected, not the next or previous record
 				in the chain: we cannot look at the next or
@@ -858,15 +984,17 @@ btr_search_guess_on_hash(
 					to protect the record! */
 	btr_cur_t*	cursor,		/*!< out: tree cursor */
 	ulint		has_search_latch,/*!< in: latch mode the caller
-					currently has on btr_search_latch:
+					currently has on the adaptive hash
+					index latch of index:
 					RW_S_LATCH, RW_X_LATCH, or 0 */
 	mtr_t*		mtr)		/*!< in: mtr */
 {
-	buf_pool_t*	buf_pool;
-	buf_block_t*	block;
-	const rec_t*	rec;
-	ulint		fold;
-	index_id_t	index_id;
+	buf_pool_t*		buf_pool;
+	buf_block_t*		block;
+	const rec_t*		rec;
+	ulint			fold;
+	index_id_t		index_id;
+	btr_search_part_t*	part;
 #ifdef notdefined
 	btr_cur_t	cursor2;
 	btr_pcur_t	pcur;
@@ -903,18 +1031,20 @@ btr_search_guess_on_hash(
 	cursor->fold = fold;
 	cursor->flag = BTR_CUR_HASH;
 
+	part = btr_search_get_part(index);
+
 	if (UNIV_LIKELY(!has_search_latch)) {
-		rw_lock_s_lock(&btr_search_latch);
+		btr_search_s_lock(part);
 
 		if (UNIV_UNLIKELY(!btr_search_enabled)) {
 			goto failure_unlock;
 		}
 	}
 
-	ut_ad(rw_lock_get_writer(&btr_search_latch) != RW_LOCK_EX);
-	ut_ad(rw_lock_get_reader_count(&btr_search_latch) > 0);
+	ut_ad(rw_lock_get_writer(&part->latch) != RW_LOCK_EX);
+	ut_ad(rw_lock_get_reader_count(&part->latch) > 0);
 
-	rec = (rec_t*) ha_search_and_get_data(btr_search_sys->hash_index, fold);
+	rec = (rec_t*) ha_search_and_get_data(part->hash_index, fold);
 
 	if (UNIV_UNLIKELY(!rec)) {
 		goto failure_unlock;
@@ -932,7 +1062,7 @@ btr_search_guess_on_hash(
 			goto failure_unlock;
 		}
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 
 		buf_block_dbg_add_level(block, SYNC_TREE_NODE_FROM_HASH);
 	}
@@ -954,8 +1084,8 @@ btr_search_guess_on_hash(
 
 	/* Check the validity of the guess within the page */
 
-	/* If we only have the latch on btr_search_latch, not on the
-	page, it only protects the columns of the record the cursor
+	/* If we only have the adaptive hash index latch, not the latch
+	on the page, it only protects the columns of the record the cursor
 	is positioned on. We cannot look at the next of the previous
 	record to determine if our guess for the cursor position is
 	right. */
@@ -1009,6 +1139,7 @@ btr_search_guess_on_hash(
 	meanwhile! Thus it might not be a bug. */
 #endif
 	info->last_hash_succ = TRUE;
+	part->n_hits++;
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
@@ -1029,10 +1160,11 @@ btr_search_guess_on_hash(
 	/*-------------------------------------------*/
 failure_unlock:
 	if (UNIV_LIKELY(!has_search_latch)) {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 	}
 failure:
 	cursor->flag = BTR_CUR_HASH_FAIL;
+	part->n_misses++;
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	info->n_hash_fail++;
@@ -1077,30 +1209,40 @@ btr_search_drop_page_hash_index(
 	const dict_index_t*	index;
 	ulint*			offsets;
 	btr_search_t*		info;
+	btr_search_part_t*	part;
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!btr_search_own_any(RW_LOCK_SHARED));
+	ut_ad(!btr_search_own_any(RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
 	/* Do a dirty check on block->index, return if the block is
 	not in the adaptive hash index. This is to avoid acquiring
-	shared btr_search_latch for performance consideration. */
+	the shared partition latch for performance consideration. */
 	if (!block->index) {
 		return;
 	}
 
+	/* block->index may only be dereferenced while holding the
+	partition latch. Find the partition by the index id stored on
+	the page: a hashed page always belongs to block->index. The
+	page number and space id in block->page cannot be used, because
+	buf_LRU_free_page() has already reset them. */
+	part = btr_search_get_part_by_id(btr_page_get_index_id(block->frame));
+
 retry:
-	rw_lock_s_lock(&btr_search_latch);
+	btr_search_s_lock(part);
 	index = block->index;
 
 	if (UNIV_LIKELY(!index)) {
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 
 		return;
 	}
 
+	ut_ad(part == btr_search_get_part(index));
+
 	ut_a(!dict_index_is_ibuf(index));
 #ifdef UNIV_DEBUG
 	switch (dict_index_get_online_status(index)) {
@@ -1123,7 +1265,7 @@ retry:
 	}
 #endif /* UNIV_DEBUG */
 
-	table = btr_search_sys->hash_index;
+	table = part->hash_index;
 
 #ifdef UNIV_SYNC_DEBUG
 	ut_ad(rw_lock_own(&(block->lock), RW_LOCK_SHARED)
@@ -1136,10 +1278,10 @@ retry:
 	n_bytes = block->curr_n_bytes;
 
 	/* NOTE: The fields of block must not be accessed after
-	releasing btr_search_latch, as the index page might only
+	releasing the partition latch, as the index page might only
 	be s-latched! */
 
-	rw_lock_s_unlock(&btr_search_latch);
+	rw_lock_s_unlock(&part->latch);
 
 	ut_a(n_fields + n_bytes > 0);
 
@@ -1190,7 +1332,7 @@ next_rec:
 		mem_heap_free(heap);
 	}
 
-	rw_lock_x_lock(&btr_search_latch);
+	btr_search_x_lock(part);
 
 	if (UNIV_UNLIKELY(!block->index)) {
 		/* Someone else has meanwhile dropped the hash index */
@@ -1206,7 +1348,7 @@ next_rec:
 		/* Someone else has meanwhile built a new hash index on the
 		page, with different parameters */
 
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 
 		mem_free(folds);
 		goto retry;
@@ -1237,14 +1379,14 @@ cleanup:
 			"InnoDB: the hash index to a page of %s,"
 			" still %lu hash nodes remain.\n",
 			index->name, (ulong) block->n_pointers);
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 
 		ut_ad(btr_search_validate());
 	} else {
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 	}
 #else /* UNIV_AHI_DEBUG || UNIV_DEBUG */
-	rw_lock_x_unlock(&btr_search_latch);
+	rw_lock_x_unlock(&part->latch);
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 
 	mem_free(folds);
@@ -1303,50 +1445,53 @@ btr_search_build_page_hash_index(
 				field */
 	ibool		left_side)/*!< in: hash for searches from left side? */
 {
-	hash_table_t*	table;
-	page_t*		page;
-	rec_t*		rec;
-	rec_t*		next_rec;
-	ulint		fold;
-	ulint		next_fold;
-	ulint		n_cached;
-	ulint		n_recs;
-	ulint*		folds;
-	rec_t**		recs;
-	ulint		i;
-	mem_heap_t*	heap		= NULL;
-	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
-	ulint*		offsets		= offsets_;
+	hash_table_t*		table;
+	btr_search_part_t*	part;
+	page_t*			page;
+	rec_t*			rec;
+	rec_t*			next_rec;
+	ulint			fold;
+	ulint			next_fold;
+	ulint			n_cached;
+	ulint			n_recs;
+	ulint*			folds;
+	rec_t**			recs;
+	ulint			i;
+	mem_heap_t*		heap		= NULL;
+	ulint			offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*			offsets		= offsets_;
 	rec_offs_init(offsets_);
 
 	ut_ad(index);
 	ut_a(!dict_index_is_ibuf(index));
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!btr_search_own_any(RW_LOCK_EX));
 	ut_ad(rw_lock_own(&(block->lock), RW_LOCK_SHARED)
 	      || rw_lock_own(&(block->lock), RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
-	rw_lock_s_lock(&btr_search_latch);
+	part = btr_search_get_part(index);
+
+	btr_search_s_lock(part);
 
 	if (!btr_search_enabled) {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 		return;
 	}
 
-	table = btr_search_sys->hash_index;
+	table = part->hash_index;
 	page = buf_block_get_frame(block);
 
 	if (block->index && ((block->curr_n_fields != n_fields)
 			     || (block->curr_n_bytes != n_bytes)
 			     || (block->curr_left_side != left_side))) {
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 
 		btr_search_drop_page_hash_index(block);
 	} else {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 	}
 
 	n_recs = page_get_n_recs(page);
@@ -1440,9 +1585,9 @@ btr_search_build_page_hash_index(
 		fold = next_fold;
 	}
 
-	btr_search_check_free_space_in_heap();
+	btr_search_check_free_space_in_heap(part);
 
-	rw_lock_x_lock(&btr_search_latch);
+	btr_search_x_lock(part);
 
 	if (UNIV_UNLIKELY(!btr_search_enabled)) {
 		goto exit_func;
@@ -1478,7 +1623,7 @@ btr_search_build_page_hash_index(
 	MONITOR_INC(MONITOR_ADAPTIVE_HASH_PAGE_ADDED);
 	MONITOR_INC_VALUE(MONITOR_ADAPTIVE_HASH_ROW_ADDED, n_cached);
 exit_func:
-	rw_lock_x_unlock(&btr_search_latch);
+	rw_lock_x_unlock(&part->latch);
 
 	mem_free(folds);
 	mem_free(recs);
@@ -1504,16 +1649,19 @@ btr_search_move_or_delete_hash_entries(
 					from this page */
 	dict_index_t*	index)		/*!< in: record descriptor */
 {
-	ulint	n_fields;
-	ulint	n_bytes;
-	ibool	left_side;
+	ulint			n_fields;
+	ulint			n_bytes;
+	ibool			left_side;
+	btr_search_part_t*	part;
 
 #ifdef UNIV_SYNC_DEBUG
 	ut_ad(rw_lock_own(&(block->lock), RW_LOCK_EX));
 	ut_ad(rw_lock_own(&(new_block->lock), RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
-	rw_lock_s_lock(&btr_search_latch);
+	part = btr_search_get_part(index);
+
+	btr_search_s_lock(part);
 
 	ut_a(!new_block->index || new_block->index == index);
 	ut_a(!block->index || block->index == index);
@@ -1522,7 +1670,7 @@ btr_search_move_or_delete_hash_entries(
 
 	if (new_block->index) {
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 
 		btr_search_drop_page_hash_index(block);
 
@@ -1539,7 +1687,7 @@ btr_search_move_or_delete_hash_entries(
 		new_block->n_bytes = block->curr_n_bytes;
 		new_block->left_side = left_side;
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 
 		ut_a(n_fields + n_bytes > 0);
 
@@ -1551,7 +1699,7 @@ btr_search_move_or_delete_hash_entries(
 		return;
 	}
 
-	rw_lock_s_unlock(&btr_search_latch);
+	rw_lock_s_unlock(&part->latch);
 }
 
 /********************************************************************//**
@@ -1564,13 +1712,13 @@ btr_search_update_hash_on_delete(
 				record to delete using btr_cur_search_...,
 				the record is not yet deleted */
 {
-	hash_table_t*	table;
-	buf_block_t*	block;
-	const rec_t*	rec;
-	ulint		fold;
-	dict_index_t*	index;
-	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
-	mem_heap_t*	heap		= NULL;
+	btr_search_part_t*	part;
+	buf_block_t*		block;
+	const rec_t*		rec;
+	ulint			fold;
+	dict_index_t*		index;
+	ulint			offsets_[REC_OFFS_NORMAL_SIZE];
+	mem_heap_t*		heap		= NULL;
 	rec_offs_init(offsets_);
 
 	block = btr_cur_get_block(cursor);
@@ -1590,7 +1738,7 @@ btr_search_update_hash_on_delete(
 	ut_a(block->curr_n_fields + block->curr_n_bytes > 0);
 	ut_a(!dict_index_is_ibuf(index));
 
-	table = btr_search_sys->hash_index;
+	part = btr_search_get_part(index);
 
 	rec = btr_cur_get_rec(cursor);
 
@@ -1601,12 +1749,12 @@ btr_search_update_hash_on_delete(
 		mem_heap_free(heap);
 	}
 
-	rw_lock_x_lock(&btr_search_latch);
+	btr_search_x_lock(part);
 
 	if (block->index) {
 		ut_a(block->index == index);
 
-		if (ha_search_and_delete_if_found(table, fold, rec)) {
+		if (ha_search_and_delete_if_found(part->hash_index, fold, rec)) {
 			MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_REMOVED);
 		} else {
 			MONITOR_INC(
@@ -1614,7 +1762,7 @@ btr_search_update_hash_on_delete(
 		}
 	}
 
-	rw_lock_x_unlock(&btr_search_latch);
+	rw_lock_x_unlock(&part->latch);
 }
 
 /********************************************************************//**
@@ -1628,10 +1776,10 @@ btr_search_update_hash_node_on_insert(
 				and the new record has been inserted next
 				to the cursor */
 {
-	hash_table_t*	table;
-	buf_block_t*	block;
-	dict_index_t*	index;
-	rec_t*		rec;
+	btr_search_part_t*	part;
+	buf_block_t*		block;
+	dict_index_t*		index;
+	rec_t*			rec;
 
 	rec = btr_cur_get_rec(cursor);
 
@@ -1651,7 +1799,9 @@ btr_search_update_hash_node_on_insert(
 	ut_a(cursor->index == index);
 	ut_a(!dict_index_is_ibuf(index));
 
-	rw_lock_x_lock(&btr_search_latch);
+	part = btr_search_get_part(index);
+
+	btr_search_x_lock(part);
 
 	if (!block->index) {
 
@@ -1665,18 +1815,16 @@ btr_search_update_hash_node_on_insert(
 	    && (cursor->n_bytes == block->curr_n_bytes)
 	    && !block->curr_left_side) {
 
-		table = btr_search_sys->hash_index;
-
 		if (ha_search_and_update_if_found(
-			table, cursor->fold, rec, block,
+			part->hash_index, cursor->fold, rec, block,
 			page_rec_get_next(rec))) {
 			MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_UPDATED);
 		}
 
 func_exit:
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 	} else {
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 
 		btr_search_update_hash_on_insert(cursor);
 	}
@@ -1693,22 +1841,23 @@ btr_search_update_hash_on_insert(
 				and the new record has been inserted next
 				to the cursor */
 {
-	hash_table_t*	table;
-	buf_block_t*	block;
-	dict_index_t*	index;
-	const rec_t*	rec;
-	const rec_t*	ins_rec;
-	const rec_t*	next_rec;
-	ulint		fold;
-	ulint		ins_fold;
-	ulint		next_fold = 0; /* remove warning (??? bug ???) */
-	ulint		n_fields;
-	ulint		n_bytes;
-	ibool		left_side;
-	ibool		locked		= FALSE;
-	mem_heap_t*	heap		= NULL;
-	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
-	ulint*		offsets		= offsets_;
+	hash_table_t*		table;
+	btr_search_part_t*	part;
+	buf_block_t*		block;
+	dict_index_t*		index;
+	const rec_t*		rec;
+	const rec_t*		ins_rec;
+	const rec_t*		next_rec;
+	ulint			fold;
+	ulint			ins_fold;
+	ulint			next_fold = 0; /* remove warning (??? bug ???) */
+	ulint			n_fields;
+	ulint			n_bytes;
+	ibool			left_side;
+	ibool			locked		= FALSE;
+	mem_heap_t*		heap		= NULL;
+	ulint			offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*			offsets		= offsets_;
 	rec_offs_init(offsets_);
 
 	block = btr_cur_get_block(cursor);
@@ -1724,9 +1873,11 @@ btr_search_update_hash_on_insert(
 		return;
 	}
 
-	btr_search_check_free_space_in_heap();
+	part = btr_search_get_part(index);
 
-	table = btr_search_sys->hash_index;
+	btr_search_check_free_space_in_heap(part);
+
+	table = part->hash_index;
 
 	rec = btr_cur_get_rec(cursor);
 
@@ -1758,7 +1909,7 @@ btr_search_update_hash_on_insert(
 	} else {
 		if (left_side) {
 
-			rw_lock_x_lock(&btr_search_latch);
+			btr_search_x_lock(part);
 
 			locked = TRUE;
 
@@ -1776,7 +1927,7 @@ btr_search_update_hash_on_insert(
 
 		if (!locked) {
 
-			rw_lock_x_lock(&btr_search_latch);
+			btr_search_x_lock(part);
 
 			locked = TRUE;
 
@@ -1798,7 +1949,7 @@ check_next_rec:
 		if (!left_side) {
 
 			if (!locked) {
-				rw_lock_x_lock(&btr_search_latch);
+				btr_search_x_lock(part);
 
 				locked = TRUE;
 
@@ -1817,7 +1968,7 @@ check_next_rec:
 
 		if (!locked) {
 
-			rw_lock_x_lock(&btr_search_latch);
+			btr_search_x_lock(part);
 
 			locked = TRUE;
 
@@ -1844,18 +1995,19 @@ function_exit:
 		mem_heap_free(heap);
 	}
 	if (locked) {
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 	}
 }
 
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
 /********************************************************************//**
-Validates the search system.
+Validates a partition of the search system.
 @return	TRUE if ok */
-UNIV_INTERN
+static
 ibool
-btr_search_validate(void)
+btr_search_validate_part(
 /*=====================*/
+	btr_search_part_t*	part)	/*!< in: partition */
 {
 	ha_node_t*	node;
 	ulint		n_page_dumps	= 0;
@@ -1867,29 +2019,29 @@ btr_search_validate(void)
 	ulint*		offsets		= offsets_;
 
 	/* How many cells to check before temporarily releasing
-	btr_search_latch. */
+	the partition latch. */
 	ulint		chunk_size = 10000;
 
 	rec_offs_init(offsets_);
 
-	rw_lock_x_lock(&btr_search_latch);
+	rw_lock_x_lock(&part->latch);
 	buf_pool_mutex_enter_all();
 
-	cell_count = hash_get_n_cells(btr_search_sys->hash_index);
+	cell_count = hash_get_n_cells(part->hash_index);
 
 	for (i = 0; i < cell_count; i++) {
-		/* We release btr_search_latch every once in a while to
+		/* We release the partition latch every once in a while to
 		give other queries a chance to run. */
 		if ((i != 0) && ((i % chunk_size) == 0)) {
 			buf_pool_mutex_exit_all();
-			rw_lock_x_unlock(&btr_search_latch);
+			rw_lock_x_unlock(&part->latch);
 			os_thread_yield();
-			rw_lock_x_lock(&btr_search_latch);
+			rw_lock_x_lock(&part->latch);
 			buf_pool_mutex_enter_all();
 		}
 
 		node = (ha_node_t*)
-			hash_get_nth_cell(btr_search_sys->hash_index, i)->node;
+			hash_get_nth_cell(part->hash_index, i)->node;
 
 		for (; node != NULL; node = node->next) {
 			const buf_block_t*	block
@@ -1927,7 +2079,7 @@ btr_search_validate(void)
 				After that, it invokes
 				btr_search_drop_page_hash_index() to
 				remove the block from
-				btr_search_sys->hash_index. */
+				part->hash_index. */
 
 				ut_a(buf_block_get_state(block)
 				     == BUF_BLOCK_REMOVE_HASH);
@@ -1994,27 +2146,47 @@ btr_search_validate(void)
 	for (i = 0; i < cell_count; i += chunk_size) {
 		ulint end_index = ut_min(i + chunk_size - 1, cell_count - 1);
 
-		/* We release btr_search_latch every once in a while to
+		/* We release the partition latch every once in a while to
 		give other queries a chance to run. */
 		if (i != 0) {
 			buf_pool_mutex_exit_all();
-			rw_lock_x_unlock(&btr_search_latch);
+			rw_lock_x_unlock(&part->latch);
 			os_thread_yield();
-			rw_lock_x_lock(&btr_search_latch);
+			rw_lock_x_lock(&part->latch);
 			buf_pool_mutex_enter_all();
 		}
 
-		if (!ha_validate(btr_search_sys->hash_index, i, end_index)) {
+		if (!ha_validate(part->hash_index, i, end_index)) {
 			ok = FALSE;
 		}
 	}
 
 	buf_pool_mutex_exit_all();
-	rw_lock_x_unlock(&btr_search_latch);
+	rw_lock_x_unlock(&part->latch);
 	if (UNIV_LIKELY_NULL(heap)) {
 		mem_heap_free(heap);
 	}
 
 	return(ok);
 }
+
+/********************************************************************//**
+Validates the search system.
+@return	TRUE if ok */
+UNIV_INTERN
+ibool
+btr_search_validate(void)
+/*=====================*/
+{
+	ibool	ok	= TRUE;
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		if (!btr_search_validate_part(&btr_search_sys->parts[i])) {
+			ok = FALSE;
+		}
+	}
+
+	return(ok);
+}
 #endif /* defined UNIV_AHI_DEBUG || defined UNIV_DEBUG */
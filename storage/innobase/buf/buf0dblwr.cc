@@ -119,6 +119,287 @@ buf_dblwr_sync_datafiles()
 	fil_flush_file_spaces(FIL_TABLESPACE);
 }
 
+/** Number of doublewrite files of a buffer pool instance with
+innodb_parallel_doublewrite: one for BUF_FLUSH_LRU, one for BUF_FLUSH_LIST */
+#define BUF_DBLWR_FILES_PER_INSTANCE	2
+
+/** Upper limit of the number of doublewrite files that recovery looks for */
+#define BUF_DBLWR_FILES_MAX	(BUF_DBLWR_FILES_PER_INSTANCE * MAX_BUFFER_POOLS)
+
+/****************************************************************//**
+Builds the path of a parallel doublewrite file. The files are named
+ib_dblwr_<buffer pool instance>_<lru|list> and live in the directory of
+the system tablespace. */
+static
+void
+buf_dblwr_file_name(
+/*================*/
+	char*	name,	/*!< out: path, OS_FILE_MAX_PATH bytes */
+	ulint	n)	/*!< in: number of the file; the buffer pool
+			instance is n / BUF_DBLWR_FILES_PER_INSTANCE */
+{
+	ulint	dirnamelen = strlen(srv_data_home);
+
+	ut_a(dirnamelen + 32 < OS_FILE_MAX_PATH);
+
+	memcpy(name, srv_data_home, dirnamelen);
+
+	/* Add a path separator if needed. */
+	if (dirnamelen && name[dirnamelen - 1] != SRV_PATH_SEPARATOR) {
+		name[dirnamelen++] = SRV_PATH_SEPARATOR;
+	}
+
+	sprintf(name + dirnamelen, "ib_dblwr_%lu_%s",
+		(ulong) (n / BUF_DBLWR_FILES_PER_INSTANCE),
+		n % BUF_DBLWR_FILES_PER_INSTANCE ? "list" : "lru");
+}
+
+/****************************************************************//**
+Returns the parallel doublewrite file a batch page is written to.
+@return the file, or NULL if the batches are written to the doublewrite
+buffer in the system tablespace */
+UNIV_INLINE
+buf_dblwr_file_t*
+buf_dblwr_get_file(
+/*===============*/
+	const buf_page_t*	bpage,		/*!< in: page in the batch */
+	buf_flush_t		flush_type)	/*!< in: BUF_FLUSH_LRU or
+						BUF_FLUSH_LIST */
+{
+	ulint	n;
+
+	if (buf_dblwr->n_files == 0) {
+		return(NULL);
+	}
+
+	ut_ad(flush_type == BUF_FLUSH_LRU || flush_type == BUF_FLUSH_LIST);
+
+	n = bpage->buf_pool_index * BUF_DBLWR_FILES_PER_INSTANCE
+		+ (flush_type == BUF_FLUSH_LIST);
+
+	ut_ad(n < buf_dblwr->n_files);
+
+	return(&buf_dblwr->files[n]);
+}
+
+/****************************************************************//**
+Opens or creates the doublewrite file of a buffer pool instance and flush
+type and allocates the memory for its batch.
+@return true if success */
+static
+bool
+buf_dblwr_file_open(
+/*================*/
+	buf_dblwr_file_t*	file,	/*!< out: doublewrite file */
+	ulint			n)	/*!< in: number of the file */
+{
+	ibool	success;
+
+	file->name = static_cast<char*>(mem_alloc(OS_FILE_MAX_PATH));
+	buf_dblwr_file_name(file->name, n);
+
+	file->file = os_file_create(
+		innodb_file_data_key, file->name,
+		OS_FILE_OPEN | OS_FILE_ON_ERROR_NO_EXIT
+		| OS_FILE_ON_ERROR_SILENT,
+		OS_FILE_NORMAL, OS_DATA_FILE, &success);
+
+	if (!success) {
+		file->file = os_file_create(
+			innodb_file_data_key, file->name,
+			OS_FILE_CREATE | OS_FILE_ON_ERROR_NO_EXIT,
+			OS_FILE_NORMAL, OS_DATA_FILE, &success);
+
+		if (success && !os_file_set_size(
+			    file->name, file->file,
+			    (os_offset_t) srv_doublewrite_batch_size
+			    * UNIV_PAGE_SIZE)) {
+
+			os_file_close(file->file);
+			success = FALSE;
+		}
+	}
+
+	if (!success) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"Cannot open or create the doublewrite file %s",
+			file->name);
+
+		mem_free(file->name);
+		file->name = NULL;
+		return(false);
+	}
+
+	mutex_create(buf_dblwr_mutex_key, &file->mutex, SYNC_DOUBLEWRITE);
+
+	file->b_event = os_event_create();
+	file->first_free = 0;
+	file->b_reserved = 0;
+	file->batch_running = false;
+
+	file->write_buf_unaligned = static_cast<byte*>(
+		mem_zalloc((1 + srv_doublewrite_batch_size) * UNIV_PAGE_SIZE));
+
+	file->write_buf = static_cast<byte*>(
+		ut_align(file->write_buf_unaligned, UNIV_PAGE_SIZE));
+
+	file->buf_block_arr = static_cast<buf_page_t**>(
+		mem_zalloc(srv_doublewrite_batch_size * sizeof(void*)));
+
+	return(true);
+}
+
+/****************************************************************//**
+Closes a parallel doublewrite file and frees the memory of its batch. */
+static
+void
+buf_dblwr_file_close(
+/*=================*/
+	buf_dblwr_file_t*	file)	/*!< in/out: doublewrite file */
+{
+	ut_ad(file->b_reserved == 0);
+	ut_ad(!file->batch_running);
+
+	os_file_close(file->file);
+
+	os_event_free(file->b_event);
+	mem_free(file->write_buf_unaligned);
+	mem_free(file->buf_block_arr);
+	mem_free(file->name);
+	mutex_free(&file->mutex);
+}
+
+/****************************************************************//**
+Opens the doublewrite files of all buffer pool instances if
+innodb_parallel_doublewrite is set. If any file cannot be opened the
+batches are written to the doublewrite buffer in the system tablespace. */
+static
+void
+buf_dblwr_files_open(void)
+/*======================*/
+{
+	ulint	n_files;
+
+	if (!srv_parallel_doublewrite) {
+		return;
+	}
+
+	if (srv_read_only_mode || srv_use_doublewrite_buf != 1) {
+		if (srv_use_doublewrite_buf == 2) {
+			ib_logf(IB_LOG_LEVEL_WARN,
+				"innodb_parallel_doublewrite is ignored "
+				"in the reduced doublewrite mode");
+		}
+
+		srv_parallel_doublewrite = FALSE;
+		return;
+	}
+
+	n_files = srv_buf_pool_instances * BUF_DBLWR_FILES_PER_INSTANCE;
+
+	buf_dblwr->files = static_cast<buf_dblwr_file_t*>(
+		mem_zalloc(n_files * sizeof(buf_dblwr_file_t)));
+
+	for (ulint i = 0; i < n_files; i++) {
+		if (!buf_dblwr_file_open(&buf_dblwr->files[i], i)) {
+
+			while (i-- > 0) {
+				buf_dblwr_file_close(&buf_dblwr->files[i]);
+			}
+
+			mem_free(buf_dblwr->files);
+			buf_dblwr->files = NULL;
+
+			ib_logf(IB_LOG_LEVEL_WARN,
+				"Using the doublewrite buffer in the "
+				"system tablespace");
+
+			srv_parallel_doublewrite = FALSE;
+			return;
+		}
+	}
+
+	buf_dblwr->n_files = n_files;
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Using %lu parallel doublewrite files",
+		(ulong) n_files);
+}
+
+/****************************************************************//**
+Loads the pages of the parallel doublewrite files that exist on disk into
+memory for crash recovery. All files are scanned, whatever the current
+number of buffer pool instances and value of innodb_parallel_doublewrite
+are, because they might have been different before the crash. */
+static
+void
+buf_dblwr_files_load_pages(
+/*=======================*/
+	recv_dblwr_t&	recv_dblwr)	/*!< in/out: pages for recovery */
+{
+	char	name[OS_FILE_MAX_PATH];
+
+	ut_ad(buf_dblwr->recv_bufs == NULL);
+
+	for (ulint n = 0; n < BUF_DBLWR_FILES_MAX; n++) {
+		os_file_t	file;
+		ibool		success;
+		ulint		n_pages;
+		byte*		buf;
+
+		buf_dblwr_file_name(name, n);
+
+		file = os_file_create_simple_no_error_handling(
+			innodb_file_data_key, name, OS_FILE_OPEN,
+			OS_FILE_READ_ONLY, &success);
+
+		if (!success) {
+			continue;
+		}
+
+		if (buf_dblwr->recv_bufs == NULL) {
+			buf_dblwr->recv_bufs = static_cast<byte**>(
+				mem_zalloc(BUF_DBLWR_FILES_MAX
+					   * sizeof(byte*)));
+		}
+
+		n_pages = static_cast<ulint>(
+			os_file_get_size(file) / UNIV_PAGE_SIZE);
+
+		buf_dblwr->recv_bufs[n] = static_cast<byte*>(
+			ut_malloc((1 + n_pages) * UNIV_PAGE_SIZE));
+
+		buf = static_cast<byte*>(
+			ut_align(buf_dblwr->recv_bufs[n], UNIV_PAGE_SIZE));
+
+		if (n_pages > 0
+		    && !os_file_read(file, buf, 0, n_pages * UNIV_PAGE_SIZE)) {
+
+			ib_logf(IB_LOG_LEVEL_WARN,
+				"Cannot read the doublewrite file %s", name);
+			n_pages = 0;
+		}
+
+		os_file_close(file);
+
+		for (ulint i = 0; i < n_pages; i++) {
+			byte*	page = buf + i * UNIV_PAGE_SIZE;
+
+			if (buf_page_is_zeroes(page, 0)) {
+				/* This part of the file has not
+				been written to yet. */
+				continue;
+			}
+
+			recv_dblwr.add(page,
+				       mach_read_from_4(
+					       page + FIL_PAGE_SPACE_ID),
+				       mach_read_from_4(
+					       page + FIL_PAGE_OFFSET));
+		}
+	}
+}
+
 /****************************************************************//**
 Creates or initialializes the doublewrite buffer at a database start. */
 static
@@ -181,6 +462,8 @@ buf_dblwr_init(
 			buf_dblwr->block1);
 	mach_write_to_2(buf_dblwr->header + FIL_PAGE_TYPE,
 			FIL_PAGE_TYPE_DBLWR_HEADER);
+
+	buf_dblwr_files_open();
 }
 
 /****************************************************************//**
@@ -584,10 +867,50 @@ buf_dblwr_init_or_load_pages(
 		os_file_flush(file);
 	}
 
+	if (load_corrupt_pages) {
+		buf_dblwr_files_load_pages(recv_dblwr);
+	}
+
 leave_func:
 	ut_free(unaligned_read_buf);
 }
 
+/****************************************************************//**
+Frees the copies of the pages which were loaded from the parallel
+doublewrite files for crash recovery, and removes the files which are
+not used by this server instance. */
+UNIV_INTERN
+void
+buf_dblwr_free_recv_pages(void)
+/*===========================*/
+{
+	char	name[OS_FILE_MAX_PATH];
+
+	if (buf_dblwr == NULL || buf_dblwr->recv_bufs == NULL) {
+		return;
+	}
+
+	for (ulint n = 0; n < BUF_DBLWR_FILES_MAX; n++) {
+
+		if (buf_dblwr->recv_bufs[n] == NULL) {
+			continue;
+		}
+
+		ut_free(buf_dblwr->recv_bufs[n]);
+
+		/* A file left behind by an earlier configuration would
+		keep stale page copies that a later recovery could
+		restore. */
+		if (n >= buf_dblwr->n_files && !srv_read_only_mode) {
+			buf_dblwr_file_name(name, n);
+			os_file_delete_if_exists(innodb_file_data_key, name);
+		}
+	}
+
+	mem_free(buf_dblwr->recv_bufs);
+	buf_dblwr->recv_bufs = NULL;
+}
+
 /****************************************************************//**
 Process the double write buffer pages. */
 void
@@ -635,6 +958,18 @@ buf_dblwr_process()
 			       zip_size ? zip_size : UNIV_PAGE_SIZE,
 			       read_buf, NULL);
 
+			/* The page may have been written through more
+			than one of the parallel doublewrite files and the
+			doublewrite buffer: use the newest copy. */
+			if (i->page != NULL) {
+				byte*	newest = recv_sys->dblwr.find_page(
+					i->space_id, i->page_no);
+
+				if (newest != NULL) {
+					i->page = newest;
+				}
+			}
+
 			/* Check if the page is corrupt */
 
 			if (buf_page_is_corrupted(true, read_buf, zip_size)) {
@@ -759,6 +1094,18 @@ buf_dblwr_free(void)
 	mem_free(buf_dblwr->in_use);
 	buf_dblwr->in_use = NULL;
 
+	for (ulint i = 0; i < buf_dblwr->n_files; i++) {
+		buf_dblwr_file_close(&buf_dblwr->files[i]);
+	}
+
+	if (buf_dblwr->files != NULL) {
+		mem_free(buf_dblwr->files);
+		buf_dblwr->files = NULL;
+		buf_dblwr->n_files = 0;
+	}
+
+	buf_dblwr_free_recv_pages();
+
 	mutex_free(&buf_dblwr->mutex);
 	mem_free(buf_dblwr);
 	buf_dblwr = NULL;
@@ -777,9 +1124,39 @@ buf_dblwr_update(
 		return;
 	}
 
+	buf_dblwr_file_t*	file;
+
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
+		file = buf_dblwr_get_file(bpage, flush_type);
+
+		if (file != NULL) {
+			mutex_enter(&file->mutex);
+
+			ut_ad(file->batch_running);
+			ut_ad(file->b_reserved > 0);
+			ut_ad(file->b_reserved <= file->first_free);
+
+			file->b_reserved--;
+
+			if (file->b_reserved == 0) {
+				mutex_exit(&file->mutex);
+				/* This will finish the batch. Sync data
+				files to the disk. */
+				fil_flush_file_spaces(FIL_TABLESPACE);
+				mutex_enter(&file->mutex);
+
+				/* We can now reuse the write buffer: */
+				file->first_free = 0;
+				file->batch_running = false;
+				os_event_set(file->b_event);
+			}
+
+			mutex_exit(&file->mutex);
+			break;
+		}
+
 		mutex_enter(&buf_dblwr->mutex);
 
 		ut_ad(buf_dblwr->batch_running);
@@ -954,6 +1331,171 @@ buf_dblwr_write_block_to_datafile(
 
 }
 
+/********************************************************************//**
+Copies a page to a slot of a doublewrite write buffer. A compressed page is
+padded with zeroes to UNIV_PAGE_SIZE. */
+static
+void
+buf_dblwr_copy_page(
+/*================*/
+	byte*			buf,	/*!< out: slot in the write buffer */
+	const buf_page_t*	bpage)	/*!< in: buffer block to write */
+{
+	ulint	zip_size = buf_page_get_zip_size(bpage);
+
+	if (zip_size) {
+		UNIV_MEM_ASSERT_RW(bpage->zip.data, zip_size);
+		/* Copy the compressed page and clear the rest. */
+		memcpy(buf, bpage->zip.data, zip_size);
+		memset(buf + zip_size, 0, UNIV_PAGE_SIZE - zip_size);
+	} else {
+		ut_a(buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE);
+		UNIV_MEM_ASSERT_RW(((buf_block_t*) bpage)->frame,
+				   UNIV_PAGE_SIZE);
+
+		memcpy(buf, ((buf_block_t*) bpage)->frame, UNIV_PAGE_SIZE);
+	}
+}
+
+/********************************************************************//**
+Writes the batch of a parallel doublewrite file to the file, syncs it and
+then posts the writes of the pages to the datafiles. The datafiles are
+synced by the IO helper thread when the last of the writes completes. */
+static
+void
+buf_dblwr_file_flush(
+/*=================*/
+	buf_dblwr_file_t*	file)	/*!< in/out: doublewrite file */
+{
+	ulint	first_free;
+
+try_again:
+	mutex_enter(&file->mutex);
+
+	if (file->first_free == 0) {
+
+		mutex_exit(&file->mutex);
+
+		return;
+	}
+
+	if (file->batch_running) {
+		/* Another thread is writing the batch right now. Wait
+		for it to finish. */
+		ib_int64_t	sig_count = os_event_reset(file->b_event);
+		mutex_exit(&file->mutex);
+
+		os_event_wait_low(file->b_event, sig_count);
+		goto try_again;
+	}
+
+	ut_ad(file->first_free == file->b_reserved);
+
+	/* Disallow anyone else to post to the batch or to start
+	writing it. */
+	file->batch_running = true;
+	first_free = file->first_free;
+
+	mutex_exit(&file->mutex);
+
+	for (ulint i = 0; i < first_free; i++) {
+		const buf_block_t*	block;
+
+		block = (buf_block_t*) file->buf_block_arr[i];
+
+		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
+		    || block->page.zip.data) {
+			/* No simple validate for compressed
+			pages exists. */
+			continue;
+		}
+
+		/* Check that the actual page in the buffer pool is
+		not corrupt and the LSN values are sane. */
+		buf_dblwr_check_block(block);
+
+		/* Check that the page as written to the doublewrite
+		file has sane LSN values. */
+		buf_dblwr_check_page_lsn(file->write_buf
+					 + i * UNIV_PAGE_SIZE);
+	}
+
+	if (!os_file_write(file->name, file->file, file->write_buf, 0,
+			   first_free * UNIV_PAGE_SIZE)
+	    || !os_file_flush(file->file)) {
+
+		ib_logf(IB_LOG_LEVEL_FATAL,
+			"Cannot write the doublewrite file %s", file->name);
+	}
+
+	srv_stats.dblwr_pages_written.add(first_free);
+	srv_stats.dblwr_writes.inc();
+
+	/* The pages are now safe in the doublewrite file. Next do the
+	writes to the intended positions. As with the doublewrite buffer,
+	file->first_free can not be used as the loop bound here. */
+	for (ulint i = 0; i < first_free; i++) {
+		buf_dblwr_write_block_to_datafile(
+			file->buf_block_arr[i], false);
+	}
+
+	/* Wake possible simulated aio thread to actually post the
+	writes to the operating system. */
+	os_aio_simulated_wake_handler_threads();
+}
+
+/********************************************************************//**
+Posts a buffer page for writing to the batch of a parallel doublewrite file.
+If the batch is full it is written out first. */
+static
+void
+buf_dblwr_file_add(
+/*===============*/
+	buf_dblwr_file_t*	file,	/*!< in/out: doublewrite file */
+	buf_page_t*		bpage)	/*!< in: buffer block to write */
+{
+try_again:
+	mutex_enter(&file->mutex);
+
+	ut_a(file->first_free <= srv_doublewrite_batch_size);
+
+	if (file->batch_running) {
+		ib_int64_t	sig_count = os_event_reset(file->b_event);
+		mutex_exit(&file->mutex);
+
+		os_event_wait_low(file->b_event, sig_count);
+		goto try_again;
+	}
+
+	if (file->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&file->mutex);
+
+		buf_dblwr_file_flush(file);
+
+		goto try_again;
+	}
+
+	buf_dblwr_copy_page(file->write_buf
+			    + UNIV_PAGE_SIZE * file->first_free, bpage);
+
+	file->buf_block_arr[file->first_free] = bpage;
+
+	file->first_free++;
+	file->b_reserved++;
+
+	ut_ad(file->first_free == file->b_reserved);
+
+	if (file->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&file->mutex);
+
+		buf_dblwr_file_flush(file);
+
+		return;
+	}
+
+	mutex_exit(&file->mutex);
+}
+
 /********************************************************************//**
 Flushes possible buffered writes from the doublewrite memory buffer to disk,
 and also wakes up the aio thread if simulated aio is used. It is very
@@ -977,6 +1519,10 @@ buf_dblwr_flush_buffered_writes(void)
 		return;
 	}
 
+	for (ulint i = 0; i < buf_dblwr->n_files; i++) {
+		buf_dblwr_file_flush(&buf_dblwr->files[i]);
+	}
+
 try_again:
 	mutex_enter(&buf_dblwr->mutex);
 
@@ -1153,6 +1699,33 @@ flush:
 	os_aio_simulated_wake_handler_threads();
 }
 
+/********************************************************************//**
+Flushes the buffered writes of the batch of one buffer pool instance and
+flush type. With innodb_parallel_doublewrite each buffer pool instance has
+a doublewrite file for each flush type and only that file is written;
+otherwise this is the same as buf_dblwr_flush_buffered_writes(). */
+UNIV_INTERN
+void
+buf_dblwr_flush_instance_writes(
+/*============================*/
+	const buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	buf_flush_t		flush_type)	/*!< in: BUF_FLUSH_LRU or
+						BUF_FLUSH_LIST */
+{
+	ut_ad(flush_type == BUF_FLUSH_LRU || flush_type == BUF_FLUSH_LIST);
+
+	if (!srv_use_doublewrite_buf || buf_dblwr == NULL
+	    || buf_dblwr->n_files == 0) {
+
+		buf_dblwr_flush_buffered_writes();
+		return;
+	}
+
+	buf_dblwr_file_flush(&buf_dblwr->files[
+		buf_pool_index(buf_pool) * BUF_DBLWR_FILES_PER_INSTANCE
+		+ (flush_type == BUF_FLUSH_LIST)]);
+}
+
 /********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
@@ -1163,10 +1736,17 @@ buf_dblwr_add_to_batch(
 /*====================*/
 	buf_page_t*	bpage)	/*!< in: buffer block to write */
 {
-	ulint	zip_size;
+	buf_dblwr_file_t*	file;
 
 	ut_a(buf_page_in_file(bpage));
 
+	file = buf_dblwr_get_file(bpage, buf_page_get_flush_type(bpage));
+
+	if (file != NULL) {
+		buf_dblwr_file_add(file, bpage);
+		return;
+	}
+
 try_again:
 	mutex_enter(&buf_dblwr->mutex);
 
@@ -1195,26 +1775,8 @@ try_again:
 		goto try_again;
 	}
 
-	zip_size = buf_page_get_zip_size(bpage);
-
-	if (zip_size) {
-		UNIV_MEM_ASSERT_RW(bpage->zip.data, zip_size);
-		/* Copy the compressed page and clear the rest. */
-		memcpy(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free,
-		       bpage->zip.data, zip_size);
-		memset(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free
-		       + zip_size, 0, UNIV_PAGE_SIZE - zip_size);
-	} else {
-		ut_a(buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE);
-		UNIV_MEM_ASSERT_RW(((buf_block_t*) bpage)->frame,
-				   UNIV_PAGE_SIZE);
-
-		memcpy(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free,
-		       ((buf_block_t*) bpage)->frame, UNIV_PAGE_SIZE);
-	}
+	buf_dblwr_copy_page(buf_dblwr->write_buf
+			    + UNIV_PAGE_SIZE * buf_dblwr->first_free, bpage);
 
 	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
 
@@ -69,6 +69,61 @@ UNIV_INTERN mysql_pfs_key_t buf_lru_manager_thread_key;
 /** Event to synchronise with the flushing. */
  os_event_t	buf_lru_event;
 
+/** Work request and result of the page cleaner workers for one buffer
+pool instance */
+struct page_cleaner_slot_t {
+	bool		requested[BUF_FLUSH_N_TYPES];
+					/*!< true if a batch of this type
+					has been requested but not yet
+					picked up by the owning worker */
+	ulint		min_n;		/*!< BUF_FLUSH_LIST: wished minimum
+					number of pages to flush */
+	lsn_t		lsn_limit;	/*!< BUF_FLUSH_LIST: flush up to
+					this lsn */
+	bool		success;	/*!< BUF_FLUSH_LIST: false if
+					another flush list batch was
+					already running in the instance */
+	ulint		n_processed[BUF_FLUSH_N_TYPES];
+					/*!< number of pages processed
+					by the last batch of each type */
+};
+
+/** Page cleaner workers. Buffer pool instance i is owned by worker
+i % n_workers, where worker 0 is the thread that requests the batch: the
+page_cleaner thread for flush list batches and the lru_manager thread for
+LRU batches. */
+struct page_cleaner_t {
+	os_ib_mutex_t	mutex;		/*!< protects the fields below and
+					the slots */
+	os_event_t	is_requested;	/*!< set when a batch has been
+					requested from the workers */
+	os_event_t	is_finished[BUF_FLUSH_N_TYPES];
+					/*!< set when the workers have
+					finished the requested batches
+					of the type */
+	ulint		n_pending[BUF_FLUSH_N_TYPES];
+					/*!< number of requested slots of
+					the type not yet finished */
+	ulint		n_workers;	/*!< number of threads that flush,
+					including the requesting thread */
+	ulint		n_workers_started;
+					/*!< used to assign the worker
+					numbers */
+	ulint		n_workers_running;
+					/*!< number of worker threads that
+					have not exited */
+	bool		is_running;	/*!< false when the workers have
+					been told to exit */
+	page_cleaner_slot_t*	slots;	/*!< one per buffer pool instance */
+};
+
+/** The page cleaner workers, or NULL if not initialized */
+static page_cleaner_t*	page_cleaner = NULL;
+
+#ifdef UNIV_PFS_THREAD
+UNIV_INTERN mysql_pfs_key_t buf_page_cleaner_worker_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
 /** If LRU list of a buf_pool is less than this size then LRU eviction
 should not happen. This is because when we do LRU flushing we also put
 the blocks on free list. If LRU list is very small then we can end up
@@ -1646,10 +1701,11 @@ static
 void
 buf_flush_common(
 /*=============*/
+	buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
 	buf_flush_t	flush_type,	/*!< in: type of flush */
 	ulint		page_count)	/*!< in: number of pages flushed */
 {
-	buf_dblwr_flush_buffered_writes();
+	buf_dblwr_flush_instance_writes(buf_pool, flush_type);
 
 	ut_a(flush_type == BUF_FLUSH_LRU || flush_type == BUF_FLUSH_LIST);
 
@@ -1751,6 +1807,53 @@ buf_flush_wait_batch_end(
 	}
 }
 
+/*******************************************************************//**
+Flushes dirty blocks from the end of the flush list of one buffer pool
+instance.
+NOTE: The calling thread is not allowed to own any latches on pages!
+@return false if another flush list batch was already running in the
+instance */
+static
+bool
+buf_flush_list_instance(
+/*====================*/
+	buf_pool_t*	buf_pool,	/*!< in/out: buffer pool instance */
+	ulint		min_n,		/*!< in: wished minimum mumber of blocks
+					flushed from this instance */
+	lsn_t		lsn_limit,	/*!< in: all blocks whose
+					oldest_modification is smaller than
+					this should be flushed (if their
+					number does not exceed min_n) */
+	ulint*		n_processed)	/*!< out: the number of pages
+					which were processed */
+{
+	std::pair<ulint, ulint>	res;
+
+	*n_processed = 0;
+
+	if (!buf_flush_start(buf_pool, BUF_FLUSH_LIST)) {
+		return(false);
+	}
+
+	res = buf_flush_batch(buf_pool, BUF_FLUSH_LIST, min_n, lsn_limit);
+
+	buf_flush_end(buf_pool, BUF_FLUSH_LIST);
+
+	buf_flush_common(buf_pool, BUF_FLUSH_LIST, res.first);
+
+	if (res.first) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_FLUSH_BATCH_TOTAL_PAGE,
+			MONITOR_FLUSH_BATCH_COUNT,
+			MONITOR_FLUSH_BATCH_PAGES,
+			res.first);
+	}
+
+	*n_processed = res.first;
+
+	return(true);
+}
+
 /*******************************************************************//**
 This utility flushes dirty blocks from the end of the flush list of
 all buffer pool instances.
@@ -1793,44 +1896,21 @@ buf_flush_list(
 
 	/* Flush to lsn_limit in all buffer pool instances */
 	for (i = 0; i < srv_buf_pool_instances; i++) {
-		buf_pool_t*		buf_pool;
-		std::pair<ulint, ulint>	res;
-
-		buf_pool = buf_pool_from_array(i);
-
-		if (!buf_flush_start(buf_pool, BUF_FLUSH_LIST)) {
-			/* We have two choices here. If lsn_limit was
-			specified then skipping an instance of buffer
-			pool means we cannot guarantee that all pages
-			up to lsn_limit has been flushed. We can
-			return right now with failure or we can try
-			to flush remaining buffer pools up to the
-			lsn_limit. We attempt to flush other buffer
-			pools based on the assumption that it will
-			help in the retry which will follow the
-			failure. */
+		ulint	n;
+
+		/* If we skip an instance because a flush list batch is
+		already running there, we cannot guarantee that all pages
+		up to lsn_limit have been flushed. We could return right
+		now with failure, but we attempt to flush the other buffer
+		pools based on the assumption that it will help in the
+		retry which will follow the failure. */
+		if (!buf_flush_list_instance(
+			    buf_pool_from_array(i), min_n, lsn_limit, &n)) {
 			success = false;
-
-			continue;
 		}
 
-		res = buf_flush_batch(
-			buf_pool, BUF_FLUSH_LIST, min_n, lsn_limit);
-
-		buf_flush_end(buf_pool, BUF_FLUSH_LIST);
-
-		buf_flush_common(BUF_FLUSH_LIST, res.first);
-
 		if (n_processed) {
-			*n_processed += res.first;
-		}
-
-		if (res.first) {
-			MONITOR_INC_VALUE_CUMULATIVE(
-				MONITOR_FLUSH_BATCH_TOTAL_PAGE,
-				MONITOR_FLUSH_BATCH_COUNT,
-				MONITOR_FLUSH_BATCH_PAGES,
-				res.first);
+			*n_processed += n;
 		}
 	}
 
@@ -1918,64 +1998,78 @@ buf_flush_single_page_from_LRU(
 }
 
 /*********************************************************************//**
-Clears up tail of the LRU lists:
+Clears up tail of the LRU list of one buffer pool instance:
 * Put replaceable pages at the tail of LRU to the free list
 * Flush dirty pages at the tail of LRU to the disk
-The depth to which we scan each buffer pool is controlled by dynamic
-config parameter innodb_LRU_scan_depth.
-@return total pages processed. */
-UNIV_INTERN
+@return pages processed. */
+static
 ulint
-buf_flush_LRU_tail(void)
-/*====================*/
+buf_flush_LRU_tail_instance(
+/*========================*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
 {
-	ulint	total_processed = 0;
+	std::pair<ulint, ulint>	res;
+	ulint			scan_depth;
 
-	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+	/* srv_LRU_scan_depth can be arbitrarily large value.
+	We cap it with current LRU size. */
+	buf_pool_mutex_enter(buf_pool);
+	scan_depth = UT_LIST_GET_LEN(buf_pool->LRU);
+	buf_pool_mutex_exit(buf_pool);
 
-		buf_pool_t*	buf_pool = buf_pool_from_array(i);
-		std::pair<ulint, ulint>	res;
-		ulint	scan_depth;
+	scan_depth = ut_min(srv_LRU_scan_depth, scan_depth);
 
-		/* srv_LRU_scan_depth can be arbitrarily large value.
-		We cap it with current LRU size. */
-		buf_pool_mutex_enter(buf_pool);
-		scan_depth = UT_LIST_GET_LEN(buf_pool->LRU);
-		buf_pool_mutex_exit(buf_pool);
+	/* Currently page_cleaner is the only thread
+	that can trigger an LRU flush. It is possible
+	that a batch triggered during last iteration is
+	still running, */
+	if (!buf_flush_start(buf_pool, BUF_FLUSH_LRU)) {
+		return(0);
+	}
 
-		scan_depth = ut_min(srv_LRU_scan_depth, scan_depth);
+	res = buf_flush_batch(buf_pool, BUF_FLUSH_LRU, scan_depth, 0);
 
-		/* Currently page_cleaner is the only thread
-		that can trigger an LRU flush. It is possible
-		that a batch triggered during last iteration is
-		still running, */
-		if (!buf_flush_start(buf_pool, BUF_FLUSH_LRU)) {
-			continue;
-		}
+	buf_flush_end(buf_pool, BUF_FLUSH_LRU);
+
+	buf_flush_common(buf_pool, BUF_FLUSH_LRU, res.first);
 
-		res = buf_flush_batch(buf_pool, BUF_FLUSH_LRU, scan_depth, 0);
+	if (res.first) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_LRU_BATCH_FLUSH_TOTAL_PAGE,
+			MONITOR_LRU_BATCH_FLUSH_COUNT,
+			MONITOR_LRU_BATCH_FLUSH_PAGES,
+			res.first);
+	}
 
-		buf_flush_end(buf_pool, BUF_FLUSH_LRU);
+	if (res.second) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_LRU_BATCH_EVICT_TOTAL_PAGE,
+			MONITOR_LRU_BATCH_EVICT_COUNT,
+			MONITOR_LRU_BATCH_EVICT_PAGES,
+			res.second);
+	}
 
-		buf_flush_common(BUF_FLUSH_LRU, res.first);
+	return(res.first + res.second);
+}
 
-		if (res.first) {
-			MONITOR_INC_VALUE_CUMULATIVE(
-				MONITOR_LRU_BATCH_FLUSH_TOTAL_PAGE,
-				MONITOR_LRU_BATCH_FLUSH_COUNT,
-				MONITOR_LRU_BATCH_FLUSH_PAGES,
-				res.first);
-		}
+/*********************************************************************//**
+Clears up tail of the LRU lists:
+* Put replaceable pages at the tail of LRU to the free list
+* Flush dirty pages at the tail of LRU to the disk
+The depth to which we scan each buffer pool is controlled by dynamic
+config parameter innodb_LRU_scan_depth.
+@return total pages processed. */
+UNIV_INTERN
+ulint
+buf_flush_LRU_tail(void)
+/*====================*/
+{
+	ulint	total_processed = 0;
 
-		if (res.second) {
-			MONITOR_INC_VALUE_CUMULATIVE(
-				MONITOR_LRU_BATCH_EVICT_TOTAL_PAGE,
-				MONITOR_LRU_BATCH_EVICT_COUNT,
-				MONITOR_LRU_BATCH_EVICT_PAGES,
-				res.second);
-		}
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
 
-		total_processed += (res.first + res.second);
+		total_processed += buf_flush_LRU_tail_instance(
+			buf_pool_from_array(i));
 	}
 
 	return(total_processed);
@@ -2006,6 +2100,331 @@ buf_flush_wait_LRU_batch_end(void)
 	}
 }
 
+/*********************************************************************//**
+Initializes the page cleaner workers. The caller must then create
+srv_n_page_cleaners - 1 buf_flush_page_cleaner_worker threads. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void)
+/*=============================*/
+{
+	ut_a(page_cleaner == NULL);
+	ut_a(srv_n_page_cleaners >= 1);
+	ut_a(srv_n_page_cleaners <= srv_buf_pool_instances);
+
+	page_cleaner = static_cast<page_cleaner_t*>(
+		mem_zalloc(sizeof(*page_cleaner)));
+
+	page_cleaner->mutex = os_mutex_create();
+	page_cleaner->is_requested = os_event_create();
+	page_cleaner->is_finished[BUF_FLUSH_LRU] = os_event_create();
+	page_cleaner->is_finished[BUF_FLUSH_LIST] = os_event_create();
+
+	page_cleaner->n_workers = srv_n_page_cleaners;
+	page_cleaner->n_workers_running = srv_n_page_cleaners - 1;
+	page_cleaner->is_running = srv_n_page_cleaners > 1;
+
+	page_cleaner->slots = static_cast<page_cleaner_slot_t*>(
+		mem_zalloc(srv_buf_pool_instances
+			   * sizeof(*page_cleaner->slots)));
+}
+
+/*********************************************************************//**
+Tells the page cleaner workers to exit and waits until they have exited. */
+static
+void
+buf_flush_page_cleaner_workers_exit(void)
+/*=====================================*/
+{
+	os_mutex_enter(page_cleaner->mutex);
+	page_cleaner->is_running = false;
+	os_mutex_exit(page_cleaner->mutex);
+
+	os_event_set(page_cleaner->is_requested);
+
+	for (;;) {
+		ulint	n_running;
+
+		os_mutex_enter(page_cleaner->mutex);
+		n_running = page_cleaner->n_workers_running;
+		os_mutex_exit(page_cleaner->mutex);
+
+		if (n_running == 0) {
+			break;
+		}
+
+		os_thread_sleep(10000);
+	}
+}
+
+/*********************************************************************//**
+Frees the page cleaner workers. All the threads that use them must have
+exited. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_close(void)
+/*==============================*/
+{
+	if (page_cleaner == NULL) {
+		return;
+	}
+
+	ut_a(page_cleaner->n_workers_running == 0);
+
+	mem_free(page_cleaner->slots);
+
+	os_event_free(page_cleaner->is_finished[BUF_FLUSH_LIST]);
+	os_event_free(page_cleaner->is_finished[BUF_FLUSH_LRU]);
+	os_event_free(page_cleaner->is_requested);
+	os_mutex_free(page_cleaner->mutex);
+
+	mem_free(page_cleaner);
+	page_cleaner = NULL;
+}
+
+/*********************************************************************//**
+Does the batch requested in a page cleaner slot.
+@return number of pages processed */
+static
+ulint
+page_cleaner_do_slot(
+/*=================*/
+	ulint		i,	/*!< in: buffer pool instance number */
+	buf_flush_t	type)	/*!< in: BUF_FLUSH_LRU or BUF_FLUSH_LIST */
+{
+	page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+	buf_pool_t*		buf_pool = buf_pool_from_array(i);
+
+	if (type == BUF_FLUSH_LRU) {
+		slot->n_processed[type] = buf_flush_LRU_tail_instance(
+			buf_pool);
+	} else {
+		ut_ad(type == BUF_FLUSH_LIST);
+
+		slot->success = buf_flush_list_instance(
+			buf_pool, slot->min_n, slot->lsn_limit,
+			&slot->n_processed[type]);
+	}
+
+	return(slot->n_processed[type]);
+}
+
+/*********************************************************************//**
+Does a batch of the given type in all buffer pool instances, sharing the
+instances with the page cleaner workers.
+@return number of pages processed */
+static
+ulint
+page_cleaner_do_batch(
+/*==================*/
+	buf_flush_t	type,		/*!< in: BUF_FLUSH_LRU or
+					BUF_FLUSH_LIST */
+	ulint		min_n,		/*!< in: BUF_FLUSH_LIST: wished
+					minimum number of pages to flush
+					from each instance */
+	lsn_t		lsn_limit,	/*!< in: BUF_FLUSH_LIST: flush up to
+					this lsn */
+	bool*		success)	/*!< out: BUF_FLUSH_LIST: false if
+					another flush list batch was running
+					in some instance */
+{
+	ulint		n_workers;
+	ulint		n_processed = 0;
+	ib_int64_t	sig_count = 0;
+
+	*success = true;
+
+	os_mutex_enter(page_cleaner->mutex);
+
+	/* If the workers have exited at shutdown, the requesting thread
+	does all the work. */
+	n_workers = page_cleaner->is_running ? page_cleaner->n_workers : 1;
+
+	ut_a(page_cleaner->n_pending[type] == 0);
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		if (type == BUF_FLUSH_LIST) {
+			/* Only the page_cleaner thread requests flush
+			list batches, so nobody is reading these. */
+			slot->min_n = min_n;
+			slot->lsn_limit = lsn_limit;
+		}
+
+		if (i % n_workers != 0) {
+			slot->requested[type] = true;
+			page_cleaner->n_pending[type]++;
+		}
+	}
+
+	if (page_cleaner->n_pending[type] > 0) {
+		sig_count = os_event_reset(page_cleaner->is_finished[type]);
+	}
+
+	os_mutex_exit(page_cleaner->mutex);
+
+	os_event_set(page_cleaner->is_requested);
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i += n_workers) {
+		n_processed += page_cleaner_do_slot(i, type);
+
+		if (type == BUF_FLUSH_LIST
+		    && !page_cleaner->slots[i].success) {
+			*success = false;
+		}
+	}
+
+	/* Wait for the workers to finish their instances. */
+
+	os_mutex_enter(page_cleaner->mutex);
+
+	while (page_cleaner->n_pending[type] > 0) {
+		os_mutex_exit(page_cleaner->mutex);
+
+		os_event_wait_low(page_cleaner->is_finished[type], sig_count);
+
+		os_mutex_enter(page_cleaner->mutex);
+
+		sig_count = os_event_reset(page_cleaner->is_finished[type]);
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		if (i % n_workers != 0) {
+			n_processed += page_cleaner->slots[i].n_processed[type];
+
+			if (type == BUF_FLUSH_LIST
+			    && !page_cleaner->slots[i].success) {
+				*success = false;
+			}
+		}
+	}
+
+	os_mutex_exit(page_cleaner->mutex);
+
+	return(n_processed);
+}
+
+/******************************************************************//**
+Page cleaner worker thread, which does the flush list and LRU batches of
+the buffer pool instances it owns on request of the page_cleaner and
+lru_manager threads.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
+/*==========================================*/
+	void*	arg __attribute__((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	ulint	id;
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(buf_page_cleaner_worker_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	os_mutex_enter(page_cleaner->mutex);
+	id = ++page_cleaner->n_workers_started;
+	os_mutex_exit(page_cleaner->mutex);
+
+	ut_a(id < page_cleaner->n_workers);
+
+#ifdef UNIV_DEBUG_THREAD_CREATION
+	fprintf(stderr, "InnoDB: page_cleaner worker %lu running, id %lu\n",
+		id, os_thread_pf(os_thread_get_curr_id()));
+#endif /* UNIV_DEBUG_THREAD_CREATION */
+
+	for (;;) {
+		ib_int64_t	sig_count;
+		ulint		slot_no = ULINT_UNDEFINED;
+		buf_flush_t	type = BUF_FLUSH_LRU;
+
+		sig_count = os_event_reset(page_cleaner->is_requested);
+
+		os_mutex_enter(page_cleaner->mutex);
+
+		/* Look for a requested batch in our instances. LRU
+		batches go first, because user threads may be waiting
+		for free pages. */
+		for (ulint i = id;
+		     slot_no == ULINT_UNDEFINED
+		     && i < srv_buf_pool_instances;
+		     i += page_cleaner->n_workers) {
+
+			page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+			if (slot->requested[BUF_FLUSH_LRU]) {
+				slot_no = i;
+				type = BUF_FLUSH_LRU;
+			} else if (slot->requested[BUF_FLUSH_LIST]) {
+				slot_no = i;
+				type = BUF_FLUSH_LIST;
+			}
+		}
+
+		if (slot_no == ULINT_UNDEFINED) {
+			bool	is_running = page_cleaner->is_running;
+
+			os_mutex_exit(page_cleaner->mutex);
+
+			if (!is_running) {
+				break;
+			}
+
+			os_event_wait_low(page_cleaner->is_requested,
+					  sig_count);
+			continue;
+		}
+
+		page_cleaner->slots[slot_no].requested[type] = false;
+
+		os_mutex_exit(page_cleaner->mutex);
+
+		ulint	n = page_cleaner_do_slot(slot_no, type);
+
+		MONITOR_INC_VALUE(MONITOR_FLUSH_WORKER_PAGES, n);
+
+		os_mutex_enter(page_cleaner->mutex);
+
+		ut_a(page_cleaner->n_pending[type] > 0);
+
+		if (--page_cleaner->n_pending[type] == 0) {
+			os_event_set(page_cleaner->is_finished[type]);
+		}
+
+		os_mutex_exit(page_cleaner->mutex);
+	}
+
+	os_mutex_enter(page_cleaner->mutex);
+	page_cleaner->n_workers_running--;
+	os_mutex_exit(page_cleaner->mutex);
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Clears up the tails of the LRU lists, sharing the buffer pool instances
+with the page cleaner workers if there are any.
+@return total pages processed */
+static
+ulint
+page_cleaner_do_LRU_batch(void)
+/*===========================*/
+{
+	bool	success;
+
+	if (page_cleaner == NULL || page_cleaner->n_workers == 1) {
+		return(buf_flush_LRU_tail());
+	}
+
+	return(page_cleaner_do_batch(BUF_FLUSH_LRU, 0, 0, &success));
+}
+
 /*********************************************************************//**
 Flush a batch of dirty pages from the flush list
 @return number of pages flushed, 0 if no page is flushed or if another
@@ -2019,11 +2438,65 @@ page_cleaner_do_flush_batch(
 	lsn_t		lsn_limit)	/*!< in: LSN up to which flushing
 					must happen */
 {
-	ulint n_flushed;
+	ulint	n_flushed;
+	bool	success;
 
-	buf_flush_list(n_to_flush, lsn_limit, &n_flushed);
+	if (page_cleaner == NULL || page_cleaner->n_workers == 1) {
+		buf_flush_list(n_to_flush, lsn_limit, &n_flushed);
 
-	return(n_flushed);
+		return(n_flushed);
+	}
+
+	/* Spread the flushing evenly amongst the buffer pool instances,
+	as buf_flush_list() does. */
+	if (n_to_flush != ULINT_MAX) {
+		n_to_flush = (n_to_flush + srv_buf_pool_instances - 1)
+			/ srv_buf_pool_instances;
+	}
+
+	return(page_cleaner_do_batch(
+		       BUF_FLUSH_LIST, n_to_flush, lsn_limit, &success));
+}
+
+/*********************************************************************//**
+Updates the monitor counters for the smallest and the largest redo lag,
+that is, the age of the oldest modification, of the buffer pool
+instances. A large difference shows that the flushing is unbalanced. */
+static
+void
+page_cleaner_set_instance_lag(void)
+/*===============================*/
+{
+	lsn_t	cur_lsn = log_get_lsn();
+	lsn_t	max_lag = 0;
+	lsn_t	min_lag = LSN_MAX;
+
+	if (!MONITOR_IS_ON(MONITOR_FLUSH_INSTANCE_MAX_LAG)
+	    && !MONITOR_IS_ON(MONITOR_FLUSH_INSTANCE_MIN_LAG)) {
+		return;
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_pool_t*	buf_pool = buf_pool_from_array(i);
+		buf_page_t*	bpage;
+		lsn_t		lag = 0;
+
+		buf_flush_list_mutex_enter(buf_pool);
+
+		bpage = UT_LIST_GET_LAST(buf_pool->flush_list);
+
+		if (bpage != NULL && cur_lsn > bpage->oldest_modification) {
+			lag = cur_lsn - bpage->oldest_modification;
+		}
+
+		buf_flush_list_mutex_exit(buf_pool);
+
+		max_lag = ut_max(max_lag, lag);
+		min_lag = ut_min(min_lag, lag);
+	}
+
+	MONITOR_SET(MONITOR_FLUSH_INSTANCE_MAX_LAG, max_lag);
+	MONITOR_SET(MONITOR_FLUSH_INSTANCE_MIN_LAG, min_lag);
 }
 
 /*********************************************************************//**
@@ -2379,6 +2852,8 @@ DECLARE_THREAD(buf_flush_page_cleaner_thread)(
 		next_loop_time = ut_time_ms() +
 			 page_cleaner_adapt_sleep_time();
 
+		page_cleaner_set_instance_lag();
+
 		if (srv_check_activity(last_activity)) {
 			last_activity = srv_get_activity_count();
 
@@ -2462,6 +2937,10 @@ DECLARE_THREAD(buf_flush_page_cleaner_thread)(
 	/* We have lived our life. Time to die. */
 
 thread_exit:
+	/* The page cleaner workers are no longer needed: from now on, the
+	lru_manager thread does all its LRU batches itself. */
+	buf_flush_page_cleaner_workers_exit();
+
 	buf_page_cleaner_is_active = FALSE;
 
 
@@ -2510,7 +2989,7 @@ DECLARE_THREAD(buf_flush_lru_manager_thread)(
 
 		next_loop_time = ut_time_ms() + lru_sleep_time;
 
-		buf_flush_LRU_tail();
+		page_cleaner_do_LRU_batch();
 	}
 
 	buf_lru_manager_is_active = false;
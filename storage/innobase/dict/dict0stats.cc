@@ -834,6 +834,9 @@ dict_stats_update_transient_for_index(
 	} else {
 		mtr_t	mtr;
 		ulint	size;
+
+		index->stat_modified_counter = 0;
+
 		mtr_start(&mtr);
 		mtr_s_lock(dict_index_get_lock(index), &mtr);
 
@@ -1903,6 +1906,8 @@ dict_stats_analyze_index(
 
 	dict_stats_empty_index(index);
 
+	index->stat_modified_counter = 0;
+
 	mtr_start(&mtr);
 
 	mtr_s_lock(dict_index_get_lock(index), &mtr);
@@ -2172,6 +2177,102 @@ found_level:
 	DBUG_VOID_RETURN;
 }
 
+/** Indexes to be analyzed by dict_stats_analyze_indexes(), possibly by
+several threads at the same time */
+struct dict_stats_analyze_work_t {
+	const dict_table_t*	table;		/*!< table of the indexes */
+	dict_index_t**		indexes;	/*!< indexes to analyze */
+	ulint			n_indexes;	/*!< number of elements in
+						indexes */
+	os_ib_mutex_t		mutex;		/*!< protects next and
+						n_running */
+	ulint			next;		/*!< the next index that
+						no thread has picked yet */
+	ulint			n_running;	/*!< number of helper
+						threads not finished yet */
+	os_event_t		done;		/*!< set when the last helper
+						thread finishes */
+};
+
+/*********************************************************************//**
+Analyzes the indexes of a dict_stats_analyze_work_t until no index is left.
+If the background stats thread has been asked to stop using the table, the
+remaining secondary indexes are emptied instead. */
+static
+void
+dict_stats_analyze_indexes(
+/*=======================*/
+	dict_stats_analyze_work_t*	work)	/*!< in/out: indexes */
+{
+	for (;;) {
+		dict_index_t*	index;
+
+		os_mutex_enter(work->mutex);
+
+		if (work->next == work->n_indexes) {
+			os_mutex_exit(work->mutex);
+			return;
+		}
+
+		index = work->indexes[work->next++];
+
+		os_mutex_exit(work->mutex);
+
+		if (!dict_index_is_clust(index)
+		    && (work->table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
+			dict_stats_empty_index(index);
+		} else {
+			dict_stats_analyze_index(index);
+		}
+	}
+}
+
+/*********************************************************************//**
+Helper thread of a parallel dict_stats_update_persistent().
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(dict_stats_analyze_thread)(
+/*======================================*/
+	void*	arg)	/*!< in/out: dict_stats_analyze_work_t */
+{
+	dict_stats_analyze_work_t*	work
+		= static_cast<dict_stats_analyze_work_t*>(arg);
+	bool				last;
+
+	dict_stats_analyze_indexes(work);
+
+	os_mutex_enter(work->mutex);
+	last = --work->n_running == 0;
+	/* The owner of work frees it as soon as done is set and the
+	mutex is released, so do not touch work afterwards. */
+	if (last) {
+		os_event_set(work->done);
+	}
+	os_mutex_exit(work->mutex);
+
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Checks whether an incremental auto recalculation must analyze an index:
+it is empty or has never been analyzed, or the keys of more than 10% of the
+rows of the table changed in it since it was last analyzed.
+@return true if the index must be analyzed */
+static
+bool
+dict_stats_index_changed(
+/*=====================*/
+	const dict_index_t*	index,	/*!< in: index */
+	ib_uint64_t		n_rows)	/*!< in: number of rows in the
+					table */
+{
+	return(index->stat_n_diff_key_vals[0] == 0
+	       || index->stat_modified_counter > n_rows / 10 /* 10% */);
+}
+
 /*********************************************************************//**
 Calculates new estimates for table and index statistics. This function
 is relatively slow and is used to calculate persistent statistics that
@@ -2181,9 +2282,16 @@ static
 dberr_t
 dict_stats_update_persistent(
 /*=========================*/
-	dict_table_t*	table)		/*!< in/out: table */
+	dict_table_t*	table,		/*!< in/out: table */
+	bool		incremental,	/*!< in: true if only the indexes
+					that changed enough since they were
+					last analyzed are to be analyzed */
+	ulint		n_threads)	/*!< in: number of threads to
+					analyze the indexes with */
 {
-	dict_index_t*	index;
+	dict_index_t*			index;
+	ib_uint64_t			n_rows;
+	std::vector<dict_index_t*>	indexes;
 
 	DEBUG_PRINTF("%s(table=%s)\n", __func__, table->name);
 
@@ -2206,7 +2314,65 @@ dict_stats_update_persistent(
 
 	ut_ad(!dict_index_is_univ(index));
 
-	dict_stats_analyze_index(index);
+	/* The statistics in memory are only a base for an incremental
+	recalculation if they have been fetched or calculated. */
+	incremental = incremental && table->stat_initialized;
+	n_rows = table->stat_n_rows;
+
+	for (; index != NULL; index = dict_table_get_next_index(index)) {
+
+		ut_ad(!dict_index_is_univ(index));
+
+		if (index->type & DICT_FTS) {
+			continue;
+		}
+
+		if (!dict_index_is_clust(index)
+		    && dict_stats_should_ignore_index(index)) {
+
+			dict_stats_empty_index(index);
+			continue;
+		}
+
+		if (!incremental || dict_stats_index_changed(index, n_rows)) {
+			indexes.push_back(index);
+		}
+	}
+
+	if (!indexes.empty()) {
+		dict_stats_analyze_work_t	work;
+
+		work.table = table;
+		work.indexes = &indexes[0];
+		work.n_indexes = indexes.size();
+		work.next = 0;
+		work.n_running = ut_min(n_threads, work.n_indexes) - 1;
+		work.mutex = os_mutex_create();
+		work.done = os_event_create();
+
+		bool	parallel = work.n_running > 0;
+
+		for (ulint i = work.n_running; i > 0; i--) {
+			os_thread_create(dict_stats_analyze_thread,
+					 &work, NULL);
+		}
+
+		dict_stats_analyze_indexes(&work);
+
+		if (parallel) {
+			os_event_wait(work.done);
+
+			/* Wait until the last helper thread has released
+			the mutex before freeing it. */
+			os_mutex_enter(work.mutex);
+			os_mutex_exit(work.mutex);
+		}
+
+		os_event_free(work.done);
+		os_mutex_free(work.mutex);
+	}
+
+	index = dict_table_get_first_index(table);
 
 	ulint	n_unique = dict_index_get_n_unique(index);
 
@@ -2214,30 +2380,17 @@ dict_stats_update_persistent(
 
 	table->stat_clustered_index_size = index->stat_index_size;
 
-	/* analyze other indexes from the table, if any */
-
 	table->stat_sum_of_other_index_sizes = 0;
 
 	for (index = dict_table_get_next_index(index);
 	     index != NULL;
 	     index = dict_table_get_next_index(index)) {
 
-		ut_ad(!dict_index_is_univ(index));
-
-		if (index->type & DICT_FTS) {
-			continue;
-		}
-
-		dict_stats_empty_index(index);
-
-		if (dict_stats_should_ignore_index(index)) {
+		if ((index->type & DICT_FTS)
+		    || dict_stats_should_ignore_index(index)) {
 			continue;
 		}
 
-		if (!(table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
-			dict_stats_analyze_index(index);
-		}
-
 		table->stat_sum_of_other_index_sizes
 			+= index->stat_index_size;
 	}
@@ -3101,6 +3254,7 @@ dict_stats_update(
 
 	switch (stats_upd_option) {
 	case DICT_STATS_RECALC_PERSISTENT:
+	case DICT_STATS_RECALC_PERSISTENT_AUTO:
 
 		if (srv_read_only_mode) {
 			goto transient;
@@ -3124,7 +3278,15 @@ dict_stats_update(
 
 			dberr_t	err;
 
-			err = dict_stats_update_persistent(table);
+			if (stats_upd_option == DICT_STATS_RECALC_PERSISTENT) {
+				err = dict_stats_update_persistent(
+					table, false,
+					srv_stats_analyze_threads);
+			} else {
+				err = dict_stats_update_persistent(
+					table, srv_stats_incremental_recalc,
+					1);
+			}
 
 			if (err != DB_SUCCESS) {
 				return(err);
@@ -310,7 +310,7 @@ dict_stats_process_entry_from_recalc_pool()
 
 	} else {
 
-		dict_stats_update(table, DICT_STATS_RECALC_PERSISTENT);
+		dict_stats_update(table, DICT_STATS_RECALC_PERSISTENT_AUTO);
 	}
 
 	mutex_enter(&dict_sys->mutex);
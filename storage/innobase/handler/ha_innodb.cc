@@ -65,6 +65,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "row0sel.h"
 #include "row0upd.h"
 #include "log0log.h"
+#include "log0recv.h"
 #include "lock0lock.h"
 #include "dict0crea.h"
 #include "btr0cur.h"
@@ -396,8 +397,11 @@ static PSI_thread_info	all_innodb_threads[] = {
 	{&srv_master_thread_key, "srv_master_thread", 0},
 	{&srv_purge_thread_key, "srv_purge_thread", 0},
 	{&buf_page_cleaner_thread_key, "page_cleaner_thread", 0},
+	{&buf_page_cleaner_worker_thread_key, "page_cleaner_worker_thread", 0},
 	{&buf_lru_manager_thread_key, "lru_manager_thread", 0},
-	{&recv_writer_thread_key, "recv_writer_thread", 0}
+	{&recv_writer_thread_key, "recv_writer_thread", 0},
+	{&recv_apply_thread_key, "recv_apply_thread", 0},
+	{&log_writer_thread_key, "log_writer_thread", 0}
 };
 # endif /* UNIV_PFS_THREAD */
 
@@ -1244,7 +1248,8 @@ innobase_srv_conc_exit_innodb(
 	trx_t*	trx)	/*!< in: transaction handle */
 {
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!sync_thread_levels_nonempty_trx(trx->has_search_latch));
+	ut_ad(!sync_thread_levels_nonempty_trx(
+		trx->has_search_latch != NULL));
 #endif /* UNIV_SYNC_DEBUG */
 
 	/* This is to avoid making an unnecessary function call. */
@@ -1264,7 +1269,8 @@ innobase_srv_conc_force_exit_innodb(
 	trx_t*	trx)	/*!< in: transaction handle */
 {
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!sync_thread_levels_nonempty_trx(trx->has_search_latch));
+	ut_ad(!sync_thread_levels_nonempty_trx(
+		trx->has_search_latch != NULL));
 #endif /* UNIV_SYNC_DEBUG */
 
 	/* This is to avoid making an unnecessary function call. */
@@ -2479,7 +2485,7 @@ innobase_query_caching_of_table_permitted(
 		return((my_bool)FALSE);
 	}
 
-	if (UNIV_UNLIKELY(trx->has_search_latch)) {
+	if (UNIV_UNLIKELY(trx->has_search_latch != NULL)) {
 		sql_print_error("The calling thread is holding the adaptive "
 				"search, latch though calling "
 				"innobase_query_caching_of_table_permitted.");
@@ -3457,9 +3463,9 @@ innobase_flush_logs(
 		if (target_lsn == 0) {
 			log_buffer_flush_to_disk();
 		} else if (srv_flush_log_at_trx_commit > 0) {
-			log_write_up_to(target_lsn,
-					LOG_WAIT_ONE_GROUP,
-					(srv_flush_log_at_trx_commit == 1));
+			log_write_up_to_for_commit(
+				target_lsn,
+				(srv_flush_log_at_trx_commit == 1));
 		}
 	}
 
@@ -4811,7 +4817,7 @@ ha_innobase::open(
 	thd = ha_thd();
 
 	/* Under some cases MySQL seems to call this function while
-	holding btr_search_latch. This breaks the latching order as
+	holding an adaptive hash index latch. This breaks the latching order as
 	we acquire dict_sys->mutex below and leads to a deadlock. */
 	if (thd != NULL) {
 		innobase_release_temporary_latches(ht, thd);
@@ -14028,7 +14034,14 @@ innodb_doublewrite_update(
 				    "change it from or to 0.");
 	} else {
 		ut_a(in_val == 1 || in_val == 2);
-		if (srv_use_doublewrite_buf != in_val) {
+		if (in_val == 2 && srv_parallel_doublewrite) {
+			push_warning_printf(thd, Sql_condition::WARN_LEVEL_WARN,
+					    ER_WRONG_ARGUMENTS,
+					    "innodb_doublewrite can not be "
+					    "changed to 2 when "
+					    "innodb_parallel_doublewrite "
+					    "is set.");
+		} else if (srv_use_doublewrite_buf != in_val) {
 			srv_use_doublewrite_buf = in_val;
 			srv_doublewrite_reset = 1;
 		}
@@ -15914,6 +15927,14 @@ static MYSQL_SYSVAR_ULONG(doublewrite, srv_use_doublewrite_buf,
   "2=Enable reduced doublewrite mode. ",
   NULL, innodb_doublewrite_update, 1, 0, 2, 0);
 
+static MYSQL_SYSVAR_BOOL(parallel_doublewrite, srv_parallel_doublewrite,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Write the doublewrite batches of each buffer pool instance and flush "
+  "type to their own file instead of the doublewrite buffer in the system "
+  "tablespace, so that they can be written in parallel. Not supported in "
+  "the reduced doublewrite mode. Disabled by default.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(io_capacity, srv_io_capacity,
   PLUGIN_VAR_RQCMDARG,
   "Number of IOPs the server can do. Tunes the background IO rate",
@@ -16166,12 +16187,33 @@ static MYSQL_SYSVAR_ULONGLONG(stats_persistent_sample_pages,
   "statistics (by ANALYZE, default 20)",
   NULL, NULL, 20, 1, ~0ULL, 0);
 
+static MYSQL_SYSVAR_BOOL(stats_incremental_recalc,
+  srv_stats_incremental_recalc,
+  PLUGIN_VAR_OPCMDARG,
+  "Make the automatic recalculation of persistent statistics analyze only "
+  "the indexes whose keys changed in more than 10% of the rows since they "
+  "were last analyzed; the other indexes keep their statistics "
+  "(disabled by default)",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_ULONG(stats_analyze_threads, srv_stats_analyze_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that analyze the indexes of a table in parallel when "
+  "persistent statistics are calculated by ANALYZE TABLE (default 1)",
+  NULL, NULL, 1, 1, 32, 0);
+
 static MYSQL_SYSVAR_BOOL(adaptive_hash_index, btr_search_enabled,
   PLUGIN_VAR_OPCMDARG,
   "Enable InnoDB adaptive hash index (enabled by default).  "
   "Disable with --skip-innodb-adaptive-hash-index.",
   NULL, innodb_adaptive_hash_index_update, TRUE);
 
+static MYSQL_SYSVAR_ULONG(adaptive_hash_index_parts, btr_ahi_parts,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of InnoDB adaptive hash index partitions, each with its own "
+  "latch (default 8).",
+  NULL, NULL, 8, 1, 512, 0);
+
 static MYSQL_SYSVAR_ULONG(replication_delay, srv_replication_delay,
   PLUGIN_VAR_RQCMDARG,
   "Replication thread delay (ms) on the slave server if "
@@ -16241,6 +16283,12 @@ static MYSQL_SYSVAR_ULONG(sync_pool_size, innobase_sync_pool_size,
   "and condition variables.",
   NULL, NULL, 1024UL, 1UL, ULONG_MAX, 1UL);
 
+static MYSQL_SYSVAR_ULONG(lock_sys_partitions, srv_n_lock_sys_partitions,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of mutexes partitioning the InnoDB record lock hash table."
+  " Rounded up to the next power of 2",
+  NULL, NULL, 16, 1, MAX_LOCK_SYS_PARTITIONS, 0);
+
 #if defined UNIV_DEBUG || defined UNIV_PERF_DEBUG
 static MYSQL_SYSVAR_ULONG(page_hash_locks, srv_n_page_hash_locks,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
@@ -16387,6 +16435,20 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(merge_sort_threads, srv_merge_sort_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that merge the sorted runs of a non-unique index "
+  "in index creation. Each thread uses 3 * innodb_sort_buffer_size of "
+  "memory.",
+  NULL, NULL, 1, 1, ROW_MERGE_MAX_THREADS, 0);
+
+static MYSQL_SYSVAR_ULONG(fill_factor, srv_fill_factor,
+  PLUGIN_VAR_RQCMDARG,
+  "Percentage of each B-tree page that is filled with records when "
+  "an index is built from sorted records. The rest of the page is left "
+  "free for later inserts and updates.",
+  NULL, NULL, 100, 10, 100, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -16430,6 +16492,19 @@ static MYSQL_SYSVAR_LONG(log_buffer_size, innobase_log_buffer_size,
   "The size of the buffer which InnoDB uses to write log to the log files on disk.",
   NULL, NULL, 16*1024*1024L, 256*1024L, LONG_MAX, 1024);
 
+static MYSQL_SYSVAR_BOOL(log_parallel_copy, srv_log_parallel_copy,
+  PLUGIN_VAR_OPCMDARG,
+  "Reserve space for mini-transaction log records in the log buffer under"
+  " the log mutex, but copy the records there after releasing it, so that"
+  " concurrent mini-transactions copy their records in parallel.",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_BOOL(log_writer_thread, srv_log_writer_thread,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Let a dedicated background thread write and flush the log for the"
+  " committing transactions, which only wait until their commit is durable.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_LONGLONG(log_file_size, innobase_log_file_size,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Size of each log file in a log group.",
@@ -16768,6 +16843,19 @@ static MYSQL_SYSVAR_BOOL(page_cleaner_adaptive_sleep, srv_pc_adaptive_sleep,
   "Enable adaptive sleep time calculation for page cleaner thread",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_ULONG(recovery_apply_threads, srv_n_recovery_apply_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads that apply the redo log records to the pages in the"
+  " buffer pool during crash recovery.",
+  NULL, NULL, 1, 1, RECV_MAX_APPLY_THREADS, 0);
+
+static MYSQL_SYSVAR_ULONG(page_cleaners, srv_n_page_cleaners,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads that do the flush list and LRU flushing, each owning"
+  " a subset of the buffer pool instances. Capped at"
+  " innodb_buffer_pool_instances.",
+  NULL, NULL, 1, 1, MAX_BUFFER_POOLS, 0);
+
 static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(additional_mem_pool_size),
   MYSQL_SYSVAR(api_trx_level),
@@ -16776,6 +16864,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_size),
   MYSQL_SYSVAR(buffer_pool_populate),
   MYSQL_SYSVAR(sync_pool_size),
+  MYSQL_SYSVAR(lock_sys_partitions),
   MYSQL_SYSVAR(buffer_pool_instances),
   MYSQL_SYSVAR(buffer_pool_filename),
   MYSQL_SYSVAR(buffer_pool_dump_now),
@@ -16797,6 +16886,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(deadlock_detect),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(parallel_doublewrite),
   MYSQL_SYSVAR(api_enable_binlog),
   MYSQL_SYSVAR(api_enable_mdl),
   MYSQL_SYSVAR(api_disable_rowlock),
@@ -16833,6 +16923,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #endif /* UNIV_LOG_ARCHIVE */
   MYSQL_SYSVAR(page_size),
   MYSQL_SYSVAR(log_buffer_size),
+  MYSQL_SYSVAR(log_parallel_copy),
+  MYSQL_SYSVAR(log_writer_thread),
   MYSQL_SYSVAR(log_file_size),
   MYSQL_SYSVAR(log_files_in_group),
   MYSQL_SYSVAR(log_group_home_dir),
@@ -16861,13 +16953,18 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_persistent),
   MYSQL_SYSVAR(stats_persistent_sample_pages),
   MYSQL_SYSVAR(stats_auto_recalc),
+  MYSQL_SYSVAR(stats_incremental_recalc),
+  MYSQL_SYSVAR(stats_analyze_threads),
   MYSQL_SYSVAR(adaptive_hash_index),
+  MYSQL_SYSVAR(adaptive_hash_index_parts),
   MYSQL_SYSVAR(stats_method),
   MYSQL_SYSVAR(replication_delay),
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(support_xa),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(merge_sort_threads),
+  MYSQL_SYSVAR(fill_factor),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -16941,6 +17038,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(zlib_strategy),
   MYSQL_SYSVAR(lru_manager_max_sleep_time),
   MYSQL_SYSVAR(page_cleaner_adaptive_sleep),
+  MYSQL_SYSVAR(page_cleaners),
+  MYSQL_SYSVAR(recovery_apply_threads),
   NULL
 };
 
@@ -0,0 +1,100 @@
+/*****************************************************************************
+
+Copyright (c) 2014, Oracle and/or its affiliates. All Rights Reserved.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/btr0bulk.h
+Bulk loading of an empty B-tree from sorted records
+
+The records are appended to leaf pages from left to right. Each page
+is filled up to innodb_fill_factor percent and written to the redo log
+as one record list. A level is first built in the root page; when it
+does not fit there, the records of the root are moved to the first page
+of the level and the root is left empty for the level above. When all
+records have been appended, the upper levels are built one at a time
+from the first records of the pages of the level below, until a level
+fits in the root page.
+*******************************************************/
+
+#ifndef btr0bulk_h
+#define btr0bulk_h
+
+#include "univ.i"
+#include "dict0types.h"
+#include "data0types.h"
+#include "buf0types.h"
+#include "mtr0mtr.h"
+#include "page0cur.h"
+
+/** State of a bulk load of an index tree */
+struct btr_bulk_t{
+	dict_index_t*	index;		/*!< the index; must be empty and
+					not compressed */
+	trx_id_t	trx_id;		/*!< transaction that builds the
+					index, for PAGE_MAX_TRX_ID */
+	ulint		reserved;	/*!< number of bytes to leave free
+					on each page */
+	ulint		level;		/*!< the level that is being built */
+	ulint		first_page_no;	/*!< first page of level */
+	ulint		n_pages;	/*!< number of pages of level */
+	buf_block_t*	block;		/*!< the page that is being filled,
+					or NULL */
+	mtr_t		mtr;		/*!< mini-transaction that latches
+					block */
+	page_bulk_t	page;		/*!< state of appending to block */
+	mem_heap_t*	heap;		/*!< memory heap for the records
+					that are being appended */
+};
+
+/*********************************************************************//**
+Starts a bulk load of an empty index tree. */
+UNIV_INTERN
+void
+btr_bulk_init(
+/*==========*/
+	btr_bulk_t*	bulk,	/*!< out: bulk load */
+	dict_index_t*	index,	/*!< in: index; must be empty and must
+				not be in a compressed table */
+	trx_id_t	trx_id)	/*!< in: transaction identifier */
+	__attribute__((nonnull));
+/*********************************************************************//**
+Appends a leaf record to the index tree. The records must be appended in
+ascending order. No other mini-transaction may latch pages of the index
+until btr_bulk_finish() has been called.
+@return DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+btr_bulk_insert(
+/*============*/
+	btr_bulk_t*	bulk,	/*!< in/out: bulk load */
+	dtuple_t*	tuple)	/*!< in/out: index entry; fields may be
+				stored externally and converted back */
+	__attribute__((nonnull, warn_unused_result));
+/*********************************************************************//**
+Finishes a bulk load: builds the non-leaf levels of the tree. On error, only releases the pages; the
+index must then be dropped.
+@return DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+btr_bulk_finish(
+/*============*/
+	btr_bulk_t*	bulk,	/*!< in/out: bulk load; freed */
+	dberr_t		err)	/*!< in: error of btr_bulk_insert(),
+				or DB_SUCCESS */
+	__attribute__((nonnull, warn_unused_result));
+
+#endif /* btr0bulk_h */
@@ -33,6 +33,11 @@ Created 2/17/1996 Heikki Tuuri
 #include "btr0types.h"
 #include "mtr0mtr.h"
 #include "ha0ha.h"
+#include "ut0counter.h"
+
+/** Number of partitions of the adaptive hash index; each index is
+mapped to one partition by its index id */
+extern ulong	btr_ahi_parts;
 
 /*****************************************************************//**
 Creates and initializes the adaptive search system at a database start. */
@@ -40,7 +45,8 @@ UNIV_INTERN
 void
 btr_search_sys_create(
 /*==================*/
-	ulint	hash_size);	/*!< in: hash index hash table size */
+	ulint	hash_size);	/*!< in: hash index hash table size,
+				divided among the btr_ahi_parts partitions */
 /*****************************************************************//**
 Frees the adaptive search system at a database shutdown. */
 UNIV_INTERN
@@ -70,6 +76,50 @@ btr_search_get_info(
 /*================*/
 	dict_index_t*	index)	/*!< in: index */
 	__attribute__((nonnull));
+/********************************************************************//**
+Returns the adaptive hash index partition of an index.
+@return	partition */
+UNIV_INLINE
+btr_search_part_t*
+btr_search_get_part_by_id(
+/*======================*/
+	index_id_t	index_id);	/*!< in: index id */
+/********************************************************************//**
+Returns the adaptive hash index partition of an index.
+@return	partition */
+UNIV_INLINE
+btr_search_part_t*
+btr_search_get_part(
+/*================*/
+	const dict_index_t*	index)	/*!< in: index */
+	__attribute__((nonnull));
+/********************************************************************//**
+Returns the latch of the adaptive hash index partition of an index.
+@return	latch */
+UNIV_INLINE
+rw_lock_t*
+btr_search_get_latch(
+/*=================*/
+	const dict_index_t*	index)	/*!< in: index */
+	__attribute__((nonnull));
+/********************************************************************//**
+S-latches an adaptive hash index partition, counting the cases where
+the latch could not be acquired at once. */
+UNIV_INLINE
+void
+btr_search_s_lock(
+/*==============*/
+	btr_search_part_t*	part)	/*!< in/out: partition */
+	__attribute__((nonnull));
+/********************************************************************//**
+X-latches an adaptive hash index partition, counting the cases where
+the latch could not be acquired at once. */
+UNIV_INLINE
+void
+btr_search_x_lock(
+/*==============*/
+	btr_search_part_t*	part)	/*!< in/out: partition */
+	__attribute__((nonnull));
 /*****************************************************************//**
 Creates and initializes a search info struct.
 @return	own: search info struct */
@@ -79,14 +129,15 @@ btr_search_info_create(
 /*===================*/
 	mem_heap_t*	heap);	/*!< in: heap where created */
 /*****************************************************************//**
-Returns the value of ref_count. The value is protected by
-btr_search_latch.
+Returns the value of ref_count. The value is protected by the latch
+of the adaptive hash index partition of the index.
 @return	ref_count value. */
 UNIV_INTERN
 ulint
 btr_search_info_get_ref_count(
 /*==========================*/
-	btr_search_t*   info);	/*!< in: search info. */
+	btr_search_t*		info,	/*!< in: search info. */
+	const dict_index_t*	index);	/*!< in: index */
 /*********************************************************************//**
 Updates the search info. */
 UNIV_INLINE
@@ -112,7 +163,8 @@ btr_search_guess_on_hash(
 	ulint		latch_mode,	/*!< in: BTR_SEARCH_LEAF, ... */
 	btr_cur_t*	cursor,		/*!< out: tree cursor */
 	ulint		has_search_latch,/*!< in: latch mode the caller
-					currently has on btr_search_latch:
+					currently has on the adaptive hash
+					index latch of index:
 					RW_S_LATCH, RW_X_LATCH, or 0 */
 	mtr_t*		mtr);		/*!< in: mtr */
 /********************************************************************//**
@@ -190,13 +242,65 @@ ibool
 btr_search_validate(void);
 /*======================*/
 #endif /* defined UNIV_AHI_DEBUG || defined UNIV_DEBUG */
+/********************************************************************//**
+X-latches all the adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_x_lock_all(void);
+/*========================*/
+/********************************************************************//**
+Releases the x-latches on all the adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_x_unlock_all(void);
+/*==========================*/
+#ifdef UNIV_SYNC_DEBUG
+/********************************************************************//**
+Checks if the thread owns the latch of any adaptive hash index partition
+in the given mode.
+@return	TRUE if owns */
+UNIV_INTERN
+ibool
+btr_search_own_any(
+/*===============*/
+	ulint	lock_type);	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+/********************************************************************//**
+Checks if the thread owns the latches of all adaptive hash index
+partitions in the given mode.
+@return	TRUE if owns */
+UNIV_INTERN
+ibool
+btr_search_own_all(
+/*===============*/
+	ulint	lock_type);	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+#endif /* UNIV_SYNC_DEBUG */
+/********************************************************************//**
+Prints the size and the hit, miss and latch wait counts of each adaptive
+hash index partition. */
+UNIV_INTERN
+void
+btr_search_print_info(
+/*==================*/
+	FILE*	file);	/*!< in: file where to print */
+/********************************************************************//**
+Sums the lookup and latch wait counts of all the adaptive hash index
+partitions. */
+UNIV_INTERN
+void
+btr_search_get_stats(
+/*=================*/
+	ulint*	n_hits,		/*!< out: successful lookups */
+	ulint*	n_misses,	/*!< out: failed lookups */
+	ulint*	n_latch_waits);	/*!< out: times a partition latch could
+				not be acquired at once */
 
 /** The search info struct in an index */
 struct btr_search_t{
 	ulint	ref_count;	/*!< Number of blocks in this index tree
 				that have search index built
 				i.e. block->index points to this index.
-				Protected by btr_search_latch except
+				Protected by the latch of the adaptive
+				hash index partition of the index except
 				when during initialization in
 				btr_search_info_create(). */
 
@@ -246,11 +350,39 @@ struct btr_search_t{
 #endif /* UNIV_DEBUG */
 };
 
+/** A partition of the adaptive hash index. The latch protects the
+(1) hash index of the partition;
+(2) columns of a record to which we have a pointer in the hash index;
+(3) the block->index and block->curr_* fields of the pages of the
+indexes mapped to the partition;
+
+but does NOT protect:
+
+(4) next record offset field in a record;
+(5) next or previous records on the same page.
+
+Bear in mind (4) and (5) when using the hash index. */
+struct btr_search_part_t{
+	rw_lock_t	latch;		/*!< latch protecting the partition */
+	hash_table_t*	hash_index;	/*!< the adaptive hash index of the
+					partition, mapping dtuple_fold values
+					to rec_t pointers on index pages */
+	ulint		n_hits;		/*!< successful lookups; updated
+					without protection, for monitoring */
+	ulint		n_misses;	/*!< failed lookups; updated
+					without protection, for monitoring */
+	ulint		n_latch_waits;	/*!< times the latch could not be
+					acquired at once; updated without
+					protection, for monitoring */
+	byte		pad[CACHE_LINE_SIZE];
+					/*!< padding to keep the partitions
+					on separate cache lines */
+};
+
 /** The hash index system */
 struct btr_search_sys_t{
-	hash_table_t*	hash_index;	/*!< the adaptive hash index,
-					mapping dtuple_fold values
-					to rec_t pointers on index pages */
+	btr_search_part_t*	parts;	/*!< the btr_ahi_parts partitions
+					of the adaptive hash index */
 };
 
 /** The adaptive hash index */
@@ -277,7 +409,7 @@ the hash index */
 #define BTR_SEARCH_ON_HASH_LIMIT	3
 
 /** We do this many searches before trying to keep the search latch
-over calls from MySQL. If we notice someone waiting for the latch, we
+of a partition over calls from MySQL. If we notice someone waiting for the latch, we
 again set this much timeout. This is to reduce contention. */
 #define BTR_SEA_TIMEOUT			10000
 
@@ -38,31 +38,11 @@ struct btr_pcur_t;
 struct btr_cur_t;
 /** B-tree search information for the adaptive hash index */
 struct btr_search_t;
-
-#ifndef UNIV_HOTBACKUP
-
-/** @brief The latch protecting the adaptive search system
-
-This latch protects the
-(1) hash index;
-(2) columns of a record to which we have a pointer in the hash index;
-
-but does NOT protect:
-
-(3) next record offset field in a record;
-(4) next or previous records on the same page.
-
-Bear in mind (3) and (4) when using the hash index.
-*/
-extern rw_lock_t*	btr_search_latch_temp;
-
-#endif /* UNIV_HOTBACKUP */
-
-/** The latch protecting the adaptive search system */
-#define btr_search_latch	(*btr_search_latch_temp)
+/** A partition of the adaptive hash index */
+struct btr_search_part_t;
 
 /** Flag: has the search system been enabled?
-Protected by btr_search_latch. */
+Protected by the latches of all the adaptive hash index partitions. */
 extern char	btr_search_enabled;
 
 #ifdef UNIV_BLOB_DEBUG
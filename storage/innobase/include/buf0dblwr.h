@@ -62,6 +62,15 @@ buf_dblwr_init_or_load_pages(
 	char*		path,
 	bool		load_corrupt_pages);
 
+/****************************************************************//**
+Frees the copies of the pages which were loaded from the parallel
+doublewrite files for crash recovery, and removes the files which are
+not used by this server instance. */
+UNIV_INTERN
+void
+buf_dblwr_free_recv_pages(void);
+/*===========================*/
+
 /****************************************************************//**
 Process the double write buffer pages. */
 void
@@ -110,6 +119,19 @@ UNIV_INTERN
 void
 buf_dblwr_flush_buffered_writes(void);
 /*=================================*/
+/********************************************************************//**
+Flushes the buffered writes of the batch of one buffer pool instance and
+flush type. With innodb_parallel_doublewrite each buffer pool instance has
+a doublewrite file for each flush type and only that file is written;
+otherwise this is the same as buf_dblwr_flush_buffered_writes(). */
+UNIV_INTERN
+void
+buf_dblwr_flush_instance_writes(
+/*============================*/
+	const buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	buf_flush_t		flush_type);	/*!< in: BUF_FLUSH_LRU or
+						BUF_FLUSH_LIST */
+
 /********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
 the page to the datafile and sync the datafile. This function is used
@@ -125,6 +147,32 @@ buf_dblwr_write_single_page(
 	buf_page_t*	bpage,	/*!< in: buffer block to write */
 	bool		sync);	/*!< in: true if sync IO requested */
 
+/** A doublewrite file of one buffer pool instance and flush type, used
+when innodb_parallel_doublewrite is set. The batch protocol is the same
+as for the batch part of buf_dblwr_t. */
+struct buf_dblwr_file_t{
+	ib_mutex_t	mutex;	/*!< mutex protecting the fields below */
+	char*		name;	/*!< path of the file */
+	os_file_t	file;	/*!< handle to the file */
+	ulint		first_free;/*!< first free position in write_buf
+				measured in units of UNIV_PAGE_SIZE */
+	ulint		b_reserved;/*!< number of slots currently reserved
+				for the batch */
+	os_event_t	b_event;/*!< event where threads wait for the
+				batch to end */
+	bool		batch_running;/*!< set to true if currently the
+				batch is being written to the file */
+	byte*		write_buf;/*!< write buffer of
+				srv_doublewrite_batch_size pages, aligned
+				to an address divisible by
+				UNIV_PAGE_SIZE */
+	byte*		write_buf_unaligned;/*!< pointer to write_buf,
+				but unaligned */
+	buf_page_t**	buf_block_arr;/*!< array to store pointers to
+				the buffer blocks which have been
+				cached to write_buf */
+};
+
 /** Doublewrite control struct */
 struct buf_dblwr_t{
 	ib_mutex_t	mutex;	/*!< mutex protecting the first_free
@@ -162,6 +210,16 @@ struct buf_dblwr_t{
 				mode (innodb_doublewrite=2) */
 	byte*		header_unaligned;/*!< pointer to header,
 				but unaligned */
+	buf_dblwr_file_t* files;/*!< the doublewrite files of the
+				buffer pool instances, two per instance
+				(BUF_FLUSH_LRU, BUF_FLUSH_LIST), or NULL
+				if the batches are written to the system
+				tablespace */
+	ulint		n_files;/*!< number of elements in files */
+	byte**		recv_bufs;/*!< unaligned buffers holding the
+				pages read from the doublewrite files
+				at startup, indexed like files, or
+				NULL */
 };
 
 
@@ -190,6 +190,31 @@ DECLARE_THREAD(buf_flush_page_cleaner_thread)(
 	void*	arg);		/*!< in: a dummy parameter required by
 				os_thread_create */
 
+/******************************************************************//**
+Page cleaner worker thread, which does the flush list and LRU batches of
+the buffer pool instances it owns on request of the page_cleaner and
+lru_manager threads.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
+/*==========================================*/
+	void*	arg);		/*!< in: a dummy parameter required by
+				os_thread_create */
+/*********************************************************************//**
+Initializes the page cleaner workers. The caller must then create
+srv_n_page_cleaners - 1 buf_flush_page_cleaner_worker threads. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void);
+/*=============================*/
+/*********************************************************************//**
+Frees the page cleaner workers. All the threads that use them must have
+exited. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_close(void);
+/*==============================*/
 /******************************************************************//**
 lru_manager thread tasked with performing LRU flushes and evictions to refill
 the buffer pool free lists.  As of now we'll have only one instance of this
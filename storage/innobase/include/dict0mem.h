@@ -645,6 +645,13 @@ struct dict_index_t{
 	ulint		stat_n_leaf_pages;
 				/*!< approximate number of leaf pages in the
 				index tree */
+	ib_uint64_t	stat_modified_counter;
+				/*!< number of rows whose key was inserted
+				into or removed from this index since its
+				statistics were last calculated; used by
+				innodb_stats_incremental_recalc. Not
+				protected by any latch, like
+				dict_table_t::stat_modified_counter */
 	/* @} */
 	rw_lock_t	lock;	/*!< read-write lock protecting the
 				upper levels of the index tree */
@@ -39,6 +39,15 @@ enum dict_stats_upd_option_t {
 				storage, if the persistent storage is
 				not present then emit a warning and
 				fall back to transient stats */
+	DICT_STATS_RECALC_PERSISTENT_AUTO,/* like
+				DICT_STATS_RECALC_PERSISTENT, but
+				used by the auto recalculation: the
+				indexes are analyzed one at a time and
+				with innodb_stats_incremental_recalc
+				only the indexes whose keys changed in
+				more than 10% of the rows are analyzed
+				again, the others keep their
+				statistics */
 	DICT_STATS_RECALC_TRANSIENT,/* (re) calculate the statistics
 				using an imprecise quick algo
 				without saving the results
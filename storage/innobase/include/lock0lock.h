@@ -43,6 +43,10 @@ Created 5/7/1996 Heikki Tuuri
 extern ibool	lock_print_waits;
 #endif /* UNIV_DEBUG */
 
+#define MAX_LOCK_SYS_PARTITIONS	1024	/*!< The maximum number of
+					mutexes partitioning
+					lock_sys->rec_hash */
+
 /*********************************************************************//**
 Gets the size of a lock struct.
 @return	size in bytes */
@@ -912,7 +916,11 @@ struct lock_sys_t{
 	ib_mutex_t	mutex;			/*!< Mutex protecting the
 						locks */
 	hash_table_t*	rec_hash;		/*!< hash table of the record
-						locks */
+						locks; modifying a hash chain
+						requires both lock_sys->mutex
+						and the partition mutex of
+						the cell, so a chain may be
+						read holding either one */
 	ib_mutex_t	wait_mutex;		/*!< Mutex protecting the
 						next two fields */
 	srv_slot_t*	waiting_threads;	/*!< Array  of user threads
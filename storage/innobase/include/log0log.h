@@ -69,6 +69,11 @@ extern	ibool	log_debug_writes;
 /* @} */
 /** Maximum number of log groups in log_group_t::checkpoint_buf */
 #define LOG_MAX_N_GROUPS	32
+/** Number of events in log_t::writer_done_events */
+#define LOG_WRITER_N_DONE_EVENTS	8
+
+/** Flag indicating if the log_writer thread is in active state */
+extern ibool	log_writer_is_active;
 
 /*******************************************************************//**
 Calculates where in log files we find a specified lsn.
@@ -132,6 +137,40 @@ log_write_low(
 /*==========*/
 	byte*	str,		/*!< in: string */
 	ulint	str_len);	/*!< in: string length */
+#ifdef HAVE_ATOMIC_BUILTINS
+/************************************************************//**
+Reserves space for a string in the log buffer and initializes the log block
+headers and trailers of that space, but does not copy the string: the caller
+must do that with log_write_copy() and then call log_write_copy_complete().
+It is assumed that the caller holds the log mutex.
+@return	offset in the log buffer where the string must be copied */
+UNIV_INTERN
+ulint
+log_write_reserve(
+/*==============*/
+	ulint	str_len);	/*!< in: string length */
+/************************************************************//**
+Copies a string to the log buffer space reserved by log_write_reserve().
+Does not require the log mutex.
+@return	offset in the log buffer where the next part of the string
+must be copied */
+UNIV_INTERN
+ulint
+log_write_copy(
+/*===========*/
+	ulint		offset,	/*!< in: offset returned by
+				log_write_reserve() or by the previous
+				call of this function */
+	const byte*	str,	/*!< in: string */
+	ulint		str_len);/*!< in: string length */
+/************************************************************//**
+Notes that the string whose space was reserved by log_write_reserve() has
+been copied to the log buffer. */
+UNIV_INTERN
+void
+log_write_copy_complete(void);
+/*=========================*/
+#endif /* HAVE_ATOMIC_BUILTINS */
 /************************************************************//**
 Closes the log.
 @return	lsn */
@@ -208,6 +247,30 @@ log_write_up_to(
 	ibool	flush_to_disk);
 			/*!< in: TRUE if we want the written log
 			also to be flushed to disk */
+/******************************************************//**
+Called when a transaction commits. Waits until the log has been written,
+and flushed to disk if requested, up to the given lsn. If the log_writer
+thread is running, the write is done by that thread and the caller only
+waits for it; otherwise this is log_write_up_to(lsn, LOG_WAIT_ONE_GROUP,
+flush_to_disk). */
+UNIV_INTERN
+void
+log_write_up_to_for_commit(
+/*=======================*/
+	lsn_t	lsn,		/*!< in: log sequence number up to which
+				the log should be written */
+	ibool	flush_to_disk);	/*!< in: TRUE if we want the written log
+				also to be flushed to disk */
+/******************************************************************//**
+The log_writer thread, which writes and flushes the log on behalf of the
+committing transactions.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg);		/*!< in: a dummy parameter required by
+				os_thread_create */
 /****************************************************************//**
 Does a syncronous flush of the log buffer to disk. */
 UNIV_INTERN
@@ -819,6 +882,14 @@ struct log_t{
 					groups */
 	volatile bool	is_extending;	/*!< this is set to true during extend
 					the log buffer size */
+	ulint		n_pending_copies;/*!< number of mini-transactions
+					which have reserved space in the log
+					buffer with log_write_reserve() but
+					have not yet copied their log records
+					there; incremented only when holding
+					the log mutex, so that holding it and
+					waiting for this to drop to zero
+					makes the log buffer stable */
 	lsn_t		written_to_some_lsn;
 					/*!< first log sequence number not yet
 					written to any log group; for this to
@@ -878,6 +949,20 @@ struct log_t{
 					but NOTE that to set or reset this
 					event, the thread MUST own the log
 					mutex! */
+	lsn_t		writer_lsn;	/*!< the log_writer thread should
+					write the log up to this lsn;
+					protected by the log mutex */
+	ibool		writer_flush;	/*!< TRUE if the log_writer thread
+					should also flush the log to disk;
+					protected by the log mutex */
+	os_event_t	writer_event;	/*!< set to wake up the log_writer
+					thread */
+	os_event_t	writer_done_events[LOG_WRITER_N_DONE_EVENTS];
+					/*!< set by the log_writer thread
+					when it has completed a write; the
+					committing threads wait on these,
+					sharded by lsn so that they do not
+					all queue on the same event mutex */
 	ulint		n_log_ios;	/*!< number of log i/os initiated thus
 					far */
 	ulint		n_log_ios_old;	/*!< number of log i/o's at the
@@ -450,6 +450,10 @@ struct recv_sys_t{
 	hash_table_t*	addr_hash;/*!< hash table of file addresses of pages */
 	ulint		n_addrs;/*!< number of not processed hashed file
 				addresses in the hash table */
+	ulint		n_apply_threads;
+				/*!< number of recv_apply threads which
+				have not yet finished their part of the
+				hash table in the current apply batch */
 
 	recv_dblwr_t	dblwr;
 };
@@ -494,6 +498,9 @@ extern ulint		recv_max_parsed_page_no;
 times! */
 #define RECV_PARSING_BUF_SIZE	(2 * 1024 * 1024)
 
+/** Maximum value of innodb_recovery_apply_threads */
+#define RECV_MAX_APPLY_THREADS	64
+
 /** Size of block reads when the log groups are scanned forward to do a
 roll-forward */
 #define RECV_SCAN_SIZE		(4 * UNIV_PAGE_SIZE)
@@ -257,6 +257,57 @@ page_copy_rec_list_end_to_created_page(
 	rec_t*		rec,		/*!< in: first record to copy */
 	dict_index_t*	index,		/*!< in: record descriptor */
 	mtr_t*		mtr);		/*!< in: mtr */
+/*************************************************************//**
+Starts appending records to a newly created uncompressed page. The records
+appended by page_bulk_append() are logged in one MLOG_LIST_END_COPY_CREATED
+record, which page_bulk_finish() completes. No other log records may be
+written to mtr in between. */
+UNIV_INTERN
+void
+page_bulk_start(
+/*============*/
+	page_bulk_t*	bulk,		/*!< out: append state */
+	page_t*		new_page,	/*!< in/out: index page to append
+					to; must be empty */
+	dict_index_t*	index,		/*!< in: record descriptor */
+	mtr_t*		mtr);		/*!< in/out: mtr */
+/*************************************************************//**
+Checks if a record fits on a page after the records appended so far.
+@return true if the record fits and at least reserved bytes would remain
+free, or if it fits and fewer than 2 records have been appended */
+UNIV_INTERN
+bool
+page_bulk_has_space(
+/*================*/
+	const page_bulk_t*	bulk,		/*!< in: append state */
+	ulint			rec_size,	/*!< in: size of the record */
+	ulint			reserved);	/*!< in: number of bytes to
+						leave free on the page */
+/*************************************************************//**
+Appends a record to a page after the records appended so far. The
+record is logged when the next record is appended or the page is
+finished, so the caller may still modify it in the meantime, for
+example to store the pointers to its externally stored columns.
+@return the record on the page */
+UNIV_INTERN
+rec_t*
+page_bulk_append(
+/*=============*/
+	page_bulk_t*	bulk,	/*!< in/out: append state */
+	const rec_t*	rec,	/*!< in: record to append, not on the page */
+	ulint*		offsets,/*!< in/out: rec_get_offsets(rec, index) */
+	dict_index_t*	index,	/*!< in: record descriptor */
+	mtr_t*		mtr);	/*!< in/out: mtr */
+/*************************************************************//**
+Finishes appending records to a page: completes the page directory and
+header and the log record written by page_bulk_start(). */
+UNIV_INTERN
+void
+page_bulk_finish(
+/*=============*/
+	page_bulk_t*	bulk,	/*!< in/out: append state */
+	dict_index_t*	index,	/*!< in: record descriptor */
+	mtr_t*		mtr);	/*!< in/out: mtr */
 /***********************************************************//**
 Deletes a record at the page cursor. The cursor is moved to the
 next record after the deleted one. */
@@ -380,6 +431,31 @@ struct page_cur_t{
 	buf_block_t*	block;	/*!< pointer to the block containing rec */
 };
 
+/** State of appending records to a newly created page,
+see page_bulk_start() */
+struct page_bulk_t{
+	page_t*		page;		/*!< the page */
+	byte*		log_ptr;	/*!< 4-byte field where to write
+					the log data length, or NULL */
+	ulint		log_data_len;	/*!< size of the mtr log before
+					the appended records */
+	ulint		log_mode;	/*!< log mode to restore */
+	byte*		heap_top;	/*!< end of the appended records */
+	rec_t*		prev_rec;	/*!< the last appended record,
+					or the infimum */
+	rec_t*		unlogged_rec;	/*!< the last appended record if
+					it has not been logged yet */
+	rec_t*		unlogged_prev;	/*!< the record before
+					unlogged_rec */
+	ulint		unlogged_size;	/*!< size of unlogged_rec */
+	page_dir_slot_t* slot;		/*!< the last directory slot
+					that was set */
+	ulint		slot_index;	/*!< index of slot */
+	ulint		count;		/*!< number of records appended
+					after the record of slot */
+	ulint		n_recs;		/*!< number of appended records */
+};
+
 #ifndef UNIV_NONINL
 #include "page0cur.ic"
 #endif
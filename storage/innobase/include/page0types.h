@@ -40,6 +40,8 @@ using namespace std;
 typedef	byte		page_t;
 /** Index page cursor */
 struct page_cur_t;
+/** State of appending records to a newly created index page */
+struct page_bulk_t;
 
 /** Compressed index page */
 typedef byte		page_zip_t;
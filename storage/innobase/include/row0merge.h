@@ -66,6 +66,10 @@ The format is the same as a record in ROW_FORMAT=COMPACT with the
 exception that the REC_N_NEW_EXTRA_BYTES are omitted. */
 typedef byte	mrec_t;
 
+/** Maximum number of threads merging the sort file of one index,
+see innodb_merge_sort_threads */
+#define ROW_MERGE_MAX_THREADS	64
+
 /** Merge record in row_merge_buf_t */
 struct mtuple_t {
 	dfield_t*	fields;		/*!< data fields */
@@ -370,7 +374,11 @@ row_merge_sort(
 	merge_file_t*		file,	/*!< in/out: file containing
 					index entries */
 	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
-	int*			tmpfd)	/*!< in/out: temporary file handle */
+	int*			tmpfd,	/*!< in/out: temporary file handle */
+	ulint			n_threads)/*!< in: maximum number of
+					threads to merge with; unique
+					indexes are always merged by
+					one thread */
 	__attribute__((nonnull));
 /*********************************************************************//**
 Allocate a sort buffer.
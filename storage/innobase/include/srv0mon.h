@@ -133,6 +133,8 @@ enum monitor_id_t {
 	MONITOR_LOCKREC_WAIT,
 	MONITOR_TABLELOCK_WAIT,
 	MONITOR_NUM_RECLOCK_REQ,
+	MONITOR_RECLOCK_PARTITION_CHECK,
+	MONITOR_RECLOCK_PARTITION_FALLBACK,
 	MONITOR_RECLOCK_CREATED,
 	MONITOR_RECLOCK_REMOVED,
 	MONITOR_NUM_RECLOCK,
@@ -180,6 +182,9 @@ enum monitor_id_t {
 	MONITOR_FLUSH_LSN_AVG_RATE,
 	MONITOR_FLUSH_PCT_FOR_DIRTY,
 	MONITOR_FLUSH_PCT_FOR_LSN,
+	MONITOR_FLUSH_INSTANCE_MAX_LAG,
+	MONITOR_FLUSH_INSTANCE_MIN_LAG,
+	MONITOR_FLUSH_WORKER_PAGES,
 	MONITOR_FLUSH_SYNC_WAITS,
 	MONITOR_FLUSH_ADAPTIVE_TOTAL_PAGE,
 	MONITOR_FLUSH_ADAPTIVE_COUNT,
@@ -296,6 +301,10 @@ enum monitor_id_t {
 	MONITOR_PENDING_LOG_WRITE,
 	MONITOR_PENDING_CHECKPOINT_WRITE,
 	MONITOR_LOG_IO,
+	MONITOR_LOG_PARALLEL_COPY,
+	MONITOR_LOG_PENDING_COPY_WAITS,
+	MONITOR_LOG_WRITER_WRITES,
+	MONITOR_LOG_WRITER_COMMIT_WAITS,
 	MONITOR_OVLD_LOG_WAITS,
 	MONITOR_OVLD_LOG_WRITE_REQUEST,
 	MONITOR_OVLD_LOG_WRITES,
@@ -320,6 +329,9 @@ enum monitor_id_t {
 	MONITOR_MODULE_ADAPTIVE_HASH,
 	MONITOR_OVLD_ADAPTIVE_HASH_SEARCH,
 	MONITOR_OVLD_ADAPTIVE_HASH_SEARCH_BTREE,
+	MONITOR_OVLD_ADAPTIVE_HASH_HITS,
+	MONITOR_OVLD_ADAPTIVE_HASH_MISSES,
+	MONITOR_OVLD_ADAPTIVE_HASH_LATCH_WAITS,
 	MONITOR_ADAPTIVE_HASH_PAGE_ADDED,
 	MONITOR_ADAPTIVE_HASH_PAGE_REMOVED,
 	MONITOR_ADAPTIVE_HASH_ROW_ADDED,
@@ -230,6 +230,12 @@ extern ibool	srv_locks_unsafe_for_binlog;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Number of threads that merge the sort files of a non-unique index
+in index creation */
+extern ulong	srv_merge_sort_threads;
+/** Percentage of each B-tree page that is filled when an index is
+built from sorted records */
+extern ulong	srv_fill_factor;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -281,6 +287,8 @@ extern ib_uint64_t	srv_log_file_size_requested;
 extern ulint	srv_log_buffer_size;
 extern ulong	srv_flush_log_at_trx_commit;
 extern uint	srv_flush_log_at_timeout;
+extern my_bool	srv_log_parallel_copy;
+extern my_bool	srv_log_writer_thread;
 extern char	srv_adaptive_flushing;
 
 /* If this flag is TRUE, then we will load the indexes' (and tables') metadata
@@ -301,6 +309,11 @@ extern my_bool	srv_buf_pool_populate;	/*!< virtual page preallocation */
 extern ulint    srv_buf_pool_instances; /*!< requested number of buffer pool instances */
 extern ulong	srv_n_page_hash_locks;	/*!< number of locks to
 					protect buf_pool->page_hash */
+extern ulong	srv_n_recovery_apply_threads;
+					/*!< number of threads that apply
+					the redo log in crash recovery */
+extern ulong	srv_n_page_cleaners;	/*!< number of threads that
+					flush the buffer pool instances */
 extern ulong	srv_LRU_scan_depth;	/*!< Scan depth for LRU
 					flush batch */
 extern ulong	srv_flush_neighbors;	/*!< whether or not to flush
@@ -310,6 +323,8 @@ extern ulint	srv_buf_pool_curr_size;	/*!< current size in bytes */
 extern ulint	srv_sync_pool_size;	/*!< requested size (number) */
 extern ulint	srv_mem_pool_size;
 extern ulint	srv_lock_table_size;
+extern ulong	srv_n_lock_sys_partitions;/*!< number of mutexes
+					partitioning lock_sys->rec_hash */
 
 extern ulint	srv_n_file_io_threads;
 extern my_bool	srv_random_read_ahead;
@@ -374,10 +389,13 @@ extern unsigned long long	srv_stats_transient_sample_pages;
 extern my_bool			srv_stats_persistent;
 extern unsigned long long	srv_stats_persistent_sample_pages;
 extern my_bool			srv_stats_auto_recalc;
+extern my_bool			srv_stats_incremental_recalc;
+extern ulong			srv_stats_analyze_threads;
 
 extern ulong	srv_use_doublewrite_buf;
 extern my_bool	srv_doublewrite_reset;
 extern ulong	srv_doublewrite_batch_size;
+extern my_bool	srv_parallel_doublewrite;
 extern ulong	srv_checksum_algorithm;
 
 extern double	srv_max_buf_pool_modified_pct;
@@ -493,6 +511,7 @@ extern srv_stats_t	srv_stats;
 # ifdef UNIV_PFS_THREAD
 /* Keys to register InnoDB threads with performance schema */
 extern mysql_pfs_key_t	buf_page_cleaner_thread_key;
+extern mysql_pfs_key_t	buf_page_cleaner_worker_thread_key;
 extern mysql_pfs_key_t  buf_lru_manager_thread_key;
 extern mysql_pfs_key_t	trx_rollback_clean_thread_key;
 extern mysql_pfs_key_t	io_handler_thread_key;
@@ -502,6 +521,8 @@ extern mysql_pfs_key_t	srv_monitor_thread_key;
 extern mysql_pfs_key_t	srv_master_thread_key;
 extern mysql_pfs_key_t	srv_purge_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
+extern mysql_pfs_key_t	recv_apply_thread_key;
+extern mysql_pfs_key_t	log_writer_thread_key;
 
 /* This macro register the current thread and its key with performance
 schema */
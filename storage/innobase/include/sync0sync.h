@@ -453,7 +453,7 @@ except for data dictionary latches. */
 	(!sync_thread_levels_nonempty_gen(TRUE))
 /******************************************************************//**
 Checks if the level array for the current thread is empty,
-except for the btr_search_latch.
+except for an adaptive hash index partition latch.
 @return	a latch, or NULL if empty except the exceptions specified below */
 UNIV_INTERN
 void*
@@ -461,7 +461,8 @@ sync_thread_levels_nonempty_trx(
 /*============================*/
 	ibool	has_search_latch)
 				/*!< in: TRUE if and only if the thread
-				is supposed to hold btr_search_latch */
+				is supposed to hold an adaptive
+				hash index partition latch */
 	__attribute__((warn_unused_result));
 
 /******************************************************************//**
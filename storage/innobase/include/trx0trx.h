@@ -901,9 +901,10 @@ struct trx_t{
 					flush the log in
 					trx_commit_complete_for_mysql() */
 	ulint		duplicates;	/*!< TRX_DUP_IGNORE | TRX_DUP_REPLACE */
-	ulint		has_search_latch;
-					/*!< TRUE if this trx has latched the
-					search system latch in S-mode */
+	rw_lock_t*	has_search_latch;
+					/*!< the adaptive hash index partition
+					latch this trx has latched in S-mode,
+					or NULL */
 	ulint		search_latch_timeout;
 					/*!< If we notice that someone is
 					waiting for our S-lock on the search
@@ -1195,24 +1196,6 @@ struct commit_node_t{
 	mutex_exit(&t->mutex);			\
 } while (0)
 
-/** @brief The latch protecting the adaptive search system
-
-This latch protects the
-(1) hash index;
-(2) columns of a record to which we have a pointer in the hash index;
-
-but does NOT protect:
-
-(3) next record offset field in a record;
-(4) next or previous records on the same page.
-
-Bear in mind (3) and (4) when using the hash index.
-*/
-extern rw_lock_t*	btr_search_latch_temp;
-
-/** The latch protecting the adaptive search system */
-#define btr_search_latch	(*btr_search_latch_temp)
-
 #ifndef UNIV_NONINL
 #include "trx0trx.ic"
 #endif
@@ -617,6 +617,17 @@ lock_sys_create(
 
 	lock_sys->rec_hash = hash_create(n_cells);
 
+	/* Partition the record lock hash table so that the common
+	"is this record locked at all?" checks done by modifying
+	transactions need not serialize on lock_sys->mutex. */
+	srv_n_lock_sys_partitions = static_cast<ulong>(
+		ut_2_power_up(srv_n_lock_sys_partitions));
+	ut_a(srv_n_lock_sys_partitions != 0);
+	ut_a(srv_n_lock_sys_partitions <= MAX_LOCK_SYS_PARTITIONS);
+
+	hash_create_sync_obj(lock_sys->rec_hash, HASH_TABLE_SYNC_MUTEX,
+			     srv_n_lock_sys_partitions, SYNC_REC_LOCK);
+
 	if (!srv_read_only_mode) {
 		lock_latest_err_file = os_file_create_tmpfile();
 		ut_a(lock_latest_err_file);
@@ -635,6 +646,11 @@ lock_sys_close(void)
 		lock_latest_err_file = NULL;
 	}
 
+	for (ulint i = 0; i < lock_sys->rec_hash->n_sync_obj; i++) {
+		mutex_free(hash_get_nth_mutex(lock_sys->rec_hash, i));
+	}
+
+	mem_free(lock_sys->rec_hash->sync_obj.mutexes);
 	hash_table_free(lock_sys->rec_hash);
 
 	mutex_free(&lock_sys->mutex);
@@ -1232,10 +1248,25 @@ lock_rec_expl_exist_on_page(
 	ulint	page_no)/*!< in: page number */
 {
 	lock_t*	lock;
+	ulint	fold = lock_rec_fold(space, page_no);
 
-	lock_mutex_enter();
-	lock = lock_rec_get_first_on_page_addr(space, page_no);
-	lock_mutex_exit();
+	/* Reading a hash chain only requires the partition mutex. */
+	hash_mutex_enter(lock_sys->rec_hash, fold);
+
+	for (lock = static_cast<lock_t*>(
+			HASH_GET_FIRST(lock_sys->rec_hash,
+				       lock_rec_hash(space, page_no)));
+	     lock != NULL;
+	     lock = static_cast<lock_t*>(HASH_GET_NEXT(hash, lock))) {
+
+		if (lock->un_member.rec_lock.space == space
+		    && lock->un_member.rec_lock.page_no == page_no) {
+
+			break;
+		}
+	}
+
+	hash_mutex_exit(lock_sys->rec_hash, fold);
 
 	return(lock);
 }
@@ -1274,6 +1305,59 @@ lock_rec_get_first_on_page(
 	return(lock);
 }
 
+/*********************************************************************//**
+Checks if there is an explicit lock request, granted or waiting, on a
+record, holding only the lock_sys->rec_hash partition mutex of the page
+instead of lock_sys->mutex. The caller must hold an x-latch on the page.
+Setting a lock bit on a record requires a latch on its page, so while we
+hold the x-latch bits can only be reset concurrently, which can merely
+make us report a lock that is just going away.
+@return	true if an explicit lock may exist on the record */
+static
+bool
+lock_rec_expl_exist_on_rec(
+/*=======================*/
+	const buf_block_t*	block,	/*!< in: x-latched buffer block */
+	ulint			heap_no)/*!< in: heap number of the record */
+{
+	const lock_t*	lock;
+	ulint		space	= buf_block_get_space(block);
+	ulint		page_no	= buf_block_get_page_no(block);
+	ulint		fold	= lock_rec_fold(space, page_no);
+
+	ut_ad(!lock_mutex_own());
+#ifdef UNIV_SYNC_DEBUG
+	ut_ad(rw_lock_own(&const_cast<buf_block_t*>(block)->lock,
+			  RW_LOCK_EX));
+#endif /* UNIV_SYNC_DEBUG */
+
+	hash_mutex_enter(lock_sys->rec_hash, fold);
+
+	for (lock = static_cast<const lock_t*>(
+			HASH_GET_FIRST(lock_sys->rec_hash,
+				       buf_block_get_lock_hash_val(block)));
+	     lock != NULL;
+	     lock = static_cast<const lock_t*>(HASH_GET_NEXT(hash, lock))) {
+
+		if (lock->un_member.rec_lock.space == space
+		    && lock->un_member.rec_lock.page_no == page_no
+		    && lock_rec_get_nth_bit(lock, heap_no)) {
+
+			break;
+		}
+	}
+
+	hash_mutex_exit(lock_sys->rec_hash, fold);
+
+	if (lock != NULL) {
+		MONITOR_INC(MONITOR_RECLOCK_PARTITION_FALLBACK);
+		return(true);
+	}
+
+	MONITOR_INC(MONITOR_RECLOCK_PARTITION_CHECK);
+	return(false);
+}
+
 /*********************************************************************//**
 Gets the next explicit lock request on a record.
 @return	next lock, NULL if none exists or if heap_no == ULINT_UNDEFINED */
@@ -1798,6 +1882,7 @@ lock_rec_create(
 	ulint		space;
 	ulint		n_bits;
 	ulint		n_bytes;
+	ulint		fold;
 	const page_t*	page;
 
 	ut_ad(lock_mutex_own());
@@ -1852,8 +1937,11 @@ lock_rec_create(
 
 	ut_ad(index->table->n_ref_count > 0 || !index->table->can_be_evicted);
 
-	HASH_INSERT(lock_t, hash, lock_sys->rec_hash,
-		    lock_rec_fold(space, page_no), lock);
+	fold = lock_rec_fold(space, page_no);
+
+	hash_mutex_enter(lock_sys->rec_hash, fold);
+	HASH_INSERT(lock_t, hash, lock_sys->rec_hash, fold, lock);
+	hash_mutex_exit(lock_sys->rec_hash, fold);
 
 	if (!caller_owns_trx_mutex) {
 		trx_mutex_enter(trx);
@@ -2473,6 +2561,7 @@ lock_rec_dequeue_from_page(
 {
 	ulint		space;
 	ulint		page_no;
+	ulint		fold;
 	lock_t*		lock;
 	trx_lock_t*	trx_lock;
 
@@ -2487,8 +2576,11 @@ lock_rec_dequeue_from_page(
 
 	in_lock->index->table->n_rec_locks--;
 
-	HASH_DELETE(lock_t, hash, lock_sys->rec_hash,
-		    lock_rec_fold(space, page_no), in_lock);
+	fold = lock_rec_fold(space, page_no);
+
+	hash_mutex_enter(lock_sys->rec_hash, fold);
+	HASH_DELETE(lock_t, hash, lock_sys->rec_hash, fold, in_lock);
+	hash_mutex_exit(lock_sys->rec_hash, fold);
 
 	UT_LIST_REMOVE(trx_locks, trx_lock->trx_locks, in_lock);
 
@@ -2525,6 +2617,7 @@ lock_rec_discard(
 {
 	ulint		space;
 	ulint		page_no;
+	ulint		fold;
 	trx_lock_t*	trx_lock;
 
 	ut_ad(lock_mutex_own());
@@ -2537,8 +2630,11 @@ lock_rec_discard(
 
 	in_lock->index->table->n_rec_locks--;
 
-	HASH_DELETE(lock_t, hash, lock_sys->rec_hash,
-		    lock_rec_fold(space, page_no), in_lock);
+	fold = lock_rec_fold(space, page_no);
+
+	hash_mutex_enter(lock_sys->rec_hash, fold);
+	HASH_DELETE(lock_t, hash, lock_sys->rec_hash, fold, in_lock);
+	hash_mutex_exit(lock_sys->rec_hash, fold);
 
 	UT_LIST_REMOVE(trx_locks, trx_lock->trx_locks, in_lock);
 
@@ -5986,6 +6082,23 @@ lock_rec_insert_check_and_lock(
 	next_rec = page_rec_get_next_const(rec);
 	next_rec_heap_no = page_rec_get_heap_no(next_rec);
 
+	if (!lock_rec_expl_exist_on_rec(block, next_rec_heap_no)) {
+		/* We optimize CPU time usage in the simplest case:
+		the successor is not locked, and we do not need to
+		acquire lock_sys->mutex at all. */
+
+		if (inherit_in && !dict_index_is_clust(index)) {
+			/* Update the page max trx id field */
+			page_update_max_trx_id(block,
+					       buf_block_get_page_zip(block),
+					       trx->id, mtr);
+		}
+
+		*inherit = FALSE;
+
+		return(DB_SUCCESS);
+	}
+
 	lock_mutex_enter();
 	/* Because this code is invoked for a running transaction by
 	the thread that is serving the transaction, it is not necessary
@@ -6191,6 +6304,18 @@ lock_clust_rec_modify_check_and_lock(
 
 	lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 
+	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
+
+	if (!lock_rec_expl_exist_on_rec(block, heap_no)) {
+		/* No other transaction can hold a conflicting explicit
+		lock, and we only need the implicit lock. */
+
+		ut_ad(lock_rec_queue_validate(
+			FALSE, block, rec, index, offsets));
+
+		return(DB_SUCCESS);
+	}
+
 	lock_mutex_enter();
 
 	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
@@ -6198,8 +6323,6 @@ lock_clust_rec_modify_check_and_lock(
 	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
 	lock_mutex_exit();
 
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
@@ -6251,16 +6374,22 @@ lock_sec_rec_modify_check_and_lock(
 	index record, and this would not have been possible if another active
 	transaction had modified this secondary index record. */
 
-	lock_mutex_enter();
+	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
 
-	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
+	if (!lock_rec_expl_exist_on_rec(block, heap_no)) {
+		/* No explicit lock can conflict with ours. */
+		err = DB_SUCCESS;
+	} else {
+		lock_mutex_enter();
 
-	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
-			    block, heap_no, index, thr);
+		ut_ad(lock_table_has(thr_get_trx(thr), index->table,
+				     LOCK_IX));
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
+		err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
+				    block, heap_no, index, thr);
 
-	lock_mutex_exit();
+		lock_mutex_exit();
+	}
 
 #ifdef UNIV_DEBUG
 	{
@@ -80,6 +80,13 @@ reduce the size of the log.
 /* Global log system variable */
 UNIV_INTERN log_t*	log_sys	= NULL;
 
+/** Flag indicating if the log_writer thread is in active state */
+UNIV_INTERN ibool	log_writer_is_active = FALSE;
+
+#ifdef UNIV_PFS_THREAD
+UNIV_INTERN mysql_pfs_key_t	log_writer_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
 #ifdef UNIV_PFS_RWLOCK
 UNIV_INTERN mysql_pfs_key_t	checkpoint_lock_key;
 # ifdef UNIV_LOG_ARCHIVE
@@ -161,6 +168,35 @@ log_io_complete_archive(void);
 /*=========================*/
 #endif /* UNIV_LOG_ARCHIVE */
 
+/************************************************************//**
+Waits until the mini-transactions that have reserved space in the log buffer
+have copied their log records there. The caller must hold the log mutex,
+which prevents new reservations. */
+static
+void
+log_wait_for_pending_copies(void)
+/*=============================*/
+{
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+#ifdef HAVE_ATOMIC_BUILTINS
+	if (os_atomic_increment_ulint(&log_sys->n_pending_copies, 0) == 0) {
+
+		return;
+	}
+
+	MONITOR_INC(MONITOR_LOG_PENDING_COPY_WAITS);
+
+	while (os_atomic_increment_ulint(&log_sys->n_pending_copies, 0) > 0) {
+		/* The copies are plain memcpy() calls that do not need
+		any latch, so they will complete soon. */
+		ut_delay(ut_rnd_interval(0, srv_spin_wait_delay));
+	}
+#else /* HAVE_ATOMIC_BUILTINS */
+	ut_ad(log_sys->n_pending_copies == 0);
+#endif /* HAVE_ATOMIC_BUILTINS */
+}
+
 /****************************************************************//**
 Returns the oldest modified block lsn in the pool, or log_sys->lsn if none
 exists.
@@ -228,6 +264,8 @@ log_buffer_extend(
 		mutex_enter(&(log_sys->mutex));
 	}
 
+	log_wait_for_pending_copies();
+
 	move_start = ut_calc_align_down(
 		log_sys->buf_free,
 		OS_FILE_LOG_BLOCK_SIZE);
@@ -366,14 +404,16 @@ loop:
 }
 
 /************************************************************//**
-Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
-UNIV_INTERN
+Advances the log buffer by the length of a string, initializing the log
+block headers and trailers on the way, and copies the string there if it
+is given. It is assumed that the caller holds the log mutex. */
+static
 void
-log_write_low(
-/*==========*/
-	byte*	str,		/*!< in: string */
-	ulint	str_len)	/*!< in: string length */
+log_write_advance(
+/*==============*/
+	const byte*	str,	/*!< in: string, or NULL if the caller
+				copies it later with log_write_copy() */
+	ulint		str_len)/*!< in: string length */
 {
 	log_t*	log	= log_sys;
 	ulint	len;
@@ -400,10 +440,13 @@ part_loop:
 			- LOG_BLOCK_TRL_SIZE;
 	}
 
-	ut_memcpy(log->buf + log->buf_free, str, len);
+	if (str != NULL) {
+		ut_memcpy(log->buf + log->buf_free, str, len);
+
+		str = str + len;
+	}
 
 	str_len -= len;
-	str = str + len;
 
 	log_block = static_cast<byte*>(
 		ut_align_down(
@@ -437,6 +480,106 @@ part_loop:
 	srv_stats.log_write_requests.inc();
 }
 
+/************************************************************//**
+Writes to the log the string given. It is assumed that the caller holds the
+log mutex. */
+UNIV_INTERN
+void
+log_write_low(
+/*==========*/
+	byte*	str,		/*!< in: string */
+	ulint	str_len)	/*!< in: string length */
+{
+	log_write_advance(str, str_len);
+}
+
+#ifdef HAVE_ATOMIC_BUILTINS
+/************************************************************//**
+Reserves space for a string in the log buffer and initializes the log block
+headers and trailers of that space, but does not copy the string: the caller
+must do that with log_write_copy() and then call log_write_copy_complete().
+It is assumed that the caller holds the log mutex.
+@return	offset in the log buffer where the string must be copied */
+UNIV_INTERN
+ulint
+log_write_reserve(
+/*==============*/
+	ulint	str_len)	/*!< in: string length */
+{
+	ulint	offset	= log_sys->buf_free;
+
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+	/* The log buffer must not be written or moved until the string
+	has been copied. */
+	os_atomic_increment_ulint(&log_sys->n_pending_copies, 1);
+
+	log_write_advance(NULL, str_len);
+
+	MONITOR_INC(MONITOR_LOG_PARALLEL_COPY);
+
+	return(offset);
+}
+
+/************************************************************//**
+Copies a string to the log buffer space reserved by log_write_reserve().
+Does not require the log mutex.
+@return	offset in the log buffer where the next part of the string
+must be copied */
+UNIV_INTERN
+ulint
+log_write_copy(
+/*===========*/
+	ulint		offset,	/*!< in: offset returned by
+				log_write_reserve() or by the previous
+				call of this function */
+	const byte*	str,	/*!< in: string */
+	ulint		str_len)/*!< in: string length */
+{
+	ut_ad(log_sys->n_pending_copies > 0);
+
+	while (str_len > 0) {
+		ulint	block_offset	= offset % OS_FILE_LOG_BLOCK_SIZE;
+		ulint	len;
+
+		if (block_offset
+		    >= OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE) {
+			/* Skip the trailer of this block and the header
+			of the next block */
+			offset += OS_FILE_LOG_BLOCK_SIZE - block_offset
+				+ LOG_BLOCK_HDR_SIZE;
+			continue;
+		}
+
+		len = ut_min(str_len, OS_FILE_LOG_BLOCK_SIZE
+			     - LOG_BLOCK_TRL_SIZE - block_offset);
+
+		ut_memcpy(log_sys->buf + offset, str, len);
+
+		offset += len;
+		str += len;
+		str_len -= len;
+	}
+
+	return(offset);
+}
+
+/************************************************************//**
+Notes that the string whose space was reserved by log_write_reserve() has
+been copied to the log buffer. */
+UNIV_INTERN
+void
+log_write_copy_complete(void)
+/*=========================*/
+{
+	ut_ad(log_sys->n_pending_copies > 0);
+
+	/* This is a full memory barrier: the copied string is visible
+	to the thread that sees the decremented counter. */
+	os_atomic_decrement_ulint(&log_sys->n_pending_copies, 1);
+}
+#endif /* HAVE_ATOMIC_BUILTINS */
+
 /************************************************************//**
 Closes the log.
 @return	lsn */
@@ -865,6 +1008,7 @@ log_init(void)
 
 	log_sys->buf_size = LOG_BUFFER_SIZE;
 	log_sys->is_extending = false;
+	log_sys->n_pending_copies = 0;
 
 	log_sys->max_buf_free = log_sys->buf_size / LOG_BUF_FLUSH_RATIO
 		- LOG_BUF_FLUSH_MARGIN;
@@ -896,6 +1040,14 @@ log_init(void)
 
 	os_event_set(log_sys->one_flushed_event);
 
+	log_sys->writer_lsn = 0;
+	log_sys->writer_flush = FALSE;
+	log_sys->writer_event = os_event_create();
+
+	for (ulint i = 0; i < LOG_WRITER_N_DONE_EVENTS; i++) {
+		log_sys->writer_done_events[i] = os_event_create();
+	}
+
 	/*----------------------------*/
 
 	log_sys->next_checkpoint_no = 0;
@@ -1136,6 +1288,8 @@ log_sys_check_flush_completion(void)
 			/* Move the log buffer content to the start of the
 			buffer */
 
+			log_wait_for_pending_copies();
+
 			move_start = ut_calc_align_down(
 				log_sys->write_end_offset,
 				OS_FILE_LOG_BLOCK_SIZE);
@@ -1528,6 +1682,10 @@ loop:
 		return;
 	}
 
+	/* Mini-transactions may still be copying their log records
+	into the part of the log buffer that we are about to write. */
+	log_wait_for_pending_copies();
+
 #ifdef UNIV_DEBUG
 	if (log_debug_writes) {
 		fprintf(stderr,
@@ -1650,6 +1808,172 @@ do_waits:
 	}
 }
 
+/******************************************************//**
+Checks if the log has been written, and flushed to disk if requested, up to
+the given lsn. The check is done without the log mutex.
+@return	TRUE if the log has been written far enough */
+static
+ibool
+log_write_is_done(
+/*==============*/
+	lsn_t	lsn,		/*!< in: log sequence number */
+	ibool	flush_to_disk)	/*!< in: TRUE if the log must also have
+				been flushed to disk */
+{
+	if (flush_to_disk) {
+		return(log_sys->flushed_to_disk_lsn >= lsn);
+	}
+
+	return(log_sys->written_to_some_lsn >= lsn);
+}
+
+/******************************************************//**
+Called when a transaction commits. Waits until the log has been written,
+and flushed to disk if requested, up to the given lsn. If the log_writer
+thread is running, the write is done by that thread and the caller only
+waits for it; otherwise this is log_write_up_to(lsn, LOG_WAIT_ONE_GROUP,
+flush_to_disk). */
+UNIV_INTERN
+void
+log_write_up_to_for_commit(
+/*=======================*/
+	lsn_t	lsn,		/*!< in: log sequence number up to which
+				the log should be written */
+	ibool	flush_to_disk)	/*!< in: TRUE if we want the written log
+				also to be flushed to disk */
+{
+	os_event_t	event;
+
+	if (!log_writer_is_active) {
+		log_write_up_to(lsn, LOG_WAIT_ONE_GROUP, flush_to_disk);
+		return;
+	}
+
+	if (log_write_is_done(lsn, flush_to_disk)) {
+		return;
+	}
+
+	mutex_enter(&(log_sys->mutex));
+
+	if (log_sys->writer_lsn < lsn) {
+		log_sys->writer_lsn = lsn;
+	}
+
+	if (flush_to_disk) {
+		log_sys->writer_flush = TRUE;
+	}
+
+	mutex_exit(&(log_sys->mutex));
+
+	os_event_set(log_sys->writer_event);
+
+	/* The log_writer thread groups the requests that arrive while it
+	is writing, so the wait is often short: spin for a while before
+	going to sleep. */
+
+	for (ulint i = 0; i < srv_n_spin_wait_rounds; i++) {
+
+		if (log_write_is_done(lsn, flush_to_disk)) {
+			return;
+		}
+
+		ut_delay(ut_rnd_interval(0, srv_spin_wait_delay));
+	}
+
+	MONITOR_INC(MONITOR_LOG_WRITER_COMMIT_WAITS);
+
+	event = log_sys->writer_done_events[
+		(lsn / OS_FILE_LOG_BLOCK_SIZE) % LOG_WRITER_N_DONE_EVENTS];
+
+	for (;;) {
+		ib_int64_t	sig_count = os_event_reset(event);
+
+		if (log_write_is_done(lsn, flush_to_disk)) {
+			return;
+		}
+
+		if (!log_writer_is_active) {
+			/* The log_writer thread exited at shutdown
+			before serving our request. */
+			log_write_up_to(
+				lsn, LOG_WAIT_ONE_GROUP, flush_to_disk);
+			return;
+		}
+
+		os_event_wait_low(event, sig_count);
+	}
+}
+
+/******************************************************************//**
+The log_writer thread, which writes and flushes the log on behalf of the
+committing transactions. The requests that arrive while a write is running
+are served by the next write, so that one fsync covers all of them.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg __attribute__((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(log_writer_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+#ifdef UNIV_DEBUG_THREAD_CREATION
+	fprintf(stderr, "InnoDB: log_writer thread running, id %lu\n",
+		os_thread_pf(os_thread_get_curr_id()));
+#endif /* UNIV_DEBUG_THREAD_CREATION */
+
+	log_writer_is_active = TRUE;
+
+	/* The committing transactions are gone when the shutdown enters
+	the flush phase. */
+	while (srv_shutdown_state < SRV_SHUTDOWN_FLUSH_PHASE) {
+		ib_int64_t	sig_count;
+		lsn_t		lsn;
+		ibool		flush_to_disk;
+
+		sig_count = os_event_reset(log_sys->writer_event);
+
+		mutex_enter(&(log_sys->mutex));
+
+		lsn = log_sys->writer_lsn;
+		flush_to_disk = log_sys->writer_flush;
+		log_sys->writer_flush = FALSE;
+
+		mutex_exit(&(log_sys->mutex));
+
+		if (log_write_is_done(lsn, flush_to_disk)) {
+			os_event_wait_low(log_sys->writer_event, sig_count);
+			continue;
+		}
+
+		log_write_up_to(lsn, LOG_WAIT_ALL_GROUPS, flush_to_disk);
+
+		MONITOR_INC(MONITOR_LOG_WRITER_WRITES);
+
+		for (ulint i = 0; i < LOG_WRITER_N_DONE_EVENTS; i++) {
+			os_event_set(log_sys->writer_done_events[i]);
+		}
+	}
+
+	log_writer_is_active = FALSE;
+
+	/* Wake up the threads that are still waiting, so that they write
+	the log themselves. */
+	for (ulint i = 0; i < LOG_WRITER_N_DONE_EVENTS; i++) {
+		os_event_set(log_sys->writer_done_events[i]);
+	}
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /****************************************************************//**
 Does a syncronous flush of the log buffer to disk. */
 UNIV_INTERN
@@ -3306,6 +3630,18 @@ loop:
 
 	srv_shutdown_state = SRV_SHUTDOWN_FLUSH_PHASE;
 
+	count = 0;
+	while (log_writer_is_active) {
+		os_event_set(log_sys->writer_event);
+		++count;
+		os_thread_sleep(100000);
+		if (srv_print_verbose_log && count > 600) {
+			ib_logf(IB_LOG_LEVEL_INFO,
+				"Waiting for log_writer thread to exit.");
+			count = 0;
+		}
+	}
+
 	count = 0;
 	while (buf_lru_manager_is_active) {
 		++count;
@@ -3714,6 +4050,12 @@ log_shutdown(void)
 	os_event_free(log_sys->no_flush_event);
 	os_event_free(log_sys->one_flushed_event);
 
+	os_event_free(log_sys->writer_event);
+
+	for (ulint i = 0; i < LOG_WRITER_N_DONE_EVENTS; i++) {
+		os_event_free(log_sys->writer_done_events[i]);
+	}
+
 	rw_lock_free(&log_sys->checkpoint_lock);
 
 	mutex_free(&log_sys->mutex);
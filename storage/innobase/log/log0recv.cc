@@ -71,6 +71,16 @@ this must be less than UNIV_PAGE_SIZE as it is stored in the buffer pool */
 /** Read-ahead area in applying log records to file pages */
 #define RECV_READ_AHEAD_AREA	32
 
+/** Interval in milliseconds between the progress reports of an apply
+batch */
+#define RECV_APPLY_REPORT_INTERVAL	10000
+
+/** Share of the hash table cells of a recv_apply thread */
+struct recv_apply_arg_t {
+	ulint	first;	/*!< first cell */
+	ulint	step;	/*!< distance between the cells */
+};
+
 /** The recovery system */
 UNIV_INTERN recv_sys_t*	recv_sys = NULL;
 /** TRUE when applying redo log records during crash recovery; FALSE
@@ -166,6 +176,7 @@ UNIV_INTERN mysql_pfs_key_t	recv_sys_mutex_key;
 #ifndef UNIV_HOTBACKUP
 # ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t	recv_writer_thread_key;
+UNIV_INTERN mysql_pfs_key_t	recv_apply_thread_key;
 # endif /* UNIV_PFS_THREAD */
 
 # ifdef UNIV_PFS_MUTEX
@@ -417,6 +428,7 @@ recv_sys_init(
 
 	recv_sys->addr_hash = hash_create(available_memory / 512);
 	recv_sys->n_addrs = 0;
+	recv_sys->n_apply_threads = 0;
 
 	recv_sys->apply_log_recs = FALSE;
 	recv_sys->apply_batch_on = FALSE;
@@ -1832,6 +1844,138 @@ recv_read_in_area(
 	return(n);
 }
 
+/*******************************************************************//**
+Applies the log records in a subset of the cells of the hash table, or
+starts the reading of the pages to which they will be applied. The caller
+must own recv_sys->mutex. */
+static
+void
+recv_apply_hashed_cells(
+/*====================*/
+	ulint	first,		/*!< in: first cell */
+	ulint	step,		/*!< in: distance between the cells */
+	ibool	print_progress)	/*!< in: whether to print the progress
+				in percent */
+{
+	ulint	n_cells = hash_get_n_cells(recv_sys->addr_hash);
+	mtr_t	mtr;
+
+	ut_ad(mutex_own(&recv_sys->mutex));
+
+	for (ulint i = first; i < n_cells; i += step) {
+		recv_addr_t*	recv_addr;
+
+		for (recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_FIRST(recv_sys->addr_hash, i));
+		     recv_addr != 0;
+		     recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_NEXT(addr_hash, recv_addr))) {
+
+			ulint	space = recv_addr->space;
+			ulint	zip_size = fil_space_get_zip_size(space);
+			ulint	page_no = recv_addr->page_no;
+
+			if (recv_addr->state == RECV_NOT_PROCESSED) {
+
+				mutex_exit(&(recv_sys->mutex));
+
+				if (buf_page_peek(space, page_no)) {
+					buf_block_t*	block;
+
+					mtr_start(&mtr);
+
+					block = buf_page_get(
+						space, zip_size, page_no,
+						RW_X_LATCH, &mtr);
+					buf_block_dbg_add_level(
+						block, SYNC_NO_ORDER_CHECK);
+
+					recv_recover_page(FALSE, block);
+					mtr_commit(&mtr);
+				} else {
+					recv_read_in_area(space, zip_size,
+							  page_no);
+				}
+
+				mutex_enter(&(recv_sys->mutex));
+			}
+		}
+
+		if (print_progress
+		    && (i * 100) / n_cells != ((i + step) * 100) / n_cells) {
+
+			fprintf(stderr, "%lu ", (ulong) ((i * 100) / n_cells));
+		}
+	}
+}
+
+/******************************************************************//**
+recv_apply thread, which applies the log records in its share of the cells
+of the hash table during an apply batch.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(
+/*==============================*/
+	void*	arg)	/*!< in: recv_apply_arg_t* */
+{
+	const recv_apply_arg_t*	apply_arg
+		= static_cast<const recv_apply_arg_t*>(arg);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_apply_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	mutex_enter(&recv_sys->mutex);
+
+	recv_apply_hashed_cells(apply_arg->first, apply_arg->step, FALSE);
+
+	ut_a(recv_sys->n_apply_threads > 0);
+	recv_sys->n_apply_threads--;
+
+	mutex_exit(&recv_sys->mutex);
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*******************************************************************//**
+Prints the number of pages that remain to be processed in the current
+apply batch and an estimate of the time that it will still take. The
+caller must own recv_sys->mutex. */
+static
+void
+recv_apply_report_progress(
+/*=======================*/
+	ulint	n_addrs_start,	/*!< in: recv_sys->n_addrs at the start
+				of the batch */
+	ulint	start_time)	/*!< in: ut_time_ms() at the start of
+				the batch */
+{
+	ulint	n_done = n_addrs_start - recv_sys->n_addrs;
+	ulint	elapsed = ut_time_ms() - start_time;
+
+	ut_ad(mutex_own(&recv_sys->mutex));
+
+	if (n_done == 0) {
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Apply batch: %lu of %lu pages remaining",
+			(ulong) recv_sys->n_addrs, (ulong) n_addrs_start);
+		return;
+	}
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Apply batch: %lu of %lu pages remaining,"
+		" estimated %lu seconds left",
+		(ulong) recv_sys->n_addrs, (ulong) n_addrs_start,
+		(ulong) (((ib_uint64_t) elapsed * recv_sys->n_addrs
+			  / n_done) / 1000));
+}
+
 /*******************************************************************//**
 Empties the hash table of stored log records, applying them to appropriate
 pages. */
@@ -1849,10 +1993,12 @@ recv_apply_hashed_log_recs(
 				the caller must in this case own the log
 				mutex */
 {
-	recv_addr_t* recv_addr;
 	ulint	i;
 	ibool	has_printed	= FALSE;
-	mtr_t	mtr;
+	ulint	n_threads;
+	ulint	n_addrs_start;
+	ulint	start_time;
+	ulint	last_report_time;
 loop:
 	mutex_enter(&(recv_sys->mutex));
 
@@ -1874,78 +2020,72 @@ loop:
 	recv_sys->apply_log_recs = TRUE;
 	recv_sys->apply_batch_on = TRUE;
 
-	for (i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
+	if (recv_sys->n_addrs > 0) {
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Starting an apply batch of log records to %lu pages"
+			" of the database...", (ulong) recv_sys->n_addrs);
+		has_printed = TRUE;
+	}
 
-		for (recv_addr = static_cast<recv_addr_t*>(
-				HASH_GET_FIRST(recv_sys->addr_hash, i));
-		     recv_addr != 0;
-		     recv_addr = static_cast<recv_addr_t*>(
-				HASH_GET_NEXT(addr_hash, recv_addr))) {
+	n_addrs_start = recv_sys->n_addrs;
+	start_time = ut_time_ms();
+	last_report_time = start_time;
 
-			ulint	space = recv_addr->space;
-			ulint	zip_size = fil_space_get_zip_size(space);
-			ulint	page_no = recv_addr->page_no;
+	/* The cells of the hash table are split between this thread and
+	the recv_apply threads: thread k applies the log records in the
+	cells k, k + n_threads, ... Pages that are not in the buffer pool
+	are read asynchronously and the log records are applied to them
+	in the i/o handler threads. */
+	n_threads = ut_min(srv_n_recovery_apply_threads,
+			   hash_get_n_cells(recv_sys->addr_hash));
 
-			if (recv_addr->state == RECV_NOT_PROCESSED) {
-				if (!has_printed) {
-					ib_logf(IB_LOG_LEVEL_INFO,
-						"Starting an apply batch"
-						" of log records"
-						" to the database...");
-					fputs("InnoDB: Progress in percent: ",
-					      stderr);
-					has_printed = TRUE;
-				}
+	if (n_threads > 1 && recv_sys->n_addrs > 1) {
+		static recv_apply_arg_t	args[RECV_MAX_APPLY_THREADS];
 
-				mutex_exit(&(recv_sys->mutex));
+		ut_a(n_threads <= RECV_MAX_APPLY_THREADS);
 
-				if (buf_page_peek(space, page_no)) {
-					buf_block_t*	block;
+		recv_sys->n_apply_threads = n_threads - 1;
 
-					mtr_start(&mtr);
+		for (i = 1; i < n_threads; i++) {
+			args[i].first = i;
+			args[i].step = n_threads;
 
-					block = buf_page_get(
-						space, zip_size, page_no,
-						RW_X_LATCH, &mtr);
-					buf_block_dbg_add_level(
-						block, SYNC_NO_ORDER_CHECK);
+			os_thread_create(recv_apply_thread, &args[i], NULL);
+		}
+	} else {
+		n_threads = 1;
+	}
 
-					recv_recover_page(FALSE, block);
-					mtr_commit(&mtr);
-				} else {
-					recv_read_in_area(space, zip_size,
-							  page_no);
-				}
+	if (has_printed) {
+		fputs("InnoDB: Progress in percent: ", stderr);
+	}
 
-				mutex_enter(&(recv_sys->mutex));
-			}
-		}
+	recv_apply_hashed_cells(0, n_threads, has_printed);
 
-		if (has_printed
-		    && (i * 100) / hash_get_n_cells(recv_sys->addr_hash)
-		    != ((i + 1) * 100)
-		    / hash_get_n_cells(recv_sys->addr_hash)) {
+	if (has_printed) {
 
-			fprintf(stderr, "%lu ", (ulong)
-				((i * 100)
-				 / hash_get_n_cells(recv_sys->addr_hash)));
-		}
+		fprintf(stderr, "\n");
 	}
 
 	/* Wait until all the pages have been processed */
 
-	while (recv_sys->n_addrs != 0) {
+	while (recv_sys->n_addrs != 0 || recv_sys->n_apply_threads != 0) {
 
 		mutex_exit(&(recv_sys->mutex));
 
-		os_thread_sleep(500000);
+		os_thread_sleep(recv_sys->n_apply_threads != 0
+				? 10000 : 500000);
 
 		mutex_enter(&(recv_sys->mutex));
-	}
 
-	if (has_printed) {
+		if (ut_time_ms() - last_report_time
+		    >= RECV_APPLY_REPORT_INTERVAL) {
 
-		fprintf(stderr, "\n");
+			recv_apply_report_progress(
+				n_addrs_start, start_time);
+
+			last_report_time = ut_time_ms();
+		}
 	}
 
 	if (!allow_ibuf) {
@@ -240,6 +240,7 @@ mtr_log_reserve_and_write(
 	dyn_array_t*	mlog;
 	ulint		data_size;
 	byte*		first_data;
+	ulint		copy_offset	= ULINT_UNDEFINED;
 
 	ut_ad(!srv_read_only_mode);
 
@@ -280,6 +281,13 @@ mtr_log_reserve_and_write(
 
 	if (mtr->log_mode == MTR_LOG_ALL) {
 
+#if defined HAVE_ATOMIC_BUILTINS && !defined UNIV_LOG_DEBUG
+		if (srv_log_parallel_copy) {
+			/* Only reserve the space here, and copy the log
+			records after releasing the log mutex. */
+			copy_offset = log_write_reserve(data_size);
+		} else
+#endif /* HAVE_ATOMIC_BUILTINS && !UNIV_LOG_DEBUG */
 		for (dyn_block_t* block = mlog;
 		     block != 0;
 		     block = dyn_array_get_next_block(mlog, block)) {
@@ -298,6 +306,27 @@ mtr_log_reserve_and_write(
 	mtr->end_lsn = log_close();
 
 	mtr_add_dirtied_pages_to_flush_list(mtr);
+
+#if defined HAVE_ATOMIC_BUILTINS && !defined UNIV_LOG_DEBUG
+	if (copy_offset != ULINT_UNDEFINED) {
+		/* We still hold the latches on the modified pages, so
+		they cannot be flushed before the log records are in the
+		log buffer, and the log buffer will not be written before
+		log_write_copy_complete(). */
+
+		for (dyn_block_t* block = mlog;
+		     block != 0;
+		     block = dyn_array_get_next_block(mlog, block)) {
+
+			copy_offset = log_write_copy(
+				copy_offset,
+				dyn_block_get_data(block),
+				dyn_block_get_used(block));
+		}
+
+		log_write_copy_complete();
+	}
+#endif /* HAVE_ATOMIC_BUILTINS && !UNIV_LOG_DEBUG */
 }
 #endif /* !UNIV_HOTBACKUP */
 
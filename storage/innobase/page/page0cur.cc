@@ -1722,23 +1722,12 @@ page_copy_rec_list_end_to_created_page(
 	dict_index_t*	index,		/*!< in: record descriptor */
 	mtr_t*		mtr)		/*!< in: mtr */
 {
-	page_dir_slot_t* slot = 0; /* remove warning */
-	byte*	heap_top;
-	rec_t*	insert_rec = 0; /* remove warning */
-	rec_t*	prev_rec;
-	ulint	count;
-	ulint	n_recs;
-	ulint	slot_index;
-	ulint	rec_size;
-	ulint	log_mode;
-	byte*	log_ptr;
-	ulint	log_data_len;
+	page_bulk_t	bulk;
 	mem_heap_t*	heap		= NULL;
 	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
 	ulint*		offsets		= offsets_;
 	rec_offs_init(offsets_);
 
-	ut_ad(page_dir_get_n_heap(new_page) == PAGE_HEAP_NO_USER_LOW);
 	ut_ad(page_align(rec) != new_page);
 	ut_ad(page_rec_is_comp(rec) == page_is_comp(new_page));
 
@@ -1752,6 +1741,45 @@ page_copy_rec_list_end_to_created_page(
 		return;
 	}
 
+	page_bulk_start(&bulk, new_page, index, mtr);
+
+	do {
+		rec_t*	insert_rec __attribute__((unused));
+
+		offsets = rec_get_offsets(rec, index, offsets,
+					  ULINT_UNDEFINED, &heap);
+		insert_rec = page_bulk_append(&bulk, rec, offsets, index, mtr);
+
+		btr_blob_dbg_add_rec(insert_rec, index, offsets, "copy_end");
+
+		rec = page_rec_get_next(rec);
+	} while (!page_rec_is_supremum(rec));
+
+	page_bulk_finish(&bulk, index, mtr);
+
+	if (UNIV_LIKELY_NULL(heap)) {
+		mem_heap_free(heap);
+	}
+}
+
+/*************************************************************//**
+Starts appending records to a newly created uncompressed page. The records
+appended by page_bulk_append() are logged in one MLOG_LIST_END_COPY_CREATED
+record, which page_bulk_finish() completes. No other log records may be
+written to mtr in between. */
+UNIV_INTERN
+void
+page_bulk_start(
+/*============*/
+	page_bulk_t*	bulk,		/*!< out: append state */
+	page_t*		new_page,	/*!< in/out: index page to append
+					to; must be empty */
+	dict_index_t*	index,		/*!< in: record descriptor */
+	mtr_t*		mtr)		/*!< in/out: mtr */
+{
+	ut_ad(page_dir_get_n_heap(new_page) == PAGE_HEAP_NO_USER_LOW);
+	ut_ad(!!page_is_comp(new_page) == dict_table_is_comp(index->table));
+
 #ifdef UNIV_DEBUG
 	/* To pass the debug tests we have to set these dummy values
 	in the debug version */
@@ -1760,76 +1788,176 @@ page_copy_rec_list_end_to_created_page(
 			    new_page + UNIV_PAGE_SIZE - 1);
 #endif
 
-	log_ptr = page_copy_rec_list_to_created_page_write_log(new_page,
-							       index, mtr);
+	bulk->page = new_page;
+
+	bulk->log_ptr = page_copy_rec_list_to_created_page_write_log(
+		new_page, index, mtr);
 
-	log_data_len = dyn_array_get_data_size(&(mtr->log));
+	bulk->log_data_len = dyn_array_get_data_size(&(mtr->log));
 
 	/* Individual inserts are logged in a shorter form */
 
-	log_mode = mtr_set_log_mode(mtr, MTR_LOG_SHORT_INSERTS);
+	bulk->log_mode = mtr_set_log_mode(mtr, MTR_LOG_SHORT_INSERTS);
 
-	prev_rec = page_get_infimum_rec(new_page);
+	bulk->prev_rec = page_get_infimum_rec(new_page);
 	if (page_is_comp(new_page)) {
-		heap_top = new_page + PAGE_NEW_SUPREMUM_END;
+		bulk->heap_top = new_page + PAGE_NEW_SUPREMUM_END;
 	} else {
-		heap_top = new_page + PAGE_OLD_SUPREMUM_END;
+		bulk->heap_top = new_page + PAGE_OLD_SUPREMUM_END;
+	}
+	bulk->unlogged_rec = NULL;
+	bulk->unlogged_prev = NULL;
+	bulk->slot = NULL;
+	bulk->slot_index = 0;
+	bulk->count = 0;
+	bulk->n_recs = 0;
+}
+
+/*************************************************************//**
+Checks if a record fits on a page after the records appended so far.
+@return true if the record fits and at least reserved bytes would remain
+free, or if it fits and fewer than 2 records have been appended */
+UNIV_INTERN
+bool
+page_bulk_has_space(
+/*================*/
+	const page_bulk_t*	bulk,		/*!< in: append state */
+	ulint			rec_size,	/*!< in: size of the record */
+	ulint			reserved)	/*!< in: number of bytes to
+						leave free on the page */
+{
+	/* When the page is finished, the directory will contain the
+	slots of the infimum and the supremum and possibly a new slot
+	for the record. */
+	const byte*	dir_start = bulk->page + UNIV_PAGE_SIZE - PAGE_DIR
+		- (bulk->slot_index + 3) * PAGE_DIR_SLOT_SIZE;
+
+	if (bulk->heap_top + rec_size > dir_start) {
+		return(false);
 	}
-	count = 0;
-	slot_index = 0;
-	n_recs = 0;
 
-	do {
-		offsets = rec_get_offsets(rec, index, offsets,
-					  ULINT_UNDEFINED, &heap);
-		insert_rec = rec_copy(heap_top, rec, offsets);
+	return(bulk->n_recs < 2
+	       || ulint(dir_start - (bulk->heap_top + rec_size)) >= reserved);
+}
 
-		if (page_is_comp(new_page)) {
-			rec_set_next_offs_new(prev_rec,
-					      page_offset(insert_rec));
+/*************************************************************//**
+Appends a record to a page after the records appended so far. The
+record is logged when the next record is appended or the page is
+finished, so the caller may still modify it in the meantime, for
+example to store the pointers to its externally stored columns.
+@return the record on the page */
+UNIV_INTERN
+rec_t*
+page_bulk_append(
+/*=============*/
+	page_bulk_t*	bulk,	/*!< in/out: append state */
+	const rec_t*	rec,	/*!< in: record to append, not on the page */
+	ulint*		offsets,/*!< in/out: rec_get_offsets(rec, index) */
+	dict_index_t*	index,	/*!< in: record descriptor */
+	mtr_t*		mtr)	/*!< in/out: mtr */
+{
+	page_t*	new_page = bulk->page;
+	rec_t*	insert_rec;
+	ulint	rec_size;
 
-			rec_set_n_owned_new(insert_rec, NULL, 0);
-			rec_set_heap_no_new(insert_rec,
-					    PAGE_HEAP_NO_USER_LOW + n_recs);
-		} else {
-			rec_set_next_offs_old(prev_rec,
-					      page_offset(insert_rec));
+	ut_ad(page_align(rec) != new_page);
+	ut_ad(mtr_get_log_mode(mtr) == MTR_LOG_SHORT_INSERTS);
 
-			rec_set_n_owned_old(insert_rec, 0);
-			rec_set_heap_no_old(insert_rec,
-					    PAGE_HEAP_NO_USER_LOW + n_recs);
-		}
+	if (bulk->unlogged_rec != NULL) {
+		page_cur_insert_rec_write_log(
+			bulk->unlogged_rec, bulk->unlogged_size,
+			bulk->unlogged_prev, index, mtr);
+	}
 
-		count++;
-		n_recs++;
+	insert_rec = rec_copy(bulk->heap_top, rec, offsets);
 
-		if (UNIV_UNLIKELY
-		    (count == (PAGE_DIR_SLOT_MAX_N_OWNED + 1) / 2)) {
+	if (page_is_comp(new_page)) {
+		rec_set_next_offs_new(bulk->prev_rec,
+				      page_offset(insert_rec));
 
-			slot_index++;
+		rec_set_n_owned_new(insert_rec, NULL, 0);
+		rec_set_heap_no_new(insert_rec,
+				    PAGE_HEAP_NO_USER_LOW + bulk->n_recs);
+	} else {
+		rec_set_next_offs_old(bulk->prev_rec,
+				      page_offset(insert_rec));
 
-			slot = page_dir_get_nth_slot(new_page, slot_index);
+		rec_set_n_owned_old(insert_rec, 0);
+		rec_set_heap_no_old(insert_rec,
+				    PAGE_HEAP_NO_USER_LOW + bulk->n_recs);
+	}
 
-			page_dir_slot_set_rec(slot, insert_rec);
-			page_dir_slot_set_n_owned(slot, NULL, count);
+	bulk->count++;
+	bulk->n_recs++;
 
-			count = 0;
-		}
+	if (UNIV_UNLIKELY
+	    (bulk->count == (PAGE_DIR_SLOT_MAX_N_OWNED + 1) / 2)) {
 
-		rec_size = rec_offs_size(offsets);
+		bulk->slot_index++;
 
-		ut_ad(heap_top < new_page + UNIV_PAGE_SIZE);
+		bulk->slot = page_dir_get_nth_slot(new_page,
+						   bulk->slot_index);
 
-		heap_top += rec_size;
+		page_dir_slot_set_rec(bulk->slot, insert_rec);
+		page_dir_slot_set_n_owned(bulk->slot, NULL, bulk->count);
 
-		rec_offs_make_valid(insert_rec, index, offsets);
-		btr_blob_dbg_add_rec(insert_rec, index, offsets, "copy_end");
+		bulk->count = 0;
+	}
 
-		page_cur_insert_rec_write_log(insert_rec, rec_size, prev_rec,
-					      index, mtr);
-		prev_rec = insert_rec;
-		rec = page_rec_get_next(rec);
-	} while (!page_rec_is_supremum(rec));
+	rec_size = rec_offs_size(offsets);
+
+	ut_ad(bulk->heap_top < new_page + UNIV_PAGE_SIZE);
+
+	bulk->heap_top += rec_size;
+
+	rec_offs_make_valid(insert_rec, index, offsets);
+
+	bulk->unlogged_rec = insert_rec;
+	bulk->unlogged_prev = bulk->prev_rec;
+	bulk->unlogged_size = rec_size;
+	bulk->prev_rec = insert_rec;
+
+	return(insert_rec);
+}
+
+/*************************************************************//**
+Finishes appending records to a page: completes the page directory and
+header and the log record written by page_bulk_start(). */
+UNIV_INTERN
+void
+page_bulk_finish(
+/*=============*/
+	page_bulk_t*	bulk,	/*!< in/out: append state */
+	dict_index_t*	index,	/*!< in: record descriptor */
+	mtr_t*		mtr)	/*!< in/out: mtr */
+{
+	page_t*		new_page = bulk->page;
+	page_dir_slot_t* slot;
+	ulint		slot_index = bulk->slot_index;
+	ulint		count = bulk->count;
+	ulint		log_data_len;
+
+	if (bulk->unlogged_rec != NULL) {
+		page_cur_insert_rec_write_log(
+			bulk->unlogged_rec, bulk->unlogged_size,
+			bulk->unlogged_prev, index, mtr);
+		bulk->unlogged_rec = NULL;
+	}
+
+	if (UNIV_UNLIKELY(bulk->n_recs == 0)) {
+		/* Nothing was appended: log an empty record list and
+		restore the header fields of an empty page. */
+		if (bulk->log_ptr != NULL) {
+			mach_write_to_4(bulk->log_ptr, 0);
+		}
+#ifdef UNIV_DEBUG
+		page_dir_set_n_slots(new_page, NULL, 2);
+		page_header_set_ptr(new_page, NULL, PAGE_HEAP_TOP,
+				    bulk->heap_top);
+#endif
+		mtr_set_log_mode(mtr, bulk->log_mode);
+		return;
+	}
 
 	if ((slot_index > 0) && (count + 1
 				 + (PAGE_DIR_SLOT_MAX_N_OWNED + 1) / 2
@@ -1843,27 +1971,24 @@ page_copy_rec_list_end_to_created_page(
 
 		count += (PAGE_DIR_SLOT_MAX_N_OWNED + 1) / 2;
 
-		page_dir_slot_set_n_owned(slot, NULL, 0);
+		page_dir_slot_set_n_owned(bulk->slot, NULL, 0);
 
 		slot_index--;
 	}
 
-	if (UNIV_LIKELY_NULL(heap)) {
-		mem_heap_free(heap);
-	}
-
-	log_data_len = dyn_array_get_data_size(&(mtr->log)) - log_data_len;
+	log_data_len = dyn_array_get_data_size(&(mtr->log))
+		- bulk->log_data_len;
 
 	ut_a(log_data_len < 100 * UNIV_PAGE_SIZE);
 
-	if (UNIV_LIKELY(log_ptr != NULL)) {
-		mach_write_to_4(log_ptr, log_data_len);
+	if (UNIV_LIKELY(bulk->log_ptr != NULL)) {
+		mach_write_to_4(bulk->log_ptr, log_data_len);
 	}
 
 	if (page_is_comp(new_page)) {
-		rec_set_next_offs_new(insert_rec, PAGE_NEW_SUPREMUM);
+		rec_set_next_offs_new(bulk->prev_rec, PAGE_NEW_SUPREMUM);
 	} else {
-		rec_set_next_offs_old(insert_rec, PAGE_OLD_SUPREMUM);
+		rec_set_next_offs_old(bulk->prev_rec, PAGE_OLD_SUPREMUM);
 	}
 
 	slot = page_dir_get_nth_slot(new_page, 1 + slot_index);
@@ -1872,18 +1997,19 @@ page_copy_rec_list_end_to_created_page(
 	page_dir_slot_set_n_owned(slot, NULL, count + 1);
 
 	page_dir_set_n_slots(new_page, NULL, 2 + slot_index);
-	page_header_set_ptr(new_page, NULL, PAGE_HEAP_TOP, heap_top);
-	page_dir_set_n_heap(new_page, NULL, PAGE_HEAP_NO_USER_LOW + n_recs);
-	page_header_set_field(new_page, NULL, PAGE_N_RECS, n_recs);
+	page_header_set_ptr(new_page, NULL, PAGE_HEAP_TOP, bulk->heap_top);
+	page_dir_set_n_heap(new_page, NULL,
+			    PAGE_HEAP_NO_USER_LOW + bulk->n_recs);
+	page_header_set_field(new_page, NULL, PAGE_N_RECS, bulk->n_recs);
 
 	page_header_set_ptr(new_page, NULL, PAGE_LAST_INSERT, NULL);
 	page_header_set_field(new_page, NULL, PAGE_DIRECTION,
-							PAGE_NO_DIRECTION);
+			      PAGE_NO_DIRECTION);
 	page_header_set_field(new_page, NULL, PAGE_N_DIRECTION, 0);
 
 	/* Restore the log mode */
 
-	mtr_set_log_mode(mtr, log_mode);
+	mtr_set_log_mode(mtr, bulk->log_mode);
 }
 
 /***********************************************************//**
@@ -3045,6 +3045,10 @@ row_ins_index_entry_step(
 
 	err = row_ins_index_entry(node->index, node->entry, thr);
 
+	if (err == DB_SUCCESS) {
+		node->index->stat_modified_counter++;
+	}
+
 #ifdef UNIV_DEBUG
 	/* Work around Bug#14626800 ASSERTION FAILURE IN DEBUG_SYNC().
 	Once it is fixed, remove the 'ifdef', 'if' and this comment. */
@@ -26,6 +26,7 @@ Completed by Sunny Bains and Marko Makela
 
 #include "row0merge.h"
 #include "row0ext.h"
+#include "btr0bulk.h"
 #include "row0log.h"
 #include "row0ins.h"
 #include "row0sel.h"
@@ -2144,6 +2145,110 @@ done0:
 	       != NULL);
 }
 
+/** One pass of row_merge(), whose merges may be divided between
+several threads */
+struct row_merge_pass_t {
+	trx_t*			trx;	/*!< transaction */
+	const row_merge_dup_t*	dup;	/*!< descriptor of index being
+					created */
+	const merge_file_t*	file;	/*!< input file */
+	const ulint*		in_offset;/*!< first offset of each input
+					run */
+	ulint			n_in;	/*!< number of input runs */
+	ulint*			run_offset;/*!< out: first offset of each
+					output run */
+	os_ib_mutex_t		mutex;	/*!< protects n_running */
+	ulint			n_running;/*!< number of helper threads
+					not finished yet */
+	os_event_t		done;	/*!< set when the last helper
+					thread finishes */
+};
+
+/** The merges of a row_merge() pass that are done by one thread */
+struct row_merge_chunk_t {
+	row_merge_pass_t*	pass;	/*!< the pass */
+	ulint			first;	/*!< first output run */
+	ulint			last;	/*!< output run after the chunk */
+	row_merge_block_t*	block;	/*!< 3 buffers of the thread */
+	merge_file_t		of;	/*!< output of the chunk */
+	dberr_t			error;	/*!< DB_SUCCESS or error code */
+};
+
+/*************************************************************//**
+Produces the output runs chunk->first to chunk->last - 1 of a merge pass.
+Output run i merges input runs i and i + n_in / 2, or copies input run
+i + n_in / 2 if there is no run to merge it with. The runs are written
+one after another starting from chunk->of.offset. */
+static
+void
+row_merge_chunk(
+/*============*/
+	row_merge_chunk_t*	chunk)	/*!< in/out: merges to do */
+{
+	row_merge_pass_t*	pass	= chunk->pass;
+	const ulint		half	= pass->n_in / 2;
+
+	chunk->error = DB_SUCCESS;
+
+	for (ulint i = chunk->first; i < chunk->last; i++) {
+		ulint	foffs0;
+		ulint	foffs1;
+
+		if (trx_is_interrupted(pass->trx)) {
+			chunk->error = DB_INTERRUPTED;
+			return;
+		}
+
+		/* Remember the offset number for this run */
+		pass->run_offset[i] = chunk->of.offset;
+
+		foffs1 = pass->in_offset[half + i];
+
+		if (i < half) {
+			foffs0 = pass->in_offset[i];
+
+			chunk->error = row_merge_blocks(
+				pass->dup, pass->file, chunk->block,
+				&foffs0, &foffs1, &chunk->of);
+		} else if (!row_merge_blocks_copy(
+				   pass->dup->index, pass->file,
+				   chunk->block, &foffs1, &chunk->of)) {
+			chunk->error = DB_CORRUPTION;
+		}
+
+		if (chunk->error != DB_SUCCESS) {
+			return;
+		}
+	}
+}
+
+/*************************************************************//**
+Helper thread of a parallel row_merge() pass.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_chunk_thread)(
+/*===================================*/
+	void*	arg)	/*!< in/out: row_merge_chunk_t */
+{
+	row_merge_chunk_t*	chunk	= static_cast<row_merge_chunk_t*>(arg);
+	row_merge_pass_t*	pass	= chunk->pass;
+
+	row_merge_chunk(chunk);
+
+	os_mutex_enter(pass->mutex);
+	/* The owner of pass frees it as soon as done is set and the
+	mutex is released, so do not touch pass afterwards. */
+	if (--pass->n_running == 0) {
+		os_event_set(pass->done);
+	}
+	os_mutex_exit(pass->mutex);
+
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /*************************************************************//**
 Merge disk files.
 @return	DB_SUCCESS or error code */
@@ -2156,30 +2261,30 @@ row_merge(
 					index being created */
 	merge_file_t*		file,	/*!< in/out: file containing
 					index entries */
-	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
+	row_merge_block_t**	blocks,	/*!< in/out: 3 buffers for
+					each thread */
+	ulint			n_threads,/*!< in: number of elements
+					in blocks[] */
 	int*			tmpfd,	/*!< in/out: temporary file handle */
 	ulint*			num_run,/*!< in/out: Number of runs remain
 					to be merged */
-	ulint*			run_offset) /*!< in/out: Array contains the
+	ulint*			run_offset,/*!< in/out: Array contains the
 					first offset number for each merge
 					run */
+	ulint*			in_offset)/*!< out: copy of the input
+					run_offset */
 {
-	ulint		foffs0;	/*!< first input offset */
-	ulint		foffs1;	/*!< second input offset */
-	dberr_t		error;	/*!< error code */
-	merge_file_t	of;	/*!< output file */
-	const ulint	ihalf	= run_offset[*num_run / 2];
-				/*!< half the input file */
-	ulint		n_run	= 0;
+	row_merge_pass_t	pass;
+	row_merge_chunk_t	chunks[ROW_MERGE_MAX_THREADS];
+	dberr_t			error	= DB_SUCCESS;
+	ib_uint64_t		n_rec	= 0;
+	const ulint		n_run	= *num_run - *num_run / 2;
 				/*!< num of runs generated from this merge */
+	ulint			n_chunks = ut_min(n_threads, n_run);
+	ulint			i;
 
-	UNIV_MEM_ASSERT_W(&block[0], 3 * srv_sort_buf_size);
-
-	ut_ad(ihalf < file->offset);
-
-	of.fd = *tmpfd;
-	of.offset = 0;
-	of.n_rec = 0;
+	ut_ad(n_threads <= ROW_MERGE_MAX_THREADS);
+	ut_ad(run_offset[*num_run / 2] < file->offset);
 
 #ifdef POSIX_FADV_SEQUENTIAL
 	/* The input file will be read sequentially, starting from the
@@ -2189,70 +2294,88 @@ row_merge(
 		      POSIX_FADV_SEQUENTIAL | POSIX_FADV_NOREUSE);
 #endif /* POSIX_FADV_SEQUENTIAL */
 
-	/* Merge blocks to the output file. */
-	foffs0 = 0;
-	foffs1 = ihalf;
+	memcpy(in_offset, run_offset, *num_run * sizeof *in_offset);
 
 	UNIV_MEM_INVALID(run_offset, *num_run * sizeof *run_offset);
 
-	for (; foffs0 < ihalf && foffs1 < file->offset; foffs0++, foffs1++) {
-
-		if (trx_is_interrupted(trx)) {
-			return(DB_INTERRUPTED);
-		}
-
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
-
-		error = row_merge_blocks(dup, file, block,
-					 &foffs0, &foffs1, &of);
-
-		if (error != DB_SUCCESS) {
-			return(error);
+	pass.trx = trx;
+	pass.dup = dup;
+	pass.file = file;
+	pass.in_offset = in_offset;
+	pass.n_in = *num_run;
+	pass.run_offset = run_offset;
+
+	/* Divide the output runs between the threads. An output run
+	never occupies more blocks than its input runs, so a chunk can
+	start writing at the sum of the sizes of the input runs of the
+	preceding chunks. The runs of a chunk are written without gaps,
+	but a chunk can end before the next one starts; the next pass
+	finds the runs through run_offset[] and never reads the gap. */
+
+	for (i = 0; i < n_chunks; i++) {
+		row_merge_chunk_t*	chunk = &chunks[i];
+
+		chunk->pass = &pass;
+		chunk->first = i * n_run / n_chunks;
+		chunk->last = (i + 1) * n_run / n_chunks;
+		chunk->block = blocks[i];
+		chunk->of.fd = *tmpfd;
+		chunk->of.n_rec = 0;
+
+		/* The output runs before this chunk were produced
+		from the input runs 0 to first - 1 of the first half and
+		the input runs half to half + first - 1. */
+		const ulint	half	= *num_run / 2;
+
+		chunk->of.offset = in_offset[ut_min(chunk->first, half)]
+			+ in_offset[half + chunk->first] - in_offset[half];
+
+		UNIV_MEM_ASSERT_W(&blocks[i][0], 3 * srv_sort_buf_size);
+	}
+
+	if (n_chunks > 1) {
+		pass.mutex = os_mutex_create();
+		pass.done = os_event_create();
+		pass.n_running = n_chunks - 1;
+
+		for (i = 1; i < n_chunks; i++) {
+			os_thread_create(row_merge_chunk_thread,
+					 &chunks[i], NULL);
 		}
-
 	}
 
-	/* Copy the last blocks, if there are any. */
+	row_merge_chunk(&chunks[0]);
 
-	while (foffs0 < ihalf) {
-		if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
-			return(DB_INTERRUPTED);
-		}
+	if (n_chunks > 1) {
+		os_event_wait(pass.done);
 
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
+		/* Wait until the last helper thread has released the
+		mutex before freeing it. */
+		os_mutex_enter(pass.mutex);
+		os_mutex_exit(pass.mutex);
 
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs0, &of)) {
-			return(DB_CORRUPTION);
-		}
+		os_event_free(pass.done);
+		os_mutex_free(pass.mutex);
 	}
 
-	ut_ad(foffs0 == ihalf);
+	for (i = 0; i < n_chunks; i++) {
+		UNIV_MEM_INVALID(&blocks[i][0], 3 * srv_sort_buf_size);
 
-	while (foffs1 < file->offset) {
-		if (trx_is_interrupted(trx)) {
-			return(DB_INTERRUPTED);
+		if (error == DB_SUCCESS) {
+			error = chunks[i].error;
 		}
 
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
-
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs1, &of)) {
-			return(DB_CORRUPTION);
-		}
+		n_rec += chunks[i].of.n_rec;
 	}
 
-	ut_ad(foffs1 == file->offset);
+	if (error != DB_SUCCESS) {
+		return(error);
+	}
 
-	if (UNIV_UNLIKELY(of.n_rec != file->n_rec)) {
+	if (UNIV_UNLIKELY(n_rec != file->n_rec)) {
 		return(DB_CORRUPTION);
 	}
 
-	ut_ad(n_run <= *num_run);
-
 	*num_run = n_run;
 
 	/* Each run can contain one or more offsets. As merge goes on,
@@ -2263,13 +2386,12 @@ row_merge(
 
 	/* The number of offsets in output file is always equal or
 	smaller than input file */
-	ut_ad(of.offset <= file->offset);
+	ut_ad(chunks[n_chunks - 1].of.offset <= file->offset);
 
 	/* Swap file descriptors for the next pass. */
 	*tmpfd = file->fd;
-	*file = of;
-
-	UNIV_MEM_INVALID(&block[0], 3 * srv_sort_buf_size);
+	file->fd = chunks[n_chunks - 1].of.fd;
+	file->offset = chunks[n_chunks - 1].of.offset;
 
 	return(DB_SUCCESS);
 }
@@ -2287,12 +2409,19 @@ row_merge_sort(
 	merge_file_t*		file,	/*!< in/out: file containing
 					index entries */
 	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
-	int*			tmpfd)	/*!< in/out: temporary file handle */
+	int*			tmpfd,	/*!< in/out: temporary file handle */
+	ulint			n_threads)/*!< in: maximum number of
+					threads to merge with; unique
+					indexes are always merged by
+					one thread */
 {
-	const ulint	half	= file->offset / 2;
-	ulint		num_runs;
-	ulint*		run_offset;
-	dberr_t		error	= DB_SUCCESS;
+	ulint			num_runs;
+	ulint*			run_offset;
+	ulint*			in_offset;
+	row_merge_block_t*	blocks[ROW_MERGE_MAX_THREADS];
+	ulint			block_size = 3 * srv_sort_buf_size;
+	dberr_t			error	= DB_SUCCESS;
+	ulint			i;
 	DBUG_ENTER("row_merge_sort");
 
 	/* Record the number of merge runs we need to perform */
@@ -2303,12 +2432,43 @@ row_merge_sort(
 		DBUG_RETURN(error);
 	}
 
+	/* A duplicate in a unique index is reported by copying the
+	record to the shared MySQL TABLE object, which must not be done
+	by several threads at a time. */
+	if (dict_index_is_unique(dup->index)) {
+		n_threads = 1;
+	}
+
+	n_threads = ut_min(n_threads, ulint(ROW_MERGE_MAX_THREADS));
+
+	/* Each helper thread needs 3 buffers of its own. Use fewer
+	threads if the memory cannot be allocated. */
+	blocks[0] = block;
+
+	for (i = 1; i < n_threads; i++) {
+		ulint	size = block_size;
+
+		blocks[i] = static_cast<row_merge_block_t*>(
+			os_mem_alloc_large(&size, FALSE));
+
+		if (blocks[i] == NULL) {
+			break;
+		}
+
+		ut_ad(size == block_size);
+	}
+
+	n_threads = i;
+
 	/* "run_offset" records each run's first offset number */
-	run_offset = (ulint*) mem_alloc(file->offset * sizeof(ulint));
+	run_offset = (ulint*) mem_alloc(2 * file->offset * sizeof(ulint));
+	in_offset = run_offset + file->offset;
 
 	/* This tells row_merge() where to start for the first round
-	of merge. */
-	run_offset[half] = half;
+	of merge. Initially every block is a run of its own. */
+	for (i = 0; i < num_runs; i++) {
+		run_offset[i] = i;
+	}
 
 	/* The file should always contain at least one byte (the end
 	of file marker).  Thus, it must be at least one block. */
@@ -2316,8 +2476,8 @@ row_merge_sort(
 
 	/* Merge the runs until we have one big run */
 	do {
-		error = row_merge(trx, dup, file, block, tmpfd,
-				  &num_runs, run_offset);
+		error = row_merge(trx, dup, file, blocks, n_threads, tmpfd,
+				  &num_runs, run_offset, in_offset);
 
 		if (error != DB_SUCCESS) {
 			break;
@@ -2328,6 +2488,10 @@ row_merge_sort(
 
 	mem_free(run_offset);
 
+	for (i = 1; i < n_threads; i++) {
+		os_mem_free_large(blocks[i], block_size);
+	}
+
 	DBUG_RETURN(error);
 }
 
@@ -2396,12 +2560,20 @@ row_merge_insert_index_tuples(
 	ulint			foffs = 0;
 	ulint*			offsets;
 	mrec_buf_t*		buf;
+	btr_bulk_t		bulk;
+	/* Compressed pages are filled by inserting record by record,
+	so that the compression of each page can be checked. */
+	const bool		use_bulk = !dict_table_zip_size(index->table);
 	DBUG_ENTER("row_merge_insert_index_tuples");
 
 	ut_ad(!srv_read_only_mode);
 	ut_ad(!(index->type & DICT_FTS));
 	ut_ad(trx_id);
 
+	if (use_bulk) {
+		btr_bulk_init(&bulk, index, trx_id);
+	}
+
 	tuple_heap = mem_heap_create(1000);
 
 	{
@@ -2486,6 +2658,20 @@ row_merge_insert_index_tuples(
 			}
 
 			ut_ad(dtuple_validate(dtuple));
+
+			if (use_bulk) {
+				/* Append to the rightmost leaf page,
+				without descending the tree. */
+				error = btr_bulk_insert(&bulk, dtuple);
+
+				if (error != DB_SUCCESS) {
+					goto err_exit;
+				}
+
+				mem_heap_empty(tuple_heap);
+				continue;
+			}
+
 			log_free_check();
 
 			mtr_start(&mtr);
@@ -2576,6 +2762,10 @@ row_merge_insert_index_tuples(
 	}
 
 err_exit:
+	if (use_bulk) {
+		error = btr_bulk_finish(&bulk, error);
+	}
+
 	mem_heap_free(tuple_heap);
 	mem_heap_free(ins_heap);
 	mem_heap_free(heap);
@@ -3735,7 +3925,7 @@ wait_again:
 
 			error = row_merge_sort(
 				trx, &dup, &merge_files[i],
-				block, &tmpfd);
+				block, &tmpfd, srv_merge_sort_threads);
 
 			if (error == DB_SUCCESS) {
 				error = row_merge_insert_index_tuples(
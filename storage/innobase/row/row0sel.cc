@@ -1217,8 +1217,8 @@ row_sel_try_search_shortcut(
 	plan_t*		plan,	/*!< in: plan for a unique search in clustered
 				index */
 	ibool		search_latch_locked,
-				/*!< in: whether the search holds
-				btr_search_latch */
+				/*!< in: whether the search holds the
+				adaptive hash index latch of plan->index */
 	mtr_t*		mtr)	/*!< in: mtr */
 {
 	dict_index_t*	index;
@@ -1236,7 +1236,8 @@ row_sel_try_search_shortcut(
 	ut_ad(!plan->must_get_clust);
 #ifdef UNIV_SYNC_DEBUG
 	if (search_latch_locked) {
-		ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
+		ut_ad(rw_lock_own(btr_search_get_latch(index),
+				  RW_LOCK_SHARED));
 	}
 #endif /* UNIV_SYNC_DEBUG */
 
@@ -1329,7 +1330,9 @@ row_sel(
 	rec_t*		rec;
 	rec_t*		old_vers;
 	rec_t*		clust_rec;
-	ibool		search_latch_locked;
+	rw_lock_t*	search_latch_locked;
+					/* the adaptive hash index latch
+					held in s-mode, or NULL */
 	ibool		consistent_read;
 
 	/* The following flag becomes TRUE when we are doing a
@@ -1357,7 +1360,7 @@ row_sel(
 
 	ut_ad(thr->run_node == node);
 
-	search_latch_locked = FALSE;
+	search_latch_locked = NULL;
 
 	if (node->read_view) {
 		/* In consistent reads, we try to do with the hash index and
@@ -1407,11 +1410,24 @@ table_loop:
 	if (consistent_read && plan->unique_search && !plan->pcur_is_open
 	    && !plan->must_get_clust
 	    && !plan->table->big_rows) {
+		btr_search_part_t*	part
+			= btr_search_get_part(plan->index);
+
+		if (search_latch_locked
+		    && search_latch_locked != &part->latch) {
+			/* We hold the latch of the partition of the
+			index of another table */
+			rw_lock_s_unlock(search_latch_locked);
+
+			search_latch_locked = NULL;
+		}
+
 		if (!search_latch_locked) {
-			rw_lock_s_lock(&btr_search_latch);
+			btr_search_s_lock(part);
 
-			search_latch_locked = TRUE;
-		} else if (rw_lock_get_writer(&btr_search_latch) == RW_LOCK_WAIT_EX) {
+			search_latch_locked = &part->latch;
+		} else if (rw_lock_get_writer(&part->latch)
+			   == RW_LOCK_WAIT_EX) {
 
 			/* There is an x-latch request waiting: release the
 			s-latch for a moment; as an s-latch here is often
@@ -1420,13 +1436,12 @@ table_loop:
 			from acquiring an s-latch for a long time, lowering
 			performance significantly in multiprocessors. */
 
-			rw_lock_s_unlock(&btr_search_latch);
-			rw_lock_s_lock(&btr_search_latch);
+			rw_lock_s_unlock(&part->latch);
+			rw_lock_s_lock(&part->latch);
 		}
 
 		found_flag = row_sel_try_search_shortcut(node, plan,
-							 search_latch_locked,
-							 &mtr);
+							 TRUE, &mtr);
 
 		if (found_flag == SEL_FOUND) {
 
@@ -1446,16 +1461,16 @@ table_loop:
 	}
 
 	if (search_latch_locked) {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(search_latch_locked);
 
-		search_latch_locked = FALSE;
+		search_latch_locked = NULL;
 	}
 
 	if (!plan->pcur_is_open) {
 		/* Evaluate the expressions to build the search tuple and
 		open the cursor */
 
-		row_sel_open_pcur(plan, search_latch_locked, &mtr);
+		row_sel_open_pcur(plan, FALSE, &mtr);
 
 		cursor_just_opened = TRUE;
 
@@ -2022,7 +2037,7 @@ lock_wait_or_error:
 
 func_exit:
 	if (search_latch_locked) {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(search_latch_locked);
 	}
 	if (UNIV_LIKELY_NULL(heap)) {
 		mem_heap_free(heap);
@@ -4043,7 +4058,8 @@ row_search_for_mysql(
 	}
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!sync_thread_levels_nonempty_trx(trx->has_search_latch));
+	ut_ad(!sync_thread_levels_nonempty_trx(
+		trx->has_search_latch != NULL));
 #endif /* UNIV_SYNC_DEBUG */
 
 	if (dict_table_is_discarded(prebuilt->table)) {
@@ -4107,16 +4123,17 @@ row_search_for_mysql(
 	/* PHASE 0: Release a possible s-latch we are holding on the
 	adaptive hash index latch if there is someone waiting behind */
 
-	if (UNIV_UNLIKELY(rw_lock_get_writer(&btr_search_latch) != RW_LOCK_NOT_LOCKED)
-	    && trx->has_search_latch) {
+	if (trx->has_search_latch
+	    && UNIV_UNLIKELY(rw_lock_get_writer(trx->has_search_latch)
+			     != RW_LOCK_NOT_LOCKED)) {
 
 		/* There is an x-latch request on the adaptive hash index:
 		release the s-latch to reduce starvation and wait for
 		BTR_SEA_TIMEOUT rounds before trying to keep it again over
 		calls from MySQL */
 
-		rw_lock_s_unlock(&btr_search_latch);
-		trx->has_search_latch = FALSE;
+		rw_lock_s_unlock(trx->has_search_latch);
+		trx->has_search_latch = NULL;
 
 		trx->search_latch_timeout = BTR_SEA_TIMEOUT;
 	}
@@ -4267,9 +4284,20 @@ row_search_for_mysql(
 			hash index semaphore! */
 
 #ifndef UNIV_SEARCH_DEBUG
+			btr_search_part_t*	part
+				= btr_search_get_part(index);
+
+			if (trx->has_search_latch
+			    && trx->has_search_latch != &part->latch) {
+				/* We hold the latch of the partition
+				of another index */
+				rw_lock_s_unlock(trx->has_search_latch);
+				trx->has_search_latch = NULL;
+			}
+
 			if (!trx->has_search_latch) {
-				rw_lock_s_lock(&btr_search_latch);
-				trx->has_search_latch = TRUE;
+				btr_search_s_lock(part);
+				trx->has_search_latch = &part->latch;
 			}
 #endif
 			switch (row_sel_try_search_shortcut_for_mysql(
@@ -4340,8 +4368,9 @@ release_search_latch_if_needed:
 
 					trx->search_latch_timeout--;
 
-					rw_lock_s_unlock(&btr_search_latch);
-					trx->has_search_latch = FALSE;
+					rw_lock_s_unlock(
+						trx->has_search_latch);
+					trx->has_search_latch = NULL;
 				}
 
 				/* NOTE that we do NOT store the cursor
@@ -4364,8 +4393,8 @@ release_search_latch_if_needed:
 	/* PHASE 3: Open or restore index cursor position */
 
 	if (trx->has_search_latch) {
-		rw_lock_s_unlock(&btr_search_latch);
-		trx->has_search_latch = FALSE;
+		rw_lock_s_unlock(trx->has_search_latch);
+		trx->has_search_latch = NULL;
 	}
 
 	/* The state of a running trx can only be changed by the
@@ -5573,7 +5602,8 @@ func_exit:
 	}
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!sync_thread_levels_nonempty_trx(trx->has_search_latch));
+	ut_ad(!sync_thread_levels_nonempty_trx(
+		trx->has_search_latch != NULL));
 #endif /* UNIV_SYNC_DEBUG */
 
 	DEBUG_SYNC_C("innodb_row_search_for_mysql_exit");
@@ -1858,7 +1858,13 @@ row_upd_sec_step(
 	if (node->state == UPD_NODE_UPDATE_ALL_SEC
 	    || row_upd_changes_ord_field_binary(node->index, node->update,
 						thr, node->row, node->ext)) {
-		return(row_upd_sec_index_entry(node, thr));
+		dberr_t	err = row_upd_sec_index_entry(node, thr);
+
+		if (err == DB_SUCCESS) {
+			node->index->stat_modified_counter++;
+		}
+
+		return(err);
 	}
 
 	return(DB_SUCCESS);
@@ -2411,6 +2417,7 @@ row_upd_clust_step(
 			node, index, offsets, thr, referenced, &mtr);
 
 		if (err == DB_SUCCESS) {
+			index->stat_modified_counter++;
 			node->state = UPD_NODE_UPDATE_ALL_SEC;
 			node->index = dict_table_get_next_index(index);
 		}
@@ -2460,6 +2467,8 @@ row_upd_clust_step(
 			goto exit_func;
 		}
 
+		index->stat_modified_counter++;
+
 		node->state = UPD_NODE_UPDATE_ALL_SEC;
 	} else {
 		err = row_upd_clust_rec(
@@ -464,7 +464,8 @@ retry:
 
 	ut_ad(!trx->has_search_latch);
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!sync_thread_levels_nonempty_trx(trx->has_search_latch));
+	ut_ad(!sync_thread_levels_nonempty_trx(
+		trx->has_search_latch != NULL));
 #endif /* UNIV_SYNC_DEBUG */
 	trx->op_info = "waiting in InnoDB queue";
 
@@ -504,7 +505,8 @@ srv_conc_enter_innodb(
 			thread */
 {
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!sync_thread_levels_nonempty_trx(trx->has_search_latch));
+	ut_ad(!sync_thread_levels_nonempty_trx(
+		trx->has_search_latch != NULL));
 #endif /* UNIV_SYNC_DEBUG */
 
 #ifdef HAVE_ATOMIC_BUILTINS
@@ -525,7 +527,8 @@ srv_conc_force_enter_innodb(
 			thread */
 {
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!sync_thread_levels_nonempty_trx(trx->has_search_latch));
+	ut_ad(!sync_thread_levels_nonempty_trx(
+		trx->has_search_latch != NULL));
 #endif /* UNIV_SYNC_DEBUG */
 
 	if (!srv_thread_concurrency) {
@@ -571,7 +574,8 @@ srv_conc_force_exit_innodb(
 #endif /* HAVE_ATOMIC_BUILTINS */
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!sync_thread_levels_nonempty_trx(trx->has_search_latch));
+	ut_ad(!sync_thread_levels_nonempty_trx(
+		trx->has_search_latch != NULL));
 #endif /* UNIV_SYNC_DEBUG */
 }
 
@@ -30,6 +30,7 @@ Created 12/9/2009 Jimmy Yang
 #include "srv0mon.h"
 #include "srv0srv.h"
 #include "buf0buf.h"
+#include "btr0sea.h"
 #include "trx0sys.h"
 #include "trx0rseg.h"
 #include "lock0lock.h"
@@ -123,6 +124,18 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_NUM_RECLOCK_REQ},
 
+	{"lock_rec_lock_partition_checks", "lock",
+	 "Number of record lock checks done holding only a lock_sys"
+	 " partition mutex",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_RECLOCK_PARTITION_CHECK},
+
+	{"lock_rec_lock_partition_fallbacks", "lock",
+	 "Number of record lock checks that found an explicit lock and"
+	 " fell back to lock_sys->mutex",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_RECLOCK_PARTITION_FALLBACK},
+
 	{"lock_rec_lock_created", "lock", "Number of record locks created",
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_RECLOCK_CREATED},
@@ -382,6 +395,23 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_FLUSH_PCT_FOR_LSN},
 
+	{"buffer_flush_instance_max_lag", "buffer",
+	 "Largest age of the oldest modified page of a buffer pool instance"
+	 " (lsn), as seen by the page cleaner",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_INSTANCE_MAX_LAG},
+
+	{"buffer_flush_instance_min_lag", "buffer",
+	 "Smallest age of the oldest modified page of a buffer pool instance"
+	 " (lsn), as seen by the page cleaner",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_INSTANCE_MIN_LAG},
+
+	{"buffer_flush_cleaner_worker_pages", "buffer",
+	 "Pages flushed or evicted by the page cleaner worker threads",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_WORKER_PAGES},
+
 	{"buffer_flush_sync_waits", "buffer",
 	 "Number of times a wait happens due to sync flushing",
 	 MONITOR_NONE,
@@ -848,6 +878,29 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_LOG_IO},
 
+	{"log_parallel_copies", "recovery",
+	 "Number of mini-transaction log copies done after releasing"
+	 " the log mutex (innodb_log_parallel_copy)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_PARALLEL_COPY},
+
+	{"log_pending_copy_waits", "recovery",
+	 "Number of times a log buffer write or move waited for"
+	 " mini-transactions to copy their log records",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_PENDING_COPY_WAITS},
+
+	{"log_writer_writes", "recovery",
+	 "Number of log writes done by the log_writer thread",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_WRITER_WRITES},
+
+	{"log_writer_commit_waits", "recovery",
+	 "Number of times a committing transaction had to sleep until"
+	 " the log_writer thread made its commit durable",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_WRITER_COMMIT_WAITS},
+
 	{"log_waits", "recovery",
 	 "Number of log waits due to small log buffer (innodb_log_waits)",
 	 static_cast<monitor_type_t>(
@@ -940,6 +993,27 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_SEARCH_BTREE},
 
+	{"adaptive_hash_hits", "adaptive_hash_index",
+	 "Number of Adaptive Hash Index lookups that found the record,"
+	 " summed over all partitions",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_HITS},
+
+	{"adaptive_hash_misses", "adaptive_hash_index",
+	 "Number of Adaptive Hash Index lookups that failed,"
+	 " summed over all partitions",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_MISSES},
+
+	{"adaptive_hash_latch_waits", "adaptive_hash_index",
+	 "Number of times an Adaptive Hash Index partition latch could not"
+	 " be acquired at once, summed over all partitions",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_LATCH_WAITS},
+
 	{"adaptive_hash_pages_added", "adaptive_hash_index",
 	 "Number of index pages on which the Adaptive Hash Index is built",
 	 MONITOR_NONE,
@@ -1462,6 +1536,9 @@ srv_mon_process_existing_counter(
 	ulint			LRU_len;
 	ulint			free_len;
 	ulint			flush_list_len;
+	ulint			ahi_hits;
+	ulint			ahi_misses;
+	ulint			ahi_latch_waits;
 
 	monitor_info = srv_mon_get_info(monitor_id);
 
@@ -1805,6 +1882,21 @@ srv_mon_process_existing_counter(
 		value = btr_cur_n_non_sea;
 		break;
 
+	case MONITOR_OVLD_ADAPTIVE_HASH_HITS:
+		btr_search_get_stats(&ahi_hits, &ahi_misses, &ahi_latch_waits);
+		value = ahi_hits;
+		break;
+
+	case MONITOR_OVLD_ADAPTIVE_HASH_MISSES:
+		btr_search_get_stats(&ahi_hits, &ahi_misses, &ahi_latch_waits);
+		value = ahi_misses;
+		break;
+
+	case MONITOR_OVLD_ADAPTIVE_HASH_LATCH_WAITS:
+		btr_search_get_stats(&ahi_hits, &ahi_misses, &ahi_latch_waits);
+		value = ahi_latch_waits;
+		break;
+
 	default:
 		ut_error;
 	}
@@ -139,6 +139,12 @@ on duplicate key checking and foreign key checking */
 UNIV_INTERN ibool	srv_locks_unsafe_for_binlog = FALSE;
 /** Sort buffer size in index creation */
 UNIV_INTERN ulong	srv_sort_buf_size = 1048576;
+/** Number of threads that merge the sort files of a non-unique index
+in index creation */
+UNIV_INTERN ulong	srv_merge_sort_threads = 1;
+/** Percentage of each B-tree page that is filled when an index is
+built from sorted records */
+UNIV_INTERN ulong	srv_fill_factor = 100;
 /** Maximum modification log file size for online index creation */
 UNIV_INTERN unsigned long long	srv_online_max_size;
 
@@ -194,6 +200,12 @@ UNIV_INTERN ib_uint64_t	srv_log_file_size_requested;
 UNIV_INTERN ulint	srv_log_buffer_size	= ULINT_MAX;
 UNIV_INTERN ulong	srv_flush_log_at_trx_commit = 1;
 UNIV_INTERN uint	srv_flush_log_at_timeout = 1;
+/* whether mini-transactions copy their log records to the log buffer
+after releasing log_sys->mutex */
+UNIV_INTERN my_bool	srv_log_parallel_copy	= FALSE;
+/* whether committing transactions leave the log write and flush to the
+log_writer thread */
+UNIV_INTERN my_bool	srv_log_writer_thread	= FALSE;
 UNIV_INTERN ulong	srv_page_size		= UNIV_PAGE_SIZE_DEF;
 UNIV_INTERN ulong	srv_page_size_shift	= UNIV_PAGE_SIZE_SHIFT_DEF;
 
@@ -225,6 +237,10 @@ UNIV_INTERN my_bool	srv_buf_pool_populate	= FALSE;
 UNIV_INTERN ulint       srv_buf_pool_instances  = 1;
 /* number of locks to protect buf_pool->page_hash */
 UNIV_INTERN ulong	srv_n_page_hash_locks = 16;
+/* number of threads that apply the redo log in crash recovery */
+UNIV_INTERN ulong	srv_n_recovery_apply_threads = 1;
+/* number of threads that flush the buffer pool instances */
+UNIV_INTERN ulong	srv_n_page_cleaners	= 1;
 /** Scan depth for LRU flush batch i.e.: number of blocks scanned*/
 UNIV_INTERN ulong	srv_LRU_scan_depth	= 1024;
 /** whether or not to flush neighbors of a block */
@@ -238,6 +254,8 @@ UNIV_INTERN ulint	srv_sync_pool_size	= 1024;
 /* size in bytes */
 UNIV_INTERN ulint	srv_mem_pool_size	= ULINT_MAX;
 UNIV_INTERN ulint	srv_lock_table_size	= ULINT_MAX;
+/* number of mutexes partitioning lock_sys->rec_hash */
+UNIV_INTERN ulong	srv_n_lock_sys_partitions = 16;
 
 UNIV_INTERN ulint	srv_idle_flush_pct = 100;
 
@@ -363,6 +381,11 @@ UNIV_INTERN unsigned long long	srv_stats_transient_sample_pages = 8;
 UNIV_INTERN my_bool		srv_stats_persistent = TRUE;
 UNIV_INTERN unsigned long long	srv_stats_persistent_sample_pages = 20;
 UNIV_INTERN my_bool		srv_stats_auto_recalc = TRUE;
+/* If this is set, the automatic recalculation of persistent statistics only
+analyzes the indexes which changed enough since they were last analyzed */
+UNIV_INTERN my_bool		srv_stats_incremental_recalc = FALSE;
+/* Number of threads that analyze the indexes of a table for ANALYZE TABLE */
+UNIV_INTERN ulong		srv_stats_analyze_threads = 1;
 
 UNIV_INTERN ulong	srv_use_doublewrite_buf	= 1;
 UNIV_INTERN my_bool	srv_doublewrite_reset = FALSE;
@@ -373,6 +396,11 @@ batch flushing i.e.: LRU flushing and flush_list flushing. The rest
 of the pages are used for single page flushing. */
 UNIV_INTERN ulong	srv_doublewrite_batch_size	= 120;
 
+/** If this is set, the batches of each buffer pool instance and flush type
+are written to their own doublewrite file instead of the doublewrite buffer
+in the system tablespace. */
+UNIV_INTERN my_bool	srv_parallel_doublewrite	= FALSE;
+
 UNIV_INTERN ulong	srv_replication_delay		= 0;
 
 /*-------------------------------------------*/
@@ -1245,7 +1273,7 @@ srv_printf_innodb_monitor(
 	      "-------------------------------------\n", file);
 	ibuf_print(file);
 
-	ha_print_info(file, btr_search_sys->hash_index);
+	btr_search_print_info(file);
 
 	fprintf(file,
 		"%.2f hash searches/s, %.2f non-hash searches/s\n",
@@ -1835,7 +1835,10 @@ innobase_start_or_create_for_mysql(void)
 			    + 1 /* dict_stats_thread */
 			    + 1 /* fts_optimize_thread */
 			    + 1 /* recv_writer_thread */
+			    + srv_n_recovery_apply_threads
 			    + 1 /* buf_flush_page_cleaner_thread */
+			    + srv_n_page_cleaners /* workers */
+			    + 1 /* log_writer_thread */
 			    + 1 /* trx_rollback_or_clean_all_recovered */
 			    + 128 /* added as margin, for use of
 				  InnoDB Memcached etc. */
@@ -2445,6 +2448,10 @@ files_checked:
 			return(DB_ERROR);
 		}
 
+		/* The pages loaded from the doublewrite files are not
+		needed after the redo log has been scanned. */
+		buf_dblwr_free_recv_pages();
+
 		/* Since the insert buffer init is in dict_boot, and the
 		insert buffer is needed in any disk i/o, first we call
 		dict_boot(). Note that trx_sys_init_at_db_start() only needs
@@ -2736,12 +2743,31 @@ files_checked:
 		purge_sys->state = PURGE_STATE_DISABLED;
 	}
 
+	/* The page cleaner workers are coordinated by the page_cleaner
+	thread, which also tells them to exit. */
+	if (srv_read_only_mode) {
+		srv_n_page_cleaners = 1;
+	} else if (srv_n_page_cleaners > srv_buf_pool_instances) {
+		srv_n_page_cleaners = srv_buf_pool_instances;
+	}
+
+	buf_flush_page_cleaner_init();
+
 	if (!srv_read_only_mode) {
 		os_thread_create(buf_flush_page_cleaner_thread, NULL, NULL);
+
+		for (i = 1; i < srv_n_page_cleaners; ++i) {
+			os_thread_create(
+				buf_flush_page_cleaner_worker, NULL, NULL);
+		}
 	}
 
 	os_thread_create(buf_flush_lru_manager_thread, NULL, NULL);
 
+	if (!srv_read_only_mode && srv_log_writer_thread) {
+		os_thread_create(log_writer_thread, NULL, NULL);
+	}
+
 #ifdef UNIV_DEBUG
 	/* buf_debug_prints = TRUE; */
 #endif /* UNIV_DEBUG */
@@ -3061,6 +3087,7 @@ innobase_shutdown_for_mysql(void)
 	btr_search_disable();
 
 	ibuf_close();
+	buf_flush_page_cleaner_close();
 	log_shutdown();
 	trx_sys_file_format_close();
 	trx_sys_close();
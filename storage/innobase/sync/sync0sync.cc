@@ -993,7 +993,7 @@ sync_thread_levels_nonempty_gen(
 
 /******************************************************************//**
 Checks if the level array for the current thread is empty,
-except for the btr_search_latch.
+except for an adaptive hash index partition latch.
 @return	a latch, or NULL if empty except the exceptions specified below */
 UNIV_INTERN
 void*
@@ -1001,7 +1001,8 @@ sync_thread_levels_nonempty_trx(
 /*============================*/
 	ibool	has_search_latch)
 				/*!< in: TRUE if and only if the thread
-				is supposed to hold btr_search_latch */
+				is supposed to hold an adaptive
+				hash index partition latch */
 {
 	ulint		i;
 	sync_arr_t*	arr;
@@ -1147,7 +1148,6 @@ sync_thread_add_level(
 	case SYNC_ANY_LATCH:
 	case SYNC_FILE_FORMAT_TAG:
 	case SYNC_DOUBLEWRITE:
-	case SYNC_SEARCH_SYS:
 	case SYNC_THREADS:
 	case SYNC_LOCK_SYS:
 	case SYNC_LOCK_WAIT_SYS:
@@ -1182,6 +1182,7 @@ sync_thread_add_level(
 		break;
 	case SYNC_BUF_FLUSH_LIST:
 	case SYNC_BUF_POOL:
+	case SYNC_SEARCH_SYS:
 		/* We can have multiple mutexes of this type therefore we
 		can only check whether the greater than condition holds. */
 		if (!sync_thread_levels_g(array, level-1, TRUE)) {
@@ -33,6 +33,8 @@
 #include "thread_utils.h"
 #include "test_mdl_context_owner.h"
 
+#include <iostream>
+
 /*
   Mock thd_wait_begin/end functions
 */
@@ -1582,6 +1584,191 @@ TEST_F(MDLTest, HogLockTest5)
 }
 
 
+/*
+  A test fixture which owner doesn't need notify_shared_lock() calls
+  for its weak locks, so they are granted on the fast path.
+*/
+class MDLFastPathTest : public MDLTest
+{
+protected:
+  virtual bool needs_shared_lock_notification() { return false; }
+};
+
+
+/*
+  Verifies that locks granted on the fast path are taken into account
+  by an exclusive request from another thread, and that the request is
+  granted as soon as they are released.
+*/
+TEST_F(MDLFastPathTest, ExclusiveWaitsForFastPathLock)
+{
+  Notification lock_grabbed;
+  Notification release_locks;
+  Notification lock_blocked;
+
+  m_request.init(MDL_key::TABLE, db_name, table_name1, MDL_SHARED_READ,
+                 MDL_TRANSACTION);
+  EXPECT_FALSE(m_mdl_context.try_acquire_lock(&m_request));
+  EXPECT_NE(m_null_ticket, m_request.ticket);
+
+  MDL_thread mdl_thread(table_name1, MDL_EXCLUSIVE, &lock_grabbed,
+                        &release_locks, &lock_blocked, NULL);
+  mdl_thread.start();
+  lock_blocked.wait_for_notification();
+
+  // Weak requests from other contexts have to queue behind the pending X.
+  MDL_context other_context;
+  MDL_request other_request;
+  other_context.init(this);
+  other_request.init(MDL_key::TABLE, db_name, table_name1, MDL_SHARED_WRITE,
+                     MDL_TRANSACTION);
+  EXPECT_FALSE(other_context.try_acquire_lock(&other_request));
+  EXPECT_EQ(m_null_ticket, other_request.ticket);
+  other_context.destroy();
+
+  m_mdl_context.release_transactional_locks();
+  lock_grabbed.wait_for_notification();
+  release_locks.notify();
+  mdl_thread.join();
+}
+
+
+/*
+  Verifies that an obtrusive request is not blocked by locks which the
+  same context was granted on the fast path.
+*/
+TEST_F(MDLFastPathTest, UpgradeOwnFastPathLocks)
+{
+  MDL_request sr_request;
+  sr_request.init(MDL_key::TABLE, db_name, table_name1, MDL_SHARED_READ,
+                  MDL_TRANSACTION);
+  m_request_list.push_front(&sr_request);
+  m_request_list.push_front(&m_global_request);
+  EXPECT_FALSE(m_mdl_context.acquire_locks(&m_request_list, zero_timeout));
+
+  m_request.init(MDL_key::TABLE, db_name, table_name1, MDL_EXCLUSIVE,
+                 MDL_TRANSACTION);
+  EXPECT_FALSE(m_mdl_context.acquire_lock(&m_request, zero_timeout));
+  EXPECT_TRUE(m_mdl_context.
+              is_lock_owner(MDL_key::TABLE, db_name, table_name1,
+                            MDL_EXCLUSIVE));
+
+  MDL_context other_context;
+  MDL_request other_request;
+  other_context.init(this);
+  other_request.init(MDL_key::TABLE, db_name, table_name1, MDL_SHARED_READ,
+                     MDL_TRANSACTION);
+  EXPECT_FALSE(other_context.try_acquire_lock(&other_request));
+  EXPECT_EQ(m_null_ticket, other_request.ticket);
+
+  m_mdl_context.release_transactional_locks();
+
+  EXPECT_FALSE(other_context.try_acquire_lock(&other_request));
+  EXPECT_NE(m_null_ticket, other_request.ticket);
+  other_context.release_transactional_locks();
+  other_context.destroy();
+}
+
+
+/*
+  Acquires and releases the metadata locks taken by a DML statement
+  on a single table in a loop: SR, or IX in GLOBAL namespace and SW.
+*/
+class MDL_dml_thread : public Thread, public Test_MDL_context_owner
+{
+public:
+  MDL_dml_thread(enum_mdl_type mdl_type, int cycles, bool fast_path)
+  : m_mdl_type(mdl_type),
+    m_cycles(cycles),
+    m_fast_path(fast_path)
+  {
+    m_mdl_context.init(this);
+  }
+
+  ~MDL_dml_thread()
+  {
+    m_mdl_context.destroy();
+  }
+
+  virtual void run()
+  {
+    for (int i= 0; i < m_cycles; i++)
+    {
+      MDL_request global_request;
+      MDL_request request;
+      global_request.init(MDL_key::GLOBAL, "", "", MDL_INTENTION_EXCLUSIVE,
+                          MDL_STATEMENT);
+      request.init(MDL_key::TABLE, db_name, table_name1, m_mdl_type,
+                   MDL_TRANSACTION);
+
+      if (m_mdl_type == MDL_SHARED_WRITE)
+      {
+        EXPECT_FALSE(m_mdl_context.acquire_lock(&global_request,
+                                                long_timeout));
+      }
+      EXPECT_FALSE(m_mdl_context.acquire_lock(&request, long_timeout));
+      m_mdl_context.release_statement_locks();
+      m_mdl_context.release_transactional_locks();
+    }
+  }
+
+  virtual bool notify_shared_lock(MDL_context_owner *in_use,
+                                  bool needs_thr_lock_abort)
+  {
+    return false;
+  }
+
+  virtual bool needs_shared_lock_notification() { return ! m_fast_path; }
+
+private:
+  enum_mdl_type  m_mdl_type;
+  int            m_cycles;
+  bool           m_fast_path;
+  MDL_context    m_mdl_context;
+};
+
+
+/*
+  A microbenchmark for the fast path: several threads repeatedly
+  acquire and release weak locks on the same table, first with the
+  fast path disabled and then with it enabled. Elapsed times are
+  printed for comparison, there is no pass/fail criterion on them.
+*/
+TEST_F(MDLTest, FastPathBenchmark)
+{
+  const int num_threads= 4;
+  const int num_cycles= 50000;
+  const enum_mdl_type types[]= { MDL_SHARED_READ, MDL_SHARED_WRITE };
+
+  for (uint t= 0; t < array_elements(types); t++)
+  {
+    for (int fast_path= 0; fast_path <= 1; fast_path++)
+    {
+      MDL_dml_thread *threads[num_threads];
+      ulonglong start= my_getsystime();
+
+      for (int i= 0; i < num_threads; i++)
+      {
+        threads[i]= new MDL_dml_thread(types[t], num_cycles, fast_path);
+        threads[i]->start();
+      }
+      for (int i= 0; i < num_threads; i++)
+      {
+        threads[i]->join();
+        delete threads[i];
+      }
+
+      ulonglong elapsed= my_getsystime() - start;
+      std::cout << "MDL " << (types[t] == MDL_SHARED_READ ? "SR" : "SW")
+                << (fast_path ? " fast path: " : " slow path: ")
+                << num_threads << " threads x " << num_cycles
+                << " cycles in " << ((double) elapsed) / 1e7 << " secs"
+                << std::endl;
+    }
+  }
+}
+
+
 /** Test class for MDL_key class testing. Doesn't require MDL initialization. */
 
 class MDLKeyTest : public ::testing::Test
@@ -47,6 +47,7 @@ public:
 
   virtual int  is_killed() { return 0; }
   virtual THD* get_thd()   { return NULL; }
+  virtual bool needs_shared_lock_notification() { return true; }
 
 private:
   mysql_mutex_t *m_current_mutex;